@@ -21,6 +21,7 @@
 
 #include "ODApplication.h"
 
+#include "gamemap/LevelIndex.h"
 #include "network/ODServer.h"
 #include "network/ODClient.h"
 #include "network/ServerMode.h"
@@ -30,18 +31,21 @@
 #include "render/ODFrameListener.h"
 #include "render/TextRenderer.h"
 #include "utils/ConfigManager.h"
+#include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/LogSinkConsole.h"
 #include "utils/LogSinkFile.h"
 #include "utils/LogSinkOgre.h"
 #include "utils/Random.h"
 #include "utils/ResourceManager.h"
+#include "utils/StartupProfiler.h"
 
 #include <OgreErrorDialog.h>
 #include <OgreRenderWindow.h>
 #include <OgreRoot.h>
 #include <Overlay/OgreOverlaySystem.h>
 #include <RTShaderSystem/OgreShaderGenerator.h>
+#include <SFML/System.hpp>
 
 #ifdef OD_USE_SFML_WINDOW
 #include "modes/ModeManager.h"
@@ -60,6 +64,8 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <memory>
+#include <vector>
 
 void ODApplication::startGame(boost::program_options::variables_map& options)
 {
@@ -84,32 +90,45 @@ void ODApplication::startServer()
     OD_LOG_INF("Initializing");
 
     Random::initialize();
-    ConfigManager configManager(resMgr.getConfigPath(), "", resMgr.getSoundPath());
+    ConfigManager configManager(resMgr.getConfigPath(), "", resMgr.getSoundPath(), resMgr.getConfigCacheFile());
     OD_LOG_INF("Launching server");
 
     const std::string& creator = resMgr.getServerModeCreator();
 
-    ODServer server;
-    if(!server.startServer(creator, resMgr.getServerModeLevel(), ServerMode::ModeGameMultiPlayer, !creator.empty()))
+    // Every match has its own server running in its own thread. They share the configuration
+    std::vector<std::unique_ptr<ODServer>> servers;
+    for(int32_t matchId = 0; matchId < resMgr.getServerModeNbMatches(); ++matchId)
     {
-        OD_LOG_ERR("Could not start server !!!");
-        return;
+        std::unique_ptr<ODServer> server(new ODServer(static_cast<uint32_t>(matchId)));
+        if(!server->startServer(creator, resMgr.getServerModeLevel(), ServerMode::ModeGameMultiPlayer, !creator.empty()))
+        {
+            OD_LOG_ERR("Could not start server for match " + Helper::toString(matchId) + " !!!");
+            continue;
+        }
+
+        OD_LOG_INF("Match " + Helper::toString(matchId) + " listening on port " + Helper::toString(server->getNetworkPort()));
+        servers.push_back(std::move(server));
     }
 
-    if(!server.waitEndGame())
-    {
-        OD_LOG_ERR("Could not wait for end of game !!!");
+    if(servers.empty())
         return;
-    }
 
-    OD_LOG_INF("Stopping server...");
-    server.stopServer();
+    for(std::unique_ptr<ODServer>& server : servers)
+    {
+        if(!server->waitEndGame())
+            OD_LOG_ERR("Could not wait for end of game for match " + Helper::toString(server->getMatchId()) + " !!!");
+
+        OD_LOG_INF("Stopping server for match " + Helper::toString(server->getMatchId()) + "...");
+        server->stopServer();
+    }
 }
 
 void ODApplication::startClient()
 {
     ResourceManager& resMgr = ResourceManager::getSingleton();
+    StartupProfiler profiler(resMgr.isProfileStartup());
 
+    profiler.startStage("Ogre root and configuration");
     {
         //NOTE: This prevents a segmentation fault from OpenGL on exit.
         //Creating the object sets up an OpenAL context using a static object
@@ -122,11 +141,20 @@ void ODApplication::startClient()
     //as many of them depend on each other.
     OD_LOG_INF("Creating OGRE::Root instance; Plugins path: " + resMgr.getPluginsPath());
 
+    // The configuration files do not depend on Ogre. We read them while Ogre loads its plugins
+    std::unique_ptr<ConfigManager> configManagerPtr;
+    sf::Thread configThread([&]()
+    {
+        configManagerPtr.reset(new ConfigManager(resMgr.getConfigPath(), resMgr.getUserCfgFile(),
+            resMgr.getSoundPath(), resMgr.getConfigCacheFile()));
+    });
+    configThread.launch();
+
     // N.B: We don't use any ogre.cfg file, hence setting the file path value to "".
     Ogre::Root ogreRoot(resMgr.getPluginsPath(), "");
 
-    ConfigManager configManager(resMgr.getConfigPath(), resMgr.getUserCfgFile(),
-        resMgr.getSoundPath());
+    configThread.wait();
+    ConfigManager& configManager = *configManagerPtr;
 
     if (!configManager.initVideoConfig(ogreRoot))
         return;
@@ -136,6 +164,7 @@ void ODApplication::startClient()
 
     const std::string windowTitle = "OpenDungeons " + VERSION;
 
+    profiler.startStage("Window");
     OD_LOG_INF("Creating window...");
 #ifdef OD_USE_SFML_WINDOW
     const unsigned int MIN_WIDTH = 300;
@@ -186,6 +215,7 @@ void ODApplication::startClient()
 #endif /* OD_USE_SFML_WINDOW */
 
 
+    profiler.startStage("Ogre resources");
     //NOTE: This is currently done here as it has to be done after initialising mRoot,
     // but before running initialiseAllResourceGroups()
     resMgr.setupOgreResources(ogreRoot.getRenderSystem()->getNativeShadingLanguageVersion());
@@ -215,12 +245,15 @@ void ODApplication::startClient()
 
     Ogre::ResourceGroupManager::getSingletonPtr()->initialiseAllResourceGroups();
 
+    profiler.startStage("Music, level index and sounds");
     MusicPlayer musicPlayer(resMgr.getMusicPath(), resMgr.listAllMusicFiles());
+    LevelIndex levelIndex(resMgr.getLevelIndexFile());
     SoundEffectsManager soundEffectsManager;
 
     ODServer server;
     ODClient client;
 
+    profiler.startStage("Gui and main menu");
     Gui gui(&soundEffectsManager, resMgr.getCeguiLogFile(), *renderWindow);
     TextRenderer textRenderer;
     textRenderer.addTextBox("DebugMessages", ODApplication::MOTD.c_str(), 840,
@@ -234,6 +267,7 @@ void ODApplication::startClient()
     ogreRoot.addFrameListener(&frameListener);
 
 #ifdef OD_USE_SFML_WINDOW
+    profiler.startStage("First frame");
     bool running = true;
     while(running)
     {
@@ -258,8 +292,11 @@ void ODApplication::startClient()
         // If renderOneFrame returns false, it indicates that an exit has been requested
         running = ogreRoot.renderOneFrame();
         sfmlWindow.display();
+        // The startup ends once the main menu has been displayed
+        profiler.report();
     }
 #else /* OD_USE_SFML_WINDOW */
+    profiler.report();
     ogreRoot.startRendering();
 #endif /* OD_USE_SFML_WINDOW */
 
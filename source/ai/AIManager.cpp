@@ -19,6 +19,11 @@
 
 #include "ai/AIFactory.h"
 #include "ai/BaseAI.h"
+#include "gamemap/GameMap.h"
+#include "network/ODServer.h"
+#include "utils/WorkerPool.h"
+
+#include <functional>
 
 AIManager::AIManager(GameMap& gameMap)
     : mGameMap(gameMap)
@@ -42,6 +47,28 @@ bool AIManager::assignAI(Player& player, KeeperAIType type)
 
 bool AIManager::doTurn(double timeSinceLastTurn)
 {
+    if(mAiList.empty())
+        return true;
+
+    for(BaseAI* ai : mAiList)
+        ai->prepareTurn();
+
+    // The planning phase only reads the gamemap so every AI can plan on its own worker
+    // The workers are shared by the turns of the match so they are bound to its server for each task
+    ODServer* server = ODServer::getSingletonPtr();
+    std::vector<std::function<void()>> tasks;
+    for(BaseAI* ai : mAiList)
+    {
+        tasks.emplace_back([server, ai, timeSinceLastTurn]()
+        {
+            ODServer::ThreadBinding binding(server);
+            ai->planTurn(timeSinceLastTurn);
+        });
+    }
+    mGameMap.getWorkerPool().run(tasks);
+
+    // The plans are applied one after the other in the AI list order so that the result does
+    // not depend on the workers
     for(BaseAI* ai : mAiList)
     {
         ai->doTurn(timeSinceLastTurn);
@@ -57,3 +84,9 @@ void AIManager::clearAIList()
     }
     mAiList.clear();
 }
+
+void AIManager::getRandomGenerators(std::map<std::string, RandomGenerator>& generators) const
+{
+    for(const BaseAI* ai : mAiList)
+        generators[ai->getRandomStateKey()] = ai->getRandomGenerator();
+}
@@ -18,11 +18,14 @@
 #ifndef AIMANAGER_H
 #define AIMANAGER_H
 
+#include <map>
+#include <string>
 #include <vector>
 
 class BaseAI;
 class GameMap;
 class Player;
+class RandomGenerator;
 
 enum class KeeperAIType;
 
@@ -39,6 +42,9 @@ public:
     bool doTurn(double timeSinceLastTurn);
     void clearAIList();
 
+    //! \brief Adds the random generators of the AIs to generators, keyed by Random::getStateKey
+    void getRandomGenerators(std::map<std::string, RandomGenerator>& generators) const;
+
 private:
     GameMap& mGameMap;
     AIList mAiList;
@@ -0,0 +1,249 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ai/AITileMaps.h"
+
+#include "game/Player.h"
+#include "game/Seat.h"
+#include "gamemap/GameMap.h"
+#include "utils/LogManager.h"
+
+#include <algorithm>
+
+static const uint32_t NB_LAYERS = static_cast<uint32_t>(AITileLayer::nbLayers);
+
+static inline uint8_t layerMask(AITileLayer layer)
+{
+    return static_cast<uint8_t>(1 << static_cast<uint32_t>(layer));
+}
+
+AITileMaps::AITileMaps(GameMap& gameMap, Player& player) :
+    mGameMap(gameMap),
+    mPlayer(player),
+    mSizeX(0),
+    mSizeY(0),
+    mIsInitialized(false),
+    mSummedAreas(NB_LAYERS),
+    mIsSummedAreaDirty(NB_LAYERS, true)
+{
+}
+
+AITileMaps::~AITileMaps()
+{
+    if(!mIsInitialized)
+        return;
+
+    for(int xx = 0; xx < mSizeX; ++xx)
+    {
+        for(int yy = 0; yy < mSizeY; ++yy)
+        {
+            Tile* tile = mGameMap.getTile(xx, yy);
+            if(tile == nullptr)
+                continue;
+
+            tile->removeTileStateListener(*this);
+        }
+    }
+}
+
+void AITileMaps::initialize()
+{
+    if(mIsInitialized)
+        return;
+
+    mIsInitialized = true;
+    mSizeX = mGameMap.getMapSizeX();
+    mSizeY = mGameMap.getMapSizeY();
+    mTileFlags.assign(mSizeX * mSizeY, 0);
+    for(int xx = 0; xx < mSizeX; ++xx)
+    {
+        for(int yy = 0; yy < mSizeY; ++yy)
+        {
+            Tile* tile = mGameMap.getTile(xx, yy);
+            if(tile == nullptr)
+                continue;
+
+            tile->addTileStateListener(*this);
+            mTileFlags[xx * mSizeY + yy] = computeTileFlags(*tile);
+        }
+    }
+
+    for(uint32_t layer = 0; layer < NB_LAYERS; ++layer)
+    {
+        mSummedAreas[layer].assign((mSizeX + 1) * (mSizeY + 1), 0);
+        mIsSummedAreaDirty[layer] = true;
+    }
+}
+
+void AITileMaps::tileStateChanged(Tile& tile)
+{
+    if(!mIsInitialized)
+        return;
+
+    // The ground layer depends on the neighbors. We refresh them as well
+    refreshTileFlags(tile);
+    for(Tile* neigh : tile.getAllNeighbors())
+        refreshTileFlags(*neigh);
+}
+
+void AITileMaps::refreshTileFlags(Tile& tile)
+{
+    uint8_t& flags = mTileFlags[tile.getX() * mSizeY + tile.getY()];
+    uint8_t newFlags = computeTileFlags(tile);
+    uint8_t changedFlags = flags ^ newFlags;
+    if(changedFlags == 0)
+        return;
+
+    flags = newFlags;
+    for(uint32_t layer = 0; layer < NB_LAYERS; ++layer)
+    {
+        if((changedFlags & layerMask(static_cast<AITileLayer>(layer))) != 0)
+            mIsSummedAreaDirty[layer] = true;
+    }
+}
+
+uint8_t AITileMaps::computeTileFlags(Tile& tile) const
+{
+    Seat* seat = mPlayer.getSeat();
+    uint8_t flags = 0;
+    if(isGroundTileForRoom(tile))
+        flags |= layerMask(AITileLayer::groundForRoom);
+
+    if(isWallTileForRoom(tile))
+        flags |= layerMask(AITileLayer::wallForRoom);
+
+    if(tile.isBuildableUpon(seat))
+        flags |= layerMask(AITileLayer::buildable);
+
+    if((tile.getType() == TileType::gold) && (tile.getFullness() > 0.0))
+        flags |= layerMask(AITileLayer::goldWall);
+
+    return flags;
+}
+
+bool AITileMaps::isGroundTileForRoom(Tile& tile) const
+{
+    Seat* seat = mPlayer.getSeat();
+    switch(tile.getType())
+    {
+        case TileType::dirt:
+        case TileType::gold:
+        {
+            // Dirt and gold can always be built (even if digging may be needed depending on fullness)
+            if(!tile.isClaimed())
+                return true;
+
+            // We check if we can build on that tile and if there is no building currently
+            if(!tile.isClaimedForSeat(seat))
+                return false;
+            if(tile.getCoveringBuilding() != nullptr)
+                return false;
+
+            // We don't want to break a wall where there are activespots from another one
+            for(Tile* t : tile.getAllNeighbors())
+            {
+                if(t->isClaimedForSeat(seat) &&
+                    (t->getCoveringRoom() != nullptr))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+
+    return false;
+}
+
+bool AITileMaps::isWallTileForRoom(Tile& tile) const
+{
+    // We only consider wall claimed for the correct seat or dirt (that can be claimed)
+    if(tile.getFullness() <= 0.0)
+        return false;
+
+    if(tile.getType() == TileType::dirt)
+        return true;
+
+    if(tile.isWallClaimedForSeat(mPlayer.getSeat()))
+        return true;
+
+    return false;
+}
+
+void AITileMaps::rebuildSummedArea(AITileLayer layer)
+{
+    uint32_t layerIndex = static_cast<uint32_t>(layer);
+    uint8_t mask = layerMask(layer);
+    std::vector<int32_t>& summedArea = mSummedAreas[layerIndex];
+    const int strideX = mSizeY + 1;
+    for(int xx = 0; xx < mSizeX; ++xx)
+    {
+        int32_t columnSum = 0;
+        for(int yy = 0; yy < mSizeY; ++yy)
+        {
+            if((mTileFlags[xx * mSizeY + yy] & mask) != 0)
+                ++columnSum;
+
+            summedArea[(xx + 1) * strideX + yy + 1] = summedArea[xx * strideX + yy + 1] + columnSum;
+        }
+    }
+    mIsSummedAreaDirty[layerIndex] = false;
+}
+
+int32_t AITileMaps::countTiles(AITileLayer layer, int xMin, int yMin, int xMax, int yMax)
+{
+    initialize();
+
+    xMin = std::max(xMin, 0);
+    yMin = std::max(yMin, 0);
+    xMax = std::min(xMax, mSizeX - 1);
+    yMax = std::min(yMax, mSizeY - 1);
+    if((xMin > xMax) || (yMin > yMax))
+        return 0;
+
+    uint32_t layerIndex = static_cast<uint32_t>(layer);
+    if(mIsSummedAreaDirty[layerIndex])
+        rebuildSummedArea(layer);
+
+    const std::vector<int32_t>& summedArea = mSummedAreas[layerIndex];
+    const int strideX = mSizeY + 1;
+    return summedArea[(xMax + 1) * strideX + yMax + 1]
+        - summedArea[xMin * strideX + yMax + 1]
+        - summedArea[(xMax + 1) * strideX + yMin]
+        + summedArea[xMin * strideX + yMin];
+}
+
+int32_t AITileMaps::countTilesOnRing(AITileLayer layer, int x, int y, int distance)
+{
+    if(distance <= 0)
+        return countTiles(layer, x, y, x, y);
+
+    return countTiles(layer, x - distance, y - distance, x + distance, y + distance)
+        - countTiles(layer, x - distance + 1, y - distance + 1, x + distance - 1, y + distance - 1);
+}
+
+bool AITileMaps::isTileInLayer(AITileLayer layer, int x, int y)
+{
+    initialize();
+
+    if((x < 0) || (y < 0) || (x >= mSizeX) || (y >= mSizeY))
+        return false;
+
+    return (mTileFlags[x * mSizeY + y] & layerMask(layer)) != 0;
+}
@@ -0,0 +1,101 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AITILEMAPS_H
+#define AITILEMAPS_H
+
+#include "entities/Tile.h"
+
+#include <cstdint>
+#include <vector>
+
+class GameMap;
+class Player;
+
+//! \brief Tile properties the AI wants to count over rectangles of the gamemap
+enum class AITileLayer
+{
+    groundForRoom,  // Tiles where a room could be built (even if digging is needed)
+    wallForRoom,    // Walls that would give active spots to a room built next to them
+    buildable,      // Tiles where a room can be built right now
+    goldWall,       // Gold tiles that can be dug
+    nbLayers
+};
+
+/*! \brief Keeps, for the seat of the given AI player, a flag per tile and per AITileLayer and
+ * the corresponding summed-area tables. That allows to count the tiles matching a layer in
+ * any rectangle of the gamemap in O(1).
+ * The flags are updated incrementally when the tiles notify a state change. The summed-area
+ * tables are rebuilt lazily when a layer is queried after one of its flags changed.
+ */
+class AITileMaps : public TileStateListener
+{
+public:
+    AITileMaps(GameMap& gameMap, Player& player);
+    virtual ~AITileMaps();
+
+    virtual void tileStateChanged(Tile& tile) override;
+
+    //! \brief Registers the listeners on the gamemap tiles and computes the flags. Does nothing
+    //! if already done. It is called at first use but can be called before to make sure the
+    //! tiles are not modified during the queries
+    void initialize();
+
+    //! \brief Returns the number of tiles matching the given layer in the rectangle
+    //! [xMin;xMax]x[yMin;yMax]. Tiles outside the gamemap are not counted
+    int32_t countTiles(AITileLayer layer, int xMin, int yMin, int xMax, int yMax);
+
+    //! \brief Returns the number of tiles matching the given layer on the border of the square
+    //! of size 2 * distance + 1 centered on the given position
+    int32_t countTilesOnRing(AITileLayer layer, int x, int y, int distance);
+
+    //! \brief Returns true if the tile at the given position matches the given layer
+    bool isTileInLayer(AITileLayer layer, int x, int y);
+
+private:
+    GameMap& mGameMap;
+    Player& mPlayer;
+
+    //! \brief Size of the gamemap when the maps were initialized
+    int mSizeX;
+    int mSizeY;
+
+    //! \brief Set when the listeners have been registered on the gamemap tiles. It is done
+    //! at first use because the gamemap may not be loaded when the AI is created
+    bool mIsInitialized;
+
+    //! \brief Bitmask of the layers matched by each tile. Index is x * mSizeY + y
+    std::vector<uint8_t> mTileFlags;
+
+    //! \brief Summed-area table per layer. Index is x * (mSizeY + 1) + y. The value at (x,y)
+    //! is the number of tiles matching the layer in [0;x-1]x[0;y-1]
+    std::vector<std::vector<int32_t>> mSummedAreas;
+    std::vector<bool> mIsSummedAreaDirty;
+
+    //! \brief Computes the layers bitmask for the given tile
+    uint8_t computeTileFlags(Tile& tile) const;
+
+    //! \brief Refreshes the flags of the given tile and marks the changed layers as dirty
+    void refreshTileFlags(Tile& tile);
+
+    void rebuildSummedArea(AITileLayer layer);
+
+    bool isGroundTileForRoom(Tile& tile) const;
+    bool isWallTileForRoom(Tile& tile) const;
+};
+
+#endif // AITILEMAPS_H
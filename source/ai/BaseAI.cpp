@@ -23,6 +23,7 @@
 #include "entities/Tile.h"
 
 #include "game/Player.h"
+#include "game/Seat.h"
 
 #include "gamemap/GameMap.h"
 
@@ -38,71 +39,35 @@ const int32_t handicapPerTileOffset = 20;
 
 BaseAI::BaseAI(GameMap& gameMap, Player& player):
     mGameMap(gameMap),
-    mPlayer(player)
+    mPlayer(player),
+    mTileMaps(gameMap, player),
+    mRandom(Random::deriveSeed(RandomStream::ai, static_cast<uint64_t>(player.getSeat()->getId())))
 {
+    mGameMap.restoreRandomGenerator(getRandomStateKey(), mRandom);
 }
 
-Room* BaseAI::getDungeonTemple()
+std::string BaseAI::getRandomStateKey() const
 {
-    std::vector<Room*> dt = mGameMap.getRoomsByTypeAndSeat(RoomType::dungeonTemple, mPlayer.getSeat());
-    if(!dt.empty())
-        return dt.front();
-    else
-        return nullptr;
+    return Random::getStateKey(RandomStream::ai, Helper::toString(mPlayer.getSeat()->getId()));
 }
 
-bool BaseAI::shouldGroundTileBeConsideredForBestPlaceForRoom(Tile* tile, Seat* mPlayerSeat)
+void BaseAI::prepareTurn()
 {
-    switch(tile->getType())
-    {
-        case TileType::dirt:
-        case TileType::gold:
-        {
-            // Dirt and gold can always be built (even if digging may be needed depending on fullness)
-            if(!tile->isClaimed())
-                return true;
-
-            // We check if we can build on that tile and if there is no building currently
-            if(!tile->isClaimedForSeat(mPlayerSeat))
-                return false;
-            if(tile->getCoveringBuilding() != nullptr)
-                return false;
-
-            // We don't want to break a wall where there are activespots from another one
-            for(Tile* t : tile->getAllNeighbors())
-            {
-                if(t->isClaimedForSeat(mPlayerSeat) &&
-                    (t->getCoveringRoom() != nullptr))
-                {
-                    return false;
-                }
-            }
-            return true;
-        }
-        default:
-            return false;
-    }
-
-    return false;
+    // The tile maps register listeners on the tiles when initialized
+    mTileMaps.initialize();
 }
 
-bool BaseAI::shouldWallTileBeConsideredForBestPlaceForRoom(Tile* tile, Seat* mPlayerSeat)
+Room* BaseAI::getDungeonTemple()
 {
-    // We only consider wall claimed for the correct seat or dirt (that can be claimed)
-    if(tile->getFullness() <= 0.0)
-        return false;
-
-    if(tile->getType() == TileType::dirt)
-        return true;
-
-    if(tile->isWallClaimedForSeat(mPlayerSeat))
-        return true;
-
-    return false;
+    std::vector<Room*> dt = mGameMap.getRoomsByTypeAndSeat(RoomType::dungeonTemple, mPlayer.getSeat());
+    if(!dt.empty())
+        return dt.front();
+    else
+        return nullptr;
 }
 
 //! To find the position, we try every square of the wantedSize width around the given tile for each possible distance
-bool BaseAI::findBestPlaceForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedSize, bool useWalls,
+bool BaseAI::findBestPlaceForRoom(Tile* tile, int32_t wantedSize, bool useWalls,
     int32_t& bestX, int32_t& bestY)
 {
     // We use a point system to find the best position. Once we find a valid position, we will set a handicap
@@ -137,7 +102,7 @@ bool BaseAI::findBestPlaceForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedS
             // North
             t  = mGameMap.getTile(tile->getX() - offset - wantedSize + 2 + k, tile->getY() + offset);
             if((t != nullptr) &&
-               computePointsForRoom(t, mPlayerSeat, wantedSize, true, useWalls, points))
+               computePointsForRoom(t, wantedSize, true, useWalls, points))
             {
                 points -= handicap;
                 int32_t centerX = t->getX() + (wantedSize / 2);
@@ -157,7 +122,7 @@ bool BaseAI::findBestPlaceForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedS
             // East
             t  = mGameMap.getTile(tile->getX() + offset, tile->getY() - k + offset);
             if((t != nullptr) &&
-               computePointsForRoom(t, mPlayerSeat, wantedSize, true, useWalls, points))
+               computePointsForRoom(t, wantedSize, true, useWalls, points))
             {
                 points -= handicap;
                 int32_t centerX = t->getX() + (wantedSize / 2);
@@ -177,7 +142,7 @@ bool BaseAI::findBestPlaceForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedS
             // South
             t  = mGameMap.getTile(tile->getX() + offset + wantedSize - 2 - k, tile->getY() - offset);
             if((t != nullptr) &&
-               computePointsForRoom(t, mPlayerSeat, wantedSize, false, useWalls, points))
+               computePointsForRoom(t, wantedSize, false, useWalls, points))
             {
                 points -= handicap;
                 int32_t centerX = t->getX() - (wantedSize / 2);
@@ -197,7 +162,7 @@ bool BaseAI::findBestPlaceForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedS
             // West
             t  = mGameMap.getTile(tile->getX() - offset, tile->getY() - offset + k);
             if((t != nullptr) &&
-               computePointsForRoom(t, mPlayerSeat, wantedSize, false, useWalls, points))
+               computePointsForRoom(t, wantedSize, false, useWalls, points))
             {
                 points -= handicap;
                 int32_t centerX = t->getX() - (wantedSize / 2);
@@ -227,45 +192,22 @@ bool BaseAI::findBestPlaceForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedS
     return isFound;
 }
 
-bool BaseAI::computePointsForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedSize,
+bool BaseAI::computePointsForRoom(Tile* tile, int32_t wantedSize,
     bool bottomLeft2TopRight, bool useWalls, int32_t& points)
 {
     int tileX = tile->getX();
     int tileY = tile->getY();
-    bool isOk = true;
 
-    // We check if the tile is reachable. No need to compute if the tile is behind rocks
     points = 0;
-    // We start by searching for a place fitting the min size. If we find it,
-    // we increase tile by tile until the max size. If not, no need to continue
-    for(int32_t xx = 0; xx < wantedSize; ++xx)
-    {
-        for(int32_t yy = 0; yy < wantedSize; ++yy)
-        {
-            Tile* t;
-            if(bottomLeft2TopRight)
-                t  = mGameMap.getTile(tileX + xx, tileY + yy);
-            else
-                t  = mGameMap.getTile(tileX - xx, tileY - yy);
-
-            if(t == nullptr)
-            {
-                isOk = false;
-                break;
-            }
-
-            if(!shouldGroundTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
-            {
-                isOk = false;
-                break;
-            }
-        }
-
-        if(!isOk)
-            break;
-    }
+    // We check if every tile of the square can be used. Tiles outside the gamemap are not counted
+    // so if the count matches, the whole square is within the gamemap
+    int32_t nbGroundTiles;
+    if(bottomLeft2TopRight)
+        nbGroundTiles = mTileMaps.countTiles(AITileLayer::groundForRoom, tileX, tileY, tileX + wantedSize - 1, tileY + wantedSize - 1);
+    else
+        nbGroundTiles = mTileMaps.countTiles(AITileLayer::groundForRoom, tileX - wantedSize + 1, tileY - wantedSize + 1, tileX, tileY);
 
-    if(!isOk)
+    if(nbGroundTiles != wantedSize * wantedSize)
         return false;
 
     // If we don't want to consider walls, we stop here (for example for rooms that do not have bonus
@@ -273,123 +215,53 @@ bool BaseAI::computePointsForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedS
     if(!useWalls)
         return true;
 
-    // We search points for first wall. That's not exactly how the activespots will be computed but it will be enough (especially
+    // We search points for each wall. That's not exactly how the activespots will be computed but it will be enough (especially
     // when the room size is even)
-    int nbConsecutiveTiles;
-    int nbActiveWallSpots;
-    // We search points for first wall
-    nbConsecutiveTiles = 0;
-    nbActiveWallSpots = 0;
-    for(int32_t kk = 0; kk < wantedSize; ++kk)
+    int32_t nbActiveWallSpots = 0;
+    if(bottomLeft2TopRight)
     {
-        Tile* t;
-        if(bottomLeft2TopRight)
-            t  = mGameMap.getTile(tileX - 1, tileY + kk);
-        else
-            t  = mGameMap.getTile(tileX + 1, tileY - kk);
-        if(t == nullptr)
-            continue;
-
-        if(shouldWallTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
-            ++nbConsecutiveTiles;
-        else
-            nbConsecutiveTiles = 0;
-
-        if(nbActiveWallSpots == 0)
-        {
-            if(nbConsecutiveTiles >= 3)
-            {
-                nbConsecutiveTiles = 0;
-                ++nbActiveWallSpots;
-            }
-        }
-        else if(nbConsecutiveTiles >= 2)
-        {
-            nbConsecutiveTiles = 0;
-            ++nbActiveWallSpots;
-        }
+        nbActiveWallSpots += countWallActiveSpots(tileX - 1, tileY, 0, 1, wantedSize);
+        nbActiveWallSpots += countWallActiveSpots(tileX + wantedSize, tileY, 0, 1, wantedSize);
+        nbActiveWallSpots += countWallActiveSpots(tileX, tileY - 1, 1, 0, wantedSize);
+        nbActiveWallSpots += countWallActiveSpots(tileX, tileY + wantedSize, 1, 0, wantedSize);
     }
-    points += nbActiveWallSpots * pointsPerWallSpot;
-    // We search points for second wall
-    nbConsecutiveTiles = 0;
-    nbActiveWallSpots = 0;
-    for(int32_t kk = 0; kk < wantedSize; ++kk)
+    else
     {
-        Tile* t;
-        if(bottomLeft2TopRight)
-            t = mGameMap.getTile(tileX + wantedSize, tileY + kk);
-        else
-            t = mGameMap.getTile(tileX - wantedSize, tileY - kk);
-        if(t == nullptr)
-            continue;
-
-        if(shouldWallTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
-            ++nbConsecutiveTiles;
-        else
-            nbConsecutiveTiles = 0;
-
-        if(nbActiveWallSpots == 0)
-        {
-            if(nbConsecutiveTiles >= 3)
-            {
-                nbConsecutiveTiles = 0;
-                ++nbActiveWallSpots;
-            }
-        }
-        else if(nbConsecutiveTiles >= 2)
-        {
-            nbConsecutiveTiles = 0;
-            ++nbActiveWallSpots;
-        }
+        nbActiveWallSpots += countWallActiveSpots(tileX + 1, tileY, 0, -1, wantedSize);
+        nbActiveWallSpots += countWallActiveSpots(tileX - wantedSize, tileY, 0, -1, wantedSize);
+        nbActiveWallSpots += countWallActiveSpots(tileX, tileY + 1, -1, 0, wantedSize);
+        nbActiveWallSpots += countWallActiveSpots(tileX, tileY - wantedSize, -1, 0, wantedSize);
     }
     points += nbActiveWallSpots * pointsPerWallSpot;
-    // We search points for first wall
-    nbConsecutiveTiles = 0;
-    nbActiveWallSpots = 0;
-    for(int32_t kk = 0; kk < wantedSize; ++kk)
-    {
-        Tile* t;
-        if(bottomLeft2TopRight)
-            t = mGameMap.getTile(tileX + kk, tileY - 1);
-        else
-            t = mGameMap.getTile(tileX - kk, tileY + 1);
-        if(t == nullptr)
-            continue;
 
-        if(shouldWallTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
-            ++nbConsecutiveTiles;
-        else
-            nbConsecutiveTiles = 0;
+    return true;
+}
 
-        if(nbActiveWallSpots == 0)
-        {
-            if(nbConsecutiveTiles >= 3)
-            {
-                nbConsecutiveTiles = 0;
-                ++nbActiveWallSpots;
-            }
-        }
-        else if(nbConsecutiveTiles >= 2)
-        {
-            nbConsecutiveTiles = 0;
-            ++nbActiveWallSpots;
-        }
-    }
-    points += nbActiveWallSpots * pointsPerWallSpot;
-    // We search points for first wall
-    nbConsecutiveTiles = 0;
-    nbActiveWallSpots = 0;
-    for(int32_t kk = 0; kk < wantedSize; ++kk)
+int32_t BaseAI::countWallActiveSpots(int startX, int startY, int dirX, int dirY, int32_t length)
+{
+    int endX = startX + (length - 1) * dirX;
+    int endY = startY + (length - 1) * dirY;
+    int32_t nbWallTiles = mTileMaps.countTiles(AITileLayer::wallForRoom,
+        std::min(startX, endX), std::min(startY, endY), std::max(startX, endX), std::max(startY, endY));
+
+    // We need at least 3 consecutive walls for the first active spot
+    if(nbWallTiles < 3)
+        return 0;
+
+    // If the whole side is made of walls, we know the result without scanning it
+    if(nbWallTiles == length)
+        return 1 + (length - 3) / 2;
+
+    int32_t nbConsecutiveTiles = 0;
+    int32_t nbActiveWallSpots = 0;
+    for(int32_t kk = 0; kk < length; ++kk)
     {
-        Tile* t;
-        if(bottomLeft2TopRight)
-            t = mGameMap.getTile(tileX + kk, tileY + wantedSize);
-        else
-            t = mGameMap.getTile(tileX - kk, tileY - wantedSize);
-        if(t == nullptr)
+        int x = startX + kk * dirX;
+        int y = startY + kk * dirY;
+        if(mGameMap.getTile(x, y) == nullptr)
             continue;
 
-        if(shouldWallTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
+        if(mTileMaps.isTileInLayer(AITileLayer::wallForRoom, x, y))
             ++nbConsecutiveTiles;
         else
             nbConsecutiveTiles = 0;
@@ -408,12 +280,20 @@ bool BaseAI::computePointsForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedS
             ++nbActiveWallSpots;
         }
     }
-    points += nbActiveWallSpots * pointsPerWallSpot;
+    return nbActiveWallSpots;
+}
+
+bool BaseAI::digWayToTile(Tile* tileStart, Tile* tileEnd)
+{
+    std::vector<Tile*> tilesToDig;
+    if(!findWayToTile(tileStart, tileEnd, tilesToDig))
+        return false;
 
+    markTilesForDigging(tilesToDig);
     return true;
 }
 
-bool BaseAI::digWayToTile(Tile* tileStart, Tile* tileEnd)
+bool BaseAI::findWayToTile(Tile* tileStart, Tile* tileEnd, std::vector<Tile*>& tilesToDig)
 {
     // We find a way to tileEnd. We search in reverse order to stop when we reach the first
     // accessible tile
@@ -430,9 +310,8 @@ bool BaseAI::digWayToTile(Tile* tileStart, Tile* tileEnd)
 
     // We search for the first reachable tile in the list
     bool isPathFound = false;
-    for(std::list<Tile*>::iterator it = pathToDig.begin(); it != pathToDig.end();)
+    for(Tile* tile : pathToDig)
     {
-        Tile* tile = *it;
         if(!isPathFound &&
            (tile->getFullness() == 0.0) &&
            (mGameMap.pathExists(worker, tileStart, tile)))
@@ -441,35 +320,35 @@ bool BaseAI::digWayToTile(Tile* tileStart, Tile* tileEnd)
         }
 
         if(isPathFound)
-        {
-            it = pathToDig.erase(it);
-            continue;
-        }
+            break;
 
         // If the tile should be dug, we check if one of its neighboors can be reached.
         // If yes, we will stop after digging it to avoid digging through a wall as much as
         // possible
         for(Tile* t : tile->getAllNeighbors())
         {
-            if(!isPathFound &&
-               (t->getFullness() == 0.0) &&
+            if((t->getFullness() == 0.0) &&
                (mGameMap.pathExists(worker, tileStart, t)))
             {
-                // we let the iterator increment because we want to dig the currently
-                // tested tile
+                // we keep the currently tested tile because we want to dig it
                 isPathFound = true;
                 break;
             }
         }
 
-        ++it;
+        if(tile->isDiggable(seat))
+            tilesToDig.push_back(tile);
     }
 
-    for(Tile* tile : pathToDig)
+    return true;
+}
+
+void BaseAI::markTilesForDigging(const std::vector<Tile*>& tilesToDig)
+{
+    Seat* seat = mPlayer.getSeat();
+    for(Tile* tile : tilesToDig)
     {
-        if (tile && tile->isDiggable(seat))
+        if (tile->isDiggable(seat))
             tile->setMarkedForDigging(true, &mPlayer);
     }
-
-    return true;
 }
@@ -18,6 +18,9 @@
 #ifndef BASEAI_H
 #define BASEAI_H
 
+#include "ai/AITileMaps.h"
+#include "utils/Random.h"
+
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -34,16 +37,35 @@ class BaseAI
 {
 public:
     virtual ~BaseAI()
+    {}
+
+    //! \brief Called on the server thread before the planning phase. It makes sure nothing
+    //! will be modified by the AI on the gamemap while planning
+    void prepareTurn();
+
+     /** \brief Planning phase. Called each turn before doTurn.
+     *  The AIs plan in parallel on the current gamemap state. So, this function must not
+     *  modify the gamemap nor use the global random generator. The results should be kept
+     *  by the AI and used during doTurn.
+     *  \param timeSinceLastTurn Time elapsed since last call in seconds.
+     */
+    virtual void planTurn(double timeSinceLastTurn)
     {}
 
      /** \brief This is the function that will be called each turn for the ai.
      *  This is the function that will be called each turn for the ai.
      *  For custom AI's this should be overridden and return true on a
-     *  successful call.
+     *  successful call. The AIs are called one after the other in a fixed order.
      *  \param frameTime Time elapsed since last call in seconds.
      */
     virtual bool doTurn(double timeSinceLastTurn) = 0;
 
+    //! \brief Key under which the state of the AI random generator is saved (see Random::getStateKey)
+    std::string getRandomStateKey() const;
+
+    inline const RandomGenerator& getRandomGenerator() const
+    { return mRandom; }
+
 protected:
     BaseAI(GameMap& gameMap, Player& player);
 
@@ -53,19 +75,38 @@ protected:
     //! into account any constructible tile (even if not digged yet). On success, it returns true and bestX
     //! and bestY will be set accordingly. It will return false if no constructible square of wantedSize
     //! is found
-    bool findBestPlaceForRoom(Tile* tile, Seat* playerSeat, int32_t wantedSize, bool useWalls,
+    bool findBestPlaceForRoom(Tile* tile, int32_t wantedSize, bool useWalls,
         int32_t& bestX, int32_t& bestY);
 
+    //! \brief Marks for digging the tiles needed to reach tileEnd from tileStart. Returns false if
+    //! there is no way
     bool digWayToTile(Tile* tileStart, Tile* tileEnd);
-    bool computePointsForRoom(Tile* tile, Seat* playerSeat, int32_t wantedSize,
+
+    //! \brief Fills tilesToDig with the tiles to dig to reach tileEnd from tileStart. It only reads
+    //! the gamemap so that it can be used while planning. Returns false if there is no way
+    bool findWayToTile(Tile* tileStart, Tile* tileEnd, std::vector<Tile*>& tilesToDig);
+
+    //! \brief Marks the given tiles for digging. Tiles that cannot be dug anymore are ignored
+    void markTilesForDigging(const std::vector<Tile*>& tilesToDig);
+
+    bool computePointsForRoom(Tile* tile, int32_t wantedSize,
         bool bottomLeft2TopRight, bool useWalls, int32_t& points);
 
     GameMap& mGameMap;
     Player& mPlayer;
 
+    //! \brief Per tile flags and summed-area tables used to speed up the searches on the gamemap
+    AITileMaps mTileMaps;
+
+    //! \brief Random generator of this AI. It is derived from the match seed and the player seat
+    //! so that the AI decisions do not depend on the other AIs or on the game random stream.
+    //! When a saved game is loaded, it continues from its saved state
+    RandomGenerator mRandom;
+
 private:
-    bool shouldGroundTileBeConsideredForBestPlaceForRoom(Tile* tile, Seat* playerSeat);
-    bool shouldWallTileBeConsideredForBestPlaceForRoom(Tile* tile, Seat* playerSeat);
+    //! \brief Returns the number of active spots a wall of length tiles starting at (startX, startY)
+    //! in the given direction would give to a room next to it
+    int32_t countWallActiveSpots(int startX, int startY, int dirX, int dirY, int32_t length);
 };
 
 #endif // BASEAI_H
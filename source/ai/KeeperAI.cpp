@@ -69,10 +69,73 @@ KeeperAI::KeeperAI(GameMap& gameMap, Player& player, int cooldownDefenseMin, int
     mCooldownSaveWoundedCreatures(0),
     mCooldownSaveWoundedCreaturesMin(cooldownSaveWoundedCreaturesMin),
     mCooldownSaveWoundedCreaturesMax(cooldownSaveWoundedCreaturesMax),
-    mIsFirstUpkeepDone(false)
+    mIsFirstUpkeepDone(false),
+    mIsRoomSearchPlanned(false),
+    mPlannedRoomPosX(-1),
+    mPlannedRoomPosY(-1),
+    mIsGoldSearchPlanned(false),
+    mPlannedGoldTile(nullptr),
+    mIsGoldWayPlanned(false),
+    mIsCreatureTriagePlanned(false)
 {
 }
 
+void KeeperAI::planTurn(double timeSinceLastTurn)
+{
+    mIsRoomSearchPlanned = false;
+    mPlannedRoomPosX = -1;
+    mPlannedRoomPosY = -1;
+    mIsGoldSearchPlanned = false;
+    mPlannedGoldTiles.clear();
+    mPlannedGoldTile = nullptr;
+    mIsGoldWayPlanned = false;
+    mPlannedGoldWay.clear();
+    mIsCreatureTriagePlanned = false;
+    mPlannedWoundedCreatures.clear();
+    mPlannedTiredCreatures.clear();
+    mPlannedHungryCreatures.clear();
+
+    Room* dungeonTemple = getDungeonTemple();
+    if(dungeonTemple == nullptr)
+        return;
+
+    Tile* central = dungeonTemple->getCentralTile();
+
+    // We only search if handleRooms or lookForGold will need the result this turn
+    if((mRoomSize == -1) && (mCooldownLookingForRooms <= 0))
+    {
+        mIsRoomSearchPlanned = true;
+        int32_t bestX = 0;
+        int32_t bestY = 0;
+        if(findBestPlaceForRoom(central, 5, true, bestX, bestY))
+        {
+            mPlannedRoomPosX = bestX;
+            mPlannedRoomPosY = bestY;
+        }
+    }
+
+    if(!mNoMoreReachableGold && (mCooldownLookingForGold <= 0) && needGold())
+    {
+        mIsGoldSearchPlanned = true;
+        findClosestGoldTiles(central, mPlannedGoldTiles);
+        mPlannedGoldTile = chooseGoldTile(mPlannedGoldTiles);
+        if(mPlannedGoldTile != nullptr)
+            mIsGoldWayPlanned = findWayToTile(central, mPlannedGoldTile, mPlannedGoldWay);
+    }
+
+    // We list the creatures that may need help. Only them will be checked when applying
+    mIsCreatureTriagePlanned = true;
+    for(Creature* creature : mGameMap.getCreaturesBySeat(mPlayer.getSeat()))
+    {
+        if((mCooldownSaveWoundedCreatures <= 0) && isWoundedCreatureToSave(*creature, *central))
+            mPlannedWoundedCreatures.push_back(creature);
+        if(getTiredCreatureDropTile(*creature, *central) != nullptr)
+            mPlannedTiredCreatures.push_back(creature);
+        if(isHungryCreatureToHelp(*creature, *central))
+            mPlannedHungryCreatures.push_back(creature);
+    }
+}
+
 bool KeeperAI::doTurn(double timeSinceLastTurn)
 {
     // If we have no dungeon temple, we are dead
@@ -122,7 +185,7 @@ bool KeeperAI::checkTreasury()
         --mCooldownCheckTreasury;
         return false;
     }
-    mCooldownCheckTreasury = Random::Int(10,30);
+    mCooldownCheckTreasury = mRandom.Int(10,30);
 
     int totalGold = 0;
     int totalStorage = 0;
@@ -182,6 +245,10 @@ bool KeeperAI::checkTreasury()
     Tile* firstAvailableTile = nullptr;
     for(int32_t distance = 1; distance < widerSide; ++distance)
     {
+        // No need to check the tiles on this ring if none is buildable
+        if(mTileMaps.countTilesOnRing(AITileLayer::buildable, central->getX(), central->getY(), distance) == 0)
+            continue;
+
         for(int k = 0; k <= distance; ++k)
         {
             Tile* t;
@@ -289,7 +356,7 @@ bool KeeperAI::handleRooms()
         return false;
     }
 
-    mCooldownLookingForRooms = Random::Int(mCooldownLookingForRoomsMin, mCooldownLookingForRoomsMax);
+    mCooldownLookingForRooms = mRandom.Int(mCooldownLookingForRoomsMin, mCooldownLookingForRoomsMax);
 
     // We check if the last built room is done
     if(mRoomSize != -1)
@@ -302,7 +369,7 @@ bool KeeperAI::handleRooms()
             return false;
         }
         int32_t points;
-        if(!computePointsForRoom(tile, mPlayer.getSeat(), mRoomSize, true, false, points))
+        if(!computePointsForRoom(tile, mRoomSize, true, false, points))
         {
             // The room is not valid anymore (may be claimed or built by somebody else). We redo
             mRoomSize = -1;
@@ -321,7 +388,26 @@ bool KeeperAI::handleRooms()
     Tile* central = getDungeonTemple()->getCentralTile();
     int32_t bestX = 0;
     int32_t bestY = 0;
-    if(!findBestPlaceForRoom(central, mPlayer.getSeat(), 5, true, bestX, bestY))
+    bool isPlaceFound = false;
+    if(mIsRoomSearchPlanned)
+    {
+        // No place was found while planning
+        Tile* plannedTile = mGameMap.getTile(mPlannedRoomPosX, mPlannedRoomPosY);
+        if(plannedTile == nullptr)
+            return false;
+
+        // The place found while planning may not be valid anymore if another AI built there.
+        // In this case, we search again
+        int32_t points;
+        if(computePointsForRoom(plannedTile, 5, true, false, points))
+        {
+            bestX = mPlannedRoomPosX;
+            bestY = mPlannedRoomPosY;
+            isPlaceFound = true;
+        }
+    }
+
+    if(!isPlaceFound && !findBestPlaceForRoom(central, 5, true, bestX, bestY))
         return false;
 
     mRoomSize = 5;
@@ -366,113 +452,38 @@ bool KeeperAI::lookForGold()
         return false;
     }
 
-    mCooldownLookingForGold = Random::Int(70,120);
-
-    // Do we need gold ?
-    int emptyStorage = 0;
-    for(Room* room : mGameMap.getRooms())
-    {
-        if(room->getSeat() != mPlayer.getSeat())
-            continue;
-
-        emptyStorage += (room->getTotalGoldStorage() - room->getTotalGoldStored());
-    }
+    mCooldownLookingForGold = mRandom.Int(70,120);
 
     // No need to search for gold
-    if(emptyStorage < 100)
+    if(!needGold())
         return false;
 
     Tile* central = getDungeonTemple()->getCentralTile();
-    int widerSide = mGameMap.getMapSizeX() > mGameMap.getMapSizeY() ?
-        mGameMap.getMapSizeX() : mGameMap.getMapSizeY();
 
-    // We search for the closest gold tile
-    Tile* firstGoldTile = nullptr;
-    for(int32_t distance = 1; distance < widerSide; ++distance)
+    // We search for the closest gold tile. An AI applied earlier this turn may have dug some
+    // of the planned tiles
+    std::vector<Tile*> goldTiles;
+    if(mIsGoldSearchPlanned)
     {
-        for(int k = 0; k <= distance; ++k)
+        for(Tile* t : mPlannedGoldTiles)
         {
-            Tile* t;
-            // North-East
-            t = mGameMap.getTile(central->getX() + k, central->getY() + distance);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                // If we already have a tile at same distance, we randomly change to
-                // try to not be too predictable
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // North-West
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() - k, central->getY() + distance);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-            // South-East
-            t = mGameMap.getTile(central->getX() + k, central->getY() - distance);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // South-West
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() - k, central->getY() - distance);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-            // East-North
-            t = mGameMap.getTile(central->getX() + distance, central->getY() + k);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // East-South
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() + distance, central->getY() - k);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-            // West-North
-            t = mGameMap.getTile(central->getX() - distance, central->getY() + k);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // West-South
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() - distance, central->getY() - k);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-
-            if(firstGoldTile != nullptr)
-                break;
+            if(isGoldTileToDig(*t))
+                goldTiles.push_back(t);
         }
-
-        // If we found a tile, no need to continue
-        if(firstGoldTile != nullptr)
-            break;
     }
 
+    if(goldTiles.empty())
+        findClosestGoldTiles(central, goldTiles);
+
+    Tile* firstGoldTile = nullptr;
+    bool isPlannedGoldTile = mIsGoldSearchPlanned &&
+        (mPlannedGoldTile != nullptr) &&
+        isGoldTileToDig(*mPlannedGoldTile);
+    if(isPlannedGoldTile)
+        firstGoldTile = mPlannedGoldTile;
+    else
+        firstGoldTile = chooseGoldTile(goldTiles);
+
     // No more gold
     if (firstGoldTile == nullptr)
     {
@@ -480,7 +491,18 @@ bool KeeperAI::lookForGold()
         return false;
     }
 
-    if(!digWayToTile(central, firstGoldTile))
+    // The way found while planning can be used as long as the gold tile is still there. Tiles
+    // that cannot be dug anymore are ignored when marked
+    if(isPlannedGoldTile)
+    {
+        if(!mIsGoldWayPlanned)
+        {
+            mNoMoreReachableGold = true;
+            return false;
+        }
+        markTilesForDigging(mPlannedGoldWay);
+    }
+    else if(!digWayToTile(central, firstGoldTile))
     {
         mNoMoreReachableGold = true;
         return false;
@@ -500,7 +522,7 @@ bool KeeperAI::lookForGold()
         {
             for(Tile* neigh : tile->getAllNeighbors())
             {
-                if(neigh->getType() == TileType::gold && neigh->getFullness() > 0.0)
+                if(isGoldTileToDig(*neigh))
                     tilesDig.insert(neigh);
             }
         }
@@ -512,6 +534,88 @@ bool KeeperAI::lookForGold()
     return true;
 }
 
+bool KeeperAI::needGold() const
+{
+    int emptyStorage = 0;
+    for(Room* room : mGameMap.getRooms())
+    {
+        if(room->getSeat() != mPlayer.getSeat())
+            continue;
+
+        emptyStorage += (room->getTotalGoldStorage() - room->getTotalGoldStored());
+    }
+
+    return emptyStorage >= 100;
+}
+
+bool KeeperAI::isGoldTileToDig(const Tile& tile)
+{
+    return (tile.getType() == TileType::gold) && (tile.getFullness() > 0.0);
+}
+
+Tile* KeeperAI::chooseGoldTile(const std::vector<Tile*>& goldTiles)
+{
+    Tile* goldTile = nullptr;
+    for(Tile* t : goldTiles)
+    {
+        // If we already have a tile at same distance, we randomly change to
+        // try to not be too predictable
+        if((goldTile == nullptr) || (mRandom.Uint(1,2) == 1))
+            goldTile = t;
+    }
+    return goldTile;
+}
+
+void KeeperAI::findClosestGoldTiles(Tile* central, std::vector<Tile*>& goldTiles)
+{
+    int widerSide = mGameMap.getMapSizeX() > mGameMap.getMapSizeY() ?
+        mGameMap.getMapSizeX() : mGameMap.getMapSizeY();
+
+    int centralX = central->getX();
+    int centralY = central->getY();
+    auto addIfGold = [&](int x, int y)
+    {
+        Tile* t = mGameMap.getTile(x, y);
+        if(t != nullptr && isGoldTileToDig(*t))
+            goldTiles.push_back(t);
+    };
+
+    for(int32_t distance = 1; distance < widerSide; ++distance)
+    {
+        // No need to check the tiles on this ring if there is no gold
+        if(mTileMaps.countTilesOnRing(AITileLayer::goldWall, centralX, centralY, distance) == 0)
+            continue;
+
+        for(int k = 0; k <= distance; ++k)
+        {
+            // North-East
+            addIfGold(centralX + k, centralY + distance);
+            // North-West
+            if(k > 0)
+                addIfGold(centralX - k, centralY + distance);
+            // South-East
+            addIfGold(centralX + k, centralY - distance);
+            // South-West
+            if(k > 0)
+                addIfGold(centralX - k, centralY - distance);
+            // East-North
+            addIfGold(centralX + distance, centralY + k);
+            // East-South
+            if(k > 0)
+                addIfGold(centralX + distance, centralY - k);
+            // West-North
+            addIfGold(centralX - distance, centralY + k);
+            // West-South
+            if(k > 0)
+                addIfGold(centralX - distance, centralY - k);
+
+            // If we found tiles, no need to continue
+            if(!goldTiles.empty())
+                return;
+        }
+    }
+}
+
 bool KeeperAI::buildMostNeededRoom()
 {
     for(RoomType roomType: wantedBuildings)
@@ -607,7 +711,7 @@ void KeeperAI::saveWoundedCreatures()
         --mCooldownSaveWoundedCreatures;
         return;
     }
-    mCooldownSaveWoundedCreatures = Random::Int(mCooldownSaveWoundedCreaturesMin, mCooldownSaveWoundedCreaturesMax);
+    mCooldownSaveWoundedCreatures = mRandom.Int(mCooldownSaveWoundedCreaturesMin, mCooldownSaveWoundedCreaturesMax);
 
     Tile* dungeonTempleTile = getDungeonTemple()->getCentralTile();
     if(dungeonTempleTile == nullptr)
@@ -617,23 +721,14 @@ void KeeperAI::saveWoundedCreatures()
     }
 
     Seat* seat = mPlayer.getSeat();
-    std::vector<Creature*> creatures = mGameMap.getCreaturesBySeat(seat);
+    std::vector<Creature*> creatures = mIsCreatureTriagePlanned
+        ? mPlannedWoundedCreatures
+        : mGameMap.getCreaturesBySeat(seat);
     for(Creature* creature : creatures)
     {
-        // We take away fleeing creatures not too near our dungeon heart
-        if(!creature->isActionInList(CreatureActionType::flee))
-            continue;
-        Tile* tile = creature->getPositionTile();
-        if(tile == nullptr)
+        if(!isWoundedCreatureToSave(*creature, *dungeonTempleTile))
             continue;
 
-        if((std::abs(dungeonTempleTile->getX() - tile->getX()) <= 5) &&
-           (std::abs(dungeonTempleTile->getY() - tile->getY()) <= 5))
-        {
-            // We are too close from our dungeon heart to be picked up
-            continue;
-        }
-
         if(!creature->tryPickup(seat))
             continue;
 
@@ -643,6 +738,25 @@ void KeeperAI::saveWoundedCreatures()
     }
 }
 
+bool KeeperAI::isWoundedCreatureToSave(Creature& creature, Tile& dungeonTempleTile) const
+{
+    // We take away fleeing creatures not too near our dungeon heart
+    if(!creature.isActionInList(CreatureActionType::flee))
+        return false;
+    Tile* tile = creature.getPositionTile();
+    if(tile == nullptr)
+        return false;
+
+    if((std::abs(dungeonTempleTile.getX() - tile->getX()) <= 5) &&
+       (std::abs(dungeonTempleTile.getY() - tile->getY()) <= 5))
+    {
+        // We are too close from our dungeon heart to be picked up
+        return false;
+    }
+
+    return true;
+}
+
 void KeeperAI::handleDefense()
 {
     if(mCooldownDefense > 0)
@@ -650,7 +764,7 @@ void KeeperAI::handleDefense()
         --mCooldownDefense;
         return;
     }
-    mCooldownDefense = Random::Int(mCooldownDefenseMin, mCooldownDefenseMax);
+    mCooldownDefense = mRandom.Int(mCooldownDefenseMin, mCooldownDefenseMax);
 
     Seat* seat = mPlayer.getSeat();
     // We drop creatures nearby owned or allied attacked creatures
@@ -706,7 +820,7 @@ bool KeeperAI::handleWorkers()
         return false;
     }
 
-    mCooldownWorkers = Random::Int(3,10);
+    mCooldownWorkers = mRandom.Int(3,10);
 
     // We want to use the first covered tile because the central might be destroyed and enemy claimed
     // and, if it is the case, we will not be able to spawn a worker.
@@ -719,7 +833,7 @@ bool KeeperAI::handleWorkers()
     // If we have less than 4 workers or we have the chance, we summon
     int nbWorkers = mPlayer.getSeat()->getNumCreaturesWorkers();
     if((nbWorkers < 4) ||
-       (Random::Int(0, nbWorkers * 3) == 0))
+       (mRandom.Int(0, nbWorkers * 3) == 0))
     {
         Tile* tile = getDungeonTemple()->getCoveredTile(0);
         std::vector<Tile*> tiles;
@@ -741,7 +855,7 @@ bool KeeperAI::repairRooms()
         return false;
     }
 
-    mCooldownRepairRooms = Random::Int(20,60);
+    mCooldownRepairRooms = mRandom.Int(20,60);
 
     Seat* seat = mPlayer.getSeat();
     for(Room* room : mGameMap.getRooms())
@@ -772,53 +886,13 @@ bool KeeperAI::handleTiredCreatures()
     if(mPlayer.getSeat()->getNbRooms(RoomType::dormitory) <= 0)
         return false;
 
-    std::vector<Creature*> creatures = mGameMap.getCreaturesBySeat(mPlayer.getSeat());
+    Tile* dungeonTempleTile = getDungeonTemple()->getCentralTile();
+    std::vector<Creature*> creatures = mIsCreatureTriagePlanned
+        ? mPlannedTiredCreatures
+        : mGameMap.getCreaturesBySeat(mPlayer.getSeat());
     for(Creature* creature : creatures)
     {
-        // We do not take creatures fighting
-        if(creature->isActionInList(CreatureActionType::fight))
-            continue;
-
-        if(!creature->isTired())
-            continue;
-
-        Tile* dropTile = nullptr;
-        // If the creature has a bed, we drop it in its dormitory
-        Tile* homeTile = creature->getHomeTile();
-        if(homeTile != nullptr)
-        {
-            // We check if it is already in the dormitory. If yes, do nothing
-            Tile* posTile = creature->getPositionTile();
-            if(posTile == nullptr)
-            {
-                OD_LOG_ERR("null position tile for creature=" + creature->getName() + ", pos=" + Helper::toString(creature->getPosition()));
-                continue;
-            }
-            if(homeTile->getCoveringRoom() == posTile->getCoveringRoom())
-                continue;
-
-            // It is not on its dormitory, we try to drop it there
-            dropTile = homeTile;
-        }
-        else
-        {
-            // The creature do not have a home tile. We check it can reach the
-            // dungeon temple. If not, we drop it there
-            Tile* posTile = creature->getPositionTile();
-            if(posTile == nullptr)
-            {
-                OD_LOG_ERR("null position tile for creature=" + creature->getName() + ", pos=" + Helper::toString(creature->getPosition()));
-                continue;
-            }
-
-            Tile* dungeonTempleTile = getDungeonTemple()->getCentralTile();
-            if(mGameMap.pathExists(creature, posTile, dungeonTempleTile))
-                continue;
-
-            // The creature cannot reach its dungeon temple. We drop it there
-            dropTile = dungeonTempleTile;
-        }
-
+        Tile* dropTile = getTiredCreatureDropTile(*creature, *dungeonTempleTile);
         if(dropTile == nullptr)
             continue;
 
@@ -836,32 +910,56 @@ bool KeeperAI::handleTiredCreatures()
     return false;
 }
 
+Tile* KeeperAI::getTiredCreatureDropTile(Creature& creature, Tile& dungeonTempleTile) const
+{
+    // We do not take creatures fighting
+    if(creature.isActionInList(CreatureActionType::fight))
+        return nullptr;
+
+    if(!creature.isTired())
+        return nullptr;
+
+    Tile* posTile = creature.getPositionTile();
+    if(posTile == nullptr)
+    {
+        OD_LOG_ERR("null position tile for creature=" + creature.getName() + ", pos=" + Helper::toString(creature.getPosition()));
+        return nullptr;
+    }
+
+    // If the creature has a bed, we drop it in its dormitory
+    Tile* homeTile = creature.getHomeTile();
+    if(homeTile != nullptr)
+    {
+        // We check if it is already in the dormitory. If yes, do nothing
+        if(homeTile->getCoveringRoom() == posTile->getCoveringRoom())
+            return nullptr;
+
+        // It is not on its dormitory, we try to drop it there
+        return homeTile;
+    }
+
+    // The creature do not have a home tile. We check it can reach the
+    // dungeon temple. If not, we drop it there
+    if(mGameMap.pathExists(&creature, posTile, &dungeonTempleTile))
+        return nullptr;
+
+    // The creature cannot reach its dungeon temple. We drop it there
+    return &dungeonTempleTile;
+}
+
 bool KeeperAI::handleHungryCreatures()
 {
     // Handle hungry creatures if we have a hatchery
     if(mPlayer.getSeat()->getNbRooms(RoomType::hatchery) <= 0)
         return false;
 
-    std::vector<Creature*> creatures = mGameMap.getCreaturesBySeat(mPlayer.getSeat());
+    Tile* dungeonTempleTile = getDungeonTemple()->getCentralTile();
+    std::vector<Creature*> creatures = mIsCreatureTriagePlanned
+        ? mPlannedHungryCreatures
+        : mGameMap.getCreaturesBySeat(mPlayer.getSeat());
     for(Creature* creature : creatures)
     {
-        // We do not take creatures fighting
-        if(creature->isActionInList(CreatureActionType::fight))
-            continue;
-
-        if(!creature->isHungry())
-            continue;
-
-        // We check it can reach the dungeon temple. If not, we drop it there
-        Tile* posTile = creature->getPositionTile();
-        if(posTile == nullptr)
-        {
-            OD_LOG_ERR("null position tile for creature=" + creature->getName() + ", pos=" + Helper::toString(creature->getPosition()));
-            continue;
-        }
-
-        Tile* dungeonTempleTile = getDungeonTemple()->getCentralTile();
-        if(mGameMap.pathExists(creature, posTile, dungeonTempleTile))
+        if(!isHungryCreatureToHelp(*creature, *dungeonTempleTile))
             continue;
 
         // The creature cannot reach its dungeon temple. We drop it there
@@ -879,6 +977,26 @@ bool KeeperAI::handleHungryCreatures()
     return false;
 }
 
+bool KeeperAI::isHungryCreatureToHelp(Creature& creature, Tile& dungeonTempleTile) const
+{
+    // We do not take creatures fighting
+    if(creature.isActionInList(CreatureActionType::fight))
+        return false;
+
+    if(!creature.isHungry())
+        return false;
+
+    // We check it can reach the dungeon temple. If not, we drop it there
+    Tile* posTile = creature.getPositionTile();
+    if(posTile == nullptr)
+    {
+        OD_LOG_ERR("null position tile for creature=" + creature.getName() + ", pos=" + Helper::toString(creature.getPosition()));
+        return false;
+    }
+
+    return !mGameMap.pathExists(&creature, posTile, &dungeonTempleTile);
+}
+
 void KeeperAI::handleFirstTurn()
 {
     Seat* seat = mPlayer.getSeat();
@@ -20,6 +20,8 @@
 
 #include "ai/BaseAI.h"
 
+class Creature;
+
 enum class RoomType;
 
 class KeeperAI : public BaseAI
@@ -29,7 +31,8 @@ public:
     KeeperAI(GameMap& gameMap, Player& player, int cooldownDefenseMin, int cooldownDefenseMax,
              int cooldownSaveWoundedCreaturesMin, int cooldownSaveWoundedCreaturesMax,
              int cooldownLookingForRoomsMin, int cooldownLookingForRoomsMax);
-    virtual bool doTurn(double timeSinceLastTurn);
+    virtual void planTurn(double timeSinceLastTurn) override;
+    virtual bool doTurn(double timeSinceLastTurn) override;
 
 protected:
     //! \brief Checks if the AI has a treasury. If not, we search for the first available tile
@@ -84,6 +87,30 @@ private:
     //! \brief Returns true if the given room is needed and false otherwise
     bool checkNeedRoom(RoomType roomType);
 
+    //! \brief Fills goldTiles with the closest diggable gold tiles around central. All the
+    //! returned tiles are at the same distance
+    void findClosestGoldTiles(Tile* central, std::vector<Tile*>& goldTiles);
+
+    //! \brief Returns true if the given tile is still a gold wall that can be dug
+    static bool isGoldTileToDig(const Tile& tile);
+
+    //! \brief Randomly chooses one of the given gold tiles. Returns nullptr if there is none
+    Tile* chooseGoldTile(const std::vector<Tile*>& goldTiles);
+
+    //! \brief Returns true if we need more gold storage to be filled
+    bool needGold() const;
+
+    //! \brief Returns true if the given creature is fleeing far from the dungeon temple and
+    //! should be brought back
+    bool isWoundedCreatureToSave(Creature& creature, Tile& dungeonTempleTile) const;
+
+    //! \brief Returns the tile where the given tired creature should be dropped or nullptr if
+    //! it does not need help
+    Tile* getTiredCreatureDropTile(Creature& creature, Tile& dungeonTempleTile) const;
+
+    //! \brief Returns true if the given creature is hungry and cannot reach the dungeon temple
+    bool isHungryCreatureToHelp(Creature& creature, Tile& dungeonTempleTile) const;
+
     int mCooldownCheckTreasury;
     int mCooldownLookingForRooms;
     int mCooldownLookingForRoomsMin;
@@ -102,6 +129,24 @@ private:
     int mCooldownSaveWoundedCreaturesMin;
     int mCooldownSaveWoundedCreaturesMax;
     bool mIsFirstUpkeepDone;
+
+    //! \brief Results of the planning phase for the current turn. If a search has not been
+    //! planned, it is done when needed
+    bool mIsRoomSearchPlanned;
+    int mPlannedRoomPosX;
+    int mPlannedRoomPosY;
+    bool mIsGoldSearchPlanned;
+    std::vector<Tile*> mPlannedGoldTiles;
+    //! \brief Gold tile chosen while planning and the tiles to dig to reach it (if mIsGoldWayPlanned)
+    Tile* mPlannedGoldTile;
+    bool mIsGoldWayPlanned;
+    std::vector<Tile*> mPlannedGoldWay;
+    //! \brief Creatures needing help found while planning. They are checked again when the
+    //! help is applied
+    bool mIsCreatureTriagePlanned;
+    std::vector<Creature*> mPlannedWoundedCreatures;
+    std::vector<Creature*> mPlannedTiredCreatures;
+    std::vector<Creature*> mPlannedHungryCreatures;
 };
 
 #endif // KEEPERAI_H
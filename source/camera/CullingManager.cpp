@@ -16,161 +16,188 @@
  */
 
 #include "camera/CullingManager.h"
-#include "camera/CameraManager.h"
 #include "entities/Tile.h"
 #include "gamemap/GameMap.h"
-#include "utils/VectorInt64.h"
+#include "render/RenderManager.h"
+#include "utils/Helper.h"
 #include "utils/LogManager.h"
 
-#include <OgreVector3.h>
 #include <OgreCamera.h>
 #include <OgreRay.h>
 
-#include <sstream>
 #include <algorithm>
+#include <cmath>
 
 static const Ogre::Plane GROUND_PLANE(0, 0, 1, 0);
 
+//! \brief Number of tiles added around the chunks when testing them against the camera footprint. That
+//! allows to display the walls that are outside of the footprint but high enough to be seen
+static const Ogre::Real CHUNK_MARGIN = 2.0;
+
 CullingManager::CullingManager(GameMap* gameMap, uint32_t cullingMask):
-    mFirstIter(false),
     mGameMap(gameMap),
     mCullingMask(cullingMask),
-    mCullTilesFlag(false)
+    mCullTilesFlag(false),
+    mNbChunksX(0),
+    mNbChunksY(0),
+    mMinChunkX(0),
+    mMinChunkY(0),
+    mMaxChunkX(-1),
+    mMaxChunkY(-1)
 {
 }
 
-void CullingManager::cullTiles(const std::vector<Ogre::Vector3>& ogreVectors)
-{
-    mOldWalk = mWalk;
-    mWalk.mVertices.mMyArray.clear();
-    for (int ii = 0 ; ii < 4 ; ++ii)
-        mWalk.mVertices.mMyArray.push_back(VectorInt64(ogreVectors[ii]));
-
-    // create a slope -- a set of left and right path
-    mWalk.convexHull();
-    mWalk.buildSlopes();
-
-    OD_LOG_DBG(mOldWalk.debug());
-    OD_LOG_DBG(mWalk.debug());
-
-    // reset index pointers to the begging of collections
-    mOldWalk.prepareWalk();
-    mWalk.prepareWalk();
-
-    newBashAndSplashTiles(SHOW | HIDE);
-}
-
 void CullingManager::startTileCulling(Ogre::Camera* camera, const std::vector<Ogre::Vector3>& ogreVectors)
 {
-    showAllTiles();
+    const int chunkSize = RenderManager::TILE_CHUNK_SIZE;
+    mNbChunksX = (mGameMap->getMapSizeX() + chunkSize - 1) / chunkSize;
+    mNbChunksY = (mGameMap->getMapSizeY() + chunkSize - 1) / chunkSize;
 
-    mWalk.mVertices.mMyArray.clear();
-    for (int ii = 0 ; ii < 4 ; ++ii)
-        mWalk.mVertices.mMyArray.push_back(VectorInt64(ogreVectors[ii]));
+    // We start with every chunk hidden. This is the only time every tile is processed
+    mChunkVisible.assign(mNbChunksX * mNbChunksY, 0);
+    for(int chunkY = 0; chunkY < mNbChunksY; ++chunkY)
+    {
+        for(int chunkX = 0; chunkX < mNbChunksX; ++chunkX)
+            setChunkVisible(chunkX, chunkY, false);
+    }
 
-    mWalk.convexHull();
-    mWalk.buildSlopes();
-    mOldWalk = mWalk;
-    mOldWalk.prepareWalk();
-    mWalk.prepareWalk();
-    hideAllTiles();
-    newBashAndSplashTiles(SHOW);
+    mMinChunkX = 0;
+    mMinChunkY = 0;
+    mMaxChunkX = -1;
+    mMaxChunkY = -1;
+    mLastFootprint.clear();
+    cullChunks(ogreVectors);
 
     mCullTilesFlag = true;
 }
 
-
 void CullingManager::stopTileCulling(const std::vector<Ogre::Vector3>& ogreVectors)
 {
     mCullTilesFlag = false;
-    mOldWalk = mWalk;
-    mWalk.mVertices.mMyArray.clear();
-    for (int ii = 0 ; ii < 4 ; ++ii)
-        mWalk.mVertices.mMyArray.push_back(VectorInt64(ogreVectors[ii]));
 
-    // create a slope -- a set of left and rigth path
-    mWalk.convexHull();
-    mWalk.buildSlopes();
-
-    OD_LOG_DBG(mOldWalk.debug());
-    OD_LOG_DBG(mWalk.debug());
-
-    // reset index pointers to the begging of collections
-    mOldWalk.prepareWalk();
-    mWalk.prepareWalk();
+    // We show the chunks that were hidden
+    for(int chunkY = 0; chunkY < mNbChunksY; ++chunkY)
+    {
+        for(int chunkX = 0; chunkX < mNbChunksX; ++chunkX)
+        {
+            if(mChunkVisible[chunkY * mNbChunksX + chunkX] != 0)
+                continue;
 
-    newBashAndSplashTiles(HIDE);
-    showAllTiles();
+            setChunkVisible(chunkX, chunkY, true);
+            mChunkVisible[chunkY * mNbChunksX + chunkX] = 1;
+        }
+    }
 }
 
-void CullingManager::hideAllTiles(void)
+void CullingManager::cullChunks(const std::vector<Ogre::Vector3>& ogreVectors)
 {
-    for (int jj = 0; jj < mGameMap->getMapSizeY() ; ++jj)
+    if(ogreVectors.size() != 4)
+        return;
+
+    // If the camera did not move, there is nothing to do
+    if(ogreVectors == mLastFootprint)
+        return;
+
+    mLastFootprint = ogreVectors;
+
+    Ogre::Real minX = ogreVectors[0].x;
+    Ogre::Real maxX = ogreVectors[0].x;
+    Ogre::Real minY = ogreVectors[0].y;
+    Ogre::Real maxY = ogreVectors[0].y;
+    for(const Ogre::Vector3& v : ogreVectors)
     {
-        for (int ii = 0; ii < mGameMap->getMapSizeX(); ++ii)
+        minX = std::min(minX, v.x);
+        maxX = std::max(maxX, v.x);
+        minY = std::min(minY, v.y);
+        maxY = std::max(maxY, v.y);
+    }
+
+    // Tiles are centered on their coordinates
+    const Ogre::Real chunkSize = static_cast<Ogre::Real>(RenderManager::TILE_CHUNK_SIZE);
+    int minChunkX = std::max(0, static_cast<int>(std::floor((minX + 0.5 - CHUNK_MARGIN) / chunkSize)));
+    int minChunkY = std::max(0, static_cast<int>(std::floor((minY + 0.5 - CHUNK_MARGIN) / chunkSize)));
+    int maxChunkX = std::min(mNbChunksX - 1, static_cast<int>(std::floor((maxX + 0.5 + CHUNK_MARGIN) / chunkSize)));
+    int maxChunkY = std::min(mNbChunksY - 1, static_cast<int>(std::floor((maxY + 0.5 + CHUNK_MARGIN) / chunkSize)));
+
+    // We only have to look at the chunks seen during the last update and the ones that may be
+    // seen now. Every other chunk is already hidden
+    int startX = std::min(minChunkX, mMinChunkX);
+    int startY = std::min(minChunkY, mMinChunkY);
+    int endX = std::max(maxChunkX, mMaxChunkX);
+    int endY = std::max(maxChunkY, mMaxChunkY);
+    for(int chunkY = startY; chunkY <= endY; ++chunkY)
+    {
+        for(int chunkX = startX; chunkX <= endX; ++chunkX)
         {
-            Tile* tile = mGameMap->getTile(ii, jj);
-            tile->setTileCullingFlags(mCullingMask, false);
+            bool isVisible = (chunkX >= minChunkX) && (chunkX <= maxChunkX) &&
+                (chunkY >= minChunkY) && (chunkY <= maxChunkY) &&
+                isChunkInFootprint(chunkX, chunkY, ogreVectors);
+
+            uint8_t& chunkVisible = mChunkVisible[chunkY * mNbChunksX + chunkX];
+            if((chunkVisible != 0) == isVisible)
+                continue;
+
+            chunkVisible = (isVisible ? 1 : 0);
+            setChunkVisible(chunkX, chunkY, isVisible);
         }
     }
+
+    mMinChunkX = minChunkX;
+    mMinChunkY = minChunkY;
+    mMaxChunkX = maxChunkX;
+    mMaxChunkY = maxChunkY;
 }
 
-void CullingManager::showAllTiles(void)
+bool CullingManager::isChunkInFootprint(int chunkX, int chunkY, const std::vector<Ogre::Vector3>& ogreVectors) const
 {
-    for (int jj = 0; jj < mGameMap->getMapSizeY() ; ++jj)
+    const Ogre::Real chunkSize = static_cast<Ogre::Real>(RenderManager::TILE_CHUNK_SIZE);
+    Ogre::Real rectMinX = chunkX * chunkSize - 0.5 - CHUNK_MARGIN;
+    Ogre::Real rectMinY = chunkY * chunkSize - 0.5 - CHUNK_MARGIN;
+    Ogre::Real rectMaxX = (chunkX + 1) * chunkSize - 0.5 + CHUNK_MARGIN;
+    Ogre::Real rectMaxY = (chunkY + 1) * chunkSize - 0.5 + CHUNK_MARGIN;
+
+    // The footprint is convex. The chunk was already tested against its bounding box so we only
+    // have to look for a separating axis along the footprint edges
+    const std::size_t nbPoints = ogreVectors.size();
+    for(std::size_t i = 0; i < nbPoints; ++i)
     {
-        for (int ii = 0; ii < mGameMap->getMapSizeX(); ++ii)
+        const Ogre::Vector3& p1 = ogreVectors[i];
+        const Ogre::Vector3& p2 = ogreVectors[(i + 1) % nbPoints];
+        Ogre::Real axisX = p1.y - p2.y;
+        Ogre::Real axisY = p2.x - p1.x;
+
+        Ogre::Real polyMin = axisX * p1.x + axisY * p1.y;
+        Ogre::Real polyMax = polyMin;
+        for(const Ogre::Vector3& p : ogreVectors)
         {
-            Tile* tile = mGameMap->getTile(ii, jj);
-            tile->setTileCullingFlags(mCullingMask, true);
+            Ogre::Real proj = axisX * p.x + axisY * p.y;
+            polyMin = std::min(polyMin, proj);
+            polyMax = std::max(polyMax, proj);
         }
+
+        Ogre::Real rectCenter = axisX * (rectMinX + rectMaxX) * 0.5 + axisY * (rectMinY + rectMaxY) * 0.5;
+        Ogre::Real rectExtent = std::abs(axisX) * (rectMaxX - rectMinX) * 0.5 + std::abs(axisY) * (rectMaxY - rectMinY) * 0.5;
+        if((rectCenter + rectExtent < polyMin) || (rectCenter - rectExtent > polyMax))
+            return false;
     }
+
+    return true;
 }
 
-void CullingManager::newBashAndSplashTiles(uint32_t mode)
+void CullingManager::setChunkVisible(int chunkX, int chunkY, bool visible)
 {
-    int64_t xxLeftOld = mOldWalk.getTopLeftVertex().x;
-    int64_t xxRightOld = mOldWalk.getTopRightVertex().x;
-    int64_t xxLeft = mWalk.getTopLeftVertex().x;
-    int64_t xxRight = mWalk.getTopRightVertex().x;
-    int64_t xxp, yyp;
-    std::stringstream ss;
-    int64_t bb = ((std::min(mWalk.getBottomLeftVertex().y, mOldWalk.getBottomRightVertex().y) >> VectorInt64::PRECISION_DIGITS) - 2) << VectorInt64::PRECISION_DIGITS;
-
-    for (int64_t yy = ((std::max(mWalk.getTopLeftVertex().y, mOldWalk.getTopRightVertex().y  ) >> VectorInt64::PRECISION_DIGITS) + 2) << VectorInt64::PRECISION_DIGITS; yy >= bb; yy -= VectorInt64::UNIT)
+    const int chunkSize = RenderManager::TILE_CHUNK_SIZE;
+    int endX = std::min(mGameMap->getMapSizeX(), (chunkX + 1) * chunkSize);
+    int endY = std::min(mGameMap->getMapSizeY(), (chunkY + 1) * chunkSize);
+    for(int yy = chunkY * chunkSize; yy < endY; ++yy)
     {
-        mOldWalk.notifyOnMoveDown(yy);
-        mWalk.notifyOnMoveDown(yy);
-        xxLeft = mWalk.getCurrentXLeft(yy);
-        xxLeftOld = mOldWalk.getCurrentXLeft(yy);
-        xxRight = mWalk.getCurrentXRight(yy);
-        xxRightOld = mOldWalk.getCurrentXRight(yy);
-
-        int64_t mm = ((std::min(xxLeft, xxLeftOld) >> VectorInt64::PRECISION_DIGITS) << VectorInt64::PRECISION_DIGITS) ;
-        if(std::min(xxLeft, xxLeftOld) < std::max(xxRight,xxRightOld))
+        for(int xx = chunkX * chunkSize; xx < endX; ++xx)
         {
-            for (int64_t xx = mm ; xx <= std::max(xxRight,xxRightOld); xx += VectorInt64::UNIT)
-            {
-                bool bash = (xx >= xxLeftOld && xx <= xxRightOld && (yy >= mOldWalk.getBottomLeftVertex().y) && yy <= mOldWalk.getTopLeftVertex().y);
-                bool splash = (xx >= xxLeft && xx <= xxRight && (yy >= mWalk.getBottomLeftVertex().y) && yy <= mWalk.getTopLeftVertex().y);
-
-                xxp = (xx >> VectorInt64::PRECISION_DIGITS);
-                yyp = (yy >> VectorInt64::PRECISION_DIGITS);
-                Tile* tile = mGameMap->getTile(xxp, yyp);
-                if(bash && splash && (mode & HIDE) && (mode & SHOW))
-                {
-                    // Nothing
-                }
-
-                else if (bash && (mode & HIDE) && (tile != nullptr))
-                {
-                    tile->setTileCullingFlags(mCullingMask, false);
-                }
-                else if (splash && (mode & SHOW) && (tile != nullptr))
-                {
-                    tile->setTileCullingFlags(mCullingMask, true);
-                }
-            }
+            Tile* tile = mGameMap->getTile(xx, yy);
+            if(tile == nullptr)
+                continue;
+
+            tile->setTileCullingFlags(mCullingMask, visible);
         }
     }
 }
@@ -201,24 +228,5 @@ bool CullingManager::computeIntersectionPoints(Ogre::Camera* camera, std::vector
 void CullingManager::update(Ogre::Camera* camera, const std::vector<Ogre::Vector3>& ogreVectors)
 {
     if(mCullTilesFlag)
-        cullTiles(ogreVectors);
+        cullChunks(ogreVectors);
 }
-
-/*! \brief Sort two VectorInt64 p1 and p2  to satisfy p1 <= p2 according to
- * the value of X or Y coordinate, which depends on sortByX param.
- */
-void CullingManager::sort(VectorInt64& p1, VectorInt64& p2, bool sortByX)
-{
-    if (sortByX)
-    {
-        if (p1.x > p2.x)
-            std::swap(p1, p2);
-    }
-    else
-    {
-        if (p1.y > p2.y)
-            std::swap(p1, p2);
-    }
-}
-
-
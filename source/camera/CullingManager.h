@@ -18,9 +18,10 @@
 #ifndef CULLINGMANAGER_H_
 #define CULLINGMANAGER_H_
 
-#include "camera/SlopeWalk.h"
+#include <OgreVector3.h>
 
-#include "utils/VectorInt64.h"
+#include <cstdint>
+#include <vector>
 
 class GameMap;
 
@@ -43,24 +44,15 @@ namespace CullingType
  *  manage culling methods used in game. So far there is only
  *  one algorithm included : it is supposed to cull the Tiles.
  *  It should be started with the method startTileCulling.
-
- * Currently I try to implement the most general polygon rasterizing algorithm , that is :
- * 1. We choose the max and min points due to their Y value .
- * 2. We sort all the points by the angle value in it's polar representation
- * ( that is going , by visiting them clockwise due to the center of the polygon )
- * 3. Now we have two paths from which we can walk from top to down vertices : call them left and right .
- * 4. Between each following pair of vertices we can establish a >> slope << ,
- * which is just the the "a" in the eq. of linear form y = ax + b
- * 5. Now start drawing our polygon Row by Row From top to bottom .
- * Each Row has given the most left and rightmost tile due to use of both paths prepared before
- * -- Left path for tracing the most Leftmost Tile , Right path the most Rightmost Tile in each .
+ *
+ * Tiles are culled by chunks, using the same layout as the tile geometry (see
+ * RenderManager::TILE_CHUNK_SIZE). Each time the camera moves, its footprint on the ground
+ * is tested against the chunks around it and only the chunks whose visibility changed
+ * get their tiles shown or hidden. When the camera does not move, nothing is done.
  */
 class CullingManager
 {
 public:
-    static const uint32_t HIDE =  1;
-    static const uint32_t SHOW =  2;
-
     CullingManager(GameMap* gameMap, uint32_t cullingMask);
 
     void startTileCulling(Ogre::Camera* camera, const std::vector<Ogre::Vector3>& ogreVectors);
@@ -74,27 +66,35 @@ public:
     bool computeIntersectionPoints(Ogre::Camera* camera, std::vector<Ogre::Vector3>& ogreVectors);
 
 private:
+    //! \brief Shows the chunks entering the given camera footprint and hides the ones leaving it
+    void cullChunks(const std::vector<Ogre::Vector3>& ogreVectors);
 
-    void cullTiles(const std::vector<Ogre::Vector3>& ogreVectors);
-
-    void hideAllTiles();
-    void showAllTiles();
-
-    // set the new tiles
-    void newBashAndSplashTiles(uint32_t);
+    //! \brief Returns true if the given chunk intersects the camera footprint
+    bool isChunkInFootprint(int chunkX, int chunkY, const std::vector<Ogre::Vector3>& ogreVectors) const;
 
-    void sort(VectorInt64& p1, VectorInt64& p2, bool sortByX);
+    //! \brief Sets the culling flag of every tile in the given chunk
+    void setChunkVisible(int chunkX, int chunkY, bool visible);
 
-    // Objects representing past and present walk around the polygon
-    SlopeWalk mWalk;
-    SlopeWalk mOldWalk;
-
-    bool mFirstIter;
     GameMap* mGameMap;
 
     uint32_t mCullingMask;
 
     bool mCullTilesFlag;
+
+    int mNbChunksX;
+    int mNbChunksY;
+
+    //! \brief Visibility of each chunk, row by row
+    std::vector<uint8_t> mChunkVisible;
+
+    //! \brief Chunks tested during the last update. The chunks outside are hidden
+    int mMinChunkX;
+    int mMinChunkY;
+    int mMaxChunkX;
+    int mMaxChunkY;
+
+    //! \brief Footprint used during the last update
+    std::vector<Ogre::Vector3> mLastFootprint;
 };
 
 #endif // CULLINGMANAGER_H_
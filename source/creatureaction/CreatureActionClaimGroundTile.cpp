@@ -19,19 +19,22 @@
 
 #include "entities/Creature.h"
 #include "entities/Tile.h"
+#include "game/Seat.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
 CreatureActionClaimGroundTile::CreatureActionClaimGroundTile(Creature& creature, Tile& tileClaim) :
     CreatureAction(creature),
-    mTileClaim(tileClaim)
+    mTileClaim(tileClaim),
+    mJobBoard(creature.getSeat()->getWorkerJobBoard()),
+    mIsReserved(mJobBoard.reserveClaimJob(tileClaim))
 {
-    mTileClaim.addWorkerClaiming(mCreature);
 }
 
 CreatureActionClaimGroundTile::~CreatureActionClaimGroundTile()
 {
-    mTileClaim.removeWorkerClaiming(mCreature);
+    if(mIsReserved)
+        mJobBoard.releaseClaimJob(mTileClaim);
 }
 
 std::function<bool()> CreatureActionClaimGroundTile::action()
@@ -66,7 +69,7 @@ bool CreatureActionClaimGroundTile::handleCreatureActionClaimGroundTile(Creature
         return true;
     }
 
-    creature.setAnimationState(EntityAnimation::claim_anim);
+    creature.setAnimationState(EntityAnimation::claim);
     myTile->claimForSeat(creature.getSeat(), creature.getClaimRate());
     creature.receiveExp(1.5 * (creature.getClaimRate() / (0.35 + 0.05 * creature.getLevel())));
 
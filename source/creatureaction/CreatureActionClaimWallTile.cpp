@@ -19,6 +19,7 @@
 
 #include "entities/Creature.h"
 #include "entities/Tile.h"
+#include "game/Seat.h"
 #include "gamemap/GameMap.h"
 #include "gamemap/Pathfinding.h"
 #include "utils/Helper.h"
@@ -26,14 +27,16 @@
 
 CreatureActionClaimWallTile::CreatureActionClaimWallTile(Creature& creature, Tile& tileClaim) :
     CreatureAction(creature),
-    mTileClaim(tileClaim)
+    mTileClaim(tileClaim),
+    mJobBoard(creature.getSeat()->getWorkerJobBoard()),
+    mIsReserved(mJobBoard.reserveClaimJob(tileClaim))
 {
-    mTileClaim.addWorkerClaiming(mCreature);
 }
 
 CreatureActionClaimWallTile::~CreatureActionClaimWallTile()
 {
-    mTileClaim.removeWorkerClaiming(mCreature);
+    if(mIsReserved)
+        mJobBoard.releaseClaimJob(mTileClaim);
 }
 
 std::function<bool()> CreatureActionClaimWallTile::action()
@@ -98,7 +101,7 @@ bool CreatureActionClaimWallTile::handleClaimWallTile(Creature& creature, Tile&
     const Ogre::Vector3& pos = creature.getPosition();
     Ogre::Vector3 walkDirection(tileClaim.getX() - pos.x, tileClaim.getY() - pos.y, 0);
     walkDirection.normalise();
-    creature.setAnimationState(EntityAnimation::claim_anim, true, walkDirection);
+    creature.setAnimationState(EntityAnimation::claim, true, walkDirection);
     tileClaim.claimForSeat(creature.getSeat(), creature.getClaimRate());
     creature.receiveExp(1.5 * creature.getClaimRate() / 20.0);
 
@@ -21,6 +21,7 @@
 #include "creatureaction/CreatureAction.h"
 
 class Tile;
+class WorkerJobBoard;
 
 class CreatureActionClaimWallTile : public CreatureAction
 {
@@ -37,6 +38,9 @@ public:
 
 private:
     Tile& mTileClaim;
+    //! \brief Job board of the seat of the creature when the claim job was reserved
+    WorkerJobBoard& mJobBoard;
+    bool mIsReserved;
 };
 
 #endif // CREATUREACTIONCLAIMWALLTILE_H
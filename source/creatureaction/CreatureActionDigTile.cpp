@@ -35,14 +35,16 @@
 CreatureActionDigTile::CreatureActionDigTile(Creature& creature, Tile& tileDig, Tile& tilePos) :
     CreatureAction(creature),
     mTileDig(tileDig),
-    mTilePos(tilePos)
+    mTilePos(tilePos),
+    mJobBoard(creature.getSeat()->getWorkerJobBoard()),
+    mIsReserved(mJobBoard.reserveDigJob(tileDig, tilePos))
 {
-    mTileDig.addWorkerDigging(mCreature, mTilePos);
 }
 
 CreatureActionDigTile::~CreatureActionDigTile()
 {
-    mTileDig.removeWorkerDigging(mCreature, mTilePos);
+    if(mIsReserved)
+        mJobBoard.releaseDigJob(mTileDig, mTilePos);
 }
 
 std::function<bool()> CreatureActionDigTile::action()
@@ -84,7 +86,7 @@ bool CreatureActionDigTile::handleDigTile(Creature& creature, Tile& tileDig, Til
     const Ogre::Vector3& pos = creature.getPosition();
     Ogre::Vector3 walkDirection(tileDig.getX() - pos.x, tileDig.getY() - pos.y, 0);
     walkDirection.normalise();
-    creature.setAnimationState(EntityAnimation::dig_anim, true, walkDirection);
+    creature.setAnimationState(EntityAnimation::dig, true, walkDirection);
     double amountDug = tileDig.digOut(creature.getDigRate());
     if(amountDug > 0.0)
     {
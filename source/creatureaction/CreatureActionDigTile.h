@@ -21,6 +21,7 @@
 #include "creatureaction/CreatureAction.h"
 
 class Tile;
+class WorkerJobBoard;
 
 class CreatureActionDigTile : public CreatureAction
 {
@@ -38,6 +39,9 @@ public:
 private:
     Tile& mTileDig;
     Tile& mTilePos;
+    //! \brief Job board of the seat of the creature when the dig job was reserved
+    WorkerJobBoard& mJobBoard;
+    bool mIsReserved;
 };
 
 #endif // CREATUREACTIONDIGTILE_H
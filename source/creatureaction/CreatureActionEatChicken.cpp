@@ -27,7 +27,6 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
-#include "utils/Random.h"
 
 CreatureActionEatChicken::CreatureActionEatChicken(Creature& creature, ChickenEntity& chicken) :
     CreatureAction(creature),
@@ -101,7 +100,7 @@ bool CreatureActionEatChicken::handleEatChicken(Creature& creature, ChickenEntit
 
         std::vector<Ogre::Vector3> path;
         creature.tileToVector3(pathToChicken, path, true, 0.0);
-        creature.setWalkPath(EntityAnimation::walk_anim, EntityAnimation::idle_anim, true, true, path);
+        creature.setWalkPath(EntityAnimation::walk, EntityAnimation::idle, true, true, path);
         creature.pushAction(Utils::make_unique<CreatureActionWalkToTile>(creature));
         return false;
     }
@@ -109,13 +108,13 @@ bool CreatureActionEatChicken::handleEatChicken(Creature& creature, ChickenEntit
     // We can eat the chicken
     chicken->eatChicken(&creature);
     creature.foodEaten(ConfigManager::getSingleton().getRoomConfigDouble("HatcheryHungerPerChicken"));
-    creature.setJobCooldown(Random::Int(ConfigManager::getSingleton().getRoomConfigUInt32("HatcheryCooldownChickenMin"),
+    creature.setJobCooldown(creature.getRandomGenerator().Int(ConfigManager::getSingleton().getRoomConfigUInt32("HatcheryCooldownChickenMin"),
         ConfigManager::getSingleton().getRoomConfigUInt32("HatcheryCooldownChickenMax")));
     creature.setHP(creature.getHP() + ConfigManager::getSingleton().getRoomConfigDouble("HatcheryHpRecoveredPerChicken"));
     creature.computeCreatureOverlayHealthValue();
     Ogre::Vector3 walkDirection = Ogre::Vector3(chickenTile->getX(), chickenTile->getY(), 0) - creature.getPosition();
     walkDirection.normalise();
-    creature.setAnimationState(EntityAnimation::attack_anim, false, walkDirection);
+    creature.setAnimationState(EntityAnimation::attack, false, walkDirection);
     return false;
 }
 
@@ -139,7 +139,7 @@ bool CreatureActionFindHome::handleFindHome(Creature& creature, bool forced)
     std::list<Tile*> tempPath = creature.getGameMap()->findBestPath(&creature, myTile, availableDormitories, choosenTile);
     std::vector<Ogre::Vector3> path;
     creature.tileToVector3(tempPath, path, true, 0.0);
-    creature.setWalkPath(EntityAnimation::walk_anim, EntityAnimation::idle_anim, true, true, path);
+    creature.setWalkPath(EntityAnimation::walk, EntityAnimation::idle, true, true, path);
     creature.pushAction(Utils::make_unique<CreatureActionWalkToTile>(creature));
     return false;
 }
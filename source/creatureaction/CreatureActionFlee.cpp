@@ -25,7 +25,6 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
-#include "utils/Random.h"
 
 static const int NB_TURN_FLEE_MAX = 5;
 
@@ -59,7 +58,7 @@ bool CreatureActionFlee::handleFlee(Creature& creature, int32_t nbTurns)
     if(!tempRooms.empty())
     {
         // We can go to one dungeon temple
-        Room* room = tempRooms[Random::Int(0, tempRooms.size() - 1)];
+        Room* room = tempRooms[creature.getRandomGenerator().Int(0, tempRooms.size() - 1)];
         Tile* tile = room->getCoveredTile(0);
         std::list<Tile*> result = creature.getGameMap()->path(&creature, tile);
         // If we are not too near from the dungeon temple, we go there
@@ -68,13 +67,13 @@ bool CreatureActionFlee::handleFlee(Creature& creature, int32_t nbTurns)
             result.resize(5);
             std::vector<Ogre::Vector3> path;
             creature.tileToVector3(result, path, true, 0.0);
-            creature.setWalkPath(EntityAnimation::flee_anim, EntityAnimation::idle_anim, true, true, path);
+            creature.setWalkPath(EntityAnimation::flee, EntityAnimation::idle, true, true, path);
             creature.pushAction(Utils::make_unique<CreatureActionWalkToTile>(creature));
             return false;
         }
     }
 
     // No dungeon temple is acessible or we are too near. We will wander randomly
-    creature.wanderRandomly(EntityAnimation::flee_anim);
+    creature.wanderRandomly(EntityAnimation::flee);
     return false;
 }
@@ -114,7 +114,7 @@ bool CreatureActionGetFee::handleGetFee(Creature& creature)
 
     std::vector<Ogre::Vector3> vectorPath;
     creature.tileToVector3(tilePath, vectorPath, true, 0.0);
-    creature.setWalkPath(EntityAnimation::walk_anim, EntityAnimation::idle_anim, true, true, vectorPath);
+    creature.setWalkPath(EntityAnimation::walk, EntityAnimation::idle, true, true, vectorPath);
     creature.pushAction(Utils::make_unique<CreatureActionWalkToTile>(creature));
     return false;
 }
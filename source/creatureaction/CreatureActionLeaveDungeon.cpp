@@ -28,7 +28,6 @@
 #include "rooms/RoomType.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
-#include "utils/Random.h"
 
 std::function<bool()> CreatureActionLeaveDungeon::action()
 {
@@ -58,7 +57,7 @@ bool CreatureActionLeaveDungeon::handleLeaveDungeon(Creature& creature)
 
             // We are on the central tile. We can leave the dungeon
             // If the creature has a homeTile where it sleeps, its bed needs to be destroyed.
-            creature.clearDestinations(EntityAnimation::idle_anim, true, true);
+            creature.clearDestinations(EntityAnimation::idle, true, true);
 
             // Remove the creature from the game map and into the deletion queue, it will be deleted
             // when it is safe, i.e. all other pointers to it have been wiped from the program.
@@ -79,7 +78,7 @@ bool CreatureActionLeaveDungeon::handleLeaveDungeon(Creature& creature)
 
     creature.fireChatMsgLeavingDungeon();
 
-    int index = Random::Int(0, tempRooms.size() - 1);
+    int index = creature.getRandomGenerator().Int(0, tempRooms.size() - 1);
     Room* room = tempRooms[index];
     Tile* tile = room->getCentralTile();
     if(!creature.setDestination(tile))
@@ -27,7 +27,6 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
-#include "utils/Random.h"
 
 CreatureActionSearchEntityToCarry::CreatureActionSearchEntityToCarry(Creature& creature, bool forced) :
     CreatureAction(creature),
@@ -149,7 +148,7 @@ bool CreatureActionSearchEntityToCarry::handleSearchEntityToCarry(Creature& crea
     }
 
     // We randomly choose one of the visible carryable entities
-    uint32_t index = Random::Uint(0,availableEntities.size()-1);
+    uint32_t index = creature.getRandomGenerator().Uint(0,availableEntities.size()-1);
     GameEntity* entity = availableEntities[index];
     creature.pushAction(Utils::make_unique<CreatureActionGrabEntity>(creature, *entity));
     return true;
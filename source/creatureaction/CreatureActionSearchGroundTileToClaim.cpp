@@ -19,6 +19,7 @@
 
 #include "creatureaction/CreatureActionClaimGroundTile.h"
 #include "entities/Creature.h"
+#include "entities/CreatureDefinition.h"
 #include "entities/Tile.h"
 #include "game/Player.h"
 #include "game/Seat.h"
@@ -70,9 +71,11 @@ bool CreatureActionSearchGroundTileToClaim::handleSearchGroundTileToClaim(Creatu
         }
     }
 
+    WorkerJobBoard& jobBoard = creature.getSeat()->getWorkerJobBoard();
+
     // See if the tile we are standing on can be claimed
     if ((myTile->isGroundClaimable(creature.getSeat())) &&
-        (myTile->canWorkerClaim(creature)))
+        (jobBoard.canReserveClaimJob(*myTile)))
     {
         // Check to see if one of the tile's neighbors is claimed for our color
         for (Tile* tempTile : myTile->getAllNeighbors())
@@ -105,7 +108,7 @@ bool CreatureActionSearchGroundTileToClaim::handleSearchGroundTileToClaim(Creatu
             continue;
         if(!tile->isGroundClaimable(creature.getSeat()))
             continue;
-        if(!tile->canWorkerClaim(creature))
+        if(!jobBoard.canReserveClaimJob(*tile))
             continue;
 
         // The neighbor tile is a potential candidate for claiming, to be an actual candidate
@@ -125,41 +128,28 @@ bool CreatureActionSearchGroundTileToClaim::handleSearchGroundTileToClaim(Creatu
         }
     }
 
-    // If we still haven't found a tile to claim, we try to take the closest one
+    // If we still haven't found a tile to claim, we try to take the closest one within our sight radius.
+    // The job board of our seat only contains the claimable tiles next to a tile claimed for our seat
+    std::vector<Tile*> claimJobs;
+    jobBoard.getJobsAround(WorkerJobType::claimGround, *myTile,
+        creature.getDefinition()->getSightRadius(), claimJobs);
     float distBest = -1;
     Tile* tileToClaim = nullptr;
-    for (Tile* tile : creature.getTilesWithinSightRadius())
+    for (Tile* tile : claimJobs)
     {
-        // if this tile is not fully claimed yet or the tile is of another player's color
-        if(tile == nullptr)
-            continue;
-        if(tile->isFullTile())
+        float dist = Pathfinding::squaredDistanceTile(*myTile, *tile);
+        if((distBest != -1) && (distBest <= dist))
             continue;
+        // The board is refreshed by the tiles but a covering building may have changed since
         if(!tile->isGroundClaimable(creature.getSeat()))
             continue;
-        if(!creature.getGameMap()->pathExists(&creature, myTile, tile))
+        if(!jobBoard.canReserveClaimJob(*tile))
             continue;
-        if(!tile->canWorkerClaim(creature))
-            continue;
-
-        float dist = Pathfinding::squaredDistanceTile(*myTile, *tile);
-        if((distBest != -1) && (distBest <= dist))
+        if(!creature.getGameMap()->pathExists(&creature, myTile, tile))
             continue;
 
-        // Check to see if one of the tile's neighbors is claimed for our color
-        for (Tile* neigh : tile->getAllNeighbors())
-        {
-            if(neigh->isFullTile())
-                continue;
-            if(!neigh->isClaimedForSeat(creature.getSeat()))
-                continue;
-            if(neigh->getClaimedPercentage() < 1.0)
-                continue;
-
-            distBest = dist;
-            tileToClaim = tile;
-            break;
-        }
+        distBest = dist;
+        tileToClaim = tile;
     }
 
     // Check if we found a tile
@@ -33,7 +33,6 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
-#include "utils/Random.h"
 
 std::function<bool()> CreatureActionSearchJob::action()
 {
@@ -57,7 +56,7 @@ bool CreatureActionSearchJob::handleSearchJob(Creature& creature, bool forced)
         case CreatureMoodLevel::Upset:
         {
             // 20% chances of not working
-            if(Random::Int(0, 100) < 20)
+            if(creature.getRandomGenerator().Int(0, 100) < 20)
             {
                 creature.popAction();
                 return true;
@@ -151,7 +150,7 @@ bool CreatureActionSearchJob::handleSearchJob(Creature& creature, bool forced)
             if((affinity.getEfficiency() <= 0) ||
                (room->getType() == RoomType::hatchery))
             {
-                int index = Random::Int(0, room->numCoveredTiles() - 1);
+                int index = creature.getRandomGenerator().Int(0, room->numCoveredTiles() - 1);
                 Tile* tileDest = room->getCoveredTile(index);
                 creature.setDestination(tileDest);
                 return false;
@@ -201,7 +200,7 @@ bool CreatureActionSearchJob::handleSearchJob(Creature& creature, bool forced)
 
         std::vector<Ogre::Vector3> vectorPath;
         creature.tileToVector3(tilePath, vectorPath, true, 0.0);
-        creature.setWalkPath(EntityAnimation::walk_anim, EntityAnimation::idle_anim, true, true, vectorPath);
+        creature.setWalkPath(EntityAnimation::walk, EntityAnimation::idle, true, true, vectorPath);
         creature.pushAction(Utils::make_unique<CreatureActionWalkToTile>(creature));
         return false;
     }
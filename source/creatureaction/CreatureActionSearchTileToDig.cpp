@@ -20,6 +20,7 @@
 #include "creatureaction/CreatureActionDigTile.h"
 #include "creatureaction/CreatureActionGrabEntity.h"
 #include "entities/Creature.h"
+#include "entities/CreatureDefinition.h"
 #include "entities/Tile.h"
 #include "entities/TreasuryObject.h"
 #include "game/Player.h"
@@ -74,6 +75,7 @@ bool CreatureActionSearchTileToDig::handleSearchTileToDig(Creature& creature, in
     }
 
     // See if any of the tiles is one of our neighbors
+    WorkerJobBoard& jobBoard = creature.getSeat()->getWorkerJobBoard();
     Player* tempPlayer = creature.getGameMap()->getPlayerBySeat(creature.getSeat());
     for (Tile* tempTile : myTile->getAllNeighbors())
     {
@@ -85,7 +87,7 @@ bool CreatureActionSearchTileToDig::handleSearchTileToDig(Creature& creature, in
 
         // Check if there is still empty space for digging the tile
         std::vector<Tile*> tiles;
-        tempTile->canWorkerDig(creature, tiles);
+        jobBoard.getFreeDigSpots(creature, *tempTile, tiles);
         if(tiles.empty())
             continue;
 
@@ -108,19 +110,19 @@ bool CreatureActionSearchTileToDig::handleSearchTileToDig(Creature& creature, in
         return true;
     }
 
-    // Find the closest tile to dig
+    // Find the closest tile to dig within our sight radius. The job board of our seat only
+    // contains the tiles marked for digging
+    std::vector<Tile*> digJobs;
+    jobBoard.getJobsAround(WorkerJobType::dig, *myTile,
+        creature.getDefinition()->getSightRadius(), digJobs);
     float distBest = -1;
     Tile* tileToDig = nullptr;
     Tile* tilePos = nullptr;
-    for (Tile* tile : creature.getTilesWithinSightRadius())
+    for (Tile* tile : digJobs)
     {
-        // Check to see whether the tile is marked for digging
-        if(!tile->getMarkedForDigging(tempPlayer))
-            continue;
-
-        // and there is still room to work on it
+        // Check to see whether there is still room to work on the tile
         std::vector<Tile*> tiles;
-        tile->canWorkerDig(creature, tiles);
+        jobBoard.getFreeDigSpots(creature, *tile, tiles);
         if(tiles.empty())
             continue;
 
@@ -19,6 +19,7 @@
 
 #include "creatureaction/CreatureActionClaimWallTile.h"
 #include "entities/Creature.h"
+#include "entities/CreatureDefinition.h"
 #include "entities/Tile.h"
 #include "game/Player.h"
 #include "game/Seat.h"
@@ -69,6 +70,8 @@ bool CreatureActionSearchWallTileToClaim::handleSearchWallTileToClaim(Creature&
         }
     }
 
+    WorkerJobBoard& jobBoard = creature.getSeat()->getWorkerJobBoard();
+
     // See if any of the tiles is one of our neighbors
     Player* tempPlayer = creature.getSeat()->getPlayer();
     for (Tile* tile : myTile->getAllNeighbors())
@@ -77,24 +80,26 @@ bool CreatureActionSearchWallTileToClaim::handleSearchWallTileToClaim(Creature&
             continue;
         if (!tile->isWallClaimable(creature.getSeat()))
             continue;
-        if (!tile->canWorkerClaim(creature))
+        if (!jobBoard.canReserveClaimJob(*tile))
             continue;
 
         creature.pushAction(Utils::make_unique<CreatureActionClaimWallTile>(creature, *tile));
         return true;
     }
 
-    // Find paths to all of the neighbor tiles for all of the visible wall tiles.
+    // Find paths to all of the neighbor tiles for the claimable walls within our sight radius. The
+    // job board of our seat lists them
+    std::vector<Tile*> claimJobs;
+    jobBoard.getJobsAround(WorkerJobType::claimWall, *myTile,
+        creature.getDefinition()->getSightRadius(), claimJobs);
     float distBest = -1;
     Tile* tileToClaim = nullptr;
-    for(Tile* tile : creature.getTilesWithinSightRadius())
+    for(Tile* tile : claimJobs)
     {
-        // Check to see whether the tile is a claimable wall
+        // Walls marked for digging will be dug instead of claimed
         if(tile->getMarkedForDigging(tempPlayer))
             continue;
-        if(!tile->isWallClaimable(creature.getSeat()))
-            continue;
-        if (!tile->canWorkerClaim(creature))
+        if (!jobBoard.canReserveClaimJob(*tile))
             continue;
 
         // and can be reached by the creature
@@ -28,7 +28,6 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
-#include "utils/Random.h"
 
 CreatureActionUseRoom::CreatureActionUseRoom(Creature& creature, Room& room, bool forced) :
     CreatureAction(creature),
@@ -92,7 +91,7 @@ bool CreatureActionUseRoom::handleJob(Creature& creature, Room* room, bool force
             case CreatureMoodLevel::Upset:
             {
                 // 20% chances of not working
-                if(Random::Int(0, 100) < 20)
+                if(creature.getRandomGenerator().Int(0, 100) < 20)
                 {
                     creature.popAction();
                     return true;
@@ -23,6 +23,7 @@
 #include <string>
 
 class Creature;
+class ODPacket;
 
 class CreatureBehaviour
 {
@@ -61,6 +62,12 @@ public:
     //! \brief Read skills data. Returns true if loading is OK and false otherwise
     virtual bool importFromStream(std::istream& is)
     { return true; }
+
+    //! \brief Same as exportToStream/importFromStream for the binary configuration cache
+    virtual void exportToPacket(ODPacket& os) const
+    {}
+    virtual bool importFromPacket(ODPacket& is)
+    { return true; }
 };
 
 #endif // CREATUREBEHAVIOUR_H
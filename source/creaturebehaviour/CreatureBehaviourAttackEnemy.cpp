@@ -22,7 +22,6 @@
 #include "creaturemood/CreatureMood.h"
 #include "entities/Creature.h"
 #include "entities/CreatureDefinition.h"
-#include "utils/Random.h"
 
 const std::string CreatureBehaviourAttackEnemy::mNameCreatureBehaviourAttackEnemy = "AttackEnemy";
 
@@ -63,7 +62,7 @@ bool CreatureBehaviourAttackEnemy::processBehaviour(Creature& creature) const
         case CreatureMoodLevel::Angry:
         case CreatureMoodLevel::Furious:
         {
-            if(Random::Int(0,100) > 80)
+            if(creature.getRandomGenerator().Int(0,100) > 80)
             {
                 creature.flee();
                 return false;
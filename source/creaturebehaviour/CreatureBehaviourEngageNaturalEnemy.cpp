@@ -25,9 +25,9 @@
 #include "creaturemood/CreatureMood.h"
 #include "game/Player.h"
 #include "game/Seat.h"
+#include "network/ODPacket.h"
 #include "network/ODServer.h"
 #include "network/ServerNotification.h"
-#include "utils/Random.h"
 
 const std::string CreatureBehaviourEngageNaturalEnemy::mNameCreatureBehaviourEngageNaturalEnemy = "EngageNaturalEnemy";
 
@@ -67,7 +67,7 @@ bool CreatureBehaviourEngageNaturalEnemy::processBehaviour(Creature& creature) c
     if(creature.getMoodValue() < CreatureMoodLevel::Upset)
         return true;
 
-    if(Random::Int(0, 100) < 80)
+    if(creature.getRandomGenerator().Int(0, 100) < 80)
         return true;
 
     // If the creature is already fighting, it should not engage another creature
@@ -95,7 +95,7 @@ bool CreatureBehaviourEngageNaturalEnemy::processBehaviour(Creature& creature) c
     if(alliedNaturalEnemies.empty())
         return true;
 
-    uint32_t index = Random::Uint(0, alliedNaturalEnemies.size() - 1);
+    uint32_t index = creature.getRandomGenerator().Uint(0, alliedNaturalEnemies.size() - 1);
     Creature& target = *alliedNaturalEnemies.at(index);
     creature.engageAlliedNaturalEnemy(target);
     target.engageAlliedNaturalEnemy(creature);
@@ -164,3 +164,36 @@ bool CreatureBehaviourEngageNaturalEnemy::importFromStream(std::istream& is)
 
     return true;
 }
+
+void CreatureBehaviourEngageNaturalEnemy::exportToPacket(ODPacket& os) const
+{
+    CreatureBehaviour::exportToPacket(os);
+    uint32_t nb = mNaturalEnemyClasses.size();
+    os << nb;
+    for(const std::string& str : mNaturalEnemyClasses)
+    {
+        os << str;
+    }
+}
+
+bool CreatureBehaviourEngageNaturalEnemy::importFromPacket(ODPacket& is)
+{
+    if(!CreatureBehaviour::importFromPacket(is))
+        return false;
+
+    uint32_t nb;
+    if(!(is >> nb))
+        return false;
+
+    std::string str;
+    while(nb > 0)
+    {
+        --nb;
+        if(!(is >> str))
+            return false;
+
+        mNaturalEnemyClasses.push_back(str);
+    }
+
+    return true;
+}
@@ -21,7 +21,7 @@
 #include "creaturebehaviour/CreatureBehaviourManager.h"
 #include "entities/Creature.h"
 #include "entities/CreatureDefinition.h"
-#include "utils/Random.h"
+#include "network/ODPacket.h"
 
 const std::string CreatureBehaviourFleeWhenWeak::mNameCreatureBehaviourFleeWhenWeak = "FleeWhenWeak";
 
@@ -87,7 +87,7 @@ bool CreatureBehaviourFleeWhenWeak::processBehaviour(Creature& creature) const
     }
 
     // We randomly choose to flee
-    if(Random::Uint(0, 100) < 20)
+    if(creature.getRandomGenerator().Uint(0, 100) < 20)
     {
         if(creature.isActionInList(CreatureActionType::flee))
             return true;
@@ -138,3 +138,20 @@ bool CreatureBehaviourFleeWhenWeak::importFromStream(std::istream& is)
 
     return true;
 }
+
+void CreatureBehaviourFleeWhenWeak::exportToPacket(ODPacket& os) const
+{
+    CreatureBehaviour::exportToPacket(os);
+    os << mWeakCoef;
+}
+
+bool CreatureBehaviourFleeWhenWeak::importFromPacket(ODPacket& is)
+{
+    if(!CreatureBehaviour::importFromPacket(is))
+        return false;
+
+    if(!(is >> mWeakCoef))
+        return false;
+
+    return true;
+}
@@ -42,6 +42,8 @@ public:
     virtual bool isEqual(const CreatureBehaviour& creatureBehaviour) const override;
     virtual void exportToStream(std::ostream& os) const override;
     virtual bool importFromStream(std::istream& is) override;
+    virtual void exportToPacket(ODPacket& os) const override;
+    virtual bool importFromPacket(ODPacket& is) override;
 
 private:
     CreatureBehaviourFleeWhenWeak(const CreatureBehaviourFleeWhenWeak& behaviour);
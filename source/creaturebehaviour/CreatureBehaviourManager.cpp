@@ -18,6 +18,7 @@
 #include "creaturebehaviour/CreatureBehaviourManager.h"
 
 #include "creaturebehaviour/CreatureBehaviour.h"
+#include "network/ODPacket.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
@@ -31,6 +32,21 @@ namespace
         static std::vector<const CreatureBehaviourFactory*> factory;
         return factory;
     }
+
+    static const CreatureBehaviourFactory* getFactory(const std::string& name)
+    {
+        for(const CreatureBehaviourFactory* factory : getFactories())
+        {
+            if(factory == nullptr)
+                continue;
+
+            if(factory->getCreatureBehaviourName().compare(name) != 0)
+                continue;
+
+            return factory;
+        }
+        return nullptr;
+    }
 }
 
 void CreatureBehaviourManager::registerFactory(const CreatureBehaviourFactory* factory)
@@ -61,21 +77,9 @@ CreatureBehaviour* CreatureBehaviourManager::load(std::istream& is)
     if(!is.good())
         return nullptr;
 
-    std::vector<const CreatureBehaviourFactory*>& factories = getFactories();
     std::string nextParam;
     OD_ASSERT_TRUE(is >> nextParam);
-    const CreatureBehaviourFactory* factoryToUse = nullptr;
-    for(const CreatureBehaviourFactory* factory : factories)
-    {
-        if(factory == nullptr)
-            continue;
-
-        if(factory->getCreatureBehaviourName().compare(nextParam) != 0)
-            continue;
-
-        factoryToUse = factory;
-        break;
-    }
+    const CreatureBehaviourFactory* factoryToUse = getFactory(nextParam);
 
     if(factoryToUse == nullptr)
     {
@@ -94,6 +98,30 @@ CreatureBehaviour* CreatureBehaviourManager::load(std::istream& is)
     return behaviour;
 }
 
+CreatureBehaviour* CreatureBehaviourManager::loadFromPacket(ODPacket& is)
+{
+    std::string name;
+    if(!(is >> name))
+        return nullptr;
+
+    const CreatureBehaviourFactory* factoryToUse = getFactory(name);
+    if(factoryToUse == nullptr)
+    {
+        OD_LOG_ERR("Unknown behaviour modifier=" + name);
+        return nullptr;
+    }
+
+    CreatureBehaviour* behaviour = factoryToUse->createCreatureBehaviour();
+    if(!behaviour->importFromPacket(is))
+    {
+        OD_LOG_ERR("Couldn't load creature behaviour modifier=" + name);
+        delete behaviour;
+        return nullptr;
+    }
+
+    return behaviour;
+}
+
 void CreatureBehaviourManager::dispose(const CreatureBehaviour* behaviour)
 {
     delete behaviour;
@@ -105,6 +133,12 @@ void CreatureBehaviourManager::write(const CreatureBehaviour& behaviour, std::os
     behaviour.exportToStream(os);
 }
 
+void CreatureBehaviourManager::writeToPacket(const CreatureBehaviour& behaviour, ODPacket& os)
+{
+    os << behaviour.getName();
+    behaviour.exportToPacket(os);
+}
+
 void CreatureBehaviourManager::getFormatString(const CreatureBehaviour& behaviour, std::string& format)
 {
     format = "# BehaviourName";
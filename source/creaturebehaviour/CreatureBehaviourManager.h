@@ -23,6 +23,7 @@
 #include <string>
 
 class CreatureBehaviour;
+class ODPacket;
 
 //! \brief Factory class to register a new mood modifier
 class CreatureBehaviourFactory
@@ -49,9 +50,11 @@ public:
 
     static CreatureBehaviour* clone(const CreatureBehaviour* behaviour);
     static CreatureBehaviour* load(std::istream& is);
+    static CreatureBehaviour* loadFromPacket(ODPacket& is);
     //! \brief Handles the behaviour deletion
     static void dispose(const CreatureBehaviour* behaviour);
     static void write(const CreatureBehaviour& behaviour, std::ostream& os);
+    static void writeToPacket(const CreatureBehaviour& behaviour, ODPacket& os);
     static void getFormatString(const CreatureBehaviour& behaviour, std::string& format);
     static bool areEqual(const CreatureBehaviour& behaviour1, const CreatureBehaviour& behaviour2);
 
@@ -24,6 +24,7 @@
 
 class Creature;
 class GameMap;
+class ODPacket;
 
 enum class CreatureMoodLevel
 {
@@ -64,6 +65,12 @@ public:
     virtual void exportToStream(std::ostream& os) const
     {}
 
+    //! \brief Same as importFromStream/exportToStream for the binary configuration cache
+    virtual bool importFromPacket(ODPacket& is)
+    { return true; }
+    virtual void exportToPacket(ODPacket& os) const
+    {}
+
     static std::string toString(CreatureMoodLevel moodLevel);
 };
 
@@ -22,6 +22,7 @@
 #include "entities/CreatureDefinition.h"
 #include "entities/GameEntityType.h"
 #include "gamemap/GameMap.h"
+#include "network/ODPacket.h"
 #include "utils/LogManager.h"
 
 static const std::string CreatureMoodCreatureName = "Creature";
@@ -95,6 +96,26 @@ void CreatureMoodCreature::exportToStream(std::ostream& os) const
     os << "\t" << mMoodModifier;
 }
 
+void CreatureMoodCreature::exportToPacket(ODPacket& os) const
+{
+    CreatureMood::exportToPacket(os);
+    os << mCreatureClass;
+    os << mMoodModifier;
+}
+
+bool CreatureMoodCreature::importFromPacket(ODPacket& is)
+{
+    if(!CreatureMood::importFromPacket(is))
+        return false;
+
+    if(!(is >> mCreatureClass))
+        return false;
+    if(!(is >> mMoodModifier))
+        return false;
+
+    return true;
+}
+
 void CreatureMoodCreature::getFormatString(std::string& format) const
 {
     CreatureMood::getFormatString(format);
@@ -20,6 +20,7 @@
 #include "creaturemood/CreatureMoodManager.h"
 #include "entities/Creature.h"
 #include "entities/CreatureDefinition.h"
+#include "network/ODPacket.h"
 #include "utils/Helper.h"
 
 static const std::string CreatureMoodFeeName = "Fee";
@@ -78,6 +79,23 @@ void CreatureMoodFee::exportToStream(std::ostream& os) const
     os << "\t" << mMoodModifier;
 }
 
+void CreatureMoodFee::exportToPacket(ODPacket& os) const
+{
+    CreatureMood::exportToPacket(os);
+    os << mMoodModifier;
+}
+
+bool CreatureMoodFee::importFromPacket(ODPacket& is)
+{
+    if(!CreatureMood::importFromPacket(is))
+        return false;
+
+    if(!(is >> mMoodModifier))
+        return false;
+
+    return true;
+}
+
 void CreatureMoodFee::getFormatString(std::string& format) const
 {
     CreatureMood::getFormatString(format);
@@ -19,6 +19,7 @@
 
 #include "creaturemood/CreatureMoodManager.h"
 #include "entities/Creature.h"
+#include "network/ODPacket.h"
 #include "utils/Helper.h"
 
 static const std::string CreatureMoodHpLossName = "HpLoss";
@@ -77,6 +78,23 @@ void CreatureMoodHpLoss::exportToStream(std::ostream& os) const
     os << "\t" << mMoodModifier;
 }
 
+void CreatureMoodHpLoss::exportToPacket(ODPacket& os) const
+{
+    CreatureMood::exportToPacket(os);
+    os << mMoodModifier;
+}
+
+bool CreatureMoodHpLoss::importFromPacket(ODPacket& is)
+{
+    if(!CreatureMood::importFromPacket(is))
+        return false;
+
+    if(!(is >> mMoodModifier))
+        return false;
+
+    return true;
+}
+
 void CreatureMoodHpLoss::getFormatString(std::string& format) const
 {
     CreatureMood::getFormatString(format);
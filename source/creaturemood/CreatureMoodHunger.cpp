@@ -19,6 +19,7 @@
 
 #include "creaturemood/CreatureMoodManager.h"
 #include "entities/Creature.h"
+#include "network/ODPacket.h"
 
 static const std::string CreatureMoodHungerName = "Hunger";
 
@@ -78,6 +79,26 @@ void CreatureMoodHunger::exportToStream(std::ostream& os) const
     os << "\t" << mMoodModifier;
 }
 
+void CreatureMoodHunger::exportToPacket(ODPacket& os) const
+{
+    CreatureMood::exportToPacket(os);
+    os << mStartHunger;
+    os << mMoodModifier;
+}
+
+bool CreatureMoodHunger::importFromPacket(ODPacket& is)
+{
+    if(!CreatureMood::importFromPacket(is))
+        return false;
+
+    if(!(is >> mStartHunger))
+        return false;
+    if(!(is >> mMoodModifier))
+        return false;
+
+    return true;
+}
+
 void CreatureMoodHunger::getFormatString(std::string& format) const
 {
     CreatureMood::getFormatString(format);
@@ -20,6 +20,7 @@
 #include "creaturemood/CreatureMood.h"
 #include "entities/Creature.h"
 #include "entities/CreatureDefinition.h"
+#include "network/ODPacket.h"
 #include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
@@ -34,6 +35,21 @@ namespace
         static std::vector<const CreatureMoodFactory*> factory;
         return factory;
     }
+
+    static const CreatureMoodFactory* getFactory(const std::string& name)
+    {
+        for(const CreatureMoodFactory* factory : getFactories())
+        {
+            if(factory == nullptr)
+                continue;
+
+            if(factory->getCreatureMoodName().compare(name) != 0)
+                continue;
+
+            return factory;
+        }
+        return nullptr;
+    }
 }
 
 void CreatureMoodManager::registerFactory(const CreatureMoodFactory* factory)
@@ -93,21 +109,9 @@ CreatureMood* CreatureMoodManager::load(std::istream& defFile)
     if(!defFile.good())
         return nullptr;
 
-    std::vector<const CreatureMoodFactory*>& factories = getFactories();
     std::string nextParam;
     OD_ASSERT_TRUE(defFile >> nextParam);
-    const CreatureMoodFactory* factoryToUse = nullptr;
-    for(const CreatureMoodFactory* factory : factories)
-    {
-        if(factory == nullptr)
-            continue;
-
-        if(factory->getCreatureMoodName().compare(nextParam) != 0)
-            continue;
-
-        factoryToUse = factory;
-        break;
-    }
+    const CreatureMoodFactory* factoryToUse = getFactory(nextParam);
 
     if(factoryToUse == nullptr)
     {
@@ -126,6 +130,30 @@ CreatureMood* CreatureMoodManager::load(std::istream& defFile)
     return mood;
 }
 
+CreatureMood* CreatureMoodManager::loadFromPacket(ODPacket& is)
+{
+    std::string name;
+    if(!(is >> name))
+        return nullptr;
+
+    const CreatureMoodFactory* factoryToUse = getFactory(name);
+    if(factoryToUse == nullptr)
+    {
+        OD_LOG_ERR("Unknown mood modifier=" + name);
+        return nullptr;
+    }
+
+    CreatureMood* mood = factoryToUse->createCreatureMood();
+    if(!mood->importFromPacket(is))
+    {
+        OD_LOG_ERR("Couldn't load creature mood modifier=" + name);
+        delete mood;
+        return nullptr;
+    }
+
+    return mood;
+}
+
 void CreatureMoodManager::dispose(const CreatureMood* mood)
 {
     delete mood;
@@ -137,6 +165,12 @@ void CreatureMoodManager::write(const CreatureMood& mood, std::ostream& os)
     mood.exportToStream(os);
 }
 
+void CreatureMoodManager::writeToPacket(const CreatureMood& mood, ODPacket& os)
+{
+    os << mood.getModifierName();
+    mood.exportToPacket(os);
+}
+
 void CreatureMoodManager::getFormatString(const CreatureMood& mood, std::string& format)
 {
     format = "# MoodModifierName";
@@ -24,6 +24,7 @@
 
 class Creature;
 class CreatureMood;
+class ODPacket;
 
 enum class CreatureMoodLevel;
 
@@ -57,10 +58,12 @@ public:
     static CreatureMood* clone(const CreatureMood* mood);
 
     static CreatureMood* load(std::istream& defFile);
+    static CreatureMood* loadFromPacket(ODPacket& is);
 
     static void dispose(const CreatureMood* mood);
 
     static void write(const CreatureMood& mood, std::ostream& os);
+    static void writeToPacket(const CreatureMood& mood, ODPacket& os);
 
     static void getFormatString(const CreatureMood& mood, std::string& format);
 
@@ -20,6 +20,7 @@
 #include "creaturemood/CreatureMoodManager.h"
 #include "entities/Creature.h"
 #include "entities/CreatureDefinition.h"
+#include "network/ODPacket.h"
 #include "utils/Helper.h"
 
 static const std::string CreatureMoodTurnsWithoutFightName = "TurnsWithoutFight";
@@ -84,6 +85,29 @@ void CreatureMoodTurnsWithoutFight::exportToStream(std::ostream& os) const
     os << "\t" << mMoodModifier;
 }
 
+void CreatureMoodTurnsWithoutFight::exportToPacket(ODPacket& os) const
+{
+    CreatureMood::exportToPacket(os);
+    os << mTurnsWithoutFightMin;
+    os << mTurnsWithoutFightMax;
+    os << mMoodModifier;
+}
+
+bool CreatureMoodTurnsWithoutFight::importFromPacket(ODPacket& is)
+{
+    if(!CreatureMood::importFromPacket(is))
+        return false;
+
+    if(!(is >> mTurnsWithoutFightMin))
+        return false;
+    if(!(is >> mTurnsWithoutFightMax))
+        return false;
+    if(!(is >> mMoodModifier))
+        return false;
+
+    return true;
+}
+
 void CreatureMoodTurnsWithoutFight::getFormatString(std::string& format) const
 {
     CreatureMood::getFormatString(format);
@@ -40,6 +40,8 @@ public:
 
     virtual bool importFromStream(std::istream& is) override;
     virtual void exportToStream(std::ostream& os) const override;
+    virtual void exportToPacket(ODPacket& os) const override;
+    virtual bool importFromPacket(ODPacket& is) override;
     virtual void getFormatString(std::string& format) const override;
 
 private:
@@ -19,6 +19,7 @@
 
 #include "creaturemood/CreatureMoodManager.h"
 #include "entities/Creature.h"
+#include "network/ODPacket.h"
 
 static const std::string CreatureMoodWakefulnessName = "Wakefulness";
 
@@ -78,6 +79,26 @@ void CreatureMoodWakefulness::exportToStream(std::ostream& os) const
     os << "\t" << mMoodModifier;
 }
 
+void CreatureMoodWakefulness::exportToPacket(ODPacket& os) const
+{
+    CreatureMood::exportToPacket(os);
+    os << mStartWakefulness;
+    os << mMoodModifier;
+}
+
+bool CreatureMoodWakefulness::importFromPacket(ODPacket& is)
+{
+    if(!CreatureMood::importFromPacket(is))
+        return false;
+
+    if(!(is >> mStartWakefulness))
+        return false;
+    if(!(is >> mMoodModifier))
+        return false;
+
+    return true;
+}
+
 void CreatureMoodWakefulness::getFormatString(std::string& format) const
 {
     CreatureMood::getFormatString(format);
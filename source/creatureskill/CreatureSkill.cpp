@@ -21,6 +21,7 @@
 #include "creatureskill/CreatureSkillHealSelf.h"
 #include "creatureskill/CreatureSkillMeleeFight.h"
 #include "creatureskill/CreatureSkillMissileLaunch.h"
+#include "network/ODPacket.h"
 #include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
@@ -52,6 +53,23 @@ bool CreatureSkill::importFromStream(std::istream& is)
     return true;
 }
 
+void CreatureSkill::exportToPacket(ODPacket& os) const
+{
+    os << mCooldownNbTurns;
+    os << mWarmupNbTurns;
+}
+
+bool CreatureSkill::importFromPacket(ODPacket& is)
+{
+    if(!(is >> mCooldownNbTurns))
+        return false;
+
+    if(!(is >> mWarmupNbTurns))
+        return false;
+
+    return true;
+}
+
 bool CreatureSkill::isEqual(const CreatureSkill& creatureSkill) const
 {
     if(typeid(*this) != typeid(creatureSkill))
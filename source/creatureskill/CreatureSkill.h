@@ -25,6 +25,7 @@
 class Creature;
 class GameEntity;
 class GameMap;
+class ODPacket;
 class Tile;
 
 //! \brief Defines the skills the creatures can use in game. Note that the CreatureSkill
@@ -85,6 +86,10 @@ public:
     //! \brief Read skills data. Returns true if loading is OK and false otherwise
     virtual bool importFromStream(std::istream& is);
 
+    //! \brief Same as exportToStream/importFromStream for the binary configuration cache
+    virtual void exportToPacket(ODPacket& os) const;
+    virtual bool importFromPacket(ODPacket& is);
+
 private:
     uint32_t mCooldownNbTurns;
     uint32_t mWarmupNbTurns;
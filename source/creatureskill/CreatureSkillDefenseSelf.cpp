@@ -23,6 +23,7 @@
 #include "entities/Creature.h"
 #include "entities/Tile.h"
 #include "gamemap/GameMap.h"
+#include "network/ODPacket.h"
 #include "spells/Spell.h"
 
 #include <istream>
@@ -120,6 +121,35 @@ bool CreatureSkillDefenseSelf::importFromStream(std::istream& is)
     return true;
 }
 
+void CreatureSkillDefenseSelf::exportToPacket(ODPacket& os) const
+{
+    CreatureSkill::exportToPacket(os);
+    os << mCreatureLevelMin;
+    os << mEffectDuration;
+    os << mPhy;
+    os << mMag;
+    os << mEle;
+}
+
+bool CreatureSkillDefenseSelf::importFromPacket(ODPacket& is)
+{
+    if(!CreatureSkill::importFromPacket(is))
+        return false;
+
+    if(!(is >> mCreatureLevelMin))
+        return false;
+    if(!(is >> mEffectDuration))
+        return false;
+    if(!(is >> mPhy))
+        return false;
+    if(!(is >> mMag))
+        return false;
+    if(!(is >> mEle))
+        return false;
+
+    return true;
+}
+
 bool CreatureSkillDefenseSelf::isEqual(const CreatureSkill& creatureSkill) const
 {
     if(!CreatureSkill::isEqual(creatureSkill))
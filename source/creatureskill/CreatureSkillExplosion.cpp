@@ -23,6 +23,7 @@
 #include "entities/GameEntityType.h"
 #include "entities/Tile.h"
 #include "gamemap/GameMap.h"
+#include "network/ODPacket.h"
 #include "sound/SoundEffectsManager.h"
 #include "utils/LogManager.h"
 
@@ -124,6 +125,32 @@ bool CreatureSkillExplosion::importFromStream(std::istream& is)
     return true;
 }
 
+void CreatureSkillExplosion::exportToPacket(ODPacket& os) const
+{
+    CreatureSkill::exportToPacket(os);
+    os << mMaxRange;
+    os << mCreatureLevelMin;
+    os << mEffectDuration;
+    os << mEffectValue;
+}
+
+bool CreatureSkillExplosion::importFromPacket(ODPacket& is)
+{
+    if(!CreatureSkill::importFromPacket(is))
+        return false;
+
+    if(!(is >> mMaxRange))
+        return false;
+    if(!(is >> mCreatureLevelMin))
+        return false;
+    if(!(is >> mEffectDuration))
+        return false;
+    if(!(is >> mEffectValue))
+        return false;
+
+    return true;
+}
+
 bool CreatureSkillExplosion::isEqual(const CreatureSkill& creatureSkill) const
 {
     if(!CreatureSkill::isEqual(creatureSkill))
@@ -22,6 +22,7 @@
 #include "entities/Creature.h"
 #include "entities/Tile.h"
 #include "gamemap/GameMap.h"
+#include "network/ODPacket.h"
 #include "spells/Spell.h"
 
 #include <istream>
@@ -109,6 +110,29 @@ bool CreatureSkillHasteSelf::importFromStream(std::istream& is)
     return true;
 }
 
+void CreatureSkillHasteSelf::exportToPacket(ODPacket& os) const
+{
+    CreatureSkill::exportToPacket(os);
+    os << mCreatureLevelMin;
+    os << mEffectDuration;
+    os << mEffectValue;
+}
+
+bool CreatureSkillHasteSelf::importFromPacket(ODPacket& is)
+{
+    if(!CreatureSkill::importFromPacket(is))
+        return false;
+
+    if(!(is >> mCreatureLevelMin))
+        return false;
+    if(!(is >> mEffectDuration))
+        return false;
+    if(!(is >> mEffectValue))
+        return false;
+
+    return true;
+}
+
 bool CreatureSkillHasteSelf::isEqual(const CreatureSkill& creatureSkill) const
 {
     if(!CreatureSkill::isEqual(creatureSkill))
@@ -18,6 +18,7 @@
 #include "creatureskill/CreatureSkillManager.h"
 
 #include "creatureskill/CreatureSkill.h"
+#include "network/ODPacket.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
@@ -31,6 +32,21 @@ namespace
         static std::vector<const CreatureSkillFactory*> factory;
         return factory;
     }
+
+    static const CreatureSkillFactory* getFactory(const std::string& name)
+    {
+        for(const CreatureSkillFactory* factory : getFactories())
+        {
+            if(factory == nullptr)
+                continue;
+
+            if(factory->getCreatureSkillName().compare(name) != 0)
+                continue;
+
+            return factory;
+        }
+        return nullptr;
+    }
 }
 
 void CreatureSkillManager::registerFactory(const CreatureSkillFactory* factory)
@@ -61,21 +77,9 @@ CreatureSkill* CreatureSkillManager::load(std::istream& is)
     if(!is.good())
         return nullptr;
 
-    std::vector<const CreatureSkillFactory*>& factories = getFactories();
     std::string nextParam;
     OD_ASSERT_TRUE(is >> nextParam);
-    const CreatureSkillFactory* factoryToUse = nullptr;
-    for(const CreatureSkillFactory* factory : factories)
-    {
-        if(factory == nullptr)
-            continue;
-
-        if(factory->getCreatureSkillName().compare(nextParam) != 0)
-            continue;
-
-        factoryToUse = factory;
-        break;
-    }
+    const CreatureSkillFactory* factoryToUse = getFactory(nextParam);
 
     if(factoryToUse == nullptr)
     {
@@ -94,6 +98,30 @@ CreatureSkill* CreatureSkillManager::load(std::istream& is)
     return skill;
 }
 
+CreatureSkill* CreatureSkillManager::loadFromPacket(ODPacket& is)
+{
+    std::string name;
+    if(!(is >> name))
+        return nullptr;
+
+    const CreatureSkillFactory* factoryToUse = getFactory(name);
+    if(factoryToUse == nullptr)
+    {
+        OD_LOG_ERR("Unknown Skill=" + name);
+        return nullptr;
+    }
+
+    CreatureSkill* skill = factoryToUse->createCreatureSkill();
+    if(!skill->importFromPacket(is))
+    {
+        OD_LOG_ERR("Couldn't load creature Skill=" + name);
+        delete skill;
+        return nullptr;
+    }
+
+    return skill;
+}
+
 void CreatureSkillManager::dispose(const CreatureSkill* skill)
 {
     delete skill;
@@ -105,6 +133,12 @@ void CreatureSkillManager::write(const CreatureSkill& skill, std::ostream& os)
     skill.exportToStream(os);
 }
 
+void CreatureSkillManager::writeToPacket(const CreatureSkill& skill, ODPacket& os)
+{
+    os << skill.getSkillName();
+    skill.exportToPacket(os);
+}
+
 void CreatureSkillManager::getFormatString(const CreatureSkill& skill, std::string& format)
 {
     format = "# SkillName";
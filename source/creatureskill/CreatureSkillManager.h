@@ -23,6 +23,7 @@
 #include <string>
 
 class CreatureSkill;
+class ODPacket;
 
 //! \brief Factory class to register a new mood modifier
 class CreatureSkillFactory
@@ -49,9 +50,11 @@ public:
 
     static CreatureSkill* clone(const CreatureSkill* skill);
     static CreatureSkill* load(std::istream& is);
+    static CreatureSkill* loadFromPacket(ODPacket& is);
     //! \brief Handles the Skill deletion
     static void dispose(const CreatureSkill* skill);
     static void write(const CreatureSkill& skill, std::ostream& os);
+    static void writeToPacket(const CreatureSkill& skill, ODPacket& os);
     static void getFormatString(const CreatureSkill& skill, std::string& format);
     static bool areEqual(const CreatureSkill& skill1, const CreatureSkill& skill2);
 
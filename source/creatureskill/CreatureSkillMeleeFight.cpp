@@ -22,6 +22,7 @@
 #include "entities/Tile.h"
 #include "entities/Weapon.h"
 #include "gamemap/GameMap.h"
+#include "network/ODPacket.h"
 #include "spells/Spell.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
@@ -142,6 +143,41 @@ bool CreatureSkillMeleeFight::importFromStream(std::istream& is)
     return true;
 }
 
+void CreatureSkillMeleeFight::exportToPacket(ODPacket& os) const
+{
+    CreatureSkill::exportToPacket(os);
+    os << mCreatureLevelMin;
+    os << mPhyAtk;
+    os << mPhyAtkPerLvl;
+    os << mMagAtk;
+    os << mMagAtkPerLvl;
+    os << mEleAtk;
+    os << mEleAtkPerLvl;
+}
+
+bool CreatureSkillMeleeFight::importFromPacket(ODPacket& is)
+{
+    if(!CreatureSkill::importFromPacket(is))
+        return false;
+
+    if(!(is >> mCreatureLevelMin))
+        return false;
+    if(!(is >> mPhyAtk))
+        return false;
+    if(!(is >> mPhyAtkPerLvl))
+        return false;
+    if(!(is >> mMagAtk))
+        return false;
+    if(!(is >> mMagAtkPerLvl))
+        return false;
+    if(!(is >> mEleAtk))
+        return false;
+    if(!(is >> mEleAtkPerLvl))
+        return false;
+
+    return true;
+}
+
 bool CreatureSkillMeleeFight::isEqual(const CreatureSkill& creatureSkill) const
 {
     if(!CreatureSkill::isEqual(creatureSkill))
@@ -64,6 +64,8 @@ public:
     virtual void getFormatString(std::string& format) const override;
     virtual void exportToStream(std::ostream& os) const override;
     virtual bool importFromStream(std::istream& is) override;
+    virtual void exportToPacket(ODPacket& os) const override;
+    virtual bool importFromPacket(ODPacket& is) override;
 
 private:
     uint32_t mCreatureLevelMin;
@@ -23,6 +23,7 @@
 #include "entities/Tile.h"
 #include "entities/Weapon.h"
 #include "gamemap/GameMap.h"
+#include "network/ODPacket.h"
 #include "spells/Spell.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
@@ -191,6 +192,56 @@ bool CreatureSkillMissileLaunch::importFromStream(std::istream& is)
     return true;
 }
 
+void CreatureSkillMissileLaunch::exportToPacket(ODPacket& os) const
+{
+    CreatureSkill::exportToPacket(os);
+    os << mRangeMax;
+    os << mRangePerLvl;
+    os << mCreatureLevelMin;
+    os << mMissileMesh;
+    os << mMissilePartScript;
+    os << mMissileSpeed;
+    os << mPhyAtk;
+    os << mPhyAtkPerLvl;
+    os << mMagAtk;
+    os << mMagAtkPerLvl;
+    os << mEleAtk;
+    os << mEleAtkPerLvl;
+}
+
+bool CreatureSkillMissileLaunch::importFromPacket(ODPacket& is)
+{
+    if(!CreatureSkill::importFromPacket(is))
+        return false;
+
+    if(!(is >> mRangeMax))
+        return false;
+    if(!(is >> mRangePerLvl))
+        return false;
+    if(!(is >> mCreatureLevelMin))
+        return false;
+    if(!(is >> mMissileMesh))
+        return false;
+    if(!(is >> mMissilePartScript))
+        return false;
+    if(!(is >> mMissileSpeed))
+        return false;
+    if(!(is >> mPhyAtk))
+        return false;
+    if(!(is >> mPhyAtkPerLvl))
+        return false;
+    if(!(is >> mMagAtk))
+        return false;
+    if(!(is >> mMagAtkPerLvl))
+        return false;
+    if(!(is >> mEleAtk))
+        return false;
+    if(!(is >> mEleAtkPerLvl))
+        return false;
+
+    return true;
+}
+
 bool CreatureSkillMissileLaunch::isEqual(const CreatureSkill& creatureSkill) const
 {
     if(!CreatureSkill::isEqual(creatureSkill))
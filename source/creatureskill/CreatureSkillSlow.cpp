@@ -23,6 +23,7 @@
 #include "entities/GameEntityType.h"
 #include "entities/Tile.h"
 #include "gamemap/GameMap.h"
+#include "network/ODPacket.h"
 #include "spells/Spell.h"
 #include "utils/LogManager.h"
 
@@ -124,6 +125,32 @@ bool CreatureSkillSlow::importFromStream(std::istream& is)
     return true;
 }
 
+void CreatureSkillSlow::exportToPacket(ODPacket& os) const
+{
+    CreatureSkill::exportToPacket(os);
+    os << mMaxRange;
+    os << mCreatureLevelMin;
+    os << mEffectDuration;
+    os << mEffectValue;
+}
+
+bool CreatureSkillSlow::importFromPacket(ODPacket& is)
+{
+    if(!CreatureSkill::importFromPacket(is))
+        return false;
+
+    if(!(is >> mMaxRange))
+        return false;
+    if(!(is >> mCreatureLevelMin))
+        return false;
+    if(!(is >> mEffectDuration))
+        return false;
+    if(!(is >> mEffectValue))
+        return false;
+
+    return true;
+}
+
 bool CreatureSkillSlow::isEqual(const CreatureSkill& creatureSkill) const
 {
     if(!CreatureSkill::isEqual(creatureSkill))
@@ -23,6 +23,7 @@
 #include "entities/Creature.h"
 #include "entities/Tile.h"
 #include "gamemap/GameMap.h"
+#include "network/ODPacket.h"
 #include "spells/Spell.h"
 
 #include <istream>
@@ -114,6 +115,29 @@ bool CreatureSkillStrengthSelf::importFromStream(std::istream& is)
     return true;
 }
 
+void CreatureSkillStrengthSelf::exportToPacket(ODPacket& os) const
+{
+    CreatureSkill::exportToPacket(os);
+    os << mCreatureLevelMin;
+    os << mEffectDuration;
+    os << mEffectValue;
+}
+
+bool CreatureSkillStrengthSelf::importFromPacket(ODPacket& is)
+{
+    if(!CreatureSkill::importFromPacket(is))
+        return false;
+
+    if(!(is >> mCreatureLevelMin))
+        return false;
+    if(!(is >> mEffectDuration))
+        return false;
+    if(!(is >> mEffectValue))
+        return false;
+
+    return true;
+}
+
 bool CreatureSkillStrengthSelf::isEqual(const CreatureSkill& creatureSkill) const
 {
     if(!CreatureSkill::isEqual(creatureSkill))
@@ -107,7 +107,7 @@ void ChickenEntity::doUpkeep()
     if(mIsSlapped || (mNbTurnOutsideHatchery >= NB_TURNS_OUTSIDE_HATCHERY_BEFORE_DIE))
     {
         mChickenState = ChickenState::dying;
-        clearDestinations(EntityAnimation::die_anim, false, false);
+        clearDestinations(EntityAnimation::die, false, false);
         return;
     }
 
@@ -118,7 +118,7 @@ void ChickenEntity::doUpkeep()
     // We might not move
     if(Random::Int(1,2) == 1)
     {
-        setAnimationState("Pick");
+        setAnimationState(EntityAnimation::pick);
         return;
     }
 
@@ -141,7 +141,7 @@ void ChickenEntity::doUpkeep()
     Ogre::Vector3 v (static_cast<Ogre::Real>(tileDest->getX()), static_cast<Ogre::Real>(tileDest->getY()), 0.0);
     std::vector<Ogre::Vector3> path;
     path.push_back(v);
-    setWalkPath(EntityAnimation::walk_anim, EntityAnimation::idle_anim, true, true, path);
+    setWalkPath(EntityAnimation::walk, EntityAnimation::idle, true, true, path);
 }
 
 void ChickenEntity::addTileToListIfPossible(int x, int y, Room* currentHatchery, std::vector<Tile*>& possibleTileMove)
@@ -260,7 +260,7 @@ bool ChickenEntity::eatChicken(Creature* creature)
 
     removeEntityFromPositionTile();
     mChickenState = ChickenState::eaten;
-    clearDestinations(EntityAnimation::idle_anim, true, true);
+    clearDestinations(EntityAnimation::idle, true, true);
     return true;
 }
 
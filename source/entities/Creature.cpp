@@ -61,7 +61,6 @@
 #include "network/ODClient.h"
 #include "network/ODServer.h"
 #include "network/ServerNotification.h"
-#include "render/CreatureOverlayStatus.h"
 #include "render/RenderManager.h"
 #include "rooms/RoomCrypt.h"
 #include "rooms/RoomDormitory.h"
@@ -134,6 +133,8 @@ Creature::Creature(GameMap* gameMap, const CreatureDefinition* definition, Seat*
     mModifierStrength        (1.0),
     mWeaponL                 (nullptr),
     mWeaponR                 (nullptr),
+    mWeaponEntityL           (nullptr),
+    mWeaponEntityR           (nullptr),
     mHomeTile                (nullptr),
     mDefinition              (definition),
     mHasVisualDebuggingEntities (false),
@@ -171,7 +172,10 @@ Creature::Creature(GameMap* gameMap, const CreatureDefinition* definition, Seat*
     mSeatPrison              (nullptr),
     mNbTurnsTorture          (0),
     mNbTurnsPrison           (0),
-    mActiveSlapsCount        (0)
+    mActiveSlapsCount        (0),
+    mIsCountedInGameMap      (false),
+    mSeatCreaturesCounted    (nullptr),
+    mAreUpkeepSensesComputed (false)
 
 {
     //TODO: This should be set in initialiser list in parent classes
@@ -179,6 +183,7 @@ Creature::Creature(GameMap* gameMap, const CreatureDefinition* definition, Seat*
     mPosition = position;
     setMeshName(definition->getMeshName());
     setName(getGameMap()->nextUniqueNameCreature(definition->getClassName()));
+    initRandomGenerator();
 
     mMaxHP = mDefinition->getMinHp();
     setHP(mMaxHP);
@@ -212,6 +217,8 @@ Creature::Creature(GameMap* gameMap) :
     mModifierStrength        (1.0),
     mWeaponL                 (nullptr),
     mWeaponR                 (nullptr),
+    mWeaponEntityL           (nullptr),
+    mWeaponEntityR           (nullptr),
     mHomeTile                (nullptr),
     mDefinition              (nullptr),
     mHasVisualDebuggingEntities (false),
@@ -249,7 +256,10 @@ Creature::Creature(GameMap* gameMap) :
     mSeatPrison              (nullptr),
     mNbTurnsTorture          (0),
     mNbTurnsPrison           (0),
-    mActiveSlapsCount        (0)
+    mActiveSlapsCount        (0),
+    mIsCountedInGameMap      (false),
+    mSeatCreaturesCounted    (nullptr),
+    mAreUpkeepSensesComputed (false)
 {
 }
 
@@ -265,7 +275,7 @@ void Creature::createMeshLocal()
         RenderManager::getSingleton().rrCreateCreature(this);
 
         // By default, we set the creature in idle state
-        RenderManager::getSingleton().rrSetObjectAnimationState(this, EntityAnimation::idle_anim, true);
+        RenderManager::getSingleton().rrSetObjectAnimationState(this, EntityAnimation::idle, true);
     }
 
     createMeshWeapons();
@@ -288,10 +298,10 @@ void Creature::createMeshWeapons()
         return;
 
     if(mWeaponL != nullptr)
-        RenderManager::getSingleton().rrCreateWeapon(this, mWeaponL, "L");
+        mWeaponEntityL = RenderManager::getSingleton().rrCreateWeapon(this, mWeaponL, "L");
 
     if(mWeaponR != nullptr)
-        RenderManager::getSingleton().rrCreateWeapon(this, mWeaponR, "R");
+        mWeaponEntityR = RenderManager::getSingleton().rrCreateWeapon(this, mWeaponR, "R");
 }
 
 void Creature::destroyMeshWeapons()
@@ -299,11 +309,17 @@ void Creature::destroyMeshWeapons()
     if(getIsOnServerMap())
         return;
 
-    if(mWeaponL != nullptr)
-        RenderManager::getSingleton().rrDestroyWeapon(this, mWeaponL, "L");
+    if(mWeaponEntityL != nullptr)
+    {
+        RenderManager::getSingleton().rrDestroyWeapon(mWeaponEntityL);
+        mWeaponEntityL = nullptr;
+    }
 
-    if(mWeaponR != nullptr)
-        RenderManager::getSingleton().rrDestroyWeapon(this, mWeaponR, "R");
+    if(mWeaponEntityR != nullptr)
+    {
+        RenderManager::getSingleton().rrDestroyWeapon(mWeaponEntityR);
+        mWeaponEntityR = nullptr;
+    }
 }
 
 GameEntityType Creature::getObjectType() const
@@ -321,6 +337,8 @@ void Creature::addToGameMap()
         return;
 
     getGameMap()->addActiveObject(this);
+    mIsCountedInGameMap = true;
+    updateSeatCreaturesCounters();
 }
 
 void Creature::removeFromGameMap()
@@ -343,6 +361,21 @@ void Creature::removeFromGameMap()
 
     fireRemoveEntityToSeatsWithVision();
     getGameMap()->removeActiveObject(this);
+    mIsCountedInGameMap = false;
+    updateSeatCreaturesCounters();
+}
+
+void Creature::initRandomGenerator()
+{
+    if(getGameMap()->restoreRandomGenerator(getRandomStateKey(), mRandom))
+        return;
+
+    mRandom.seed(Random::deriveSeed(RandomStream::creature, getName()));
+}
+
+std::string Creature::getRandomStateKey() const
+{
+    return Random::getStateKey(RandomStream::creature, getName());
 }
 
 std::string Creature::getCreatureStreamFormat()
@@ -636,6 +669,8 @@ void Creature::setHP(double nHP)
     else
         mHp = nHP;
 
+    // The creature may have died or been revived
+    updateSeatCreaturesCounters();
     computeCreatureOverlayHealthValue();
 }
 
@@ -643,6 +678,7 @@ void Creature::heal(double hp)
 {
     mHp = std::min(mHp + hp, mMaxHP);
 
+    updateSeatCreaturesCounters();
     computeCreatureOverlayHealthValue();
 }
 
@@ -668,11 +704,6 @@ void Creature::update(Ogre::Real timeSinceLastFrame)
     {
         computeVisualDebugEntities();
     }
-
-    if(getOverlayStatus() != nullptr)
-    {
-        getOverlayStatus()->update(timeSinceLastFrame);
-    }
 }
 
 void Creature::computeVisibleTiles()
@@ -713,7 +744,7 @@ void Creature::dropCarriedEquipment()
 {
     fireCreatureSound(CreatureSound::Die);
     clearActionQueue();
-    clearDestinations(EntityAnimation::die_anim, false, false);
+    clearDestinations(EntityAnimation::die, false, false);
 
     // We drop what we are carrying
     Tile* myTile = getPositionTile();
@@ -749,8 +780,57 @@ void Creature::dropCarriedEquipment()
     // TODO: drop weapon when available
 }
 
+void Creature::computeUpkeepSenses()
+{
+    mAreUpkeepSensesComputed = false;
+
+    // We only compute if doUpkeep will use them
+    if(!getIsOnMap() || !isAlive() || (mKoTurnCounter != 0) || (mSeatPrison != nullptr))
+        return;
+
+    if(getPositionTile() == nullptr)
+        return;
+
+    mVisibleEnemyObjects         = getVisibleEnemyObjects();
+    mVisibleAlliedObjects        = getVisibleAlliedObjects();
+    mReachableAlliedObjects      = getReachableAttackableObjects(mVisibleAlliedObjects);
+    mAreUpkeepSensesComputed = true;
+}
+
+bool Creature::isSensedEntityStillValid(GameEntity* entity, bool enemyForce) const
+{
+    if(!entity->getIsOnMap())
+        return false;
+
+    if(entity->getSeat() == nullptr)
+        return false;
+
+    if(getSeat()->isAlliedSeat(entity->getSeat()) == enemyForce)
+        return false;
+
+    // Buildings are removed from the gamemap when destroyed. Their attackable state depends on
+    // the tile and is checked when attacking
+    if(entity->getObjectType() != GameEntityType::creature)
+        return true;
+
+    const Creature* creature = static_cast<const Creature*>(entity);
+    if(!creature->isAlive())
+        return false;
+
+    if(enemyForce && !creature->isAttackable(creature->getPositionTile(), getSeat()))
+        return false;
+
+    return true;
+}
+
 void Creature::doUpkeep()
 {
+    // If an entity was spawned or built since the senses were computed, we compute them again
+    // so that it is sensed like it would have been without the parallel senses
+    bool areSensesComputed = mAreUpkeepSensesComputed &&
+        !getGameMap()->isEntityAddedSinceCreaturesSenses();
+    mAreUpkeepSensesComputed = false;
+
     // If the creature is in jail, we check if it is still standing on it (if not picked up). If
     // not, it is free
     if((mSeatPrison != nullptr) &&
@@ -825,7 +905,9 @@ void Creature::doUpkeep()
         if(mKoTurnCounter < 0)
             return;
 
+        // The KO was to death
         mHp = 0;
+        updateSeatCreaturesCounters();
         computeCreatureOverlayHealthValue();
         computeCreatureOverlayMoodValue();
     }
@@ -896,9 +978,29 @@ void Creature::doUpkeep()
         increaseHunger(mDefinition->getHungerGrowthPerTurn());
     }
 
-    mVisibleEnemyObjects         = getVisibleEnemyObjects();
-    mVisibleAlliedObjects        = getVisibleAlliedObjects();
-    mReachableAlliedObjects      = getReachableAttackableObjects(mVisibleAlliedObjects);
+    if(areSensesComputed)
+    {
+        // The senses were computed before the upkeep of the other entities. Some of
+        // the objects may have been removed, killed or converted since
+        auto isNotEnemy = [this](GameEntity* entity) { return !isSensedEntityStillValid(entity, true); };
+        auto isNotAlly = [this](GameEntity* entity) { return !isSensedEntityStillValid(entity, false); };
+        auto isNotReachableAlly = [this](GameEntity* entity)
+        {
+            return (entity->getHP(nullptr) <= 0) || !isSensedEntityStillValid(entity, false);
+        };
+        mVisibleEnemyObjects.erase(std::remove_if(mVisibleEnemyObjects.begin(),
+            mVisibleEnemyObjects.end(), isNotEnemy), mVisibleEnemyObjects.end());
+        mVisibleAlliedObjects.erase(std::remove_if(mVisibleAlliedObjects.begin(),
+            mVisibleAlliedObjects.end(), isNotAlly), mVisibleAlliedObjects.end());
+        mReachableAlliedObjects.erase(std::remove_if(mReachableAlliedObjects.begin(),
+            mReachableAlliedObjects.end(), isNotReachableAlly), mReachableAlliedObjects.end());
+    }
+    else
+    {
+        mVisibleEnemyObjects         = getVisibleEnemyObjects();
+        mVisibleAlliedObjects        = getVisibleAlliedObjects();
+        mReachableAlliedObjects      = getReachableAttackableObjects(mVisibleAlliedObjects);
+    }
 
     // Check if we should compute mood
     if(mMoodCooldownTurns > 0)
@@ -910,7 +1012,7 @@ void Creature::doUpkeep()
     {
         computeMood();
         computeCreatureOverlayMoodValue();
-        mMoodCooldownTurns = Random::Int(0, 5);
+        mMoodCooldownTurns = mRandom.Int(0, 5);
     }
 
     if(mMoodValue < CreatureMoodLevel::Furious)
@@ -1025,7 +1127,7 @@ void Creature::decidePrioritaryAction()
 
 bool Creature::handleIdleAction()
 {
-    setAnimationState(EntityAnimation::idle_anim);
+    setAnimationState(EntityAnimation::idle);
 
     if (mDefinition->isWorker())
     {
@@ -1089,7 +1191,7 @@ bool Creature::handleIdleAction()
         if(!reachableCallToWars.empty())
         {
             // We go there
-            uint32_t index = Random::Uint(0,reachableCallToWars.size()-1);
+            uint32_t index = mRandom.Uint(0,reachableCallToWars.size()-1);
             Spell* callToWar = reachableCallToWars[index];
             Tile* callToWarTile = callToWar->getPositionTile();
             std::list<Tile*> tempPath = getGameMap()->path(this, callToWarTile);
@@ -1098,7 +1200,7 @@ bool Creature::handleIdleAction()
             {
                 std::vector<Ogre::Vector3> path;
                 tileToVector3(tempPath, path, true, 0.0);
-                setWalkPath(EntityAnimation::walk_anim, EntityAnimation::idle_anim, true, true, path);
+                setWalkPath(EntityAnimation::walk, EntityAnimation::idle, true, true, path);
                 pushAction(Utils::make_unique<CreatureActionGoCallToWar>(*this));
                 return false;
             }
@@ -1110,7 +1212,7 @@ bool Creature::handleIdleAction()
     if (!mDefinition->isWorker() &&
         !hasActionBeenTried(CreatureActionType::findHome) &&
         (mHomeTile == nullptr) &&
-        (Random::Double(0.0, 1.0) < 0.5))
+        (mRandom.Double(0.0, 1.0) < 0.5))
     {
         pushAction(Utils::make_unique<CreatureActionFindHome>(*this, false));
         return true;
@@ -1120,7 +1222,7 @@ bool Creature::handleIdleAction()
     if (!mDefinition->isWorker() &&
         !hasActionBeenTried(CreatureActionType::sleep) &&
         (mHomeTile != nullptr) &&
-        (Random::Double(20.0, 30.0) > mWakefulness))
+        (mRandom.Double(20.0, 30.0) > mWakefulness))
     {
         pushAction(Utils::make_unique<CreatureActionSleep>(*this));
         return true;
@@ -1129,7 +1231,7 @@ bool Creature::handleIdleAction()
     // If we are hungry, we go to eat
     if (!mDefinition->isWorker() &&
         !hasActionBeenTried(CreatureActionType::searchFood) &&
-        (Random::Double(70.0, 80.0) < mHunger))
+        (mRandom.Double(70.0, 80.0) < mHunger))
     {
         pushAction(Utils::make_unique<CreatureActionSearchFood>(*this, false));
         return true;
@@ -1140,7 +1242,7 @@ bool Creature::handleIdleAction()
     // creatures more likely to steal gold than others
     if (!mDefinition->isWorker() &&
         !hasActionBeenTried(CreatureActionType::stealFreeGold) &&
-        (Random::Uint(0, 10) > 8))
+        (mRandom.Uint(0, 10) > 8))
     {
         pushAction(Utils::make_unique<CreatureActionStealFreeGold>(*this));
         return true;
@@ -1149,7 +1251,7 @@ bool Creature::handleIdleAction()
     // Otherwise, we try to work
     if (!mDefinition->isWorker() &&
         !hasActionBeenTried(CreatureActionType::searchJob) &&
-        (Random::Double(0.0, 1.0) < 0.4))
+        (mRandom.Double(0.0, 1.0) < 0.4))
     {
         pushAction(Utils::make_unique<CreatureActionSearchJob>(*this, false));
         return true;
@@ -1172,7 +1274,7 @@ bool Creature::handleIdleAction()
         // Non-workers only.
 
         // Check to see if we want to try to follow a worker around or if we want to try to explore.
-        double r = Random::Double(0.0, 1.0);
+        double r = mRandom.Double(0.0, 1.0);
         if (r < 0.7)
         {
             bool workerFound = false;
@@ -1189,18 +1291,18 @@ bool Creature::handleIdleAction()
                     {
                         // Worker is digging, get near it since it could expose enemies.
                         int x = static_cast<int>(static_cast<double>(tempTile->getX()) + 3.0
-                                * Random::gaussianRandomDouble());
+                                * mRandom.gaussianRandomDouble());
                         int y = static_cast<int>(static_cast<double>(tempTile->getY()) + 3.0
-                                * Random::gaussianRandomDouble());
+                                * mRandom.gaussianRandomDouble());
                         tileDest = getGameMap()->getTile(x, y);
                     }
                     else
                     {
                         // Worker is not digging, wander a bit farther around the worker.
                         int x = static_cast<int>(static_cast<double>(tempTile->getX()) + 8.0
-                                * Random::gaussianRandomDouble());
+                                * mRandom.gaussianRandomDouble());
                         int y = static_cast<int>(static_cast<double>(tempTile->getY()) + 8.0
-                                * Random::gaussianRandomDouble());
+                                * mRandom.gaussianRandomDouble());
                         tileDest = getGameMap()->getTile(x, y);
                     }
                     workerFound = true;
@@ -1211,7 +1313,7 @@ bool Creature::handleIdleAction()
                 {
                     if (!reachableTiles.empty())
                     {
-                        tileDest = reachableTiles[static_cast<unsigned int>(Random::Double(0.6, 0.8)
+                        tileDest = reachableTiles[static_cast<unsigned int>(mRandom.Double(0.6, 0.8)
                                                                            * (reachableTiles.size() - 1))];
                     }
                 }
@@ -1223,7 +1325,7 @@ bool Creature::handleIdleAction()
             if (!reachableTiles.empty())
             {
                 unsigned int tileIndex = static_cast<unsigned int>(reachableTiles.size()
-                                                                   * Random::Double(0.1, 0.3));
+                                                                   * mRandom.Double(0.1, 0.3));
                 tileDest = reachableTiles[tileIndex];
             }
         }
@@ -1235,7 +1337,7 @@ bool Creature::handleIdleAction()
         // Choose a tile far away from our current position to wander to.
         if (!reachableTiles.empty())
         {
-            tileDest = reachableTiles[Random::Uint(reachableTiles.size() / 2,
+            tileDest = reachableTiles[mRandom.Uint(reachableTiles.size() / 2,
                                                    reachableTiles.size() - 1)];
         }
     }
@@ -1979,6 +2081,8 @@ double Creature::takeDamage(GameEntity* attacker, double absoluteDamage, double
             OD_LOG_INF("creature=" + getName() + " has been KO by " + attacker->getName());
             dropCarriedEquipment();
         }
+        else
+            updateSeatCreaturesCounters();
     }
 
     computeCreatureOverlayHealthValue();
@@ -2034,7 +2138,7 @@ void Creature::useAttack(CreatureSkillData& skillData, GameEntity& entityAttack,
     const Ogre::Vector3& pos = getPosition();
     Ogre::Vector3 walkDirection(tileAttack.getX() - pos.x, tileAttack.getY() - pos.y, 0);
     walkDirection.normalise();
-    setAnimationState(EntityAnimation::attack_anim, false, walkDirection, true);
+    setAnimationState(EntityAnimation::attack, false, walkDirection, true);
     fireCreatureSound(CreatureSound::Attack);
     setNbTurnsWithoutBattle(0);
 
@@ -2125,7 +2229,7 @@ void Creature::pickup()
 {
     // Stop the creature walking and set it off the map to prevent the AI from running on it.
     removeEntityFromPositionTile();
-    clearDestinations(EntityAnimation::idle_anim, true, true);
+    clearDestinations(EntityAnimation::idle, true, true);
     clearActionQueue();
 
     if(!getIsOnServerMap())
@@ -2218,7 +2322,7 @@ void Creature::drop(const Ogre::Vector3& v)
             {
                 // Check if there is room for digging
                 std::vector<Tile*> tiles;
-                tile->canWorkerDig(*this, tiles);
+                seat->getWorkerJobBoard().getFreeDigSpots(*this, *tile, tiles);
                 // We search for the closest neighbor tile (may be not the position
                 // tile if the player drops several workers at the same tile)
                 float distBest = -1;
@@ -2345,12 +2449,12 @@ bool Creature::setDestination(Tile* tile)
 
     std::vector<Ogre::Vector3> path;
     tileToVector3(result, path, true, 0.0);
-    setWalkPath(EntityAnimation::walk_anim, EntityAnimation::idle_anim, true, true, path);
+    setWalkPath(EntityAnimation::walk, EntityAnimation::idle, true, true, path);
     pushAction(Utils::make_unique<CreatureActionWalkToTile>(*this));
     return true;
 }
 
-bool Creature::wanderRandomly(const std::string& animationState)
+bool Creature::wanderRandomly(EntityAnimation animationState)
 {
     // We pick randomly a visible tile far away (at the end of visible tiles)
     if(mTilesWithinSightRadius.empty())
@@ -2367,7 +2471,7 @@ bool Creature::wanderRandomly(const std::string& animationState)
     if (reachableTiles.empty())
         return false;
 
-    Tile* tileDestination = reachableTiles[Random::Uint(0, reachableTiles.size() - 1)];
+    Tile* tileDestination = reachableTiles[mRandom.Uint(0, reachableTiles.size() - 1)];
     setDestination(tileDestination);
     return false;
 }
@@ -2516,6 +2620,7 @@ void Creature::slap()
         ConfigManager::getSingleton().getSlapEffectDuration(), "");
     addCreatureEffect(effect);
     mHp -= mMaxHP * ConfigManager::getSingleton().getSlapDamagePercent() / 100.0;
+    updateSeatCreaturesCounters();
     computeCreatureOverlayHealthValue();
 }
 
@@ -2764,6 +2869,7 @@ void Creature::setupDefinition(GameMap& gameMap, const CreatureDefinition& defau
         else
             mHp = Helper::toDouble(mHpString);
 
+        updateSeatCreaturesCounters();
         computeCreatureOverlayHealthValue();
     }
 }
@@ -3034,7 +3140,7 @@ void Creature::checkWalkPathValid()
         return;
 
     // There is an unpassable tile in our way. We stop what we are doing
-    clearDestinations(EntityAnimation::idle_anim, true, true);
+    clearDestinations(EntityAnimation::idle, true, true);
 }
 
 void Creature::setJobCooldown(int val)
@@ -3181,7 +3287,7 @@ bool Creature::isWarmup() const
 
 void Creature::fight()
 {
-    clearDestinations(EntityAnimation::idle_anim, true, true);
+    clearDestinations(EntityAnimation::idle, true, true);
     clearActionQueue();
     bool ko = getSeat()->getKoCreatures();
     pushAction(Utils::make_unique<CreatureActionFight>(*this, nullptr, ko, true));
@@ -3189,28 +3295,28 @@ void Creature::fight()
 
 void Creature::fightCreature(Creature& creature, bool ko, bool notifyPlayerIfHit)
 {
-    clearDestinations(EntityAnimation::idle_anim, true, true);
+    clearDestinations(EntityAnimation::idle, true, true);
     clearActionQueue();
     pushAction(Utils::make_unique<CreatureActionFight>(*this, &creature, ko, notifyPlayerIfHit));
 }
 
 void Creature::flee()
 {
-    clearDestinations(EntityAnimation::idle_anim, true, true);
+    clearDestinations(EntityAnimation::idle, true, true);
     clearActionQueue();
     pushAction(Utils::make_unique<CreatureActionFlee>(*this));
 }
 
 void Creature::sleep()
 {
-    clearDestinations(EntityAnimation::idle_anim, true, true);
+    clearDestinations(EntityAnimation::idle, true, true);
     clearActionQueue();
     pushAction(Utils::make_unique<CreatureActionSleep>(*this));
 }
 
 void Creature::leaveDungeon()
 {
-    clearDestinations(EntityAnimation::idle_anim, true, true);
+    clearDestinations(EntityAnimation::idle, true, true);
     clearActionQueue();
     pushAction(Utils::make_unique<CreatureActionLeaveDungeon>(*this));
 }
@@ -3220,6 +3326,9 @@ void Creature::changeSeat(Seat* newSeat)
     OD_LOG_INF("creature=" + getName() + " changes side from seatId=" + Helper::toString(getSeat()->getId()) + " to seatId=" + Helper::toString(newSeat->getId()));
     OD_ASSERT_TRUE_MSG(getSeat() != newSeat, "creature=" + getName() + ", seatId=" + Helper::toString(newSeat->getId()));
     setSeat(newSeat);
+    updateSeatCreaturesCounters();
+    // The senses computed for this turn were for the previous seat
+    mAreUpkeepSensesComputed = false;
     mMoodValue = CreatureMoodLevel::Neutral;
     mMoodPoints = 0;
     mWakefulness = 100;
@@ -3227,7 +3336,7 @@ void Creature::changeSeat(Seat* newSeat)
     mNbTurnsTorture = 0;
     mNbTurnsPrison = 0;
     mActiveSlapsCount = 0;
-    clearDestinations(EntityAnimation::idle_anim, true, true);
+    clearDestinations(EntityAnimation::idle, true, true);
     clearActionQueue();
     mNeedFireRefresh = true;
     if (getHomeTile() != nullptr)
@@ -3236,3 +3345,24 @@ void Creature::changeSeat(Seat* newSeat)
         home->releaseTileForSleeping(getHomeTile(), this);
     }
 }
+
+void Creature::updateSeatCreaturesCounters()
+{
+    if(!getIsOnServerMap())
+        return;
+
+    if(mDefinition == nullptr)
+        return;
+
+    Seat* seat = (mIsCountedInGameMap && isAlive()) ? getSeat() : nullptr;
+    if(seat == mSeatCreaturesCounted)
+        return;
+
+    if(mSeatCreaturesCounted != nullptr)
+        mSeatCreaturesCounted->updateCreaturesCounters(mDefinition->isWorker(), -1);
+
+    if(seat != nullptr)
+        seat->updateCreaturesCounters(mDefinition->isWorker(), 1);
+
+    mSeatCreaturesCounted = seat;
+}
@@ -22,6 +22,7 @@
 #define CREATURE_H
 
 #include "entities/MovableGameEntity.h"
+#include "utils/Random.h"
 
 #include <OgreVector2.h>
 #include <OgreVector3.h>
@@ -53,6 +54,7 @@ class Window;
 
 namespace Ogre
 {
+class Entity;
 class ParticleSystem;
 }
 
@@ -207,7 +209,7 @@ public:
     //! \brief Picks a destination far away in the visible tiles and goes there
     //! Returns true if a valid Tile was found. The creature will go there
     //! Returns false if no reachable Tile was found
-    bool wanderRandomly(const std::string& animationState);
+    bool wanderRandomly(EntityAnimation animationState);
 
     void setHP(double nHP);
 
@@ -249,6 +251,13 @@ public:
      */
     void doUpkeep() override;
 
+    //! \brief First part of the creature upkeep. Computes the visible enemies and allies that
+    //! will be used by doUpkeep. It only reads the gamemap so it can be called for every creature
+    //! in parallel before calling doUpkeep on them. Entities moving after that are sensed at their
+    //! previous position until the next turn. If an entity is added after that, doUpkeep computes
+    //! the senses again.
+    void computeUpkeepSenses();
+
     //! \brief Computes the visible tiles and tags them to know which are visible
     void computeVisibleTiles();
 
@@ -326,6 +335,20 @@ public:
     inline void setOverlayStatus(CreatureOverlayStatus* overlayStatus)
     { mOverlayStatus = overlayStatus; }
 
+    //! \brief Random generator used by the creature decisions (and the actions it runs). Used on server side only
+    inline RandomGenerator& getRandomGenerator()
+    { return mRandom; }
+
+    inline const RandomGenerator& getRandomGenerator() const
+    { return mRandom; }
+
+    //! \brief Seeds the random generator from the match seed and the creature name. If the level is a
+    //! saved game, the generator continues from its saved state
+    void initRandomGenerator();
+
+    //! \brief Key under which the state of the random generator is saved (see Random::getStateKey)
+    std::string getRandomStateKey() const;
+
     //! \brief Get the text format of creatures in level files (already spawned at startup).
     //! \returns A string describing the IO format the creatures need to have in file.
     static std::string getCreatureStreamFormat();
@@ -630,6 +653,10 @@ private:
     //! managed by the game map and thus, should not be deleted by the creature class
     const Weapon* mWeaponR;
 
+    //! \brief Client side only. Weapon entities attached to the creature mesh (nullptr if none)
+    Ogre::Entity* mWeaponEntityL;
+    Ogre::Entity* mWeaponEntityR;
+
     //! \brief The creatures home tile (where its bed is located)
     Tile *mHomeTile;
 
@@ -761,6 +788,27 @@ private:
     //! \brief Skills the creature can use
     std::vector<CreatureSkillData> mSkillData;
 
+    //! \brief true while the creature is on the server gamemap (between addToGameMap and removeFromGameMap)
+    bool                            mIsCountedInGameMap;
+
+    //! \brief The seat whose creature counters currently include this creature. Used on server side only
+    Seat*                           mSeatCreaturesCounted;
+
+    //! \brief Updates the creature counters of the seats if the creature seat or alive state changed
+    void updateSeatCreaturesCounters();
+
+    //! \brief true if computeUpkeepSenses has been called for the current upkeep
+    bool                            mAreUpkeepSensesComputed;
+
+    //! \brief Random generator of the creature. It is derived from the match seed and the creature name so
+    //! that the creature decisions do not depend on the other creatures
+    RandomGenerator                 mRandom;
+
+    //! \brief Returns true if the given entity sensed by computeUpkeepSenses is still a visible enemy (if
+    //! enemyForce is true) or ally of this creature. It uses the same conditions as GameMap::getVisibleForce
+    //! because the entity may have been killed, knocked out or converted since the senses were computed
+    bool isSensedEntityStillValid(GameEntity* entity, bool enemyForce) const;
+
     //! \brief A sub-function called by doTurn()
     //! This one checks if there is something prioritary to do (like fighting). If it is the case,
     //! it should empty the action list before adding what to do.
@@ -349,6 +349,93 @@ ODPacket& operator>>(ODPacket& is, CreatureDefinition* c)
     return is;
 }
 
+void CreatureDefinition::exportToPacketCache(ODPacket& os) const
+{
+    // The client data already contains the XP table
+    os << this;
+    os << mBaseDefinition;
+
+    uint32_t nb = mCreatureSkills.size();
+    os << nb;
+    for(const CreatureSkill* skill : mCreatureSkills)
+        CreatureSkillManager::writeToPacket(*skill, os);
+
+    nb = mCreatureBehaviours.size();
+    os << nb;
+    for(const CreatureBehaviour* behaviour : mCreatureBehaviours)
+        CreatureBehaviourManager::writeToPacket(*behaviour, os);
+
+    nb = mCreatureMoods.size();
+    os << nb;
+    for(const CreatureMood* mood : mCreatureMoods)
+        CreatureMoodManager::writeToPacket(*mood, os);
+
+    nb = mRoomAffinity.size();
+    os << nb;
+    for(const CreatureRoomAffinity& affinity : mRoomAffinity)
+        os << affinity.getRoomType() << affinity.getLikeness() << affinity.getEfficiency();
+}
+
+CreatureDefinition* CreatureDefinition::loadFromPacketCache(ODPacket& is)
+{
+    CreatureDefinition* creatureDef = new CreatureDefinition();
+    is >> creatureDef;
+    is >> creatureDef->mBaseDefinition;
+
+    // The added elements are owned by the definition so they will be released if it is deleted
+    uint32_t nb;
+    bool isOk = (is >> nb);
+    while(isOk && (nb > 0))
+    {
+        --nb;
+        CreatureSkill* skill = CreatureSkillManager::loadFromPacket(is);
+        isOk = (skill != nullptr);
+        if(isOk)
+            creatureDef->mCreatureSkills.push_back(skill);
+    }
+
+    isOk = isOk && (is >> nb);
+    while(isOk && (nb > 0))
+    {
+        --nb;
+        CreatureBehaviour* behaviour = CreatureBehaviourManager::loadFromPacket(is);
+        isOk = (behaviour != nullptr);
+        if(isOk)
+            creatureDef->mCreatureBehaviours.push_back(behaviour);
+    }
+
+    isOk = isOk && (is >> nb);
+    while(isOk && (nb > 0))
+    {
+        --nb;
+        CreatureMood* mood = CreatureMoodManager::loadFromPacket(is);
+        isOk = (mood != nullptr);
+        if(isOk)
+            creatureDef->mCreatureMoods.push_back(mood);
+    }
+
+    isOk = isOk && (is >> nb);
+    while(isOk && (nb > 0))
+    {
+        --nb;
+        RoomType roomType;
+        int32_t likeness;
+        double efficiency;
+        isOk = (is >> roomType >> likeness >> efficiency);
+        if(isOk)
+            creatureDef->mRoomAffinity.push_back(CreatureRoomAffinity(roomType, likeness, efficiency));
+    }
+
+    if(!isOk || !is)
+    {
+        OD_LOG_ERR("Invalid cached creature definition class=" + creatureDef->mClassName);
+        delete creatureDef;
+        return nullptr;
+    }
+
+    return creatureDef;
+}
+
 CreatureDefinition* CreatureDefinition::load(std::stringstream& defFile, const std::map<std::string, CreatureDefinition*>& defMap)
 {
     if (!defFile.good())
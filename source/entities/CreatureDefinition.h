@@ -142,6 +142,12 @@ public:
     static CreatureDefinition* load(std::stringstream& defFile, const std::map<std::string, CreatureDefinition*>& defMap);
     static bool update(CreatureDefinition* creatureDef, std::stringstream& defFile, const std::map<std::string, CreatureDefinition*>& defMap);
 
+    //! \brief Writes the whole definition for the binary configuration cache. Unlike operator <<, that
+    //! only sends what the clients need, it also writes the skills, behaviours, moods and room affinities
+    void exportToPacketCache(ODPacket& os) const;
+    //! \brief Reads a definition written by exportToPacketCache. Returns nullptr if the data is invalid
+    static CreatureDefinition* loadFromPacketCache(ODPacket& is);
+
     inline CreatureJob          getCreatureJob  () const    { return mCreatureJob; }
     inline const std::string&   getClassName    () const    { return mClassName; }
 
@@ -31,7 +31,7 @@
 
 DoorEntity::DoorEntity(GameMap* gameMap, Building& building, const std::string& meshName,
         Tile* tile, Ogre::Real rotationAngle, bool hideCoveredTile, float opacity,
-        const std::string& initialAnimationState, bool initialAnimationLoop) :
+        EntityAnimation initialAnimationState, bool initialAnimationLoop) :
     TrapEntity(
         gameMap,
         building,
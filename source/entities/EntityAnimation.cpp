@@ -0,0 +1,65 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "entities/EntityAnimation.h"
+
+#include "network/ODPacket.h"
+
+//! \brief Indexed by EntityAnimation
+static const std::string ANIMATION_NAMES[] =
+{
+    "",
+    "Idle",
+    "Flee",
+    "Die",
+    "Dig",
+    "Attack1",
+    "Claim",
+    "Walk",
+    "Sleep",
+    "Pick",
+    "Triggered",
+    "Open",
+    "Close",
+    "Loop"
+};
+static_assert(sizeof(ANIMATION_NAMES) / sizeof(ANIMATION_NAMES[0]) == static_cast<uint32_t>(EntityAnimation::nbAnimations),
+    "Every animation should have a name");
+
+const std::string& entityAnimationToString(EntityAnimation animation)
+{
+    uint32_t index = static_cast<uint32_t>(animation);
+    if(index >= static_cast<uint32_t>(EntityAnimation::nbAnimations))
+        return ANIMATION_NAMES[0];
+
+    return ANIMATION_NAMES[index];
+}
+
+ODPacket& operator>>(ODPacket& is, EntityAnimation& animation)
+{
+    uint8_t tmp;
+    is >> tmp;
+    animation = static_cast<EntityAnimation>(tmp);
+    return is;
+}
+
+ODPacket& operator<<(ODPacket& os, const EntityAnimation& animation)
+{
+    uint8_t tmp = static_cast<uint8_t>(animation);
+    os << tmp;
+    return os;
+}
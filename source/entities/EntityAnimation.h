@@ -0,0 +1,53 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ENTITYANIMATION_H
+#define ENTITYANIMATION_H
+
+#include <cstdint>
+#include <string>
+
+class ODPacket;
+
+//! \brief Animations played by the movable entities. They are sent to the clients as small integers and each
+//! entity resolves them once into the Ogre::AnimationState of its mesh (see RenderManager::rrSetObjectAnimationState)
+enum class EntityAnimation : uint8_t
+{
+    none = 0,       // No animation
+    idle,
+    flee,
+    die,
+    dig,
+    attack,
+    claim,
+    walk,
+    sleep,
+    pick,
+    triggered,
+    open,
+    close,
+    loop,
+    nbAnimations    // Must be the last in this enum
+};
+
+//! \brief Returns the name of the animation in the meshes. Empty for EntityAnimation::none
+const std::string& entityAnimationToString(EntityAnimation animation);
+
+ODPacket& operator>>(ODPacket& is, EntityAnimation& animation);
+ODPacket& operator<<(ODPacket& os, const EntityAnimation& animation);
+
+#endif // ENTITYANIMATION_H
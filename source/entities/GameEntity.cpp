@@ -94,6 +94,7 @@ GameEntity::GameEntity(
     mIsDeleteRequested (false),
     mParentSceneNode   (nullptr),
     mEntityNode        (nullptr),
+    mOgreEntity        (nullptr),
     mGameMap           (gameMap),
     mIsOnMap           (false),
     mParticleSystemsNumber   (0),
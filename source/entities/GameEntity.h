@@ -30,6 +30,7 @@
 
 namespace Ogre
 {
+class Entity;
 class SceneNode;
 class ParticleSystem;
 } //End namespace Ogre
@@ -189,6 +190,9 @@ class GameEntity
     inline Ogre::SceneNode* getEntityNode() const
     { return mEntityNode; }
 
+    inline Ogre::Entity* getOgreEntity() const
+    { return mOgreEntity; }
+
     //! \brief Set the name of the entity
     inline void setName(const std::string& name)
     { mName = name; }
@@ -215,6 +219,9 @@ class GameEntity
     inline void setEntityNode(Ogre::SceneNode* sceneNode)
     { mEntityNode = sceneNode; }
 
+    inline void setOgreEntity(Ogre::Entity* ogreEntity)
+    { mOgreEntity = ogreEntity; }
+
     //! \brief Function that calls the mesh creation. If the mesh is already created, does nothing
     void createMesh();
     //! \brief Function that calls the mesh destruction. If the mesh is not created, does nothing
@@ -445,6 +452,9 @@ class GameEntity
     //! Used by the renderer to save this entity's node
     Ogre::SceneNode* mEntityNode;
 
+    //! Used by the renderer to save this entity's mesh (if any). It avoids looking for it by name
+    Ogre::Entity* mOgreEntity;
+
     //! \brief Fires a add entity message to the player of the given seat
     virtual void fireAddEntity(Seat* seat, bool async) = 0;
     //! \brief Fires a remove creature message to the player of the given seat (if not null). If null, it fires to
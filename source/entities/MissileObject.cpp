@@ -25,6 +25,9 @@
 #include "game/Seat.h"
 #include "gamemap/GameMap.h"
 #include "network/ODPacket.h"
+#include "network/ODServer.h"
+#include "network/ServerNotification.h"
+#include "network/WalkPathPacket.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
@@ -38,7 +41,9 @@ MissileObject::MissileObject(GameMap* gameMap, Seat* seat, const std::string& se
     mEntityTarget(entityTarget),
     mDamageAllies(damageAllies),
     mKoEnemyCreature(koEnemyCreature),
-    mSpeed(speed)
+    mSpeed(speed),
+    mIsFlightSent(false),
+    mFlightEnd(Ogre::Vector3::ZERO)
 {
     setSeat(seat);
 
@@ -53,7 +58,9 @@ MissileObject::MissileObject(GameMap* gameMap) :
     mEntityTarget(nullptr),
     mDamageAllies(false),
     mKoEnemyCreature(false),
-    mSpeed(1.0)
+    mSpeed(1.0),
+    mIsFlightSent(false),
+    mFlightEnd(Ogre::Vector3::ZERO)
 {
 }
 
@@ -93,18 +100,20 @@ void MissileObject::doUpkeep()
     }
 
     // We check if a creature is in our way. We start by taking the tile we will be on
+    // Missiles are numerous in big fights so we reuse the same buffers every turn
     Ogre::Vector3 position = getPosition();
     double moveDist = getMoveSpeed();
     Ogre::Vector3 destination;
-    std::list<Tile*> tiles;
-    mIsMissileAlive = computeDestination(position, moveDist, mDirection, destination, tiles);
+    mIsMissileAlive = computeDestination(position, moveDist, mDirection, destination, mTiles);
 
-    std::vector<Ogre::Vector3> path;
+    mPath.clear();
+    bool hasBounced = false;
     Tile* lastTile = nullptr;
-    while(!tiles.empty() && mIsMissileAlive)
+    std::size_t indexTile = 0;
+    while((indexTile < mTiles.size()) && mIsMissileAlive)
     {
-        Tile* tmpTile = tiles.front();
-        tiles.pop_front();
+        Tile* tmpTile = mTiles[indexTile];
+        ++indexTile;
 
         if(tmpTile == nullptr)
         {
@@ -115,7 +124,7 @@ void MissileObject::doUpkeep()
         if(tmpTile->getFullness() > 0.0)
         {
             Ogre::Vector3 nextDirection;
-            OD_LOG_INF("missile name=" + getName() + ", hit wall on tile=" + Tile::displayAsString(tmpTile));
+            OD_LOG_DBG("missile name=" + getName() + ", hit wall on tile=" + Tile::displayAsString(tmpTile));
             mIsMissileAlive = wallHitNextDirection(mDirection, lastTile, nextDirection);
             if(!mIsMissileAlive)
             {
@@ -127,10 +136,12 @@ void MissileObject::doUpkeep()
             {
                 position.x = static_cast<Ogre::Real>(lastTile->getX());
                 position.y = static_cast<Ogre::Real>(lastTile->getY());
-                path.push_back(position);
+                mPath.push_back(position);
                 // We compute next position
                 mDirection = nextDirection;
-                mIsMissileAlive = computeDestination(position, moveDist, mDirection, destination, tiles);
+                hasBounced = true;
+                mIsMissileAlive = computeDestination(position, moveDist, mDirection, destination, mTiles);
+                indexTile = 0;
                 continue;
             }
         }
@@ -165,13 +176,11 @@ void MissileObject::doUpkeep()
             }
         }
 
-        std::vector<Tile*> tileVector;
-        tileVector.push_back(tmpTile);
-        std::vector<GameEntity*> enemyCreatures = getGameMap()->getVisibleCreatures(tileVector, getSeat(), true);
-        for(std::vector<GameEntity*>::iterator it = enemyCreatures.begin(); it != enemyCreatures.end(); ++it)
+        mHitCreatures.clear();
+        tmpTile->fillWithEntities(mHitCreatures, SelectionEntityWanted::creatureAliveEnemyAttackable, getSeat()->getPlayer());
+        for(GameEntity* creature : mHitCreatures)
         {
-            GameEntity* creature = *it;
-            OD_LOG_INF("missile=" + getName() + " hit creature=" + creature->getName() + ", on tile=" + Tile::displayAsString(tmpTile));
+            OD_LOG_DBG("missile=" + getName() + " hit creature=" + creature->getName() + ", on tile=" + Tile::displayAsString(tmpTile));
             if(!hitCreature(tmpTile, creature))
             {
                 destination -= moveDist * mDirection;
@@ -183,11 +192,11 @@ void MissileObject::doUpkeep()
         if(!mDamageAllies || !mIsMissileAlive)
             continue;
 
-        std::vector<GameEntity*> alliedCreatures = getGameMap()->getVisibleCreatures(tileVector, getSeat(), false);
-        for(std::vector<GameEntity*>::iterator it = alliedCreatures.begin(); it != alliedCreatures.end(); ++it)
+        mHitCreatures.clear();
+        tmpTile->fillWithEntities(mHitCreatures, SelectionEntityWanted::creatureAliveAllied, getSeat()->getPlayer());
+        for(GameEntity* creature : mHitCreatures)
         {
-            GameEntity* creature = *it;
-            OD_LOG_INF("missile=" + getName() + " hit creature=" + creature->getName() + ", on tile=" + Tile::displayAsString(tmpTile));
+            OD_LOG_DBG("missile=" + getName() + " hit creature=" + creature->getName() + ", on tile=" + Tile::displayAsString(tmpTile));
             if(!hitCreature(tmpTile, creature))
             {
                 destination -= moveDist * mDirection;
@@ -197,16 +206,38 @@ void MissileObject::doUpkeep()
         }
     }
 
-    path.push_back(destination);
-    setWalkPath(EntityAnimation::idle_anim, EntityAnimation::idle_anim, true, true, path);
+    mPath.push_back(destination);
+
+    // When the missile stops, the clients are sent the real path
+    if(!mIsMissileAlive)
+    {
+        setWalkPath(EntityAnimation::idle, EntityAnimation::idle, true, true, mPath);
+        return;
+    }
+
+    // While the missile flies straight, the clients move it along its direction on their own. They are only
+    // sent a new flight when the direction changes
+    if(mIsFlightSent && !hasBounced)
+    {
+        setWalkPath(EntityAnimation::idle, EntityAnimation::idle, true, true, mPath, nullptr);
+        return;
+    }
+
+    mIsFlightSent = true;
+    mFlightEnd = computeFlightEnd(destination, mDirection);
+    std::deque<Ogre::Vector3> flight(mPath.begin(), mPath.end());
+    if(mFlightEnd != destination)
+        flight.push_back(mFlightEnd);
+
+    setWalkPath(EntityAnimation::idle, EntityAnimation::idle, true, true, mPath, &flight);
 }
 
 bool MissileObject::computeDestination(const Ogre::Vector3& position, double moveDist, const Ogre::Vector3& direction,
-        Ogre::Vector3& destination, std::list<Tile*>& tiles)
+        Ogre::Vector3& destination, std::vector<Tile*>& tiles)
 {
     destination = position + (moveDist * direction);
-    tiles = getGameMap()->tilesBetween(Helper::round(position.x),
-        Helper::round(position.y), Helper::round(destination.x), Helper::round(destination.y));
+    getGameMap()->tilesBetween(Helper::round(position.x),
+        Helper::round(position.y), Helper::round(destination.x), Helper::round(destination.y), tiles);
     if(tiles.empty())
     {
         OD_LOG_ERR("missile=" + getName() + " has unexpected empty tiles destination");
@@ -231,6 +262,36 @@ bool MissileObject::computeDestination(const Ogre::Vector3& position, double mov
     return true;
 }
 
+Ogre::Vector3 MissileObject::computeFlightEnd(const Ogre::Vector3& position, const Ogre::Vector3& direction)
+{
+    // We follow the direction until the edge of the map and stop before the first wall. The clients
+    // will wait there if the server has not told them what happened before
+    double maxDist = static_cast<double>(getGameMap()->getMapSizeX() + getGameMap()->getMapSizeY());
+    Ogre::Vector3 dest = position + (maxDist * direction);
+    getGameMap()->tilesBetween(Helper::round(position.x),
+        Helper::round(position.y), Helper::round(dest.x), Helper::round(dest.y), mTiles);
+
+    Tile* lastTile = nullptr;
+    for(Tile* tile : mTiles)
+    {
+        if(tile->getFullness() > 0.0)
+            break;
+
+        lastTile = tile;
+    }
+
+    if(lastTile == nullptr)
+        return position;
+
+    // We keep the flight straight by projecting the last free tile on the direction
+    Ogre::Vector3 lastPos(static_cast<Ogre::Real>(lastTile->getX()), static_cast<Ogre::Real>(lastTile->getY()), position.z);
+    Ogre::Real dist = (lastPos - position).dotProduct(direction);
+    if(dist <= 0.0)
+        return position;
+
+    return position + (dist * direction);
+}
+
 bool MissileObject::notifyDead(GameEntity* entity)
 {
     if(entity == mEntityTarget)
@@ -281,16 +342,64 @@ void MissileObject::exportHeadersToPacket(ODPacket& os) const
     os << getMissileType();
 }
 
+void MissileObject::fireAddEntity(Seat* seat, bool async)
+{
+    if(async)
+    {
+        ServerNotification serverNotification(
+            ServerNotificationType::addMissile, seat->getPlayer());
+        serverNotification.mPacket << getMissileType();
+        exportToPacket(serverNotification.mPacket, seat);
+        ODServer::getSingleton().sendAsyncMsg(serverNotification);
+    }
+    else
+    {
+        ServerNotification* serverNotification = new ServerNotification(
+            ServerNotificationType::addMissile, seat->getPlayer());
+        serverNotification->mPacket << getMissileType();
+        exportToPacket(serverNotification->mPacket, seat);
+        ODServer::getSingleton().queueServerNotification(serverNotification);
+    }
+}
+
+void MissileObject::fireRemoveEntity(Seat* seat)
+{
+    ServerNotification *serverNotification = new ServerNotification(
+        ServerNotificationType::removeMissile, seat->getPlayer());
+    const std::string& name = getName();
+    serverNotification->mPacket << name;
+    ODServer::getSingleton().queueServerNotification(serverNotification);
+}
+
 void MissileObject::exportToPacket(ODPacket& os, const Seat* seat) const
 {
-    RenderedMovableEntity::exportToPacket(os, seat);
+    // We skip the animation and rendering state of the parent classes: missiles always play their idle
+    // animation and are neither rotated nor transparent
+    GameEntity::exportToPacket(os, seat);
+    WalkPathPacket::exportToPacket(os, mWalkQueue);
     os << mSpeed;
+    // The walk queue only goes to the end of the turn. The clients continue to the flight end
+    bool isFlying = mIsMissileAlive && mIsFlightSent;
+    os << isFlying;
+    if(isFlying)
+        os << mFlightEnd;
 }
 
 void MissileObject::importFromPacket(ODPacket& is)
 {
-    RenderedMovableEntity::importFromPacket(is);
+    GameEntity::importFromPacket(is);
+    mPrevAnimationState = EntityAnimation::idle;
+    mPrevAnimationStateLoop = true;
+    importWalkQueueFromPacket(is);
     OD_ASSERT_TRUE(is >> mSpeed);
+    bool isFlying;
+    OD_ASSERT_TRUE(is >> isFlying);
+    if(!isFlying)
+        return;
+
+    OD_ASSERT_TRUE(is >> mFlightEnd);
+    if(!mWalkQueue.empty() && (mWalkQueue.back() != mFlightEnd))
+        mWalkQueue.push_back(mFlightEnd);
 }
 
 void MissileObject::exportToStream(std::ostream& os) const
@@ -22,6 +22,7 @@
 
 #include <string>
 #include <iosfwd>
+#include <vector>
 
 class Building;
 class Creature;
@@ -41,6 +42,9 @@ ODPacket& operator>>(ODPacket& is, MissileObjectType& rot);
 std::ostream& operator<<(std::ostream& os, const MissileObjectType& rot);
 std::istream& operator>>(std::istream& is, MissileObjectType& rot);
 
+//! \brief Missiles are regular rendered entities: they are saved, seen and removed like any other
+//! entity. The server announces each straight flight once and the clients move the missile along
+//! it on their own until it bounces or stops. Missiles are not pooled.
 class MissileObject: public RenderedMovableEntity, public GameEntityListener
 {
 public:
@@ -99,18 +103,38 @@ protected:
     virtual void exportHeadersToPacket(ODPacket& os) const override;
     void exportToStream(std::ostream& os) const override;
     bool importFromStream(std::istream& is) override;
+    //! \brief Missiles are numerous and short lived. Instead of the full entity, the clients are only sent
+    //! what they need to draw the missile and fly it (see fireAddEntity)
     void exportToPacket(ODPacket& os, const Seat* seat) const override;
     void importFromPacket(ODPacket& is) override;
 
+    //! \brief Sends addMissile/removeMissile instead of addEntity/removeEntity
+    void fireAddEntity(Seat* seat, bool async) override;
+    void fireRemoveEntity(Seat* seat) override;
+
 private:
     bool computeDestination(const Ogre::Vector3& position, double moveDist, const Ogre::Vector3& direction,
-        Ogre::Vector3& destination, std::list<Tile*>& tiles);
+        Ogre::Vector3& destination, std::vector<Tile*>& tiles);
+
+    //! \brief Returns the position where the missile would stop if it kept flying along direction
+    //! without hitting anything
+    Ogre::Vector3 computeFlightEnd(const Ogre::Vector3& position, const Ogre::Vector3& direction);
+
     Ogre::Vector3 mDirection;
     bool mIsMissileAlive;
     GameEntity* mEntityTarget;
     bool mDamageAllies;
     bool mKoEnemyCreature;
     double mSpeed;
+
+    //! \brief true once the clients have been sent the flight along the current direction
+    bool mIsFlightSent;
+    Ogre::Vector3 mFlightEnd;
+
+    //! \brief Buffers reused by doUpkeep
+    std::vector<Tile*> mTiles;
+    std::vector<Ogre::Vector3> mPath;
+    std::vector<GameEntity*> mHitCreatures;
 };
 
 #endif // MISSILEOBJECT_H
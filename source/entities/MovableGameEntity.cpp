@@ -17,12 +17,14 @@
 
 #include "entities/MovableGameEntity.h"
 
+#include "camera/CullingManager.h"
 #include "entities/Tile.h"
 #include "game/Player.h"
 #include "game/Seat.h"
 #include "gamemap/GameMap.h"
 #include "network/ODServer.h"
 #include "network/ServerNotification.h"
+#include "network/WalkPathPacket.h"
 #include "render/RenderManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
@@ -31,16 +33,36 @@
 
 #include <OgreAnimationState.h>
 
+#include <algorithm>
+
+//! \brief On client side, when an entity is late compared to the server, it walks faster to
+//! catch up. This is the maximum speed factor it can use
+const double MAX_CATCH_UP_SPEED_FACTOR = 2.0;
+
+//! \brief On client side, skeletal animations of entities further than these distances (in tiles) from
+//! the point the camera looks at are updated every ANIMATION_UPDATE_PERIOD_MEDIUM or ANIMATION_UPDATE_PERIOD_FAR
+//! frames. Closer ones are updated every frame
+const Ogre::Real ANIMATION_DISTANCE_MEDIUM = 12.0;
+const Ogre::Real ANIMATION_DISTANCE_FAR = 20.0;
+const uint32_t ANIMATION_UPDATE_PERIOD_MEDIUM = 2;
+const uint32_t ANIMATION_UPDATE_PERIOD_FAR = 4;
+
 MovableGameEntity::MovableGameEntity(GameMap* gameMap) :
     GameEntity(gameMap),
+    mPrevAnimationState(EntityAnimation::none),
+    mPrevAnimationStateLoop(false),
     mAnimationState(nullptr),
-    mDestinationAnimationState(EntityAnimation::idle_anim),
+    mDestinationAnimationState(EntityAnimation::idle),
     mDestinationAnimationLoop(false),
     mDestinationPlayIdleWhenAnimationEnds(false),
     mDestinationAnimationDirection(Ogre::Vector3::ZERO),
     mWalkDirection(Ogre::Vector3::ZERO),
-    mAnimationTime(0.0)
+    mAnimationTime(0.0),
+    mPendingAnimationTime(0.0),
+    mNbFramesSinceAnimationUpdate(0),
+    mWalkTime(0.0)
 {
+    mAnimationStatesCache.fill(nullptr);
 }
 
 bool MovableGameEntity::isMoving()
@@ -64,8 +86,15 @@ void MovableGameEntity::tileToVector3(const std::list<Tile*>& tiles, std::vector
     }
 }
 
-void MovableGameEntity::setWalkPath(const std::string& walkAnim, const std::string& endAnim, bool loopEndAnim,
+void MovableGameEntity::setWalkPath(EntityAnimation walkAnim, EntityAnimation endAnim, bool loopEndAnim,
         bool playIdleWhenAnimationEnds, const std::vector<Ogre::Vector3>& path)
+{
+    setWalkPath(walkAnim, endAnim, loopEndAnim, playIdleWhenAnimationEnds, path, &mWalkQueue);
+}
+
+void MovableGameEntity::setWalkPath(EntityAnimation walkAnim, EntityAnimation endAnim, bool loopEndAnim,
+        bool playIdleWhenAnimationEnds, const std::vector<Ogre::Vector3>& path,
+        const std::deque<Ogre::Vector3>* clientPath)
 {
     mWalkQueue.clear();
     // We set the animation after clearing mWalkQueue and before filling it to be
@@ -76,6 +105,11 @@ void MovableGameEntity::setWalkPath(const std::string& walkAnim, const std::stri
     for(const Ogre::Vector3& dest : path)
         mWalkQueue.push_back(dest);
 
+    // Paths are computed on server side when a turn starts so the walk starts at the beginning
+    // of the current turn
+    if(!getIsOnServerMap())
+        mWalkTime = getGameMap()->getTurnStartTime();
+
     if(path.empty())
     {
         setAnimationState(endAnim, loopEndAnim, Ogre::Vector3::ZERO, playIdleWhenAnimationEnds);
@@ -91,6 +125,9 @@ void MovableGameEntity::setWalkPath(const std::string& walkAnim, const std::stri
     if(!getIsOnServerMap())
         return;
 
+    if(clientPath == nullptr)
+        return;
+
     for(Seat* seat : mSeatsWithVisionNotified)
     {
         if(seat->getPlayer() == nullptr)
@@ -99,18 +136,15 @@ void MovableGameEntity::setWalkPath(const std::string& walkAnim, const std::stri
             continue;
 
         const std::string& name = getName();
-        uint32_t nbDest = mWalkQueue.size();
         ServerNotification *serverNotification = new ServerNotification(
             ServerNotificationType::animatedObjectSetWalkPath, seat->getPlayer());
-        serverNotification->mPacket << name << walkAnim << endAnim << loopEndAnim << playIdleWhenAnimationEnds << nbDest;
-        for(const Ogre::Vector3& v : mWalkQueue)
-            serverNotification->mPacket << v;
-
+        serverNotification->mPacket << name << walkAnim << endAnim << loopEndAnim << playIdleWhenAnimationEnds;
+        WalkPathPacket::exportToPacket(serverNotification->mPacket, *clientPath);
         ODServer::getSingleton().queueServerNotification(serverNotification);
     }
 }
 
-void MovableGameEntity::clearDestinations(const std::string& animation, bool loopAnim, bool playIdleWhenAnimationEnds)
+void MovableGameEntity::clearDestinations(EntityAnimation animation, bool loopAnim, bool playIdleWhenAnimationEnds)
 {
     mWalkQueue.clear();
     stopWalking();
@@ -123,12 +157,11 @@ void MovableGameEntity::clearDestinations(const std::string& animation, bool loo
             continue;
 
         const std::string& name = getName();
-        const std::string emptyString;
-        uint32_t nbDest = 0;
         ServerNotification *serverNotification = new ServerNotification(
             ServerNotificationType::animatedObjectSetWalkPath, seat->getPlayer());
-        serverNotification->mPacket << name << emptyString << animation
-            << loopAnim << playIdleWhenAnimationEnds << nbDest;
+        serverNotification->mPacket << name << EntityAnimation::none << animation
+            << loopAnim << playIdleWhenAnimationEnds;
+        WalkPathPacket::exportToPacket(serverNotification->mPacket, mWalkQueue);
         ODServer::getSingleton().queueServerNotification(serverNotification);
     }
 }
@@ -136,7 +169,7 @@ void MovableGameEntity::clearDestinations(const std::string& animation, bool loo
 void MovableGameEntity::stopWalking()
 {
     // Set the animation state of this object to the state that was set for it to enter into after it reaches it's destination.
-    if(mDestinationAnimationState.empty())
+    if(mDestinationAnimationState == EntityAnimation::none)
         return;
 
     if(mDestinationAnimationDirection == Ogre::Vector3::ZERO)
@@ -145,11 +178,42 @@ void MovableGameEntity::stopWalking()
     setAnimationState(mDestinationAnimationState, mDestinationAnimationLoop, mDestinationAnimationDirection, mDestinationPlayIdleWhenAnimationEnds);
 
     // We reset the destination state
-    mDestinationAnimationState.clear();
+    mDestinationAnimationState = EntityAnimation::none;
     mDestinationAnimationLoop = false;
     mDestinationAnimationDirection = Ogre::Vector3::ZERO;
 }
 
+Ogre::AnimationState* MovableGameEntity::getCachedAnimationState(EntityAnimation animation, bool& isCached) const
+{
+    std::size_t index = static_cast<std::size_t>(animation);
+    if(index >= mAnimationStatesCache.size())
+    {
+        OD_LOG_ERR("name=" + getName() + ", unexpected animation=" + Helper::toString(static_cast<uint32_t>(index)));
+        isCached = true;
+        return nullptr;
+    }
+
+    isCached = mCachedAnimationStates.test(index);
+    return mAnimationStatesCache[index];
+}
+
+void MovableGameEntity::cacheAnimationState(EntityAnimation animation, Ogre::AnimationState* animationState)
+{
+    std::size_t index = static_cast<std::size_t>(animation);
+    if(index >= mAnimationStatesCache.size())
+        return;
+
+    mAnimationStatesCache[index] = animationState;
+    mCachedAnimationStates.set(index);
+}
+
+void MovableGameEntity::clearAnimationStatesCache()
+{
+    mAnimationStatesCache.fill(nullptr);
+    mCachedAnimationStates.reset();
+    mAnimationState = nullptr;
+}
+
 void MovableGameEntity::setWalkDirection(const Ogre::Vector3& direction)
 {
     mWalkDirection = direction;
@@ -159,11 +223,11 @@ void MovableGameEntity::setWalkDirection(const Ogre::Vector3& direction)
     RenderManager::getSingleton().rrOrientEntityToward(this, direction);
 }
 
-void MovableGameEntity::setAnimationState(const std::string& state, bool loop, const Ogre::Vector3& direction, bool playIdleWhenAnimationEnds)
+void MovableGameEntity::setAnimationState(EntityAnimation state, bool loop, const Ogre::Vector3& direction, bool playIdleWhenAnimationEnds)
 {
     // Ignore the command if the command is exactly the same and looped. Otherwise, we accept
     // the command because it may be a trap/building object that is triggered several times
-    if (state.compare(mPrevAnimationState) == 0 &&
+    if ((state == mPrevAnimationState) &&
         loop &&
         mPrevAnimationStateLoop &&
         (direction == Ogre::Vector3::ZERO || direction == mWalkDirection))
@@ -214,24 +278,29 @@ void MovableGameEntity::update(Ogre::Real timeSinceLastFrame)
          * getAnimationSpeedFactor());
     mAnimationTime += addedTime;
     if (!getIsOnServerMap() && getAnimationState() != nullptr)
-    {
-        // If the animation has stopped we set it to idle if we have to
-        if(mDestinationPlayIdleWhenAnimationEnds && getAnimationState()->hasEnded())
-            RenderManager::getSingleton().rrSetObjectAnimationState(this, EntityAnimation::idle_anim, true);
-        else
-            getAnimationState()->addTime(static_cast<Ogre::Real>(addedTime));
-    }
+        updateSkeletalAnimation(addedTime);
 
     if (mWalkQueue.empty())
         return;
 
     // Move the entity
+    double moveTime = timeSinceLastFrame;
+    if(!getIsOnServerMap())
+    {
+        // On client side, the walk follows the server time estimated from the turns timestamps instead of
+        // the frame time. That way, entities do not drift from the server if the frame rates are different
+        // and they stop when the next turn is late instead of going ahead of the server
+        double serverTime = getGameMap()->getClientServerTime();
+        moveTime = std::min(serverTime - mWalkTime, timeSinceLastFrame * MAX_CATCH_UP_SPEED_FACTOR);
+        if(moveTime <= 0.0)
+            return;
+
+        mWalkTime += moveTime;
+    }
 
-    // Note: When the client and the server are using different frame rates, the entities walk at different speeds
-    // If this happens to become a problem, resyncing mechanisms will be needed.
     double moveDist = ODApplication::turnsPerSecond
                       * getMoveSpeed()
-                      * timeSinceLastFrame;
+                      * moveTime;
     Ogre::Vector3 newPosition = getPosition();
     Ogre::Vector3 nextDest = mWalkQueue.front();
     Ogre::Vector3 walkDirection = nextDest - newPosition;
@@ -268,6 +337,43 @@ void MovableGameEntity::update(Ogre::Real timeSinceLastFrame)
     setPosition(newPosition);
 }
 
+void MovableGameEntity::updateSkeletalAnimation(double addedTime)
+{
+    // Hidden entities keep the elapsed time until they are shown. Their position is still
+    // updated so that they are at the right place when they appear. Entities that are not on
+    // the map (in the keeper hand for example) are always updated
+    mPendingAnimationTime += addedTime;
+    uint32_t updatePeriod = 1;
+    if(getIsOnMap())
+    {
+        Tile* posTile = getPositionTile();
+        if((posTile == nullptr) || ((posTile->getTileCullingFlags() & CullingType::SHOW_MAIN_WINDOW) == 0))
+            return;
+
+        Ogre::Vector3 viewOffset = getPosition() - getGameMap()->getAnimationViewTarget();
+        viewOffset.z = 0;
+        Ogre::Real squaredDist = viewOffset.squaredLength();
+        if(squaredDist > ANIMATION_DISTANCE_FAR * ANIMATION_DISTANCE_FAR)
+            updatePeriod = ANIMATION_UPDATE_PERIOD_FAR;
+        else if(squaredDist > ANIMATION_DISTANCE_MEDIUM * ANIMATION_DISTANCE_MEDIUM)
+            updatePeriod = ANIMATION_UPDATE_PERIOD_MEDIUM;
+    }
+
+    ++mNbFramesSinceAnimationUpdate;
+    if(mNbFramesSinceAnimationUpdate < updatePeriod)
+        return;
+
+    mNbFramesSinceAnimationUpdate = 0;
+    Ogre::Real pendingTime = static_cast<Ogre::Real>(mPendingAnimationTime);
+    mPendingAnimationTime = 0.0;
+
+    // If the animation has stopped we set it to idle if we have to
+    if(mDestinationPlayIdleWhenAnimationEnds && getAnimationState()->hasEnded())
+        RenderManager::getSingleton().rrSetObjectAnimationState(this, EntityAnimation::idle, true);
+    else
+        getAnimationState()->addTime(pendingTime);
+}
+
 void MovableGameEntity::setPosition(const Ogre::Vector3& v)
 {
     Tile* oldTile = nullptr;
@@ -298,7 +404,7 @@ void MovableGameEntity::setPosition(const Ogre::Vector3& v)
         addEntityToPositionTile();
 }
 
-void MovableGameEntity::fireObjectAnimationState(const std::string& state, bool loop, const Ogre::Vector3& direction, bool playIdleWhenAnimationEnds)
+void MovableGameEntity::fireObjectAnimationState(EntityAnimation state, bool loop, const Ogre::Vector3& direction, bool playIdleWhenAnimationEnds)
 {
     for(Seat* seat : mSeatsWithVisionNotified)
     {
@@ -348,12 +454,7 @@ void MovableGameEntity::exportToPacket(ODPacket& os, const Seat* seat) const
     os << mWalkDirection;
     os << mAnimationTime;
 
-    int32_t nbDestinations = mWalkQueue.size();
-    os << nbDestinations;
-    for(const Ogre::Vector3& dest : mWalkQueue)
-    {
-        os << dest;
-    }
+    WalkPathPacket::exportToPacket(os, mWalkQueue);
 }
 
 void MovableGameEntity::importFromPacket(ODPacket& is)
@@ -364,21 +465,21 @@ void MovableGameEntity::importFromPacket(ODPacket& is)
     OD_ASSERT_TRUE(is >> mWalkDirection);
     OD_ASSERT_TRUE(is >> mAnimationTime);
 
-    int32_t nbDestinations;
-    OD_ASSERT_TRUE(is >> nbDestinations);
-    mWalkQueue.clear();
-    for(int32_t i = 0; i < nbDestinations; ++i)
-    {
-        Ogre::Vector3 dest;
-        OD_ASSERT_TRUE(is >> dest);
-        mWalkQueue.push_back(dest);
-    }
+    importWalkQueueFromPacket(is);
+}
+
+void MovableGameEntity::importWalkQueueFromPacket(ODPacket& is)
+{
+    std::vector<Ogre::Vector3> path;
+    OD_ASSERT_TRUE(WalkPathPacket::importFromPacket(is, path));
+    mWalkQueue.assign(path.begin(), path.end());
+    mWalkTime = getGameMap()->getTurnStartTime();
 }
 
 void MovableGameEntity::restoreEntityState()
 {
     GameEntity::restoreEntityState();
-    if(!mPrevAnimationState.empty())
+    if(mPrevAnimationState != EntityAnimation::none)
     {
         RenderManager::getSingleton().rrSetObjectAnimationState(this, mPrevAnimationState, mPrevAnimationStateLoop);
 
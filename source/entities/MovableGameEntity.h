@@ -18,27 +18,19 @@
 #ifndef MOVABLEGAMEENTITY_H
 #define MOVABLEGAMEENTITY_H
 
+#include "entities/EntityAnimation.h"
 #include "entities/GameEntity.h"
 
 #include <OgreVector3.h>
 
+#include <array>
+#include <bitset>
 #include <deque>
 #include <list>
+#include <vector>
 
 class Tile;
 
-namespace EntityAnimation
-{
-    static const std::string idle_anim = "Idle";
-    static const std::string flee_anim = "Flee";
-    static const std::string die_anim = "Die";
-    static const std::string dig_anim = "Dig";
-    static const std::string attack_anim = "Attack1";
-    static const std::string claim_anim = "Claim";
-    static const std::string walk_anim = "Walk";
-    static const std::string sleep_anim = "Sleep";
-};
-
 class MovableGameEntity : public GameEntity
 {
 public:
@@ -55,7 +47,7 @@ public:
      * walk, the entity will play walkAnim (looped). When it gets to the wanted position,
      * it will play endAnim (looped or not depending on loopEndAnim).
      */
-    void setWalkPath(const std::string& walkAnim, const std::string& endAnim, bool loopEndAnim,
+    void setWalkPath(EntityAnimation walkAnim, EntityAnimation endAnim, bool loopEndAnim,
         bool playIdleWhenAnimationEnds, const std::vector<Ogre::Vector3>& path);
 
     /*! \brief Converts a tile list to a vector of Ogre::Vector3
@@ -66,7 +58,7 @@ public:
 
     //! \brief Clears all future destinations from the walk queue, stops the object where it is, and sets its animation state.
     //! This is a server side function
-    void clearDestinations(const std::string& animation, bool loopAnim, bool playIdleWhenAnimationEnds);
+    void clearDestinations(EntityAnimation animation, bool loopAnim, bool playIdleWhenAnimationEnds);
 
     //! \brief Stops the object where it is, and sets its animation state.
     virtual void stopWalking();
@@ -81,7 +73,7 @@ public:
     virtual double getMoveSpeed() const
     { return 1.0; }
 
-    virtual void setAnimationState(const std::string& state, bool loop = true, const Ogre::Vector3& direction = Ogre::Vector3::ZERO, bool playIdleWhenAnimationEnds = true);
+    virtual void setAnimationState(EntityAnimation state, bool loop = true, const Ogre::Vector3& direction = Ogre::Vector3::ZERO, bool playIdleWhenAnimationEnds = true);
 
     virtual double getAnimationSpeedFactor() const
     { return 1.0; }
@@ -98,11 +90,23 @@ public:
     virtual void setPosition(const Ogre::Vector3& v) override;
 
     inline void setAnimationState(Ogre::AnimationState* animationState)
-    { mAnimationState = animationState; }
+    {
+        mAnimationState = animationState;
+        mPendingAnimationTime = 0.0;
+    }
 
     inline Ogre::AnimationState* getAnimationState() const
     { return mAnimationState; }
 
+    //! \brief Returns the animation state the renderer has resolved for the given animation (it may
+    //! be a close one if the mesh do not have it). isCached is false if it has not been resolved yet
+    Ogre::AnimationState* getCachedAnimationState(EntityAnimation animation, bool& isCached) const;
+
+    void cacheAnimationState(EntityAnimation animation, Ogre::AnimationState* animationState);
+
+    //! \brief Should be called when the mesh is destroyed
+    void clearAnimationStatesCache();
+
     virtual void restoreEntityState() override;
 
     static std::string getMovableGameEntityStreamFormat();
@@ -113,19 +117,47 @@ protected:
     virtual void exportToPacket(ODPacket& os, const Seat* seat) const override;
     virtual void importFromPacket(ODPacket& is) override;
 
+    /*! \brief Same as setWalkPath but the clients are sent clientPath instead of path. Used by the
+     * entities the clients can move on their own (like missiles flying straight) so that their
+     * path does not have to be sent every turn. If clientPath is nullptr, nothing is sent
+     */
+    void setWalkPath(EntityAnimation walkAnim, EntityAnimation endAnim, bool loopEndAnim,
+        bool playIdleWhenAnimationEnds, const std::vector<Ogre::Vector3>& path,
+        const std::deque<Ogre::Vector3>* clientPath);
+
+    //! \brief Client side. Reads the walk queue sent by the server. The walk starts at the beginning of the current turn
+    void importWalkQueueFromPacket(ODPacket& is);
+
     std::deque<Ogre::Vector3> mWalkQueue;
-    std::string mPrevAnimationState;
+    EntityAnimation mPrevAnimationState;
     bool mPrevAnimationStateLoop;
 
 private:
-    void fireObjectAnimationState(const std::string& state, bool loop, const Ogre::Vector3& direction, bool playIdleWhenAnimationEnds);
+    void fireObjectAnimationState(EntityAnimation state, bool loop, const Ogre::Vector3& direction, bool playIdleWhenAnimationEnds);
+
+    //! \brief Client side. Advances the skeletal animation if the entity is visible in the main window. Far
+    //! entities are only updated every few frames
+    void updateSkeletalAnimation(double addedTime);
+
     Ogre::AnimationState* mAnimationState;
-    std::string mDestinationAnimationState;
+    //! \brief Animation states resolved for the current mesh, indexed by EntityAnimation. An animation
+    //! is resolved if its bit is set in mCachedAnimationStates
+    std::array<Ogre::AnimationState*, static_cast<std::size_t>(EntityAnimation::nbAnimations)> mAnimationStatesCache;
+    std::bitset<static_cast<std::size_t>(EntityAnimation::nbAnimations)> mCachedAnimationStates;
+    EntityAnimation mDestinationAnimationState;
     bool mDestinationAnimationLoop;
     bool mDestinationPlayIdleWhenAnimationEnds;
     Ogre::Vector3 mDestinationAnimationDirection;
     Ogre::Vector3 mWalkDirection;
     double mAnimationTime;
+    //! \brief Client side only. Animation time not applied yet to mAnimationState because the entity
+    //! was hidden or far from the camera
+    double mPendingAnimationTime;
+    //! \brief Client side only. Frames since the skeletal animation has been updated
+    uint32_t mNbFramesSinceAnimationUpdate;
+    //! \brief Client side only. Server time (see GameMap::getClientServerTime) until which the walk
+    //! has been played
+    double mWalkTime;
 };
 
 
@@ -30,7 +30,7 @@
 
 PersistentObject::PersistentObject(GameMap* gameMap, Building& building, const std::string& meshName,
         Tile* tile, Ogre::Real rotationAngle, bool hideCoveredTile, float opacity,
-        const std::string& initialAnimationState, bool initialAnimationLoop) :
+        EntityAnimation initialAnimationState, bool initialAnimationLoop) :
     BuildingObject(gameMap,
         building,
         meshName,
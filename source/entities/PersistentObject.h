@@ -44,7 +44,7 @@ class PersistentObject: public BuildingObject
 public:
     PersistentObject(GameMap* gameMap, Building& building, const std::string& meshName,
         Tile* tile, Ogre::Real rotationAngle, bool hideCoveredTile, float opacity = 1.0f,
-        const std::string& initialAnimationState = "", bool initialAnimationLoop = true);
+        EntityAnimation initialAnimationState = EntityAnimation::none, bool initialAnimationLoop = true);
     PersistentObject(GameMap* gameMap);
 
     virtual GameEntityType getObjectType() const override;
@@ -142,7 +142,7 @@ void RenderedMovableEntity::setMeshOpacity(float opacity)
 void RenderedMovableEntity::pickup()
 {
     removeEntityFromPositionTile();
-    clearDestinations(EntityAnimation::idle_anim, true, true);
+    clearDestinations(EntityAnimation::idle, true, true);
 }
 
 void RenderedMovableEntity::drop(const Ogre::Vector3& v)
@@ -38,7 +38,7 @@ SkillEntity::SkillEntity(GameMap* gameMap, const std::string& libraryName, int32
     RenderedMovableEntity(gameMap, libraryName, "Grimoire", 0.0f, false, 1.0f),
     mSkillPoints(skillPoints)
 {
-    mPrevAnimationState = "Loop";
+    mPrevAnimationState = EntityAnimation::loop;
     mPrevAnimationStateLoop = true;
 }
 
@@ -113,11 +113,11 @@ void SmallSpiderEntity::doUpkeep()
 
     if(moves.empty())
     {
-        setAnimationState(EntityAnimation::idle_anim);
+        setAnimationState(EntityAnimation::idle);
         return;
     }
 
-    setWalkPath(EntityAnimation::walk_anim, EntityAnimation::idle_anim, true, true, moves);
+    setWalkPath(EntityAnimation::walk, EntityAnimation::idle, true, true, moves);
 }
 
 bool SmallSpiderEntity::canSlap(Seat* seat)
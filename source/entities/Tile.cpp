@@ -60,6 +60,7 @@ Tile::Tile(GameMap* gameMap, int x, int y, TileType type, double fullness) :
     mRefundPriceTrap    (0),
     mCoveringBuilding   (nullptr),
     mClaimedPercentage  (0.0),
+    mClaimedCounterSeat (nullptr),
     mIsRoom             (false),
     mIsTrap             (false),
     mDisplayTileMesh    (true),
@@ -67,7 +68,8 @@ Tile::Tile(GameMap* gameMap, int x, int y, TileType type, double fullness) :
     mHasBridge          (false),
     mLocalPlayerHasVision   (false),
     mTileCulling        (CullingType::HIDE),
-    mNbWorkersClaiming(0)
+    mIsMeshRefreshQueued(false),
+    mTileSetLinks       (-1)
 {
     computeTileVisual();
 }
@@ -417,6 +419,10 @@ bool Tile::isMarkedForDiggingByAnySeat()
 void Tile::addPlayerMarkingTile(const Player *p)
 {
     mPlayersMarkingTile.push_back(p);
+
+    WorkerJobBoard* jobBoard = getPlayerJobBoard(p);
+    if(jobBoard != nullptr)
+        jobBoard->addDigJob(*this);
 }
 
 void Tile::removePlayerMarkingTile(const Player *p)
@@ -426,12 +432,15 @@ void Tile::removePlayerMarkingTile(const Player *p)
         return;
 
     mPlayersMarkingTile.erase(it);
+
+    WorkerJobBoard* jobBoard = getPlayerJobBoard(p);
+    if(jobBoard != nullptr)
+        jobBoard->removeDigJob(*this);
 }
 
 void Tile::addNeighbor(Tile *n)
 {
     mNeighbors.push_back(n);
-    mNbWorkersDigging.push_back(0);
 }
 
 Tile* Tile::getNeighbor(unsigned int index)
@@ -920,6 +929,12 @@ void Tile::setFullness(double f)
                 getGameMap()->refreshFloodFill(seat, this);
         }
     }
+
+    if(oldFullness != mFullness)
+    {
+        refreshWorkerJobs();
+        fireTileStateChanged();
+    }
 }
 
 void Tile::createMeshLocal()
@@ -999,7 +1014,11 @@ void Tile::setCoveringBuilding(Building *building)
         // Set the tile as claimed and of the team color of the building
         setSeat(mCoveringBuilding->getSeat());
         mClaimedPercentage = 1.0;
+        updateClaimedTilesCounter();
     }
+
+    refreshWorkerJobs();
+    fireTileStateChanged();
 }
 
 bool Tile::isGroundClaimable(Seat* seat) const
@@ -1109,10 +1128,19 @@ void Tile::loadFromLine(const std::string& line, Tile *t)
     t->mPosition = Ogre::Vector3(static_cast<Ogre::Real>(t->mX), static_cast<Ogre::Real>(t->mY), 0.0f);
 
     TileType tileType = static_cast<TileType>(Helper::toInt(elems[2]));
-    t->setType(tileType);
+    double fullness = Helper::toDouble(elems[3]);
+    int seatId = -1;
+    if(elems.size() >= 5)
+        seatId = Helper::toInt(elems[4]);
+
+    t->loadFromData(tileType, fullness, seatId);
+}
+
+void Tile::loadFromData(TileType tileType, double fullness, int seatId)
+{
+    setType(tileType);
 
     // If the tile type is lava or water, we ignore fullness
-    double fullness;
     switch(tileType)
     {
         case TileType::water:
@@ -1121,14 +1149,13 @@ void Tile::loadFromLine(const std::string& line, Tile *t)
             break;
 
         default:
-            fullness = Helper::toDouble(elems[3]);
             break;
     }
-    t->setFullnessValue(fullness);
+    setFullnessValue(fullness);
 
     bool shouldSetSeat = false;
     // We allow to set seat if the tile is dirt (full or not) or if it is gold (ground only)
-    if(elems.size() >= 5)
+    if(seatId >= 0)
     {
         if(tileType == TileType::dirt)
         {
@@ -1143,16 +1170,17 @@ void Tile::loadFromLine(const std::string& line, Tile *t)
 
     if(!shouldSetSeat)
     {
-        t->setSeat(nullptr);
+        setSeat(nullptr);
+        updateClaimedTilesCounter();
         return;
     }
 
-    int seatId = Helper::toInt(elems[4]);
-    Seat* seat = t->getGameMap()->getSeatById(seatId);
+    Seat* seat = getGameMap()->getSeatById(seatId);
     if(seat == nullptr)
         return;
-    t->setSeat(seat);
-    t->mClaimedPercentage = 1.0;
+    setSeat(seat);
+    mClaimedPercentage = 1.0;
+    updateClaimedTilesCounter();
 }
 
 void Tile::refreshMesh()
@@ -1163,6 +1191,24 @@ void Tile::refreshMesh()
     if(getIsOnServerMap())
         return;
 
+    // A tile can be refreshed many times during a frame (by several messages or as a neighbor
+    // of several changed tiles). It will only be refreshed once
+    if(mIsMeshRefreshQueued)
+        return;
+
+    mIsMeshRefreshQueued = true;
+    getGameMap()->queueTileMeshRefresh(this);
+}
+
+void Tile::refreshMeshNow()
+{
+    mIsMeshRefreshQueued = false;
+    if (!isMeshExisting())
+        return;
+
+    if(mTileSetLinks < 0)
+        mTileSetLinks = getGameMap()->computeTileSetLinks(this);
+
     RenderManager::getSingleton().rrRefreshTile(*this, *getGameMap(), *getGameMap()->getLocalPlayer());
 }
 
@@ -1231,6 +1277,8 @@ void Tile::claimForSeat(Seat* seat, double nDanceRate)
         return;
     }
 
+    bool wasClaimed = isClaimed();
+
     // Claiming walls is less efficient than claiming ground
     if(getFullness() > 0)
         nDanceRate *= ConfigManager::getSingleton().getClaimingWallPenalty();
@@ -1261,6 +1309,15 @@ void Tile::claimForSeat(Seat* seat, double nDanceRate)
         (getSeat()->isAlliedSeat(seat)))
     {
         claimTile(seat);
+        return;
+    }
+
+    // An enemy seat may have started to claim the tile
+    updateClaimedTilesCounter();
+    if(wasClaimed != isClaimed())
+    {
+        refreshWorkerJobs();
+        fireTileStateChanged();
     }
 }
 
@@ -1273,6 +1330,7 @@ void Tile::claimTile(Seat* seat)
     // We need this because if we are a client, the tile may be from a non allied seat
     setSeat(seat);
     mClaimedPercentage = 1.0;
+    updateClaimedTilesCounter();
 
     if(isFullTile())
         fireTileSound(TileSound::ClaimWall);
@@ -1297,6 +1355,7 @@ void Tile::claimTile(Seat* seat)
         }
     }
 
+    refreshWorkerJobs();
     fireTileStateChanged();
 }
 
@@ -1308,6 +1367,7 @@ void Tile::unclaimTile()
 
     setSeat(nullptr);
     mClaimedPercentage = 0.0;
+    updateClaimedTilesCounter();
 
     computeTileVisual();
     setDirtyForAllSeats();
@@ -1324,9 +1384,28 @@ void Tile::unclaimTile()
         }
     }
 
+    refreshWorkerJobs();
     fireTileStateChanged();
 }
 
+void Tile::updateClaimedTilesCounter()
+{
+    if(!getIsOnServerMap())
+        return;
+
+    Seat* seat = isClaimed() ? getSeat() : nullptr;
+    if(seat == mClaimedCounterSeat)
+        return;
+
+    if(mClaimedCounterSeat != nullptr)
+        mClaimedCounterSeat->updateClaimedTilesCounter(-1);
+
+    if(seat != nullptr)
+        seat->updateClaimedTilesCounter(1);
+
+    mClaimedCounterSeat = seat;
+}
+
 double Tile::digOut(double digRate)
 {
     // We scle dig rate depending on the tile type
@@ -1833,136 +1912,14 @@ double Tile::getCreatureSpeedDefault(const Creature* creature) const
     }
 }
 
-bool Tile::canWorkerClaim(const Creature& worker)
-{
-    if(mNbWorkersClaiming < ConfigManager::getSingleton().getNbWorkersClaimSameTile())
-        return true;
-
-    return false;
-}
-
-bool Tile::addWorkerClaiming(const Creature& worker)
-{
-    if(!canWorkerClaim(worker))
-        return false;
-
-    ++mNbWorkersClaiming;
-    return true;
-}
-
-bool Tile::removeWorkerClaiming(const Creature& worker)
-{
-    // Sanity check
-    if(mNbWorkersClaiming <= 0)
-    {
-        OD_LOG_ERR("Cannot remove worker=" + worker.getName() + ", tile=" + Tile::displayAsString(this));
-        return false;
-    }
-
-    --mNbWorkersClaiming;
-    return true;
-}
-
-void Tile::canWorkerDig(const Creature& worker, std::vector<Tile*>& tiles)
-{
-    Tile* myTile = worker.getPositionTile();
-    if (myTile == nullptr)
-    {
-        OD_LOG_ERR("worker=" + worker.getName() + ", pos=" + Helper::toString(worker.getPosition()));
-        return;
-    }
-
-    for(uint32_t i = 0; i < mNeighbors.size(); ++i)
-    {
-        Tile* neigh = mNeighbors[i];
-        if(neigh->isFullTile())
-            continue;
-
-        if(!getGameMap()->pathExists(&worker, myTile, neigh))
-            continue;
-
-        if(i >= mNbWorkersDigging.size())
-        {
-            static bool log = true;
-            if(log)
-            {
-                log = false;
-                OD_LOG_ERR("worker=" + worker.getName() + ", myTile=" + Tile::displayAsString(myTile)
-                    + ", neigh=" + Tile::displayAsString(neigh) + ", i=" + Helper::toString(i)
-                    + ", size=" + Helper::toString(mNbWorkersDigging.size()));
-            }
-            continue;
-        }
-
-        if(mNbWorkersDigging[i] >= ConfigManager::getSingleton().getNbWorkersDigSameFaceTile())
-            continue;
-
-        tiles.push_back(neigh);
-    }
-}
-
-bool Tile::addWorkerDigging(const Creature& worker, Tile& tile)
-{
-    for(uint32_t i = 0; i < mNeighbors.size(); ++i)
-    {
-        Tile* neigh = mNeighbors[i];
-        if(neigh != &tile)
-            continue;
-
-        if(i >= mNbWorkersDigging.size())
-        {
-            static bool log = true;
-            if(log)
-            {
-                log = false;
-                OD_LOG_ERR("worker=" + worker.getName() + ", tile=" + Tile::displayAsString(&tile)
-                    + ", neigh=" + Tile::displayAsString(neigh) + ", i=" + Helper::toString(i)
-                    + ", size=" + Helper::toString(mNbWorkersDigging.size()));
-            }
-            continue;
-        }
-
-        ++mNbWorkersDigging[i];
-        return true;
-    }
-
-    return false;
-}
-
-bool Tile::removeWorkerDigging(const Creature& worker, Tile& tile)
-{
-    // Sanity check
-    for(uint32_t i = 0; i < mNeighbors.size(); ++i)
-    {
-        Tile* neigh = mNeighbors[i];
-        if(neigh != &tile)
-            continue;
-
-        if(i >= mNbWorkersDigging.size())
-        {
-            static bool log = true;
-            if(log)
-            {
-                log = false;
-                OD_LOG_ERR("worker=" + worker.getName() + ", tile=" + Tile::displayAsString(&tile)
-                    + ", neigh=" + Tile::displayAsString(neigh) + ", i=" + Helper::toString(i)
-                    + ", size=" + Helper::toString(mNbWorkersDigging.size()));
-            }
-            continue;
-        }
-
-        --mNbWorkersDigging[i];
-        return true;
-    }
-
-    return false;
-}
-
 void Tile::setTileCullingFlags(uint32_t mask, bool value)
 {
     // We save the current state. If the result is different, we refresh culling
     mTileCulling = (value ? mTileCulling | mask : mTileCulling & ~mask);
 
+    if(isMeshExisting())
+        RenderManager::getSingleton().rrSetTileCulled(*this, mTileCulling == CullingType::HIDE);
+
     if(mTileCulling == CullingType::HIDE)
     {
         // We cull the tile
@@ -2001,6 +1958,36 @@ void Tile::fireTileStateChanged()
         stateListener->tileStateChanged(*this);
 }
 
+void Tile::refreshWorkerJobs()
+{
+    if(!getIsOnServerMap())
+        return;
+
+    // Claiming a tile may allow claiming its neighbors (or prevent it if an enemy claimed it)
+    for(Seat* seat : getGameMap()->getSeats())
+    {
+        WorkerJobBoard& jobBoard = seat->getWorkerJobBoard();
+        jobBoard.refreshClaimJobs(*this);
+        for(Tile* neigh : mNeighbors)
+            jobBoard.refreshClaimJobs(*neigh);
+    }
+}
+
+WorkerJobBoard* Tile::getPlayerJobBoard(const Player* player) const
+{
+    if(!getIsOnServerMap())
+        return nullptr;
+
+    if(player->getSeat() == nullptr)
+        return nullptr;
+
+    Seat* seat = getGameMap()->getSeatById(player->getSeat()->getId());
+    if(seat == nullptr)
+        return nullptr;
+
+    return &seat->getWorkerJobBoard();
+}
+
 std::string Tile::displayAsString(const Tile* tile)
 {
     if(tile == nullptr)
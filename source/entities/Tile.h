@@ -37,6 +37,7 @@ class GameMap;
 class CreatureDefinition;
 class Trap;
 class TreasuryObject;
+class WorkerJobBoard;
 class ChickenEntity;
 class CraftedTrap;
 class BuildingObject;
@@ -214,9 +215,22 @@ public:
      */
     static int nextTileFullness(int f);
 
-    //! \brief This function puts a message in the renderQueue to change the mesh for this tile.
+    //! \brief Queues a refresh of the mesh of this tile. The refreshes are coalesced and processed
+    //! once per frame by GameMap::processTileMeshRefreshes
     void refreshMesh();
 
+    //! \brief Refreshes the mesh of this tile right away. Called when the queued refreshes are processed
+    void refreshMeshNow();
+
+    //! \brief Links with the 4 neighbors as used by the tileset (see GameMap::getMeshForTile). -1 if
+    //! it has to be computed
+    inline int32_t getTileSetLinks() const
+    { return mTileSetLinks; }
+
+    //! \brief Should be called when this tile or one of its neighbors changes its visual
+    inline void invalidateTileSetLinks()
+    { mTileSetLinks = -1; }
+
     //! \brief Marks the tile as being selected through a mouse click or drag.
     void setSelected(bool ss, const Player* pp);
 
@@ -233,6 +247,10 @@ public:
     //! \brief Set/unset the value of the mask depending on boolean value
     void setTileCullingFlags(uint32_t mask, bool value);
 
+    //! \brief Returns the culling flags (see CullingType) currently set on this tile
+    inline uint32_t getTileCullingFlags() const
+    { return mTileCulling; }
+
     //! \brief Set the tile digging mark for the given player.
     void setMarkedForDigging(bool s, const Player* p);
 
@@ -272,6 +290,11 @@ public:
     void claimForSeat(Seat* seat, double nDanceRate);
     void claimTile(Seat* seat);
     void unclaimTile();
+
+    //! \brief Updates the claimed tiles counter of the seats if the claimed state of this tile
+    //! changed. Should be called after changing the tile seat or claimed percentage.
+    //! Used on server side only
+    void updateClaimedTilesCounter();
     double digOut(double digRate);
 
     inline Building* getCoveringBuilding() const
@@ -330,6 +353,10 @@ public:
     //! \brief Loads the tile data from a level line.
     static void loadFromLine(const std::string& line, Tile *t);
 
+    //! \brief Sets the type, fullness and seat of the tile as read from a level. seatId is
+    //! -1 if the tile has no seat. The position is not changed.
+    void loadFromData(TileType tileType, double fullness, int seatId);
+
     /*! \brief This is a helper function which just converts the tile type enum into a string.
      *
      * This function is used primarily in forming the mesh names to load from disk
@@ -443,19 +470,6 @@ public:
 
     double getCreatureSpeedDefault(const Creature* creature) const;
 
-    //! \brief Allows to lock the tile for the workers claiming it. Returns true if the worker could be added
-    //! and false otherwise
-    //! Note that by nature, a tile cannot be claimed for wall and ground. Because of that, we can use the same
-    //! functions for both
-    bool canWorkerClaim(const Creature& worker);
-    bool addWorkerClaiming(const Creature& worker);
-    bool removeWorkerClaiming(const Creature& worker);
-    //! \brief Feels the tile vector with the available tiles the worker can
-    //! go to
-    void canWorkerDig(const Creature& worker, std::vector<Tile*>& tiles);
-    bool addWorkerDigging(const Creature& worker, Tile& tile);
-    bool removeWorkerDigging(const Creature& worker, Tile& tile);
-
     static void exportToStream(Tile* tile, std::ostream& os);
 
     virtual void exportToPacketForUpdate(ODPacket& os, const Seat* seat) const override;
@@ -520,6 +534,9 @@ private:
     //! \brief The tile claiming. Used on server side only
     double mClaimedPercentage;
 
+    //! \brief The seat whose claimed tiles counter currently includes this tile. Used on server side only
+    Seat* mClaimedCounterSeat;
+
     //! \brief True if a building is on this tile. False otherwise. It is used on client side because the clients do not know about
     //! buildings. However, it needs to know the tiles where a building is to display the room/trap costs.
     bool mIsRoom;
@@ -536,6 +553,12 @@ private:
 
     uint32_t mTileCulling;
 
+    //! \brief Used on client side. true if a mesh refresh is queued in the gamemap
+    bool mIsMeshRefreshQueued;
+
+    //! \brief Used on client side. Cached tileset links with the neighbors (-1 if not computed)
+    int32_t mTileSetLinks;
+
     /*! \brief Set the fullness value for the tile.
      *  This only sets the fullness variable. This function is here to change the value
      *  before a map object has been set. setFullness is called once a map is assigned.
@@ -545,13 +568,16 @@ private:
 
     void setDirtyForAllSeats();
 
-    //! \brief Vector with the number of workers digging the tile. The index corresponds
-    //! to the index in mNeighbors
-    std::vector<uint32_t> mNbWorkersDigging;
-    uint32_t mNbWorkersClaiming;
     std::vector<TileStateListener*> mStateListeners;
 
     void fireTileStateChanged();
+
+    //! \brief Server side. Called when the claim state of this tile changes. Refreshes the claim jobs
+    //! of this tile and of its neighbors in the job board of every seat (see WorkerJobBoard)
+    void refreshWorkerJobs();
+
+    //! \brief Server side. Returns the job board of the seat of the given player (nullptr if none)
+    WorkerJobBoard* getPlayerJobBoard(const Player* player) const;
 };
 
 #endif // TILE_H
@@ -80,7 +80,13 @@ Seat::Seat(GameMap* gameMap) :
     mConfigPlayerId(-1),
     mConfigTeamId(-1),
     mConfigFactionIndex(-1),
-    mKoCreatures(false)
+    mKoCreatures(false),
+    mNumClaimedTilesCounter(0),
+    mGoldCounter(0),
+    mGoldMaxCounter(0),
+    mNumCreaturesWorkersCounter(0),
+    mNumCreaturesFightersCounter(0),
+    mWorkerJobBoard(this)
 {
 }
 
@@ -1873,7 +1879,7 @@ const CreatureDefinition* Seat::getNextFighterClassToSpawn(const GameMap& gameMa
         return nullptr;
 
     // We choose randomly a creature to spawn according to their points
-    int32_t cpt = Random::Int(0, nbPointsTotal - 1);
+    int32_t cpt = Random::getGenerator(RandomStream::spawning).Int(0, nbPointsTotal - 1);
     for(std::pair<const CreatureDefinition*, int32_t>& def : defSpawnable)
     {
         if(cpt < def.second)
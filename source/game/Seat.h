@@ -19,6 +19,7 @@
 #define SEAT_H
 
 #include "game/SeatData.h"
+#include "game/WorkerJobBoard.h"
 
 #include <OgreVector3.h>
 #include <OgreColourValue.h>
@@ -167,6 +168,30 @@ public:
     inline void addGoldMined(int quantity)
     { mGoldMined += quantity; }
 
+    //! \brief Server side. Open dig and claim jobs for the workers of this seat
+    inline WorkerJobBoard& getWorkerJobBoard()
+    { return mWorkerJobBoard; }
+
+    //! \brief Server side functions called by the tiles, rooms and creatures when their
+    //! state changes so that the seat aggregates do not have to be recomputed at each turn.
+    //! The counters are published to the seat data in GameMap::doMiscUpkeep
+    inline void updateClaimedTilesCounter(int delta)
+    { mNumClaimedTilesCounter += delta; }
+
+    inline void updateGoldCounters(int goldDelta, int goldMaxDelta)
+    {
+        mGoldCounter += goldDelta;
+        mGoldMaxCounter += goldMaxDelta;
+    }
+
+    inline void updateCreaturesCounters(bool isWorker, int delta)
+    {
+        if(isWorker)
+            mNumCreaturesWorkersCounter += delta;
+        else
+            mNumCreaturesFightersCounter += delta;
+    }
+
     inline bool getIsDebuggingVision()
     { return mIsDebuggingVision; }
 
@@ -395,6 +420,16 @@ private:
     //! \brief Should the creatures fight to death or ko enemy creatures
     bool mKoCreatures;
 
+    //! \brief Aggregates maintained incrementally on server side (see updateClaimedTilesCounter,
+    //! updateGoldCounters and updateCreaturesCounters)
+    int mNumClaimedTilesCounter;
+    int mGoldCounter;
+    int mGoldMaxCounter;
+    int mNumCreaturesWorkersCounter;
+    int mNumCreaturesFightersCounter;
+
+    WorkerJobBoard mWorkerJobBoard;
+
     //! \brief Server side function. Sets mCurrentSkill to the first entry in mSkillPending. If the pending
     //! list in empty, mCurrentSkill will be set to null
     //! researchedType is the currently researched type if any (nullSkillType if none)
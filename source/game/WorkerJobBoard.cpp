@@ -0,0 +1,276 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "game/WorkerJobBoard.h"
+
+#include "entities/Creature.h"
+#include "entities/Tile.h"
+#include "game/Seat.h"
+#include "gamemap/GameMap.h"
+#include "utils/ConfigManager.h"
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <algorithm>
+
+//! \brief Size (in tiles) of the buckets the jobs are stored in
+static const int BUCKET_SIZE = 8;
+
+WorkerJobBoard::WorkerJobBoard(Seat* seat) :
+    mSeat(seat)
+{
+    mNbJobs.fill(0);
+}
+
+void WorkerJobBoard::addDigJob(Tile& tile)
+{
+    addJob(WorkerJobType::dig, tile);
+}
+
+void WorkerJobBoard::removeDigJob(Tile& tile)
+{
+    removeJob(WorkerJobType::dig, tile);
+}
+
+void WorkerJobBoard::refreshClaimJobs(Tile& tile)
+{
+    if(isClaimGroundJob(tile))
+        addJob(WorkerJobType::claimGround, tile);
+    else
+        removeJob(WorkerJobType::claimGround, tile);
+
+    if(tile.isWallClaimable(mSeat))
+        addJob(WorkerJobType::claimWall, tile);
+    else
+        removeJob(WorkerJobType::claimWall, tile);
+}
+
+void WorkerJobBoard::getJobsAround(WorkerJobType type, const Tile& center, int radius, std::vector<Tile*>& jobs) const
+{
+    if(mNbJobs[static_cast<std::size_t>(type)] == 0)
+        return;
+
+    int radiusSquared = radius * radius;
+    std::pair<int, int> keyMin = getBucketKey(center.getX() - radius, center.getY() - radius);
+    std::pair<int, int> keyMax = getBucketKey(center.getX() + radius, center.getY() + radius);
+    for(int bucketX = keyMin.first; bucketX <= keyMax.first; ++bucketX)
+    {
+        for(int bucketY = keyMin.second; bucketY <= keyMax.second; ++bucketY)
+        {
+            auto it = mBuckets.find(std::make_pair(bucketX, bucketY));
+            if(it == mBuckets.end())
+                continue;
+
+            for(Tile* tile : it->second[static_cast<std::size_t>(type)])
+            {
+                int diffX = tile->getX() - center.getX();
+                int diffY = tile->getY() - center.getY();
+                if((diffX * diffX) + (diffY * diffY) > radiusSquared)
+                    continue;
+
+                jobs.push_back(tile);
+            }
+        }
+    }
+}
+
+uint32_t WorkerJobBoard::getNbJobs(WorkerJobType type) const
+{
+    return mNbJobs[static_cast<std::size_t>(type)];
+}
+
+bool WorkerJobBoard::canReserveClaimJob(const Tile& tile) const
+{
+    auto it = mClaimReservations.find(&tile);
+    if(it == mClaimReservations.end())
+        return true;
+
+    return it->second < ConfigManager::getSingleton().getNbWorkersClaimSameTile();
+}
+
+bool WorkerJobBoard::reserveClaimJob(const Tile& tile)
+{
+    if(!canReserveClaimJob(tile))
+        return false;
+
+    ++mClaimReservations[&tile];
+    return true;
+}
+
+void WorkerJobBoard::releaseClaimJob(const Tile& tile)
+{
+    auto it = mClaimReservations.find(&tile);
+    if(it == mClaimReservations.end())
+    {
+        OD_LOG_ERR("No claim reservation on tile=" + Tile::displayAsString(&tile));
+        return;
+    }
+
+    if(--it->second == 0)
+        mClaimReservations.erase(it);
+}
+
+void WorkerJobBoard::getFreeDigSpots(const Creature& worker, Tile& tileDig, std::vector<Tile*>& spots) const
+{
+    Tile* myTile = worker.getPositionTile();
+    if (myTile == nullptr)
+    {
+        OD_LOG_ERR("worker=" + worker.getName() + ", pos=" + Helper::toString(worker.getPosition()));
+        return;
+    }
+
+    for(Tile* neigh : tileDig.getAllNeighbors())
+    {
+        if(neigh->isFullTile())
+            continue;
+
+        auto it = mDigReservations.find(std::make_pair(&tileDig, neigh));
+        if((it != mDigReservations.end()) &&
+           (it->second >= ConfigManager::getSingleton().getNbWorkersDigSameFaceTile()))
+        {
+            continue;
+        }
+
+        if(!tileDig.getGameMap()->pathExists(&worker, myTile, neigh))
+            continue;
+
+        spots.push_back(neigh);
+    }
+}
+
+bool WorkerJobBoard::reserveDigJob(const Tile& tileDig, const Tile& tilePos)
+{
+    uint32_t& nbWorkers = mDigReservations[std::make_pair(&tileDig, &tilePos)];
+    if(nbWorkers >= ConfigManager::getSingleton().getNbWorkersDigSameFaceTile())
+        return false;
+
+    ++nbWorkers;
+    return true;
+}
+
+void WorkerJobBoard::releaseDigJob(const Tile& tileDig, const Tile& tilePos)
+{
+    auto it = mDigReservations.find(std::make_pair(&tileDig, &tilePos));
+    if(it == mDigReservations.end())
+    {
+        OD_LOG_ERR("No dig reservation on tile=" + Tile::displayAsString(&tileDig)
+            + ", pos=" + Tile::displayAsString(&tilePos));
+        return;
+    }
+
+    if(--it->second == 0)
+        mDigReservations.erase(it);
+}
+
+bool WorkerJobBoard::isTileUpToDate(Tile& tile) const
+{
+    Player* player = mSeat->getPlayer();
+    bool isDigJob = (player != nullptr) && tile.getMarkedForDigging(player);
+    if(hasJob(WorkerJobType::dig, tile) != isDigJob)
+        return false;
+    if(hasJob(WorkerJobType::claimGround, tile) != isClaimGroundJob(tile))
+        return false;
+    if(hasJob(WorkerJobType::claimWall, tile) != tile.isWallClaimable(mSeat))
+        return false;
+
+    return true;
+}
+
+void WorkerJobBoard::clear()
+{
+    mBuckets.clear();
+    mNbJobs.fill(0);
+    mClaimReservations.clear();
+    mDigReservations.clear();
+}
+
+void WorkerJobBoard::addJob(WorkerJobType type, Tile& tile)
+{
+    std::vector<Tile*>& jobs = mBuckets[getBucketKey(tile.getX(), tile.getY())][static_cast<std::size_t>(type)];
+    if(std::find(jobs.begin(), jobs.end(), &tile) != jobs.end())
+        return;
+
+    jobs.push_back(&tile);
+    ++mNbJobs[static_cast<std::size_t>(type)];
+}
+
+void WorkerJobBoard::removeJob(WorkerJobType type, Tile& tile)
+{
+    auto itBucket = mBuckets.find(getBucketKey(tile.getX(), tile.getY()));
+    if(itBucket == mBuckets.end())
+        return;
+
+    JobBucket& bucket = itBucket->second;
+    std::vector<Tile*>& jobs = bucket[static_cast<std::size_t>(type)];
+    auto it = std::find(jobs.begin(), jobs.end(), &tile);
+    if(it == jobs.end())
+        return;
+
+    // The order of the jobs does not matter
+    *it = jobs.back();
+    jobs.pop_back();
+    --mNbJobs[static_cast<std::size_t>(type)];
+
+    for(const std::vector<Tile*>& bucketJobs : bucket)
+    {
+        if(!bucketJobs.empty())
+            return;
+    }
+    mBuckets.erase(itBucket);
+}
+
+bool WorkerJobBoard::hasJob(WorkerJobType type, const Tile& tile) const
+{
+    auto itBucket = mBuckets.find(getBucketKey(tile.getX(), tile.getY()));
+    if(itBucket == mBuckets.end())
+        return false;
+
+    const std::vector<Tile*>& jobs = itBucket->second[static_cast<std::size_t>(type)];
+    return std::find(jobs.begin(), jobs.end(), &tile) != jobs.end();
+}
+
+bool WorkerJobBoard::isClaimGroundJob(Tile& tile) const
+{
+    if(tile.isFullTile())
+        return false;
+    if(!tile.isGroundClaimable(mSeat))
+        return false;
+
+    // A ground tile can only be claimed next to a tile already claimed by the seat
+    for(Tile* neigh : tile.getAllNeighbors())
+    {
+        if(neigh->isFullTile())
+            continue;
+        if(!neigh->isClaimedForSeat(mSeat))
+            continue;
+        if(neigh->getClaimedPercentage() < 1.0)
+            continue;
+
+        return true;
+    }
+
+    return false;
+}
+
+std::pair<int, int> WorkerJobBoard::getBucketKey(int x, int y)
+{
+    // Tiles outside the map may be given when computing the buckets around a tile. We make
+    // sure negative coordinates are rounded down
+    int bucketX = (x >= 0) ? (x / BUCKET_SIZE) : -((-x + BUCKET_SIZE - 1) / BUCKET_SIZE);
+    int bucketY = (y >= 0) ? (y / BUCKET_SIZE) : -((-y + BUCKET_SIZE - 1) / BUCKET_SIZE);
+    return std::make_pair(bucketX, bucketY);
+}
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WORKERJOBBOARD_H
+#define WORKERJOBBOARD_H
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+class Creature;
+class Seat;
+class Tile;
+
+enum class WorkerJobType
+{
+    dig,
+    claimGround,
+    claimWall,
+    nbWorkerJobTypes
+};
+
+/*! \brief Open dig and claim jobs of a seat. Used on server side only.
+ *
+ * The board is kept up to date by the tiles: dig jobs are added/removed when the seat player marks/unmarks
+ * a tile (see Tile::setMarkedForDigging) and claim jobs are refreshed when the claim state of a tile or of
+ * one of its neighbors changes (see Tile::refreshWorkerJobs).
+ * The jobs are stored in square buckets of tiles so that a worker only goes through the jobs around it instead
+ * of testing every tile within its sight radius. A job on the board is only a candidate: the worker still checks
+ * that the tile can be worked on and that there is a free spot it can reach.
+ * The board also holds the reservations of the jobs. A worker reserves a job when it starts working on it (see
+ * CreatureActionDigTile, CreatureActionClaimGroundTile and CreatureActionClaimWallTile) and releases it when it
+ * stops. A reservation fails when the limits from ConfigManager are reached. Creature actions are processed one
+ * after the other on the server so checking and reserving cannot interleave between workers.
+ * Carrying jobs are not on the board. Whether an entity can be carried depends on its state (KO, dead, gold left,
+ * covering treasury) and on the free spots of the buildings, which change on events the tiles do not report.
+ * CreatureActionSearchEntityToCarry still looks for them in the tiles within the worker sight radius. Listing them
+ * here is left to a follow-up request.
+ */
+class WorkerJobBoard
+{
+public:
+    WorkerJobBoard(Seat* seat);
+
+    void addDigJob(Tile& tile);
+    void removeDigJob(Tile& tile);
+
+    //! \brief Adds or removes the ground and wall claim jobs of the given tile depending on its current state
+    void refreshClaimJobs(Tile& tile);
+
+    //! \brief Fills jobs with the jobs of the given type within radius around the given tile (same
+    //! region as TileContainer::circularRegion)
+    void getJobsAround(WorkerJobType type, const Tile& center, int radius, std::vector<Tile*>& jobs) const;
+
+    uint32_t getNbJobs(WorkerJobType type) const;
+
+    //! \brief Returns true if the ground or wall claim job on the given tile can still be reserved.
+    //! Note that by nature, a tile cannot be claimed for wall and ground. Because of that, both
+    //! use the same reservations
+    bool canReserveClaimJob(const Tile& tile) const;
+    //! \brief Reserves the claim job on the given tile. Returns false if it cannot be reserved
+    bool reserveClaimJob(const Tile& tile);
+    void releaseClaimJob(const Tile& tile);
+
+    //! \brief Fills spots with the neighbors of tileDig the worker can reach and from where
+    //! tileDig can still be dug
+    void getFreeDigSpots(const Creature& worker, Tile& tileDig, std::vector<Tile*>& spots) const;
+    //! \brief Reserves the spot tilePos to dig tileDig. Returns false if it cannot be reserved
+    bool reserveDigJob(const Tile& tileDig, const Tile& tilePos);
+    void releaseDigJob(const Tile& tileDig, const Tile& tilePos);
+
+    //! \brief Returns true if the jobs of the given tile on the board match the current state of the tile.
+    //! Used to check the board in debug builds
+    bool isTileUpToDate(Tile& tile) const;
+
+    void clear();
+
+private:
+    typedef std::array<std::vector<Tile*>, static_cast<std::size_t>(WorkerJobType::nbWorkerJobTypes)> JobBucket;
+
+    Seat* mSeat;
+
+    //! \brief Buckets of BUCKET_SIZE x BUCKET_SIZE tiles indexed by their position. Empty buckets are removed
+    std::map<std::pair<int, int>, JobBucket> mBuckets;
+
+    std::array<uint32_t, static_cast<std::size_t>(WorkerJobType::nbWorkerJobTypes)> mNbJobs;
+
+    //! \brief Number of workers claiming each tile
+    std::map<const Tile*, uint32_t> mClaimReservations;
+
+    //! \brief Number of workers digging each tile (first) from each neighbor (second)
+    std::map<std::pair<const Tile*, const Tile*>, uint32_t> mDigReservations;
+
+    void addJob(WorkerJobType type, Tile& tile);
+    void removeJob(WorkerJobType type, Tile& tile);
+    bool hasJob(WorkerJobType type, const Tile& tile) const;
+
+    //! \brief Returns true if the given tile is a ground tile that can be claimed by the seat
+    bool isClaimGroundJob(Tile& tile) const;
+
+    static std::pair<int, int> getBucketKey(int x, int y);
+};
+
+#endif // WORKERJOBBOARD_H
@@ -60,6 +60,8 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/ResourceManager.h"
+#include "utils/WorkerPool.h"
+#include "ODApplication.h"
 
 #include <OgreTimer.h>
 
@@ -67,12 +69,32 @@
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
 
 const std::string DEFAULT_NICK = "You";
 
+//! \brief Minimum number of creatures handled by each task when computing the creatures senses.
+//! Under that, handing the task to a worker costs more than it saves
+const uint32_t MIN_CREATURES_PER_SENSES_TASK = 32;
+
+//! \brief Bounds of the ratio between server and client time. It protects the estimation of the
+//! server time from turns delayed by network hiccups
+const double MIN_CLIENT_TIME_RATE = 0.5;
+const double MAX_CLIENT_TIME_RATE = 1.5;
+
+//! \brief When the next turn is late, the client keeps estimating the server time until this
+//! ratio of the last turn duration is reached
+const double MAX_TURN_EXTRAPOLATION = 1.5;
+
+#ifdef OD_DEBUG
+//! \brief Number of turns between 2 checks of the seat counters against a full recount
+const int64_t SEAT_COUNTERS_CHECK_PERIOD = 10;
+#endif // OD_DEBUG
+
 using namespace std;
 
 /*! \brief A helper class for the A* search in the GameMap::path function.
@@ -156,13 +178,21 @@ GameMap::GameMap(bool isServerGameMap) :
         mLocalPlayer(nullptr),
         mLocalPlayerNick(DEFAULT_NICK),
         mTurnNumber(-1),
+        mTurnStartTime(0.0),
+        mTurnDuration(1.0 / ODApplication::turnsPerSecond),
+        mTimeSinceTurnStart(0.0),
+        mClientTimeRate(1.0),
+        mAnimationViewTarget(Ogre::Vector3::ZERO),
         mIsPaused(false),
         mTimePayDay(0),
         mFloodFillEnabled(false),
         mIsFOWActivated(true),
         mNumCallsTo_path(0),
+        mWorkerPool(isServerGameMap ? new WorkerPool(WorkerPool::getDefaultNbWorkers()) : nullptr),
+        mIsEntityAddedSinceCreaturesSenses(false),
         mAiManager(*this),
-        mTileSet(nullptr)
+        mTileSet(nullptr),
+        mRandomSeed(0)
 {
     resetUniqueNumbers();
 }
@@ -257,6 +287,9 @@ void GameMap::setAllFullnessAndNeighbors()
 
 void GameMap::clearAll()
 {
+    // The AIs listen to the tiles so they should be removed first
+    clearAiManager();
+
     clearCreatures();
     clearClasses();
     clearWeapons();
@@ -270,6 +303,7 @@ void GameMap::clearAll()
 
     processDeletionQueues();
 
+    mTilesToRefresh.clear();
     clearTiles();
     processDeletionQueues();
 
@@ -278,13 +312,16 @@ void GameMap::clearAll()
     mLocalPlayer = nullptr;
     clearPlayers();
 
-    clearAiManager();
-
     mLocalPlayerNick = DEFAULT_NICK;
     mTurnNumber = -1;
+    mTurnStartTime = 0.0;
+    mTurnDuration = 1.0 / ODApplication::turnsPerSecond;
+    mTimeSinceTurnStart = 0.0;
+    mClientTimeRate = 1.0;
     resetUniqueNumbers();
     mIsFOWActivated = true;
     mTimePayDay = 0;
+    mIsEntityAddedSinceCreaturesSenses = false;
 
     // We check if the different vectors are empty
     if(!mActiveObjects.empty())
@@ -490,6 +527,7 @@ void GameMap::addCreature(Creature *cc)
         + ", seatId=" + (cc->getSeat() != nullptr ? Helper::toString(cc->getSeat()->getId()) : std::string("null")));
 
     mCreatures.push_back(cc);
+    mIsEntityAddedSinceCreaturesSenses = true;
 }
 
 void GameMap::removeCreature(Creature *c)
@@ -936,6 +974,20 @@ void GameMap::createAllEntities()
             trap->updateActiveSpots();
         }
 
+        // Lists the claim jobs of the loaded map. They are then kept up to date by the tiles
+        // (see Tile::refreshWorkerJobs)
+        for (Seat* seat : mSeats)
+        {
+            WorkerJobBoard& jobBoard = seat->getWorkerJobBoard();
+            for (int jj = 0; jj < getMapSizeY(); ++jj)
+            {
+                for (int ii = 0; ii < getMapSizeX(); ++ii)
+                {
+                    jobBoard.refreshClaimJobs(*getTile(ii, jj));
+                }
+            }
+        }
+
         for (Creature* creature : mCreatures)
         {
             //Set up definition for creature. This was previously done in createMesh for some reason.
@@ -1096,9 +1148,42 @@ void GameMap::doPlayerAITurn(double timeSinceLastTurn)
     mAiManager.doTurn(timeSinceLastTurn);
 }
 
+void GameMap::computeCreaturesUpkeepSenses()
+{
+    // Computing the senses only reads the gamemap and each creature only writes its own
+    // data. We can split the creatures between the workers. Since the results do not
+    // depend on the order, they will be the same whatever the number of workers
+    mIsEntityAddedSinceCreaturesSenses = false;
+    const uint32_t nbCreatures = mCreatures.size();
+    uint32_t nbTasks = mWorkerPool->getNbWorkers() + 1;
+    nbTasks = std::min(nbTasks, nbCreatures / MIN_CREATURES_PER_SENSES_TASK);
+    if(nbTasks <= 1)
+    {
+        for(Creature* creature : mCreatures)
+            creature->computeUpkeepSenses();
+
+        return;
+    }
+
+    ODServer* server = ODServer::getSingletonPtr();
+    std::vector<std::function<void()>> tasks;
+    uint32_t nbCreaturesPerTask = (nbCreatures + nbTasks - 1) / nbTasks;
+    for(uint32_t begin = 0; begin < nbCreatures; begin += nbCreaturesPerTask)
+    {
+        uint32_t end = std::min(begin + nbCreaturesPerTask, nbCreatures);
+        tasks.emplace_back([this, server, begin, end]()
+        {
+            ODServer::ThreadBinding binding(server);
+            for(uint32_t i = begin; i < end; ++i)
+                mCreatures[i]->computeUpkeepSenses();
+        });
+    }
+
+    mWorkerPool->run(tasks);
+}
+
 unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
 {
-    Tile *tempTile;
     Ogre::Timer stopwatch;
     unsigned long int timeTaken;
 
@@ -1116,20 +1201,7 @@ unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
                 continue;
 
             // We notify the player if he owns a fighter only
-            bool isCreatureSeat = false;
-            for(Creature* creature : mCreatures)
-            {
-                if(creature->getSeat() != player->getSeat())
-                    continue;
-
-                if(creature->getDefinition()->isWorker())
-                    continue;
-
-                isCreatureSeat = true;
-                break;
-            }
-
-            if(!isCreatureSeat)
+            if(player->getSeat()->mNumCreaturesFightersCounter <= 0)
                 continue;
 
             ServerNotification *serverNotification = new ServerNotification(
@@ -1161,27 +1233,9 @@ unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
 
         seat->mNumCreaturesFightersMax = getMaxNumberCreatures(seat);
 
-        // Set the creatures count to 0. It will be reset by the next count in doTurn()
-        seat->mNumCreaturesFighters = 0;
-        seat->mNumCreaturesWorkers = 0;
-    }
-
-    // Count how many creatures the player controls
-    for(Creature* creature : mCreatures)
-    {
-        // Check to see if the creature has died.
-        if (!creature->isAlive())
-            continue;
-
-        Seat *tempSeat = creature->getSeat();
-        if(tempSeat == nullptr)
-            continue;
-
-        // We only count fighters
-        if (creature->getDefinition()->isWorker())
-            ++(tempSeat->mNumCreaturesWorkers);
-        else
-            ++(tempSeat->mNumCreaturesFighters);
+        // The creatures counters are maintained by the creatures themselves
+        seat->mNumCreaturesFighters = seat->mNumCreaturesFightersCounter;
+        seat->mNumCreaturesWorkers = seat->mNumCreaturesWorkersCounter;
     }
 
     // At each upkeep, we re-compute tiles with vision
@@ -1232,6 +1286,7 @@ unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
     // Here, we work on a copy of the active objects list because they might
     // try to remove themselves which would break the iterator
     std::vector<GameEntity*> activeObjects = mActiveObjects;
+    computeCreaturesUpkeepSenses();
     for(GameEntity* ge : activeObjects)
         ge->doUpkeep();
 
@@ -1260,42 +1315,96 @@ unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
         }
 
         // Update the count on how much gold is available in all of the treasuries claimed by the given seat.
-        seat->mGold = 0;
-        seat->mGoldMax = 0;
-        for (Room* room : getRooms())
-        {
-            if(room->getSeat() != seat)
-                continue;
-
-            seat->mGold += room->getTotalGoldStored();
-            seat->mGoldMax += room->getTotalGoldStorage();
-        }
+        // The gold counters are maintained by the rooms when gold is deposited/withdrawn
+        seat->mGold = seat->mGoldCounter;
+        seat->mGoldMax = seat->mGoldMaxCounter;
     }
 
-    // Determine the number of tiles claimed by each seat.
-    // Begin by setting the number of claimed tiles for each seat to 0.
+    // The number of tiles claimed by each seat is maintained by the tiles when they are claimed/unclaimed
     for (Seat* seat : mSeats)
-        seat->setNumClaimedTiles(0);
+        seat->setNumClaimedTiles(seat->mNumClaimedTilesCounter);
+
+#ifdef OD_DEBUG
+    if((mTurnNumber % SEAT_COUNTERS_CHECK_PERIOD) == 0)
+    {
+        checkSeatCounters();
+        checkWorkerJobBoards();
+    }
+#endif // OD_DEBUG
+
+    timeTaken = stopwatch.getMicroseconds();
+    return timeTaken;
+}
+
+#ifdef OD_DEBUG
+void GameMap::checkSeatCounters() const
+{
+    // We recompute every counter from scratch and compare with the incremental ones
+    std::map<const Seat*, int> nbClaimedTiles;
+    std::map<const Seat*, int> gold;
+    std::map<const Seat*, int> goldMax;
+    std::map<const Seat*, int> nbWorkers;
+    std::map<const Seat*, int> nbFighters;
 
-    // Now loop over all of the tiles, if the tile is claimed increment the given seats count.
     for (int jj = 0; jj < getMapSizeY(); ++jj)
     {
         for (int ii = 0; ii < getMapSizeX(); ++ii)
         {
-            tempTile = getTile(ii,jj);
+            Tile* tile = getTile(ii,jj);
+            if (tile->isClaimed())
+                ++nbClaimedTiles[tile->getSeat()];
+        }
+    }
+
+    for (Room* room : mRooms)
+    {
+        gold[room->getSeat()] += room->getTotalGoldStored();
+        goldMax[room->getSeat()] += room->getTotalGoldStorage();
+    }
 
-            // Check to see if the current tile is claimed by anyone.
-            if (tempTile->isClaimed())
+    for(Creature* creature : mCreatures)
+    {
+        if (!creature->isAlive())
+            continue;
+
+        if (creature->getDefinition()->isWorker())
+            ++nbWorkers[creature->getSeat()];
+        else
+            ++nbFighters[creature->getSeat()];
+    }
+
+    for (const Seat* seat : mSeats)
+    {
+        OD_ASSERT_TRUE_MSG(nbClaimedTiles[seat] == seat->mNumClaimedTilesCounter, "seatId=" + Helper::toString(seat->getId())
+            + ", claimed tiles=" + Helper::toString(nbClaimedTiles[seat]) + ", counter=" + Helper::toString(seat->mNumClaimedTilesCounter));
+        OD_ASSERT_TRUE_MSG(gold[seat] == seat->mGoldCounter, "seatId=" + Helper::toString(seat->getId())
+            + ", gold=" + Helper::toString(gold[seat]) + ", counter=" + Helper::toString(seat->mGoldCounter));
+        OD_ASSERT_TRUE_MSG(goldMax[seat] == seat->mGoldMaxCounter, "seatId=" + Helper::toString(seat->getId())
+            + ", goldMax=" + Helper::toString(goldMax[seat]) + ", counter=" + Helper::toString(seat->mGoldMaxCounter));
+        OD_ASSERT_TRUE_MSG(nbWorkers[seat] == seat->mNumCreaturesWorkersCounter, "seatId=" + Helper::toString(seat->getId())
+            + ", workers=" + Helper::toString(nbWorkers[seat]) + ", counter=" + Helper::toString(seat->mNumCreaturesWorkersCounter));
+        OD_ASSERT_TRUE_MSG(nbFighters[seat] == seat->mNumCreaturesFightersCounter, "seatId=" + Helper::toString(seat->getId())
+            + ", fighters=" + Helper::toString(nbFighters[seat]) + ", counter=" + Helper::toString(seat->mNumCreaturesFightersCounter));
+    }
+}
+
+void GameMap::checkWorkerJobBoards() const
+{
+    for (Seat* seat : mSeats)
+    {
+        const WorkerJobBoard& jobBoard = seat->getWorkerJobBoard();
+        for (int jj = 0; jj < getMapSizeY(); ++jj)
+        {
+            for (int ii = 0; ii < getMapSizeX(); ++ii)
             {
-                // Increment the count of the seat who owns the tile.
-                tempTile->getSeat()->incrementNumClaimedTiles();
+                Tile* tile = getTile(ii,jj);
+                OD_ASSERT_TRUE_MSG(jobBoard.isTileUpToDate(*tile), "seatId=" + Helper::toString(seat->getId())
+                    + ", tile=" + Tile::displayAsString(tile));
             }
         }
     }
-
-    timeTaken = stopwatch.getMicroseconds();
-    return timeTaken;
 }
+#endif // OD_DEBUG
 
 void GameMap::updateAnimations(Ogre::Real timeSinceLastFrame)
 {
@@ -1305,6 +1414,9 @@ void GameMap::updateAnimations(Ogre::Real timeSinceLastFrame)
     if(getTurnNumber() <= 0)
         return;
 
+    if(!isServerGameMap())
+        mTimeSinceTurnStart += timeSinceLastFrame;
+
     // Update the animations on all AnimatedObjects
     for(MovableGameEntity* mge : mAnimatedObjects)
         mge->update(timeSinceLastFrame);
@@ -1812,6 +1924,7 @@ void GameMap::addRoom(Room *r)
     }
 
     mRooms.push_back(r);
+    mIsEntityAddedSinceCreaturesSenses = true;
 }
 
 void GameMap::removeRoom(Room *r)
@@ -1972,6 +2085,7 @@ void GameMap::addTrap(Trap *trap)
         + Helper::toString(nbTiles) + ", seatId=" + Helper::toString(trap->getSeat()->getId()));
 
     mTraps.push_back(trap);
+    mIsEntityAddedSinceCreaturesSenses = true;
 }
 
 void GameMap::removeTrap(Trap *t)
@@ -2476,15 +2590,36 @@ void GameMap::processDeletionQueues()
 
 void GameMap::refreshBorderingTilesOf(const std::vector<Tile*>& affectedTiles)
 {
-    // Add the tiles which border the affected region to the affectedTiles vector since they may need to have their meshes changed.
-    std::vector<Tile*> borderTiles = tilesBorderedByRegion(affectedTiles);
+    // The affected tiles and their neighbors may need to have their meshes changed because
+    // the links between them may have changed. The refreshes are queued so that a tile bordering
+    // several affected tiles is only refreshed once
+    for (Tile* tile : affectedTiles)
+    {
+        tile->invalidateTileSetLinks();
+        tile->refreshMesh();
+        for (Tile* neighbor : tile->getAllNeighbors())
+        {
+            neighbor->invalidateTileSetLinks();
+            neighbor->refreshMesh();
+        }
+    }
+}
 
-    borderTiles.insert(borderTiles.end(), affectedTiles.begin(), affectedTiles.end());
+void GameMap::queueTileMeshRefresh(Tile* tile)
+{
+    mTilesToRefresh.push_back(tile);
+}
 
-    // Loop over all the affected tiles and force them to examine their neighbors.  This allows
-    // them to switch to a mesh with fewer polygons if some are hidden by the neighbors, etc.
-    for (Tile* tile : borderTiles)
-        tile->refreshMesh();
+void GameMap::processTileMeshRefreshes()
+{
+    if(mTilesToRefresh.empty())
+        return;
+
+    // We swap to allow refreshes to queue tiles for the next frame
+    std::vector<Tile*> tiles;
+    tiles.swap(mTilesToRefresh);
+    for (Tile* tile : tiles)
+        tile->refreshMeshNow();
 }
 
 std::vector<Tile*> GameMap::getBuildableTilesForPlayerInArea(int x1, int y1, int x2, int y2,
@@ -2887,6 +3022,42 @@ std::vector<Spell*> GameMap::getSpellsBySeatAndType(Seat* seat, SpellType type)
     return ret;
 }
 
+//! \brief Streams drawn directly by the server. The other streams are only used to derive the
+//! generators of the entities (or by the client)
+static const RandomStream SERVER_RANDOM_STREAMS[] = { RandomStream::game, RandomStream::room, RandomStream::spawning };
+
+bool GameMap::restoreRandomGenerator(const std::string& key, RandomGenerator& generator) const
+{
+    auto it = mSavedRandomGenerators.find(key);
+    if(it == mSavedRandomGenerators.end())
+        return false;
+
+    generator = it->second;
+    return true;
+}
+
+void GameMap::initRandomGenerators()
+{
+    Random::initialize(mRandomSeed);
+    for(RandomStream stream : SERVER_RANDOM_STREAMS)
+        restoreRandomGenerator(Random::getStateKey(stream), Random::getGenerator(stream));
+
+    // The creatures read from the level were created before the match seed was known
+    for(Creature* creature : mCreatures)
+        creature->initRandomGenerator();
+}
+
+void GameMap::getRandomGenerators(std::map<std::string, RandomGenerator>& generators) const
+{
+    for(RandomStream stream : SERVER_RANDOM_STREAMS)
+        generators[Random::getStateKey(stream)] = Random::getGenerator(stream);
+
+    for(const Creature* creature : mCreatures)
+        generators[creature->getRandomStateKey()] = creature->getRandomGenerator();
+
+    mAiManager.getRandomGenerators(generators);
+}
+
 const std::string& GameMap::getMeshForDefaultTile() const
 {
     // 0 means tile not linked to any neighboor
@@ -2895,7 +3066,16 @@ const std::string& GameMap::getMeshForDefaultTile() const
 
 const TileSetValue& GameMap::getMeshForTile(const Tile* tile) const
 {
-    int index = 0;
+    int32_t index = tile->getTileSetLinks();
+    if(index < 0)
+        index = computeTileSetLinks(tile);
+
+    return mTileSet->getTileValues(tile->getTileVisual()).at(index);
+}
+
+int32_t GameMap::computeTileSetLinks(const Tile* tile) const
+{
+    int32_t index = 0;
     for(int i = 0; i < 4; ++i)
     {
         int diffX;
@@ -2928,7 +3108,7 @@ const TileSetValue& GameMap::getMeshForTile(const Tile* tile) const
             index |= (1 << i);
     }
 
-    return mTileSet->getTileValues(tile->getTileVisual()).at(index);
+    return index;
 }
 
 uint32_t GameMap::getMaxNumberCreatures(Seat* seat) const
@@ -3045,9 +3225,20 @@ void GameMap::removeClientUpkeepEntity(GameEntity* entity)
     mGameEntityClientUpkeep.erase(it);
 }
 
-void GameMap::clientUpKeep(int64_t turnNumber)
+void GameMap::clientUpKeep(int64_t turnNumber, double turnStartTime)
 {
+    // We measure how fast the server time goes compared to ours to smooth the estimation of
+    // the server time. The server is a little late on purpose (see ODServer::serverThread)
+    double turnDuration = turnStartTime - mTurnStartTime;
+    if((turnNumber > 1) && (turnDuration > 0.0) && (mTimeSinceTurnStart > 0.0))
+    {
+        mTurnDuration = turnDuration;
+        mClientTimeRate = std::min(std::max(turnDuration / mTimeSinceTurnStart, MIN_CLIENT_TIME_RATE), MAX_CLIENT_TIME_RATE);
+    }
+
     mTurnNumber = turnNumber;
+    mTurnStartTime = turnStartTime;
+    mTimeSinceTurnStart = 0.0;
     mLocalPlayer->decreaseSpellCooldowns();
 
     for(GameEntity* entity : mGameEntityClientUpkeep)
@@ -3056,6 +3247,12 @@ void GameMap::clientUpKeep(int64_t turnNumber)
     }
 }
 
+double GameMap::getClientServerTime() const
+{
+    double elapsed = std::min(mTimeSinceTurnStart * mClientTimeRate, mTurnDuration * MAX_TURN_EXTRAPOLATION);
+    return mTurnStartTime + elapsed;
+}
+
 void GameMap::doorLock(Tile* tileDoor, Seat* seat, bool locked)
 {
     if(!locked)
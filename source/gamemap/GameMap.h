@@ -21,6 +21,7 @@
 #include "gamemap/TileContainer.h"
 
 #include "ai/AIManager.h"
+#include "utils/Random.h"
 
 #ifdef __MINGW32__
 #ifndef mode_t
@@ -28,6 +29,7 @@
 #endif //mode_t
 #endif //mingw32
 
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -53,6 +55,7 @@ class Room;
 class Spell;
 class TileSet;
 class TileSetValue;
+class WorkerPool;
 
 enum class GameEntityType;
 enum class FloodFillType;
@@ -343,6 +346,16 @@ public:
 
     void doPlayerAITurn(double timeSinceLastTurn);
 
+    //! \brief Threads used for the parallel parts of the turns. Only created on server side
+    inline WorkerPool& getWorkerPool()
+    { return *mWorkerPool; }
+
+    //! \brief Returns true if a creature, a room or a trap has been added since the creatures senses were
+    //! computed for the current upkeep. In this case, the creatures upkept after that compute their senses
+    //! again so that they sense the new entity like they would have without the parallel senses
+    inline bool isEntityAddedSinceCreaturesSenses() const
+    { return mIsEntityAddedSinceCreaturesSenses; }
+
     //! \brief Tells whether a path exists between two tiles for the given creature.
     bool pathExists(const Creature* creature, Tile* tileStart, Tile* tileEnd);
 
@@ -419,12 +432,33 @@ public:
     //! \brief Updates the different entities animations.
     void updateAnimations(Ogre::Real timeSinceLastFrame);
 
+    //! \brief Client side. Ground point the main camera looks at. The skeletal animations of the entities
+    //! far from it are updated less often (see MovableGameEntity::update)
+    inline void setAnimationViewTarget(const Ogre::Vector3& viewTarget)
+    { mAnimationViewTarget = viewTarget; }
+
+    inline const Ogre::Vector3& getAnimationViewTarget() const
+    { return mAnimationViewTarget; }
+
     inline int64_t getTurnNumber() const
     { return mTurnNumber; }
 
     inline void setTurnNumber(int64_t turnNumber)
     { mTurnNumber = turnNumber; }
 
+    //! \brief Time in seconds at which the current turn started on the server. The server
+    //! sends it to the clients with each new turn
+    inline double getTurnStartTime() const
+    { return mTurnStartTime; }
+
+    inline void setTurnStartTime(double turnStartTime)
+    { mTurnStartTime = turnStartTime; }
+
+    //! \brief Client side estimation of the current server time. It is computed from the last turn
+    //! start time and the time elapsed since it was received. If the next turn is late, it stops
+    //! a little after the expected turn end so that the entities do not get ahead of the server
+    double getClientServerTime() const;
+
     inline bool isServerGameMap() const
     { return mIsServerGameMap; }
 
@@ -437,6 +471,12 @@ public:
     //! \brief Refresh the tiles borders based a recent change on the map
     void refreshBorderingTilesOf(const std::vector<Tile*>& affectedTiles);
 
+    //! \brief Adds the given tile to the tiles to refresh. Should only be called by Tile::refreshMesh
+    void queueTileMeshRefresh(Tile* tile);
+
+    //! \brief Refreshes the meshes of the queued tiles. Should be called once per frame before rendering
+    void processTileMeshRefreshes();
+
     std::vector<Tile*> getBuildableTilesForPlayerInArea(int x1, int y1, int x2, int y2,
         Player* player);
 
@@ -505,17 +545,47 @@ public:
     inline const std::string& getTileSetName() const
     { return mTileSetName; }
 
+    //! \brief Seed of the random generators for the match played on this gamemap. 0 means
+    //! no seed has been set yet. It is saved with the level so that a match can be replayed
+    inline void setRandomSeed(uint64_t randomSeed)
+    { mRandomSeed = randomSeed; }
+
+    inline uint64_t getRandomSeed() const
+    { return mRandomSeed; }
+
+    //! \brief Keeps a generator state read from a saved game. It is restored when the generator
+    //! is initialized (see restoreRandomGenerator)
+    inline void setSavedRandomGenerator(const std::string& key, const RandomGenerator& generator)
+    { mSavedRandomGenerators[key] = generator; }
+
+    inline void clearSavedRandomGenerators()
+    { mSavedRandomGenerators.clear(); }
+
+    //! \brief Sets generator to the state saved with the level under the given key (see Random::getStateKey).
+    //! Returns false if there is none
+    bool restoreRandomGenerator(const std::string& key, RandomGenerator& generator) const;
+
+    //! \brief Seeds the random streams and the creature generators from the match seed. The generators
+    //! saved with the level continue from their saved state
+    void initRandomGenerators();
+
+    //! \brief Fills generators with the generators of the match (streams, creatures and AIs) keyed
+    //! by Random::getStateKey. They are saved with the level so that a saved game continues the same sequences
+    void getRandomGenerators(std::map<std::string, RandomGenerator>& generators) const;
+
     //! \brief getMeshForDefaultTile returns a mesh for some default dirt tile. This
     //! is used as a workaround to avoid lightning issues
     const std::string& getMeshForDefaultTile() const;
     //! \brief get the tileset infos for the given tile
     const TileSetValue& getMeshForTile(const Tile* tile) const;
+    //! \brief Computes the tileset links of the given tile with its 4 neighbors
+    int32_t computeTileSetLinks(const Tile* tile) const;
 
     void playerSelects(std::vector<GameEntity*>& entities, int tileX1, int tileY1, int tileX2,
         int tileY2, SelectionTileAllowed tileAllowed, SelectionEntityWanted entityWanted, Player* player);
 
     //! \brief Called on client side each time a new turn is received
-    void clientUpKeep(int64_t turnNumber);
+    void clientUpKeep(int64_t turnNumber, double turnStartTime);
 
     //! \brief Updates floodfill for the given seat. If locked is true, creatures from the given seat would
     //! not be allowed to go through the tile. If locked is false, creatures from the given seat will be
@@ -553,6 +623,17 @@ private:
     //! \brief The current server turn number.
     int64_t mTurnNumber;
 
+    //! \brief Server time at the start of the current turn (see getTurnStartTime)
+    double mTurnStartTime;
+    //! \brief Client side only. Server duration of the last turn, time elapsed since the current turn
+    //! has been received and ratio between server and client time measured on the last turn.
+    double mTurnDuration;
+    double mTimeSinceTurnStart;
+    double mClientTimeRate;
+
+    //! \brief Client side only. See setAnimationViewTarget
+    Ogre::Vector3 mAnimationViewTarget;
+
     //! \brief Unique numbers to ensure names are unique
     int mUniqueNumberCreature;
     int mUniqueNumberMissileObj;
@@ -615,8 +696,12 @@ private:
     //! \brief Useless entities that need to be deleted. They will be deleted when processDeletionQueues is called
     std::vector<GameEntity*> mEntitiesToDelete;
 
+    //! \brief Tiles whose mesh should be refreshed before the next frame is rendered
+    std::vector<Tile*> mTilesToRefresh;
+
     //! \brief Debug member used to know how many call to pathfinding has been made within the same turn.
-    unsigned int mNumCallsTo_path;
+    //! The AIs search paths while planning on the worker threads
+    std::atomic<unsigned int> mNumCallsTo_path;
 
     std::vector<RenderedMovableEntity*> mRenderedMovableEntities;
 
@@ -624,6 +709,13 @@ private:
 
     std::vector<int> mTeamIds;
 
+    //! \brief Created with the server gamemap and kept for the whole game so that no thread
+    //! is created during the turns
+    std::unique_ptr<WorkerPool> mWorkerPool;
+
+    //! \brief Set when a creature, a room or a trap is added and reset when the creatures senses are computed
+    bool mIsEntityAddedSinceCreaturesSenses;
+
     //! AI Handling manager
     AIManager mAiManager;
 
@@ -631,10 +723,30 @@ private:
     const TileSet* mTileSet;
     std::string mTileSetName;
 
+    uint64_t mRandomSeed;
+
+    //! \brief Generator states read from a saved game, keyed by Random::getStateKey
+    std::map<std::string, RandomGenerator> mSavedRandomGenerators;
+
     //! \brief Updates different entities states.
     //! Updates active objects (creatures, rooms, ...), goals, count each team Workers, gold, mana and claimed tiles.
     unsigned long int doMiscUpkeep(double timeSinceLastTurn);
 
+    //! \brief Computes the senses of every creature before their upkeep. It may use several threads.
+    //! The senses are a snapshot of the gamemap at the start of the upkeep: an entity moving during the upkeep
+    //! is sensed where it was at that time and will be sensed at its new position on the next turn. Entities
+    //! added during the upkeep are handled by isEntityAddedSinceCreaturesSenses
+    void computeCreaturesUpkeepSenses();
+
+#ifdef OD_DEBUG
+    //! \brief Recomputes the seat counters (claimed tiles, gold, creatures) by scanning the whole
+    //! gamemap and checks they match the ones maintained incrementally
+    void checkSeatCounters() const;
+
+    //! \brief Checks that the worker job board of every seat matches the state of the tiles
+    void checkWorkerJobBoards() const;
+#endif // OD_DEBUG
+
     //! \brief Resets the unique numbers
     void resetUniqueNumbers();
 };
@@ -1,4 +1,4 @@
-/*
+/*!
  *  Copyright (C) 2011-2016  OpenDungeons Team
  *
  *  This program is free software: you can redistribute it and/or modify
@@ -15,28 +15,28 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#ifndef CULLINGVECTORMANAGER_H_
-#define CULLINGVECTORMANAGER_H_
+#include "gamemap/GameMapSnapshot.h"
 
-#include "utils/VectorInt64.h"
+#include <sstream>
 
-#include <array>
-#include <vector>
-
-/*! \brief The DummyArrayClass class is a wrapper 
- *  around the std::array mainly to overload the 
- *  operator [].        
- */
+uint64_t GameMapSnapshot::getSize() const
+{
+    return static_cast<uint64_t>(mText.size() + mTiles.size() * sizeof(LevelFile::TileRecord));
+}
 
+void GameMapSnapshot::clear()
+{
+    std::string().swap(mText);
+    std::vector<LevelFile::TileRecord>().swap(mTiles);
+}
 
-class CullingVectorManager
+bool GameMapSnapshot::buildLevel(LevelFile::LevelData& level, std::string& error) const
 {
-public:
-    VectorInt64& operator[](int ii) ;
-    void sort();
-    void sortByPhi(std::vector<VectorInt64> &ll, VectorInt64& cc);
-    void zoom(double);
-    std::vector<VectorInt64>  mMyArray;
-};
+    std::stringstream levelText(mText);
+    if(!LevelFile::parseText(LevelFile::removeComments(levelText), level, error))
+        return false;
 
-#endif // CULLINGVECTORMANAGER_H_
+    // The map size is in the tiles section of the text
+    level.mTiles = mTiles;
+    return true;
+}
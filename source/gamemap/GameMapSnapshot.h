@@ -0,0 +1,57 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GAMEMAPSNAPSHOT_H
+#define GAMEMAPSNAPSHOT_H
+
+#include "gamemap/LevelFile.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*! \brief State of the gamemap taken between 2 turns to be saved later on another thread.
+ *
+ * The snapshot is the level text of the gamemap (with an empty tiles section) and the tile records.
+ * Building the text blocks the turn but it uses the regular entity exports so that the entities only
+ * have one serialization. Splitting the text in sections and writing the binary file (see buildLevel
+ * and LevelFile::writeBinary) do not access the gamemap so they are done by GameSaveWriter.
+ */
+class GameMapSnapshot
+{
+public:
+    //! \brief Sets the level text (with an empty tiles section). text is swapped
+    inline void setText(std::string& text)
+    { mText.swap(text); }
+
+    inline std::vector<LevelFile::TileRecord>& getTiles()
+    { return mTiles; }
+
+    //! \brief Returns the size of the snapshot in bytes
+    uint64_t getSize() const;
+
+    void clear();
+
+    //! \brief Fills level with the sections of the text and the tiles
+    bool buildLevel(LevelFile::LevelData& level, std::string& error) const;
+
+private:
+    std::string mText;
+    std::vector<LevelFile::TileRecord> mTiles;
+};
+
+#endif // GAMEMAPSNAPSHOT_H
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/GameSaveWriter.h"
+
+#include "network/ODServer.h"
+#include "utils/LogManager.h"
+
+#include <boost/filesystem.hpp>
+
+#include <utility>
+
+GameSaveWriter::GameSaveWriter(ODServer* server) :
+    mServer(server),
+    mThread(&GameSaveWriter::writeThread, this),
+    mIsWriting(false),
+    mHasResult(false),
+    mIsSuccess(false),
+    mWriteTimeMs(0.0)
+{
+}
+
+GameSaveWriter::~GameSaveWriter()
+{
+    mThread.wait();
+}
+
+bool GameSaveWriter::isWriting()
+{
+    sf::Lock lock(mMutex);
+    return mIsWriting;
+}
+
+bool GameSaveWriter::startWrite(const std::string& fileName, GameMapSnapshot& snapshot)
+{
+    {
+        sf::Lock lock(mMutex);
+        if(mIsWriting)
+            return false;
+
+        mIsWriting = true;
+        mFileName = fileName;
+        std::swap(mSnapshot, snapshot);
+        snapshot.clear();
+    }
+
+    // mIsWriting was false so the previous thread (if any) has nothing left to do. launch() waits for it to end
+    mThread.launch();
+    return true;
+}
+
+bool GameSaveWriter::popResult(std::string& fileName, bool& isSuccess, double& writeTimeMs)
+{
+    sf::Lock lock(mMutex);
+    if(!mHasResult)
+        return false;
+
+    mHasResult = false;
+    fileName = mFileName;
+    isSuccess = mIsSuccess;
+    writeTimeMs = mWriteTimeMs;
+    return true;
+}
+
+void GameSaveWriter::writeThread()
+{
+    ODServer::ThreadBinding binding(mServer);
+
+    // mFileName and mSnapshot are not changed while mIsWriting is set
+    sf::Clock clock;
+    std::string tmpFileName = mFileName + ".tmp";
+    LevelFile::LevelData level;
+    std::string error;
+    bool isSuccess = mSnapshot.buildLevel(level, error)
+        && LevelFile::writeBinary(tmpFileName, level, error);
+
+    if(isSuccess)
+    {
+        boost::system::error_code ec;
+        // If the file exists, we keep a backup
+        if(boost::filesystem::exists(mFileName, ec))
+            boost::filesystem::rename(mFileName, mFileName + ".bak", ec);
+
+        boost::filesystem::rename(tmpFileName, mFileName, ec);
+        isSuccess = !ec;
+        if(!isSuccess)
+            error = ec.message();
+    }
+
+    if(!isSuccess)
+        OD_LOG_WRN("Couldn't write save file " + mFileName + ": " + error);
+
+    mSnapshot.clear();
+
+    sf::Lock lock(mMutex);
+    mHasResult = true;
+    mIsSuccess = isSuccess;
+    mWriteTimeMs = static_cast<double>(clock.getElapsedTime().asMicroseconds()) / 1000.0;
+    mIsWriting = false;
+}
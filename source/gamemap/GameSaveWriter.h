@@ -0,0 +1,74 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GAMESAVEWRITER_H
+#define GAMESAVEWRITER_H
+
+#include "gamemap/GameMapSnapshot.h"
+
+#include <SFML/System.hpp>
+
+#include <string>
+
+class ODServer;
+
+/*! \brief Writes saved games in a background thread.
+ *
+ * The server takes a snapshot of the gamemap at the end of a turn (see MapHandler::takeGameMapSnapshot)
+ * and gives it to the writer. The writer builds the saved game from the snapshot (see GameMapSnapshot::buildLevel)
+ * and writes it in a temporary file that is renamed once complete so that a crash during the write never
+ * leaves a truncated save.
+ * Only one save can be written at a time.
+ */
+class GameSaveWriter
+{
+public:
+    //! \brief server is the server of the match whose games are saved. The writing thread is bound
+    //! to it (see ODServer::ThreadBinding)
+    GameSaveWriter(ODServer* server);
+
+    //! \brief Waits for the current write (if any)
+    ~GameSaveWriter();
+
+    //! \brief Returns true if a save is being written
+    bool isWriting();
+
+    //! \brief Starts writing the given snapshot in the given file. Returns false if a save is already
+    //! being written. snapshot is swapped with an empty one
+    bool startWrite(const std::string& fileName, GameMapSnapshot& snapshot);
+
+    //! \brief Returns true if a write has ended since the last call. In this case, fileName,
+    //! isSuccess and writeTimeMs are set to the result of this write.
+    bool popResult(std::string& fileName, bool& isSuccess, double& writeTimeMs);
+
+private:
+    ODServer* mServer;
+    sf::Mutex mMutex;
+    sf::Thread mThread;
+
+    bool mIsWriting;
+    std::string mFileName;
+    GameMapSnapshot mSnapshot;
+
+    bool mHasResult;
+    bool mIsSuccess;
+    double mWriteTimeMs;
+
+    void writeThread();
+};
+
+#endif // GAMESAVEWRITER_H
@@ -0,0 +1,446 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/LevelFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace LevelFile
+{
+static const char MAGIC[8] = {'O', 'D', 'L', 'E', 'V', 'E', 'L', 'B'};
+//! \brief Allows to detect files written on a platform with another endianness
+static const uint32_t ENDIANNESS_MARK = 0x01020304;
+static const uint32_t NB_SECTIONS = static_cast<uint32_t>(Section::nbSections);
+//! \brief Every section starts on an aligned offset so that the tile records can be used in place
+static const uint64_t SECTION_ALIGNMENT = 8;
+
+struct FileHeader
+{
+    char mMagic[8];
+    uint32_t mFormatVersion;
+    uint32_t mEndiannessMark;
+    uint32_t mNbSections;
+    uint32_t mPadding;
+};
+
+struct SectionEntry
+{
+    uint32_t mId;
+    uint32_t mPadding;
+    uint64_t mOffset;
+    uint64_t mSize;
+};
+
+struct TilesHeader
+{
+    int32_t mMapSizeX;
+    int32_t mMapSizeY;
+    uint32_t mNbTiles;
+    uint32_t mPadding;
+};
+
+static uint64_t alignOffset(uint64_t offset)
+{
+    return (offset + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+//! \brief Extracts the text from startTag to the end of endTag, looking from pos. pos is moved after endTag
+static bool extractSection(const std::string& text, const std::string& startTag, const std::string& endTag,
+    std::string::size_type& pos, std::string& section, std::string& error)
+{
+    std::string::size_type start = text.find(startTag, pos);
+    if(start == std::string::npos)
+    {
+        error = "Missing " + startTag;
+        return false;
+    }
+    std::string::size_type end = text.find(endTag, start);
+    if(end == std::string::npos)
+    {
+        error = "Missing " + endTag;
+        return false;
+    }
+    end += endTag.size();
+    section = text.substr(start, end - start) + "\n";
+    pos = end;
+    return true;
+}
+
+static bool parseTiles(const std::string& tilesText, LevelData& level, std::string& error)
+{
+    std::stringstream ss(tilesText);
+    std::string tag;
+    if(!(ss >> tag >> level.mMapSizeX >> level.mMapSizeY))
+    {
+        error = "Invalid map size";
+        return false;
+    }
+
+    level.mTiles.clear();
+    std::string line;
+    while(std::getline(ss, line))
+    {
+        std::stringstream lineStream(line);
+        std::string first;
+        if(!(lineStream >> first))
+            continue;
+        if(first == "[/Tiles]")
+            break;
+
+        TileRecord record;
+        std::stringstream recordStream(line);
+        if(!(recordStream >> record.mX >> record.mY >> record.mType >> record.mFullness))
+        {
+            error = "Invalid tile line: " + line;
+            return false;
+        }
+        if(!(recordStream >> record.mSeatId))
+            record.mSeatId = -1;
+
+        level.mTiles.push_back(record);
+    }
+    return true;
+}
+
+bool isBinaryFile(const std::string& fileName)
+{
+    std::ifstream file(fileName.c_str(), std::ios::binary);
+    if(!file.is_open())
+        return false;
+
+    char magic[sizeof(MAGIC)];
+    if(!file.read(magic, sizeof(magic)))
+        return false;
+
+    return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+std::string removeComments(std::istream& is)
+{
+    std::string result;
+    std::string line;
+    while(std::getline(is, line))
+    {
+        result += line.substr(0, line.find('#'));
+        result += "\n";
+    }
+    return result;
+}
+
+bool parseText(const std::string& text, LevelData& level, std::string& error)
+{
+    std::stringstream ss(text);
+    if(!(ss >> level.mVersion))
+    {
+        error = "Missing version";
+        return false;
+    }
+
+    std::string::size_type pos = text.find(level.mVersion) + level.mVersion.size();
+    std::string& info = level.mSections[static_cast<uint32_t>(Section::info)];
+    std::string& seats = level.mSections[static_cast<uint32_t>(Section::seats)];
+    std::string& goals = level.mSections[static_cast<uint32_t>(Section::goals)];
+    std::string& rooms = level.mSections[static_cast<uint32_t>(Section::rooms)];
+    std::string& traps = level.mSections[static_cast<uint32_t>(Section::traps)];
+    std::string& lights = level.mSections[static_cast<uint32_t>(Section::lights)];
+    std::string tiles;
+    if(!extractSection(text, "[Info]", "[/Info]", pos, info, error))
+        return false;
+    if(!extractSection(text, "[Seats]", "[/Seats]", pos, seats, error))
+        return false;
+    if(!extractSection(text, "[Goals]", "[/Goals]", pos, goals, error))
+        return false;
+    if(!extractSection(text, "[Tiles]", "[/Tiles]", pos, tiles, error))
+        return false;
+    if(!parseTiles(tiles, level, error))
+        return false;
+    if(!extractSection(text, "[Rooms]", "[/Rooms]", pos, rooms, error))
+        return false;
+    if(!extractSection(text, "[Traps]", "[/Traps]", pos, traps, error))
+        return false;
+    if(!extractSection(text, "[Lights]", "[/Lights]", pos, lights, error))
+        return false;
+
+    // The creatures section includes the optional creature and equipment definitions
+    pos = text.find_first_not_of(" \t\r\n", pos);
+    if(pos == std::string::npos)
+    {
+        error = "Missing [Creatures]";
+        return false;
+    }
+    std::string::size_type endCreatures = text.find("[/Creatures]", pos);
+    if(endCreatures == std::string::npos)
+    {
+        error = "Missing [/Creatures]";
+        return false;
+    }
+    endCreatures += std::string("[/Creatures]").size();
+    level.mSections[static_cast<uint32_t>(Section::creatures)] = text.substr(pos, endCreatures - pos) + "\n";
+    std::string::size_type startEntities = text.find_first_not_of(" \t\r\n", endCreatures);
+    if(startEntities != std::string::npos)
+        level.mSections[static_cast<uint32_t>(Section::entities)] = text.substr(startEntities);
+    else
+        level.mSections[static_cast<uint32_t>(Section::entities)].clear();
+    level.mSections[static_cast<uint32_t>(Section::version)].clear();
+    return true;
+}
+
+void writeText(std::ostream& os, const LevelData& level)
+{
+    os << level.mVersion << "\n";
+    os << level.mSections[static_cast<uint32_t>(Section::info)];
+    os << level.mSections[static_cast<uint32_t>(Section::seats)];
+    os << level.mSections[static_cast<uint32_t>(Section::goals)];
+    os << "[Tiles]\n";
+    os << level.mMapSizeX << " " << level.mMapSizeY << "\n";
+    for(const TileRecord& record : level.mTiles)
+    {
+        os << record.mX << "\t" << record.mY << "\t" << record.mType << "\t" << record.mFullness;
+        if(record.mSeatId >= 0)
+            os << "\t" << record.mSeatId;
+        os << "\n";
+    }
+    os << "[/Tiles]\n";
+    os << level.mSections[static_cast<uint32_t>(Section::rooms)];
+    os << level.mSections[static_cast<uint32_t>(Section::traps)];
+    os << level.mSections[static_cast<uint32_t>(Section::lights)];
+    os << level.mSections[static_cast<uint32_t>(Section::creatures)];
+    os << level.mSections[static_cast<uint32_t>(Section::entities)];
+}
+
+bool writeBinary(std::ostream& os, const LevelData& level)
+{
+    // We build the section payloads first to compute the table
+    std::vector<std::string> payloads(NB_SECTIONS);
+    for(uint32_t id = 0; id < NB_SECTIONS; ++id)
+        payloads[id] = level.mSections[id];
+
+    payloads[static_cast<uint32_t>(Section::version)] = level.mVersion;
+
+    TilesHeader tilesHeader;
+    tilesHeader.mMapSizeX = level.mMapSizeX;
+    tilesHeader.mMapSizeY = level.mMapSizeY;
+    tilesHeader.mNbTiles = static_cast<uint32_t>(level.mTiles.size());
+    tilesHeader.mPadding = 0;
+    std::string& tiles = payloads[static_cast<uint32_t>(Section::tiles)];
+    tiles.assign(reinterpret_cast<const char*>(&tilesHeader), sizeof(tilesHeader));
+    if(!level.mTiles.empty())
+        tiles.append(reinterpret_cast<const char*>(level.mTiles.data()), level.mTiles.size() * sizeof(TileRecord));
+
+    FileHeader header;
+    std::memcpy(header.mMagic, MAGIC, sizeof(MAGIC));
+    header.mFormatVersion = FORMAT_VERSION;
+    header.mEndiannessMark = ENDIANNESS_MARK;
+    header.mNbSections = NB_SECTIONS;
+    header.mPadding = 0;
+
+    std::vector<SectionEntry> entries(NB_SECTIONS);
+    uint64_t offset = alignOffset(sizeof(FileHeader) + NB_SECTIONS * sizeof(SectionEntry));
+    for(uint32_t id = 0; id < NB_SECTIONS; ++id)
+    {
+        entries[id].mId = id;
+        entries[id].mPadding = 0;
+        entries[id].mOffset = offset;
+        entries[id].mSize = payloads[id].size();
+        offset = alignOffset(offset + payloads[id].size());
+    }
+
+    static const char PADDING[SECTION_ALIGNMENT] = {0};
+    uint64_t written = 0;
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    os.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(SectionEntry));
+    written += sizeof(header) + entries.size() * sizeof(SectionEntry);
+    for(uint32_t id = 0; id < NB_SECTIONS; ++id)
+    {
+        os.write(PADDING, entries[id].mOffset - written);
+        os.write(payloads[id].data(), payloads[id].size());
+        written = entries[id].mOffset + payloads[id].size();
+    }
+
+    return os.good();
+}
+
+bool writeBinary(const std::string& fileName, const LevelData& level, std::string& error)
+{
+    std::ofstream file(fileName.c_str(), std::ios::binary | std::ios::trunc);
+    if(!file.is_open())
+    {
+        error = "Cannot open " + fileName;
+        return false;
+    }
+
+    if(!writeBinary(file, level))
+    {
+        error = "Error while writing " + fileName;
+        return false;
+    }
+    return true;
+}
+
+bool convertFile(const std::string& inputFileName, const std::string& outputFileName, std::string& error)
+{
+    LevelData level;
+    if(isBinaryFile(inputFileName))
+    {
+        MappedLevel mappedLevel;
+        if(!mappedLevel.open(inputFileName, error))
+            return false;
+
+        mappedLevel.toLevelData(level);
+        std::ofstream file(outputFileName.c_str(), std::ios::trunc);
+        if(!file.is_open())
+        {
+            error = "Cannot open " + outputFileName;
+            return false;
+        }
+        writeText(file, level);
+        return file.good();
+    }
+
+    std::ifstream file(inputFileName.c_str());
+    if(!file.is_open())
+    {
+        error = "Cannot open " + inputFileName;
+        return false;
+    }
+    std::string text = removeComments(file);
+    if(!parseText(text, level, error))
+        return false;
+
+    return writeBinary(outputFileName, level, error);
+}
+
+MappedLevel::MappedLevel() :
+    mSections(NB_SECTIONS, std::make_pair(0, 0)),
+    mMapSizeX(0),
+    mMapSizeY(0),
+    mNbTiles(0),
+    mTiles(nullptr)
+{
+}
+
+bool MappedLevel::open(const std::string& fileName, std::string& error)
+{
+    try
+    {
+        boost::interprocess::file_mapping file(fileName.c_str(), boost::interprocess::read_only);
+        boost::interprocess::mapped_region region(file, boost::interprocess::read_only);
+        mFile.swap(file);
+        mRegion.swap(region);
+    }
+    catch(const boost::interprocess::interprocess_exception& e)
+    {
+        error = "Cannot map " + fileName + ": " + e.what();
+        return false;
+    }
+
+    const char* data = static_cast<const char*>(mRegion.get_address());
+    uint64_t fileSize = mRegion.get_size();
+    FileHeader header;
+    if(fileSize < sizeof(header))
+    {
+        error = "File too small: " + fileName;
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if(std::memcmp(header.mMagic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        error = "Not a binary level: " + fileName;
+        return false;
+    }
+    if(header.mEndiannessMark != ENDIANNESS_MARK)
+    {
+        error = "Binary level written with another endianness: " + fileName;
+        return false;
+    }
+    if(header.mFormatVersion != FORMAT_VERSION)
+    {
+        error = "Unsupported binary level version " + std::to_string(header.mFormatVersion) + ": " + fileName;
+        return false;
+    }
+    if(fileSize < sizeof(header) + static_cast<uint64_t>(header.mNbSections) * sizeof(SectionEntry))
+    {
+        error = "Corrupted section table: " + fileName;
+        return false;
+    }
+
+    std::fill(mSections.begin(), mSections.end(), std::make_pair(0, 0));
+    for(uint32_t index = 0; index < header.mNbSections; ++index)
+    {
+        SectionEntry entry;
+        std::memcpy(&entry, data + sizeof(header) + index * sizeof(SectionEntry), sizeof(entry));
+        // Sections unknown to this version are ignored
+        if(entry.mId >= NB_SECTIONS)
+            continue;
+
+        if((entry.mOffset > fileSize) || (entry.mSize > fileSize - entry.mOffset))
+        {
+            error = "Corrupted section " + std::to_string(entry.mId) + ": " + fileName;
+            return false;
+        }
+        mSections[entry.mId] = std::make_pair(entry.mOffset, entry.mSize);
+    }
+
+    const std::pair<uint64_t, uint64_t>& tiles = mSections[static_cast<uint32_t>(Section::tiles)];
+    if(tiles.second < sizeof(TilesHeader))
+    {
+        error = "Missing tiles: " + fileName;
+        return false;
+    }
+    TilesHeader tilesHeader;
+    std::memcpy(&tilesHeader, data + tiles.first, sizeof(tilesHeader));
+    if(static_cast<uint64_t>(tilesHeader.mNbTiles) * sizeof(TileRecord) > tiles.second - sizeof(TilesHeader))
+    {
+        error = "Corrupted tiles: " + fileName;
+        return false;
+    }
+    mMapSizeX = tilesHeader.mMapSizeX;
+    mMapSizeY = tilesHeader.mMapSizeY;
+    mNbTiles = tilesHeader.mNbTiles;
+    mTiles = reinterpret_cast<const TileRecord*>(data + tiles.first + sizeof(TilesHeader));
+    return true;
+}
+
+std::string MappedLevel::getSectionText(Section section) const
+{
+    const std::pair<uint64_t, uint64_t>& entry = mSections[static_cast<uint32_t>(section)];
+    if(entry.second == 0)
+        return std::string();
+
+    const char* data = static_cast<const char*>(mRegion.get_address());
+    return std::string(data + entry.first, entry.second);
+}
+
+void MappedLevel::toLevelData(LevelData& level) const
+{
+    level.mVersion = getSectionText(Section::version);
+    for(uint32_t id = 0; id < NB_SECTIONS; ++id)
+    {
+        Section section = static_cast<Section>(id);
+        if((section == Section::version) || (section == Section::tiles))
+            continue;
+
+        level.mSections[id] = getSectionText(section);
+    }
+    level.mMapSizeX = mMapSizeX;
+    level.mMapSizeY = mMapSizeY;
+    level.mTiles.assign(mTiles, mTiles + mNbTiles);
+}
+}
@@ -0,0 +1,148 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LEVELFILE_H
+#define LEVELFILE_H
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/*! \brief Binary container for levels and saved games.
+ *
+ * The file starts with a header followed by a table of sections. The tiles are stored as
+ * fixed size records that can be used directly from the mapped file. The other sections
+ * (seats, rooms, traps, lights, creatures, ...) keep the text format of the .level files
+ * (without comments) so that the entities only have one serialization.
+ * This namespace does not depend on the game classes so that it can be used by the
+ * level conversion tool.
+ */
+namespace LevelFile
+{
+    //! \brief Version of the binary container. Should be incremented when the layout changes
+    const uint32_t FORMAT_VERSION = 1;
+
+    enum class Section : uint32_t
+    {
+        version,    // OpenDungeons version that created the file
+        info,
+        seats,
+        goals,
+        tiles,      // Binary: TilesHeader followed by the TileRecords
+        rooms,
+        traps,
+        lights,
+        creatures,  // Creature and equipment definitions and the creatures
+        entities,   // Spells, crafted traps, missiles, chickens, ...
+        nbSections
+    };
+
+    //! \brief Tile as stored in the tiles section. Only the tiles that are not full unclaimed
+    //! dirt are stored (like in the text format)
+    struct TileRecord
+    {
+        int32_t mX;
+        int32_t mY;
+        int32_t mType;
+        //! \brief -1 if the tile has no seat
+        int32_t mSeatId;
+        double mFullness;
+    };
+
+    //! \brief Content of a level, used to convert between formats
+    struct LevelData
+    {
+        LevelData() :
+            mSections(static_cast<uint32_t>(Section::nbSections)),
+            mMapSizeX(0),
+            mMapSizeY(0)
+        {}
+
+        std::string mVersion;
+        //! \brief Text of each text section (including its start and end tags). Indexed by Section
+        std::vector<std::string> mSections;
+        int32_t mMapSizeX;
+        int32_t mMapSizeY;
+        std::vector<TileRecord> mTiles;
+    };
+
+    //! \brief Returns true if the given file is a binary level
+    bool isBinaryFile(const std::string& fileName);
+
+    //! \brief Returns the content of the given stream where everything after '#' on each line is removed
+    std::string removeComments(std::istream& is);
+
+    //! \brief Splits a text level (without comments) in sections. The tiles are parsed in records
+    bool parseText(const std::string& text, LevelData& level, std::string& error);
+
+    //! \brief Writes the given level in the text format
+    void writeText(std::ostream& os, const LevelData& level);
+
+    //! \brief Writes the given level in the binary format
+    bool writeBinary(const std::string& fileName, const LevelData& level, std::string& error);
+    bool writeBinary(std::ostream& os, const LevelData& level);
+
+    //! \brief Text to binary and binary to text conversions. The direction depends on the input file
+    bool convertFile(const std::string& inputFileName, const std::string& outputFileName, std::string& error);
+
+    //! \brief Read only view of a binary level file. The file is mapped in memory and nothing
+    //! is copied until needed
+    class MappedLevel
+    {
+    public:
+        MappedLevel();
+
+        bool open(const std::string& fileName, std::string& error);
+
+        //! \brief Returns the text of the given section. Empty if the section is missing
+        std::string getSectionText(Section section) const;
+
+        inline int32_t getMapSizeX() const
+        { return mMapSizeX; }
+
+        inline int32_t getMapSizeY() const
+        { return mMapSizeY; }
+
+        inline uint32_t getNbTiles() const
+        { return mNbTiles; }
+
+        //! \brief The tile records. They point into the mapped file
+        inline const TileRecord* getTiles() const
+        { return mTiles; }
+
+        //! \brief Copies the whole level
+        void toLevelData(LevelData& level) const;
+
+    private:
+        boost::interprocess::file_mapping mFile;
+        boost::interprocess::mapped_region mRegion;
+
+        //! \brief Offset and size of each section in the mapped file. Size is 0 if the section is missing
+        std::vector<std::pair<uint64_t, uint64_t>> mSections;
+
+        int32_t mMapSizeX;
+        int32_t mMapSizeY;
+        uint32_t mNbTiles;
+        const TileRecord* mTiles;
+    };
+}
+
+#endif // LEVELFILE_H
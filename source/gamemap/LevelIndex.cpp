@@ -0,0 +1,370 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/LevelIndex.h"
+
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include "ODApplication.h"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+template<> LevelIndex* Ogre::Singleton<LevelIndex>::msSingleton = nullptr;
+
+//! \brief Should be incremented when the index file format changes
+static const uint32_t INDEX_FORMAT_VERSION = 2;
+static const std::string INDEX_HEADER = "ODLevelIndex";
+
+static void writeString(std::ostream& os, const std::string& str)
+{
+    os << str.size() << " ";
+    os.write(str.data(), str.size());
+    os << " ";
+}
+
+static bool readString(std::istream& is, std::string& str)
+{
+    std::size_t size;
+    if(!(is >> size))
+        return false;
+
+    // We skip the separator
+    is.get();
+    str.resize(size);
+    if((size > 0) && !is.read(&str[0], size))
+        return false;
+
+    return true;
+}
+
+LevelIndex::LevelIndex(const std::string& indexFileName) :
+    mIndexFileName(indexFileName),
+    mThread(&LevelIndex::processPendingFiles, this),
+    mRevision(0),
+    mIsThreadRunning(false),
+    mIsStopRequested(false),
+    mIsDirty(false)
+{
+    loadIndex();
+}
+
+LevelIndex::~LevelIndex()
+{
+    {
+        sf::Lock lock(mMutex);
+        mIsStopRequested = true;
+    }
+    mThread.wait();
+    saveIndex();
+}
+
+LevelIndexState LevelIndex::getLevelInfo(const std::string& levelFileName, LevelInfo& levelInfo)
+{
+    std::string fileName = getEntryKey(levelFileName);
+    int64_t modificationTime;
+    uint64_t fileSize;
+    if(!getFileStamp(fileName, modificationTime, fileSize))
+        return LevelIndexState::invalid;
+
+    sf::Lock lock(mMutex);
+    const Entry* entry = findUpToDateEntry(fileName, modificationTime, fileSize);
+    if(entry != nullptr)
+    {
+        if(!entry->mIsValid)
+            return LevelIndexState::invalid;
+
+        levelInfo = entry->mLevelInfo;
+        return LevelIndexState::indexed;
+    }
+
+    if((fileName != mCurrentFile) &&
+       (std::find(mPendingFiles.begin(), mPendingFiles.end(), fileName) == mPendingFiles.end()))
+    {
+        mPendingFiles.push_back(fileName);
+    }
+
+    if(!mIsThreadRunning && !mIsStopRequested)
+    {
+        // The previous thread (if any) has nothing left to do. launch() waits for it to end
+        mIsThreadRunning = true;
+        mThread.launch();
+    }
+
+    return LevelIndexState::pending;
+}
+
+bool LevelIndex::getLevelInfoNow(const std::string& levelFileName, LevelInfo& levelInfo)
+{
+    std::string fileName = getEntryKey(levelFileName);
+    int64_t modificationTime;
+    uint64_t fileSize;
+    if(!getFileStamp(fileName, modificationTime, fileSize))
+        return false;
+
+    {
+        sf::Lock lock(mMutex);
+        const Entry* entry = findUpToDateEntry(fileName, modificationTime, fileSize);
+        if(entry != nullptr)
+        {
+            levelInfo = entry->mLevelInfo;
+            return entry->mIsValid;
+        }
+    }
+
+    Entry entry = readEntry(fileName, modificationTime, fileSize);
+    levelInfo = entry.mLevelInfo;
+
+    sf::Lock lock(mMutex);
+    mEntries[fileName] = entry;
+    mIsDirty = true;
+    return entry.mIsValid;
+}
+
+LevelIndexState LevelIndex::getLevelNameAndDescription(const std::string& fileName, std::string& levelName,
+    std::string& levelDescription)
+{
+    LevelInfo levelInfo;
+    LevelIndexState state = getLevelInfo(fileName, levelInfo);
+    switch(state)
+    {
+        case LevelIndexState::indexed:
+            levelName = levelInfo.mLevelName;
+            levelDescription = levelInfo.mLevelDescription;
+            break;
+        case LevelIndexState::pending:
+            levelName = boost::filesystem::path(fileName).stem().string();
+            levelDescription = "Reading level...";
+            break;
+        case LevelIndexState::invalid:
+        default:
+            levelName = "invalid map";
+            levelDescription = "invalid map";
+            break;
+    }
+    return state;
+}
+
+uint32_t LevelIndex::getRevision()
+{
+    sf::Lock lock(mMutex);
+    return mRevision;
+}
+
+std::string LevelIndex::getEntryKey(const std::string& fileName)
+{
+    boost::system::error_code ec;
+    boost::filesystem::path path = boost::filesystem::canonical(fileName, ec);
+    if(ec)
+        path = boost::filesystem::absolute(fileName);
+
+    return path.generic_string();
+}
+
+bool LevelIndex::getFileStamp(const std::string& fileName, int64_t& modificationTime, uint64_t& fileSize)
+{
+    boost::system::error_code ec;
+    std::time_t time = boost::filesystem::last_write_time(fileName, ec);
+    if(ec)
+        return false;
+
+    boost::uintmax_t size = boost::filesystem::file_size(fileName, ec);
+    if(ec)
+        return false;
+
+    modificationTime = static_cast<int64_t>(time);
+    fileSize = static_cast<uint64_t>(size);
+    return true;
+}
+
+LevelIndex::Entry LevelIndex::readEntry(const std::string& fileName, int64_t modificationTime, uint64_t fileSize)
+{
+    Entry entry;
+    entry.mModificationTime = modificationTime;
+    entry.mFileSize = fileSize;
+    entry.mIsValid = MapHandler::getMapInfo(fileName, entry.mLevelInfo);
+    return entry;
+}
+
+const LevelIndex::Entry* LevelIndex::findUpToDateEntry(const std::string& fileName, int64_t modificationTime, uint64_t fileSize) const
+{
+    auto it = mEntries.find(fileName);
+    if(it == mEntries.end())
+        return nullptr;
+
+    const Entry& entry = it->second;
+    if((entry.mModificationTime != modificationTime) || (entry.mFileSize != fileSize))
+        return nullptr;
+
+    return &entry;
+}
+
+void LevelIndex::processPendingFiles()
+{
+    while(true)
+    {
+        std::string fileName;
+        bool isQueueEmpty;
+        {
+            sf::Lock lock(mMutex);
+            isQueueEmpty = mPendingFiles.empty();
+        }
+
+        // We save the index once the queue is empty so that it is kept even if the game crashes
+        if(isQueueEmpty)
+            saveIndex();
+
+        {
+            sf::Lock lock(mMutex);
+            // Once mIsThreadRunning is cleared, the thread should not lock mMutex anymore
+            // because getLevelInfo may be waiting for it to end while holding the lock
+            if(mPendingFiles.empty() || mIsStopRequested)
+            {
+                mIsThreadRunning = false;
+                return;
+            }
+            fileName = mPendingFiles.front();
+            mPendingFiles.pop_front();
+            mCurrentFile = fileName;
+        }
+
+        int64_t modificationTime;
+        uint64_t fileSize;
+        Entry entry;
+        if(getFileStamp(fileName, modificationTime, fileSize))
+            entry = readEntry(fileName, modificationTime, fileSize);
+
+        sf::Lock lock(mMutex);
+        mEntries[fileName] = entry;
+        mCurrentFile.clear();
+        mIsDirty = true;
+        ++mRevision;
+    }
+}
+
+void LevelIndex::loadIndex()
+{
+    std::ifstream file(mIndexFileName.c_str(), std::ios::binary);
+    if(!file.is_open())
+        return;
+
+    std::string header;
+    uint32_t formatVersion;
+    std::string version;
+    if(!(file >> header >> formatVersion) || !readString(file, version))
+        return;
+
+    // Levels from another version cannot be loaded so we do not keep their entries
+    if((header != INDEX_HEADER) || (formatVersion != INDEX_FORMAT_VERSION) || (version != ODApplication::VERSIONSTRING))
+        return;
+
+    // Removed folders are checked once instead of checking each of their files
+    std::map<std::string, bool> existingFolders;
+    uint32_t nbEntries = 0;
+    while(true)
+    {
+        std::string fileName;
+        if(!readString(file, fileName))
+            break;
+
+        Entry entry;
+        LevelInfo& info = entry.mLevelInfo;
+        if(!(file >> entry.mModificationTime >> entry.mFileSize >> entry.mIsValid))
+            break;
+        if(!readString(file, info.mLevelName) || !readString(file, info.mLevelDescription))
+            break;
+        if(!(file >> info.mMapSizeX >> info.mMapSizeY >> info.mNbPlayerSeats >> info.mNbAISeats
+            >> info.mNbConfigurableSeats))
+        {
+            break;
+        }
+
+        // We forget the levels that have been removed, with their folder or not
+        std::string folder = boost::filesystem::path(fileName).parent_path().generic_string();
+        auto itFolder = existingFolders.find(folder);
+        if(itFolder == existingFolders.end())
+        {
+            boost::system::error_code ec;
+            itFolder = existingFolders.emplace(folder, boost::filesystem::is_directory(folder, ec)).first;
+        }
+
+        if(!itFolder->second || !boost::filesystem::exists(fileName))
+        {
+            mIsDirty = true;
+            continue;
+        }
+
+        mEntries[fileName] = entry;
+        ++nbEntries;
+    }
+
+    OD_LOG_INF("Loaded " + Helper::toString(nbEntries) + " entries from level index " + mIndexFileName);
+}
+
+void LevelIndex::saveIndex()
+{
+    // We copy the entries to not keep the lock while writing
+    std::map<std::string, Entry> entries;
+    {
+        sf::Lock lock(mMutex);
+        if(!mIsDirty)
+            return;
+
+        entries = mEntries;
+        mIsDirty = false;
+    }
+
+    // We write in a temporary file to not leave a partial index if something goes wrong
+    std::string tmpFileName = mIndexFileName + ".tmp";
+    {
+        std::ofstream file(tmpFileName.c_str(), std::ios::binary | std::ios::trunc);
+        if(!file.is_open())
+        {
+            OD_LOG_WRN("Couldn't open level index for writing: " + tmpFileName);
+            return;
+        }
+
+        file << INDEX_HEADER << " " << INDEX_FORMAT_VERSION << " ";
+        writeString(file, ODApplication::VERSIONSTRING);
+        file << "\n";
+        for(const std::pair<const std::string, Entry>& p : entries)
+        {
+            const Entry& entry = p.second;
+            const LevelInfo& info = entry.mLevelInfo;
+            writeString(file, p.first);
+            file << entry.mModificationTime << " " << entry.mFileSize << " " << entry.mIsValid << " ";
+            writeString(file, info.mLevelName);
+            writeString(file, info.mLevelDescription);
+            file << info.mMapSizeX << " " << info.mMapSizeY << " " << info.mNbPlayerSeats << " "
+                << info.mNbAISeats << " " << info.mNbConfigurableSeats << "\n";
+        }
+
+        if(!file.good())
+        {
+            OD_LOG_WRN("Couldn't write level index: " + tmpFileName);
+            return;
+        }
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::rename(tmpFileName, mIndexFileName, ec);
+    if(ec)
+        OD_LOG_WRN("Couldn't rename level index " + tmpFileName + ": " + ec.message());
+}
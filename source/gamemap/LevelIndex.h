@@ -0,0 +1,121 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LEVELINDEX_H
+#define LEVELINDEX_H
+
+#include "gamemap/MapHandler.h"
+
+#include <SFML/System.hpp>
+#include <OgreSingleton.h>
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+
+enum class LevelIndexState
+{
+    indexed,    // The level info is up to date
+    invalid,    // The level could not be read
+    pending     // The level is being read in the background
+};
+
+/*! \brief Cache of the LevelInfo of the level files listed in the menus.
+ *
+ * The entries are keyed by the full path of the file, so one index serves every level folder, and
+ * are valid as long as the file modification time and size do not change. Missing or outdated entries are read in a background thread so that the menus
+ * can be displayed without reading every level. The menus can compare the revision to know when
+ * new entries are available.
+ * The index is saved in the user data folder and reloaded at next launch. The entries of the files
+ * or folders that have been removed are dropped when it is reloaded.
+ */
+class LevelIndex: public Ogre::Singleton<LevelIndex>
+{
+public:
+    LevelIndex(const std::string& indexFileName);
+
+    virtual ~LevelIndex();
+
+    //! \brief Fills levelInfo if the entry of the given file is up to date. Otherwise, the
+    //! file is queued for reading in the background and pending is returned.
+    LevelIndexState getLevelInfo(const std::string& fileName, LevelInfo& levelInfo);
+
+    //! \brief Same as getLevelInfo but the file is read right away if its entry is not up to date
+    bool getLevelInfoNow(const std::string& fileName, LevelInfo& levelInfo);
+
+    //! \brief Fills the name and description to display in the level lists. While the level is
+    //! pending, the file name is used
+    LevelIndexState getLevelNameAndDescription(const std::string& fileName, std::string& levelName,
+        std::string& levelDescription);
+
+    //! \brief Incremented each time entries are read in the background
+    uint32_t getRevision();
+
+private:
+    struct Entry
+    {
+        Entry() :
+            mModificationTime(0),
+            mFileSize(0),
+            mIsValid(false)
+        {}
+
+        int64_t mModificationTime;
+        uint64_t mFileSize;
+        bool mIsValid;
+        LevelInfo mLevelInfo;
+    };
+
+    std::string mIndexFileName;
+
+    //! \brief Protects every member used by the background thread
+    sf::Mutex mMutex;
+    sf::Thread mThread;
+
+    std::map<std::string, Entry> mEntries;
+    //! \brief Files waiting to be read by the background thread
+    std::deque<std::string> mPendingFiles;
+    //! \brief File being read by the background thread
+    std::string mCurrentFile;
+
+    uint32_t mRevision;
+    bool mIsThreadRunning;
+    bool mIsStopRequested;
+    bool mIsDirty;
+
+    //! \brief Returns the full path of the given file, used as key for the entries
+    static std::string getEntryKey(const std::string& fileName);
+
+    //! \brief Fills modificationTime and fileSize from the file system. Returns false if the
+    //! file cannot be accessed
+    static bool getFileStamp(const std::string& fileName, int64_t& modificationTime, uint64_t& fileSize);
+
+    //! \brief Reads the given level file. Should not be called with mMutex locked
+    static Entry readEntry(const std::string& fileName, int64_t modificationTime, uint64_t fileSize);
+
+    //! \brief Returns the entry for the given file if it is up to date. mMutex should be locked
+    const Entry* findUpToDateEntry(const std::string& fileName, int64_t modificationTime, uint64_t fileSize) const;
+
+    //! \brief Reads the pending files until the queue is empty
+    void processPendingFiles();
+
+    void loadIndex();
+    void saveIndex();
+};
+
+#endif // LEVELINDEX_H
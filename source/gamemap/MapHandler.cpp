@@ -19,6 +19,8 @@
 
 #include "creaturemood/CreatureMoodManager.h"
 #include "gamemap/GameMap.h"
+#include "gamemap/GameMapSnapshot.h"
+#include "gamemap/LevelFile.h"
 #include "game/Seat.h"
 #include "goals/Goal.h"
 #include "goals/GoalLoading.h"
@@ -44,21 +46,60 @@
 #include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/Random.h"
 #include "utils/ResourceManager.h"
 
 #include "ODApplication.h"
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <map>
 #include <sstream>
 
 namespace MapHandler {
 
-bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
+//! \brief Rebuilds the text of a binary level. The tiles section only contains the map size
+//! because the tiles are read from the mapped records.
+static void buildBinaryLevelStream(const LevelFile::MappedLevel& binaryLevel, std::stringstream& levelFile)
 {
-    std::stringstream levelFile;
-    if(!Helper::readFileWithoutComments(fileName, levelFile))
-        return false;
+    levelFile << binaryLevel.getSectionText(LevelFile::Section::version) << "\n";
+    levelFile << binaryLevel.getSectionText(LevelFile::Section::info);
+    levelFile << binaryLevel.getSectionText(LevelFile::Section::seats);
+    levelFile << binaryLevel.getSectionText(LevelFile::Section::goals);
+    levelFile << "[Tiles]\n" << binaryLevel.getMapSizeX() << "\n" << binaryLevel.getMapSizeY() << "\n[/Tiles]\n";
+    levelFile << binaryLevel.getSectionText(LevelFile::Section::rooms);
+    levelFile << binaryLevel.getSectionText(LevelFile::Section::traps);
+    levelFile << binaryLevel.getSectionText(LevelFile::Section::lights);
+    levelFile << binaryLevel.getSectionText(LevelFile::Section::creatures);
+    levelFile << binaryLevel.getSectionText(LevelFile::Section::entities);
+}
+
+//! \brief Sets the tiles from the records of a binary level. The tiles created by createNewMap
+//! are reused instead of being replaced one by one
+static bool loadBinaryTiles(const LevelFile::MappedLevel& binaryLevel, GameMap& gameMap)
+{
+    const LevelFile::TileRecord* records = binaryLevel.getTiles();
+    for(uint32_t index = 0; index < binaryLevel.getNbTiles(); ++index)
+    {
+        const LevelFile::TileRecord& record = records[index];
+        Tile* tile = gameMap.getTile(record.mX, record.mY);
+        if(tile == nullptr)
+        {
+            OD_LOG_WRN("Invalid tile position x=" + Helper::toString(record.mX) + ", y=" + Helper::toString(record.mY));
+            return false;
+        }
+
+        tile->setPosition(Ogre::Vector3(static_cast<Ogre::Real>(record.mX), static_cast<Ogre::Real>(record.mY), 0.0f));
+        tile->loadFromData(static_cast<TileType>(record.mType), record.mFullness, record.mSeatId);
+        tile->computeTileVisual();
+    }
+    return true;
+}
 
+static bool readGameMapFromStream(const std::string& fileName, std::stringstream& levelFile,
+    GameMap& gameMap, const LevelFile::MappedLevel* binaryLevel)
+{
     std::string nextParam;
     // Read in the version number from the level file
     levelFile >> nextParam;
@@ -78,6 +119,8 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
 
     // By default, we use the default tileSet
     gameMap.setTileSetName("");
+    gameMap.setRandomSeed(0);
+    gameMap.clearSavedRandomGenerators();
 
     // Read in the seats from the level file
     while (true)
@@ -132,6 +175,32 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
             OD_LOG_INF("TileSet: " + tileSet);
             continue;
         }
+
+        param = "Seed\t";
+        if (nextParam.compare(0, param.size(), param) == 0)
+        {
+            std::stringstream ss(nextParam.substr(param.size()));
+            uint64_t seed = 0;
+            ss >> seed;
+            gameMap.setRandomSeed(seed);
+            OD_LOG_INF("Seed: " + Helper::toString(seed));
+            continue;
+        }
+
+        param = "RandomState\t";
+        if (nextParam.compare(0, param.size(), param) == 0)
+        {
+            std::stringstream ss(nextParam.substr(param.size()));
+            std::string key;
+            RandomGenerator generator;
+            if(!(ss >> key) || !generator.importFromStream(ss))
+            {
+                OD_LOG_ERR("Invalid random state: " + nextParam);
+                continue;
+            }
+            gameMap.setSavedRandomGenerator(key, generator);
+            continue;
+        }
     }
 
     levelFile >> nextParam;
@@ -214,6 +283,9 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
     // Read in the map tiles from disk
     gameMap.disableFloodFill();
 
+    if((binaryLevel != nullptr) && !loadBinaryTiles(*binaryLevel, gameMap))
+        return false;
+
     while (true)
     {
         if(!levelFile.good())
@@ -513,6 +585,39 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
     return true;
 }
 
+bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool result;
+    if(LevelFile::isBinaryFile(fileName))
+    {
+        LevelFile::MappedLevel binaryLevel;
+        std::string error;
+        if(!binaryLevel.open(fileName, error))
+        {
+            OD_LOG_WRN(error);
+            return false;
+        }
+
+        std::stringstream levelFile;
+        buildBinaryLevelStream(binaryLevel, levelFile);
+        result = readGameMapFromStream(fileName, levelFile, gameMap, &binaryLevel);
+    }
+    else
+    {
+        std::stringstream levelFile;
+        if(!Helper::readFileWithoutComments(fileName, levelFile))
+            return false;
+
+        result = readGameMapFromStream(fileName, levelFile, gameMap, nullptr);
+    }
+
+    std::chrono::milliseconds duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    OD_LOG_INF("Level " + fileName + " loaded in " + Helper::toString(static_cast<int>(duration.count())) + " ms");
+    return result;
+}
+
 bool readGameEntity(GameMap& gameMap, const std::string& item, GameEntityType type, std::stringstream& levelFile)
 {
     std::string nextParam;
@@ -550,16 +655,10 @@ bool readGameEntity(GameMap& gameMap, const std::string& item, GameEntityType ty
     return true;
 }
 
-bool writeGameMapToFile(const std::string& fileName, GameMap& gameMap)
+//! \brief Writes the level in the text format. If writeTiles is false, only the map size is written
+//! in the tiles section
+static void writeGameMapToStream(std::ostream& levelFile, GameMap& gameMap, bool writeTiles)
 {
-    std::ofstream levelFile(fileName.c_str(), std::ifstream::out);
-
-    // This is better than checking for .bad(), as it checks every error flags.
-    if (!levelFile.good()) {
-        OD_LOG_WRN("Couldn't open file for writing: " + fileName);
-        return false;
-    }
-
     // Write the identifier string and the version number
     levelFile << ODApplication::VERSIONSTRING
             << "  # The version of OpenDungeons which created this file (for compatibility reasons).\n";
@@ -575,6 +674,20 @@ bool writeGameMapToFile(const std::string& fileName, GameMap& gameMap)
         levelFile << "FightMusic\t" << gameMap.getLevelFightMusicFile() << std::endl;
     if(!gameMap.getTileSetName().empty())
         levelFile << "TileSet\t" << gameMap.getTileSetName() << std::endl;
+    if(gameMap.getRandomSeed() != 0)
+    {
+        levelFile << "Seed\t" << gameMap.getRandomSeed() << std::endl;
+
+        // The generators states are saved so that a saved game continues the same sequences
+        std::map<std::string, RandomGenerator> generators;
+        gameMap.getRandomGenerators(generators);
+        for(const std::pair<const std::string, RandomGenerator>& generator : generators)
+        {
+            levelFile << "RandomState\t" << generator.first << "\t";
+            generator.second.exportToStream(levelFile);
+            levelFile << std::endl;
+        }
+    }
 
     levelFile << "[/Info]" << std::endl;
 
@@ -612,7 +725,7 @@ bool writeGameMapToFile(const std::string& fileName, GameMap& gameMap)
     // Write out the tiles to the file
     levelFile << "# " << Tile::getFormat() << "\n";
 
-    for(int ii = 0; ii < mapSizeX; ++ii)
+    for(int ii = 0; writeTiles && (ii < mapSizeX); ++ii)
     {
         for(int jj = 0; jj < mapSizeY; ++jj)
         {
@@ -778,6 +891,84 @@ bool writeGameMapToFile(const std::string& fileName, GameMap& gameMap)
         levelFile << std::endl;
     }
     levelFile << "[/Chickens]" << std::endl;
+}
+
+//! \brief Fills tiles with the records of the tiles to save
+static void buildTileRecords(GameMap& gameMap, std::vector<LevelFile::TileRecord>& tiles)
+{
+    int mapSizeX = gameMap.getMapSizeX();
+    int mapSizeY = gameMap.getMapSizeY();
+    for(int ii = 0; ii < mapSizeX; ++ii)
+    {
+        for(int jj = 0; jj < mapSizeY; ++jj)
+        {
+            Tile* tile = gameMap.getTile(ii, jj);
+            if (tile == nullptr)
+                continue;
+
+            // Don't save standard tiles as they're auto filled in at load time.
+            if (!tile->isClaimed() && tile->getType() == TileType::dirt && tile->getFullness() >= 100.0)
+                continue;
+
+            LevelFile::TileRecord record;
+            record.mX = tile->getX();
+            record.mY = tile->getY();
+            record.mType = static_cast<int32_t>(tile->getType());
+            record.mSeatId = tile->getSeat() == nullptr ? -1 : tile->getSeat()->getId();
+            record.mFullness = tile->getFullness();
+            tiles.push_back(record);
+        }
+    }
+}
+
+//! \brief Builds the binary level. The tiles are written as records and the other
+//! sections are the text sections without comments
+static bool buildBinaryLevel(GameMap& gameMap, LevelFile::LevelData& level)
+{
+    std::stringstream levelText;
+    writeGameMapToStream(levelText, gameMap, false);
+
+    std::string error;
+    if(!LevelFile::parseText(LevelFile::removeComments(levelText), level, error))
+    {
+        OD_LOG_ERR("Couldn't build binary level: " + error);
+        return false;
+    }
+
+    buildTileRecords(gameMap, level.mTiles);
+    return true;
+}
+
+static bool writeGameMapToBinaryFile(const std::string& fileName, GameMap& gameMap)
+{
+    LevelFile::LevelData level;
+    if(!buildBinaryLevel(gameMap, level))
+        return false;
+
+    std::string error;
+    if(!LevelFile::writeBinary(fileName, level, error))
+    {
+        OD_LOG_WRN(error);
+        return false;
+    }
+
+    return true;
+}
+
+bool writeGameMapToFile(const std::string& fileName, GameMap& gameMap, bool binary)
+{
+    if(binary)
+        return writeGameMapToBinaryFile(fileName, gameMap);
+
+    std::ofstream levelFile(fileName.c_str(), std::ifstream::out);
+
+    // This is better than checking for .bad(), as it checks every error flags.
+    if (!levelFile.good()) {
+        OD_LOG_WRN("Couldn't open file for writing: " + fileName);
+        return false;
+    }
+
+    writeGameMapToStream(levelFile, gameMap, true);
 
     if (!levelFile.good()) {
         OD_LOG_WRN("Unexpected failure on file: " + fileName);
@@ -788,11 +979,32 @@ bool writeGameMapToFile(const std::string& fileName, GameMap& gameMap)
     return true;
 }
 
+void takeGameMapSnapshot(GameMap& gameMap, GameMapSnapshot& snapshot)
+{
+    snapshot.clear();
+
+    std::ostringstream levelText;
+    writeGameMapToStream(levelText, gameMap, false);
+    std::string text = levelText.str();
+    snapshot.setText(text);
+
+    buildTileRecords(gameMap, snapshot.getTiles());
+}
+
 bool getMapInfo(const std::string& fileName, LevelInfo& levelInfo)
 {
     // Prepare an invalid level reference
     std::stringstream levelFile;
-    if(!Helper::readFileWithoutComments(fileName, levelFile))
+    if(LevelFile::isBinaryFile(fileName))
+    {
+        LevelFile::MappedLevel binaryLevel;
+        std::string error;
+        if(!binaryLevel.open(fileName, error))
+            return false;
+
+        buildBinaryLevelStream(binaryLevel, levelFile);
+    }
+    else if(!Helper::readFileWithoutComments(fileName, levelFile))
         return false;
 
     std::string nextParam;
@@ -906,6 +1118,9 @@ bool getMapInfo(const std::string& fileName, LevelInfo& levelInfo)
 
         mapInfo << str << std::endl << std::endl;
     }
+    levelInfo.mNbPlayerSeats = playerSeatNumber;
+    levelInfo.mNbAISeats = AISeatNumber;
+    levelInfo.mNbConfigurableSeats = seatConfigurable;
 
     // Read in the goals that are shared by all players, the first player to complete all these goals is the winner.
     levelFile >> nextParam;
@@ -941,6 +1156,8 @@ bool getMapInfo(const std::string& fileName, LevelInfo& levelInfo)
     mapInfo << "Size: " << mapSizeX << "x" << mapSizeY << std::endl << std::endl;
 
     levelInfo.mLevelDescription = mapInfo.str();
+    levelInfo.mMapSizeX = mapSizeX;
+    levelInfo.mMapSizeY = mapSizeY;
     return true;
 }
 
@@ -22,13 +22,19 @@
 #include <string>
 
 class GameMap;
+class GameMapSnapshot;
 
 enum class GameEntityType;
 
 //! \brief A small structure storing level info for the player
 struct LevelInfo
 {
-    LevelInfo()
+    LevelInfo() :
+        mMapSizeX(0),
+        mMapSizeY(0),
+        mNbPlayerSeats(0),
+        mNbAISeats(0),
+        mNbConfigurableSeats(0)
     {}
 
     //! \brief The level visible name
@@ -36,13 +42,26 @@ struct LevelInfo
 
     //! \brief The level description, player's slot, size, ...
     std::string mLevelDescription;
+
+    int mMapSizeX;
+    int mMapSizeY;
+    int mNbPlayerSeats;
+    int mNbAISeats;
+    int mNbConfigurableSeats;
 };
 
 namespace MapHandler
 {
     bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap);
 
-    bool writeGameMapToFile(const std::string& fileName, GameMap& gameMap);
+    //! \brief Writes the level in the given file. The text format is used for edited levels. The binary
+    //! format (see LevelFile) is faster to load and is used for saved games. readGameMapFromFile
+    //! and getMapInfo handle both formats.
+    bool writeGameMapToFile(const std::string& fileName, GameMap& gameMap, bool binary = false);
+
+    //! \brief Takes a snapshot of the gamemap that can be saved later without accessing it (see GameSaveWriter).
+    //! The saved game is the same as the one written by writeGameMapToFile in binary
+    void takeGameMapSnapshot(GameMap& gameMap, GameMapSnapshot& snapshot);
 
     bool readGameEntity(GameMap& gameMap, const std::string& item, GameEntityType type, std::stringstream& levelFile);
 
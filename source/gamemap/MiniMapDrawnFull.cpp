@@ -24,6 +24,7 @@
 #include "gamemap/GameMap.h"
 #include "render/ODFrameListener.h"
 
+#include <OgrePixelFormat.h>
 #include <OgrePrerequisites.h>
 #include <OgreSceneNode.h>
 #include <OgreTextureManager.h>
@@ -39,6 +40,9 @@
 #include <CEGUI/Window.h>
 #include <CEGUI/WindowManager.h>
 
+#include <algorithm>
+#include <cmath>
+
 class MiniMapDrawnFullTileStateListener : public TileStateListener
 {
 public:
@@ -54,6 +58,8 @@ public:
         mTileXMax(tileXMax),
         mTileYMin(tileYMin),
         mTileYMax(tileYMax),
+        mIsDirty(false),
+        mIsInCameraOverlay(false),
         mMinimap(minimap)
     {}
 
@@ -62,13 +68,7 @@ public:
 
     void tileStateChanged(Tile& tile) override
     {
-        fireTileStateChanged();
-    }
-
-    void fireTileStateChanged()
-    {
-        mMinimap.updateTileState(mMinimapXMin, mMinimapXMax, mMinimapYMin,
-            mMinimapYMax, mTileXMin, mTileXMax, mTileYMin, mTileYMax);
+        mMinimap.markListenerDirty(*this);
     }
 
     const uint32_t mMinimapXMin;
@@ -80,6 +80,11 @@ public:
     const uint32_t mTileYMin;
     const uint32_t mTileYMax;
 
+    //! \brief True if the listener is in MiniMapDrawnFull::mDirtyListeners
+    bool mIsDirty;
+    //! \brief True if the listener is in MiniMapDrawnFull::mVisibleRectangle
+    bool mIsInCameraOverlay;
+
 private:
     MiniMapDrawnFull& mMinimap;
 };
@@ -108,6 +113,9 @@ enum class MiniMapDrawnFullPixel
 
 namespace
 {
+//! \brief Size of a pixel in the PF_R8G8B8 buffers
+const uint32_t PIXEL_SIZE = 3;
+
 MiniMapDrawnFullPixel getPixelValueFromTile(Seat& playerSeat, Tile& tile)
 {
     MiniMapDrawnFullPixel value = MiniMapDrawnFullPixel::dirtFull;
@@ -185,13 +193,8 @@ MiniMapDrawnFullPixel getPixelValueFromTile(Seat& playerSeat, Tile& tile)
 }
 
 void colourFromPixelValue(MiniMapDrawnFullPixel pixelValue, Seat* seatIfClaimed,
-        Ogre::HardwarePixelBufferSharedPtr& pixelBuffer, Ogre::PixelBox pixelBox,
-        uint32_t minimapWidth, uint32_t minimapHeight, uint32_t minimapXMin,
-        uint32_t minimapXMax, uint32_t minimapYMin, uint32_t minimapYMax)
+        Ogre::uint8& RR, Ogre::uint8& GG, Ogre::uint8& BB)
 {
-    Ogre::uint8 RR = 0x00;
-    Ogre::uint8 GG = 0x00;
-    Ogre::uint8 BB = 0x00;
     switch(pixelValue)
     {
         case MiniMapDrawnFullPixel::enemyCreature:
@@ -306,23 +309,6 @@ void colourFromPixelValue(MiniMapDrawnFullPixel pixelValue, Seat* seatIfClaimed,
             break;
         }
     }
-
-    auto output = pixelBuffer->lock(pixelBox, Ogre::HardwareBuffer::HBL_NORMAL);
-
-    assert(minimapXMax <= output.getWidth());
-    assert(minimapYMax <= output.getHeight());
-
-    for(size_t xx = minimapXMin; xx < minimapXMax; ++xx)
-    {
-        for(size_t yy = minimapYMin; yy < minimapYMax; ++yy)
-        {
-            // TODO: This is probably a bit inefficient at the moment.
-            output.setColourAt(Ogre::ColourValue(RR/255.0, GG/255.0, BB/255.0), xx, output.getHeight() - yy, 0);
-
-        }
-    }
-
-    pixelBuffer->unlock();
 }
 }
 
@@ -330,11 +316,18 @@ MiniMapDrawnFull::MiniMapDrawnFull(CEGUI::Window* miniMapWindow) :
     mMiniMapWindow(miniMapWindow),
     mGameMap(*ODFrameListener::getSingleton().getClientGameMap()),
     mCameraManager(*ODFrameListener::getSingleton().getCameraManager()),
+    mNbListenerColumns(0),
     mTopLeftCornerX(0),
     mTopLeftCornerY(0),
     mWidth(static_cast<unsigned int>(mMiniMapWindow->getPixelSize().d_width)),
     mHeight(static_cast<unsigned int>(mMiniMapWindow->getPixelSize().d_height)),
-    mPixelBox(mWidth, mHeight, 1, Ogre::PF_R8G8B8),
+    mTileColours(mWidth * mHeight * PIXEL_SIZE, 0),
+    mOverlay(mWidth * mHeight, 0),
+    mUploadBuffer(mWidth * mHeight * PIXEL_SIZE, 0),
+    mDirtyXMin(0),
+    mDirtyXMax(mWidth),
+    mDirtyYMin(0),
+    mDirtyYMax(mHeight),
     mMiniMapOgreTexture(Ogre::TextureManager::getSingletonPtr()->createManual(
             "miniMapOgreTexture",
             Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
@@ -353,6 +346,10 @@ MiniMapDrawnFull::MiniMapDrawnFull(CEGUI::Window* miniMapWindow) :
     Ogre::Real gainX = static_cast<Ogre::Real>(mWidth) / static_cast<Ogre::Real>(tileXMax);
     Ogre::Real gainY = static_cast<Ogre::Real>(mHeight) / static_cast<Ogre::Real>(tileYMax);
 
+    mListenerColumnOfTileX.assign(tileXMax, -1);
+    mListenerRowOfTileY.assign(tileYMax, -1);
+    int32_t column = 0;
+    int32_t row = 0;
     while((mapX < mWidth) && (mapY < mHeight) && (tileX < tileXMax) && (tileY < tileYMax))
     {
         uint32_t tileXNext = static_cast<uint32_t>(round(static_cast<Ogre::Real>(mapX + 1) / gainX));
@@ -374,6 +371,21 @@ MiniMapDrawnFull::MiniMapDrawnFull(CEGUI::Window* miniMapWindow) :
 
         mTileStateListeners.push_back(listener);
 
+        // Every row has the same columns
+        if(row == 0)
+        {
+            for(uint32_t xxx = tileX; (xxx < tileXNext) && (xxx < tileXMax); ++xxx)
+                mListenerColumnOfTileX[xxx] = column;
+
+            ++mNbListenerColumns;
+        }
+        if(column == 0)
+        {
+            for(uint32_t yyy = tileY; (yyy < tileYNext) && (yyy < tileYMax); ++yyy)
+                mListenerRowOfTileY[yyy] = row;
+        }
+
+        ++column;
         mapX = mapXNext;
         tileX = tileXNext;
         if(tileXNext >= tileXMax)
@@ -382,11 +394,12 @@ MiniMapDrawnFull::MiniMapDrawnFull(CEGUI::Window* miniMapWindow) :
             tileY = tileYNext;
             mapX = 0;
             tileX = 0;
+            column = 0;
+            ++row;
         }
     }
 
-    // It  start, we fire the tile state changed event to make sure every pixel is
-    // correctly initialized. We also set the listeners on the tiles
+    // At start, we compute every pixel. We also set the listeners on the tiles
     for(MiniMapDrawnFullTileStateListener* listener : mTileStateListeners)
     {
         for(uint32_t xxx = listener->mTileXMin; xxx < listener->mTileXMax; ++xxx)
@@ -401,7 +414,7 @@ MiniMapDrawnFull::MiniMapDrawnFull(CEGUI::Window* miniMapWindow) :
             }
         }
 
-        listener->fireTileStateChanged();
+        updateTileState(*listener);
     }
 
     CEGUI::Texture& miniMapTextureGui = static_cast<CEGUI::OgreRenderer*>(CEGUI::System::getSingletonPtr()
@@ -419,6 +432,7 @@ MiniMapDrawnFull::MiniMapDrawnFull(CEGUI::Window* miniMapWindow) :
     mMiniMapWindow->setProperty("Image", CEGUI::PropertyHelper<CEGUI::Image*>::toString(&imageset));
 
     mMiniMapOgreTexture->load();
+    uploadDirtyRectangle();
 
     mTopLeftCornerX = mMiniMapWindow->getUnclippedOuterRect().get().getPosition().d_x;
     mTopLeftCornerY = mMiniMapWindow->getUnclippedOuterRect().get().getPosition().d_y;
@@ -442,6 +456,8 @@ MiniMapDrawnFull::~MiniMapDrawnFull()
         delete listener;
     }
     mTileStateListeners.clear();
+    mDirtyListeners.clear();
+    mVisibleRectangle.clear();
 
     mMiniMapWindow->setProperty("Image", "");
     Ogre::TextureManager::getSingletonPtr()->remove("miniMapOgreTexture");
@@ -463,17 +479,25 @@ Ogre::Vector2 MiniMapDrawnFull::camera_2dPositionFromClick(int xx, int yy)
     return v;
 }
 
-void MiniMapDrawnFull::updateTileState(uint32_t minimapXMin, uint32_t minimapXMax,
-        uint32_t minimapYMin, uint32_t minimapYMax, uint32_t tileXMin,
-        uint32_t tileXMax, uint32_t tileYMin, uint32_t tileYMax)
+void MiniMapDrawnFull::markListenerDirty(MiniMapDrawnFullTileStateListener& listener)
+{
+    // Tiles usually change by groups (digging, claiming, ...) so we wait for the next update
+    if(listener.mIsDirty)
+        return;
+
+    listener.mIsDirty = true;
+    mDirtyListeners.push_back(&listener);
+}
+
+void MiniMapDrawnFull::updateTileState(MiniMapDrawnFullTileStateListener& listener)
 {
     Seat& localPlayerSeat = *(mGameMap.getLocalPlayer()->getSeat());
     // We compute the tile representation
     MiniMapDrawnFullPixel curValue = MiniMapDrawnFullPixel::dirtFull;
     Seat* seatIfClaimed = nullptr;
-    for(uint32_t xxx = tileXMin; xxx < tileXMax; ++xxx)
+    for(uint32_t xxx = listener.mTileXMin; xxx < listener.mTileXMax; ++xxx)
     {
-        for(uint32_t yyy = tileYMin; yyy < tileYMax; ++yyy)
+        for(uint32_t yyy = listener.mTileYMin; yyy < listener.mTileYMax; ++yyy)
         {
             Tile* tile = mGameMap.getTile(xxx, yyy);
             if(tile == nullptr)
@@ -497,69 +521,161 @@ void MiniMapDrawnFull::updateTileState(uint32_t minimapXMin, uint32_t minimapXMa
         }
     }
 
+    Ogre::uint8 RR;
+    Ogre::uint8 GG;
+    Ogre::uint8 BB;
+    colourFromPixelValue(curValue, seatIfClaimed, RR, GG, BB);
+
     // We paint corresponding pixels
-    colourFromPixelValue(curValue, seatIfClaimed, mPixelBuffer, mPixelBox,
-        mWidth, mHeight, minimapXMin, minimapXMax, minimapYMin, minimapYMax);
+    uint32_t xMax = std::min(listener.mMinimapXMax, static_cast<uint32_t>(mWidth));
+    uint32_t yMax = std::min(listener.mMinimapYMax, static_cast<uint32_t>(mHeight));
+    for(uint32_t yyy = listener.mMinimapYMin; yyy < yMax; ++yyy)
+    {
+        for(uint32_t xxx = listener.mMinimapXMin; xxx < xMax; ++xxx)
+        {
+            Ogre::PixelUtil::packColour(RR, GG, BB, 0xFF, Ogre::PF_R8G8B8,
+                &mTileColours[(yyy * mWidth + xxx) * PIXEL_SIZE]);
+        }
+    }
+
+    addDirtyPixels(listener);
 }
 
-bool MiniMapDrawnFull::crossSegment(const Ogre::Vector3& p1, const Ogre::Vector3& p2,
-        uint32_t xMin, uint32_t xMax, uint32_t yMin, uint32_t yMax)
+void MiniMapDrawnFull::addDirtyPixels(const MiniMapDrawnFullTileStateListener& listener)
 {
-    if((p1.x < static_cast<Ogre::Real>(xMin)) &&
-       (p2.x < static_cast<Ogre::Real>(xMin)))
-    {
-        return false;
-    }
-    if((p1.x > static_cast<Ogre::Real>(xMax)) &&
-       (p2.x > static_cast<Ogre::Real>(xMax)))
+    uint32_t xMax = std::min(listener.mMinimapXMax, static_cast<uint32_t>(mWidth));
+    uint32_t yMax = std::min(listener.mMinimapYMax, static_cast<uint32_t>(mHeight));
+    if(mDirtyXMin >= mDirtyXMax)
     {
-        return false;
+        mDirtyXMin = listener.mMinimapXMin;
+        mDirtyXMax = xMax;
+        mDirtyYMin = listener.mMinimapYMin;
+        mDirtyYMax = yMax;
+        return;
     }
 
-    if((p1.y < static_cast<Ogre::Real>(yMin)) &&
-       (p2.y < static_cast<Ogre::Real>(yMin)))
+    mDirtyXMin = std::min(mDirtyXMin, listener.mMinimapXMin);
+    mDirtyXMax = std::max(mDirtyXMax, xMax);
+    mDirtyYMin = std::min(mDirtyYMin, listener.mMinimapYMin);
+    mDirtyYMax = std::max(mDirtyYMax, yMax);
+}
+
+MiniMapDrawnFullTileStateListener* MiniMapDrawnFull::getListenerForTile(int tileX, int tileY)
+{
+    if((tileX < 0) || (tileY < 0))
+        return nullptr;
+    if((tileX >= static_cast<int>(mListenerColumnOfTileX.size())) || (tileY >= static_cast<int>(mListenerRowOfTileY.size())))
+        return nullptr;
+
+    int32_t column = mListenerColumnOfTileX[tileX];
+    int32_t row = mListenerRowOfTileY[tileY];
+    if((column < 0) || (row < 0))
+        return nullptr;
+
+    std::size_t index = static_cast<std::size_t>(row) * mNbListenerColumns + static_cast<std::size_t>(column);
+    if(index >= mTileStateListeners.size())
+        return nullptr;
+
+    return mTileStateListeners[index];
+}
+
+void MiniMapDrawnFull::drawOverlaySegment(const Ogre::Vector3& p1, const Ogre::Vector3& p2)
+{
+    // We walk along the segment with steps smaller than a tile
+    Ogre::Real length = std::max(std::abs(p2.x - p1.x), std::abs(p2.y - p1.y));
+    uint32_t nbSteps = static_cast<uint32_t>(std::ceil(length * 2.0)) + 1;
+    for(uint32_t step = 0; step <= nbSteps; ++step)
     {
-        return false;
+        Ogre::Real ratio = static_cast<Ogre::Real>(step) / static_cast<Ogre::Real>(nbSteps);
+        int tileX = static_cast<int>(std::round(p1.x + (p2.x - p1.x) * ratio));
+        int tileY = static_cast<int>(std::round(p1.y + (p2.y - p1.y) * ratio));
+        MiniMapDrawnFullTileStateListener* listener = getListenerForTile(tileX, tileY);
+        if((listener == nullptr) || listener->mIsInCameraOverlay)
+            continue;
+
+        listener->mIsInCameraOverlay = true;
+        mVisibleRectangle.push_back(listener);
+        uint32_t xMax = std::min(listener->mMinimapXMax, static_cast<uint32_t>(mWidth));
+        uint32_t yMax = std::min(listener->mMinimapYMax, static_cast<uint32_t>(mHeight));
+        for(uint32_t yyy = listener->mMinimapYMin; yyy < yMax; ++yyy)
+        {
+            for(uint32_t xxx = listener->mMinimapXMin; xxx < xMax; ++xxx)
+                mOverlay[yyy * mWidth + xxx] = 1;
+        }
+        addDirtyPixels(*listener);
     }
-    if((p1.y > static_cast<Ogre::Real>(yMax)) &&
-       (p2.y > static_cast<Ogre::Real>(yMax)))
+}
+
+void MiniMapDrawnFull::updateCameraOverlay(const std::vector<Ogre::Vector3>& cornerTiles)
+{
+    // We remove the old footprint
+    for(MiniMapDrawnFullTileStateListener* listener : mVisibleRectangle)
     {
-        return false;
+        listener->mIsInCameraOverlay = false;
+        uint32_t xMax = std::min(listener->mMinimapXMax, static_cast<uint32_t>(mWidth));
+        uint32_t yMax = std::min(listener->mMinimapYMax, static_cast<uint32_t>(mHeight));
+        for(uint32_t yyy = listener->mMinimapYMin; yyy < yMax; ++yyy)
+        {
+            for(uint32_t xxx = listener->mMinimapXMin; xxx < xMax; ++xxx)
+                mOverlay[yyy * mWidth + xxx] = 0;
+        }
+        addDirtyPixels(*listener);
     }
+    mVisibleRectangle.clear();
+
+    // And we draw the border of the new one
+    const Ogre::Vector3& topRight = cornerTiles[0];
+    const Ogre::Vector3& topLeft = cornerTiles[1];
+    const Ogre::Vector3& bottomLeft = cornerTiles[2];
+    const Ogre::Vector3& bottomRight = cornerTiles[3];
+    drawOverlaySegment(topRight, topLeft);
+    drawOverlaySegment(topLeft, bottomLeft);
+    drawOverlaySegment(bottomLeft, bottomRight);
+    drawOverlaySegment(bottomRight, topRight);
+}
 
-    Ogre::Real diffYPoints = p2.y - p1.y;
-    Ogre::Real diffXPoints = p2.x - p1.x;
-    Ogre::Real diffYMin = p2.y - static_cast<Ogre::Real>(yMin);
-    Ogre::Real diffXMin = p2.x - static_cast<Ogre::Real>(xMin);
-    Ogre::Real diffYMax = p2.y - static_cast<Ogre::Real>(yMax);
-    Ogre::Real diffXMax = p2.x - static_cast<Ogre::Real>(xMax);
-
-    // Magic number to change the size of the line
-    static const Ogre::Real DIFF_MIN = 5;
-    if(
-       (
-        (diffYMin * diffXPoints - diffYPoints * diffXMin - DIFF_MIN< 0) &&
-        (diffYMax * diffXPoints - diffYPoints * diffXMax + DIFF_MIN >= 0)
-       ) ||
-       (
-        (diffYMax * diffXPoints - diffYPoints * diffXMax - DIFF_MIN< 0) &&
-        (diffYMin * diffXPoints - diffYPoints * diffXMin + DIFF_MIN >= 0)
-       )
-      )
+void MiniMapDrawnFull::uploadDirtyRectangle()
+{
+    if(mDirtyXMin >= mDirtyXMax || mDirtyYMin >= mDirtyYMax)
+        return;
+
+    // The minimap y axis goes up while the texture rows go down
+    uint32_t rowMin = mHeight - mDirtyYMax;
+    uint32_t rowMax = mHeight - mDirtyYMin;
+    for(uint32_t row = rowMin; row < rowMax; ++row)
     {
-        return true;
+        uint32_t yyy = mHeight - 1 - row;
+        for(uint32_t xxx = mDirtyXMin; xxx < mDirtyXMax; ++xxx)
+        {
+            uint32_t index = yyy * mWidth + xxx;
+            Ogre::uint8* dest = &mUploadBuffer[(row * mWidth + xxx) * PIXEL_SIZE];
+            if(mOverlay[index] != 0)
+            {
+                // The camera footprint is drawn in black
+                std::fill(dest, dest + PIXEL_SIZE, 0);
+                continue;
+            }
+
+            const Ogre::uint8* src = &mTileColours[index * PIXEL_SIZE];
+            std::copy(src, src + PIXEL_SIZE, dest);
+        }
     }
 
-    return false;
+    // Only the dirty rectangle is sent. Since it is fully rewritten, its previous content is discarded
+    Ogre::Box box(mDirtyXMin, rowMin, mDirtyXMax, rowMax);
+    Ogre::PixelBox fullBox(mWidth, mHeight, 1, Ogre::PF_R8G8B8, mUploadBuffer.data());
+    const Ogre::PixelBox& dest = mPixelBuffer->lock(box, Ogre::HardwareBuffer::HBL_DISCARD);
+    Ogre::PixelUtil::bulkPixelConversion(fullBox.getSubVolume(box), dest);
+    mPixelBuffer->unlock();
+
+    mDirtyXMin = 0;
+    mDirtyXMax = 0;
+    mDirtyYMin = 0;
+    mDirtyYMax = 0;
 }
 
 void MiniMapDrawnFull::update(Ogre::Real timeSinceLastFrame, const std::vector<Ogre::Vector3>& cornerTiles)
 {
-    const Ogre::Vector3& topRight = cornerTiles[0];
-    const Ogre::Vector3& topLeft = cornerTiles[1];
-    const Ogre::Vector3& bottomLeft = cornerTiles[2];
-    const Ogre::Vector3& bottomRight = cornerTiles[3];
-
     bool isSame = (mLastCornerTiles.size() == cornerTiles.size());
     static const Ogre::Real squareDiffMin = 0.5;
     for(uint32_t iii = 0; isSame && iii < mLastCornerTiles.size(); ++iii)
@@ -568,68 +684,19 @@ void MiniMapDrawnFull::update(Ogre::Real timeSinceLastFrame, const std::vector<O
         isSame &= (val <= squareDiffMin);
     }
 
-    if(isSame)
-        return;
-
-    // We save corner tiles
-    mLastCornerTiles = cornerTiles;
-
-    // We refresh the old rectangle
-    for(MiniMapDrawnFullTileStateListener* listener : mVisibleRectangle)
+    if(!isSame && (cornerTiles.size() == 4))
     {
-        listener->fireTileStateChanged();
+        // We save corner tiles
+        mLastCornerTiles = cornerTiles;
+        updateCameraOverlay(cornerTiles);
     }
-    mVisibleRectangle.clear();
-
-    // And we paint the new visible rectangle
-    auto output = mPixelBuffer->lock(mPixelBox, Ogre::HardwareBuffer::HBL_NORMAL);
 
-    // we look for the tiles at the border of vision to paint them black
-    for(MiniMapDrawnFullTileStateListener* listener : mTileStateListeners)
+    for(MiniMapDrawnFullTileStateListener* listener : mDirtyListeners)
     {
-        bool isInBorder = false;
-
-        // We check if the listener tiles are on the top line
-        if(!isInBorder &&
-            crossSegment(topRight, topLeft, listener->mTileXMin, listener->mTileXMax,
-                listener->mTileYMin, listener->mTileYMax))
-        {
-            isInBorder = true;
-        }
-
-        if(!isInBorder &&
-            crossSegment(topLeft, bottomLeft, listener->mTileXMin, listener->mTileXMax,
-                listener->mTileYMin, listener->mTileYMax))
-        {
-            isInBorder = true;
-        }
-
-        if(!isInBorder &&
-            crossSegment(bottomLeft, bottomRight, listener->mTileXMin, listener->mTileXMax,
-                listener->mTileYMin, listener->mTileYMax))
-        {
-            isInBorder = true;
-        }
-
-        if(!isInBorder &&
-            crossSegment(bottomRight, topRight, listener->mTileXMin, listener->mTileXMax,
-                listener->mTileYMin, listener->mTileYMax))
-        {
-            isInBorder = true;
-        }
-
-        if(!isInBorder)
-            continue;
-
-        mVisibleRectangle.push_back(listener);
-        for(uint32_t xxx = listener->mMinimapXMin; xxx < listener->mMinimapXMax; ++xxx)
-        {
-            for(uint32_t yyy = listener->mMinimapYMin; yyy < listener->mMinimapYMax; ++yyy)
-            {
-                output.setColourAt(Ogre::ColourValue(0.0f, 0.0f, 0.0f), xxx,
-                                   output.getHeight() - yyy, 0);
-            }
-        }
+        listener->mIsDirty = false;
+        updateTileState(*listener);
     }
-    mPixelBuffer->unlock();
+    mDirtyListeners.clear();
+
+    uploadDirtyRectangle();
 }
@@ -39,6 +39,13 @@ class MiniMapDrawnFullTileStateListener;
 class Seat;
 class Tile;
 
+/*! \brief Minimap drawn from the tiles states.
+ *
+ * The tile colours are kept in a CPU buffer that is only updated for the tiles whose state
+ * changed. The camera footprint is drawn as a separate layer over it. Each frame, only the
+ * rectangle containing the changed pixels is uploaded to the texture so that the minimap
+ * costs nothing when nothing changes, whatever the map size.
+ */
 class MiniMapDrawnFull : public MiniMap
 {
 public:
@@ -53,25 +60,48 @@ public:
 
     void update(Ogre::Real timeSinceLastFrame, const std::vector<Ogre::Vector3>& cornerTiles) override;
 
-    void updateTileState(uint32_t minimapXMin, uint32_t xMinimapMax,
-        uint32_t minimapYMin, uint32_t minimapYMax, uint32_t tileXMin,
-        uint32_t tileXMax, uint32_t tileYMin, uint32_t tileYMax);
+    //! \brief Called when the state of a tile of the given listener changed. The pixels will
+    //! be refreshed during the next update
+    void markListenerDirty(MiniMapDrawnFullTileStateListener& listener);
 
     Ogre::Vector2 camera_2dPositionFromClick(int xx, int yy) override;
 
 private:
-    //! \brief Returns true is the segment between p1 and p2 (using x and y only)
-    //! crosses the values within xMin, xMax, yMin and yMax
-    bool crossSegment(const Ogre::Vector3& p1, const Ogre::Vector3& p2,
-        uint32_t xMin, uint32_t xMax, uint32_t yMin, uint32_t yMax);
+    //! \brief Computes the colour of the pixels of the given listener from its tiles
+    void updateTileState(MiniMapDrawnFullTileStateListener& listener);
+
+    //! \brief Removes the camera footprint from the overlay and draws the new one
+    void updateCameraOverlay(const std::vector<Ogre::Vector3>& cornerTiles);
+
+    //! \brief Adds the listeners crossed by the segment between p1 and p2 to the camera footprint
+    void drawOverlaySegment(const Ogre::Vector3& p1, const Ogre::Vector3& p2);
+
+    //! \brief Returns the listener containing the given tile or nullptr if there is none
+    MiniMapDrawnFullTileStateListener* getListenerForTile(int tileX, int tileY);
+
+    //! \brief Extends the rectangle to upload with the pixels of the given listener
+    void addDirtyPixels(const MiniMapDrawnFullTileStateListener& listener);
+
+    //! \brief Uploads the dirty rectangle to the texture
+    void uploadDirtyRectangle();
 
     CEGUI::Window* mMiniMapWindow;
 
     GameMap& mGameMap;
     CameraManager& mCameraManager;
 
+    //! \brief The listeners, row by row. Each listener covers a rectangle of tiles and the
+    //! corresponding rectangle of pixels
     std::vector<MiniMapDrawnFullTileStateListener*> mTileStateListeners;
+    uint32_t mNbListenerColumns;
+    //! \brief Column/row of the listener containing each tile column/row (-1 if none)
+    std::vector<int32_t> mListenerColumnOfTileX;
+    std::vector<int32_t> mListenerRowOfTileY;
+
+    //! \brief Listeners whose tiles have changed since the last update
+    std::vector<MiniMapDrawnFullTileStateListener*> mDirtyListeners;
 
+    //! \brief Listeners drawn as the camera footprint
     std::vector<MiniMapDrawnFullTileStateListener*> mVisibleRectangle;
 
     std::vector<Ogre::Vector3> mLastCornerTiles;
@@ -83,7 +113,19 @@ private:
 
     Ogre::Vector2 mCamera_2dPosition;
 
-    Ogre::PixelBox mPixelBox;
+    //! \brief Colour of each pixel computed from the tiles (PF_R8G8B8), row by row from the bottom
+    std::vector<Ogre::uint8> mTileColours;
+    //! \brief 1 for the pixels covered by the camera footprint
+    std::vector<Ogre::uint8> mOverlay;
+    //! \brief Composition of the tile colours and the overlay sent to the texture (PF_R8G8B8), in texture order
+    std::vector<Ogre::uint8> mUploadBuffer;
+
+    //! \brief Rectangle of pixels to upload (in minimap coordinates). Empty if mDirtyXMin >= mDirtyXMax
+    uint32_t mDirtyXMin;
+    uint32_t mDirtyXMax;
+    uint32_t mDirtyYMin;
+    uint32_t mDirtyYMax;
+
     Ogre::TexturePtr mMiniMapOgreTexture;
     Ogre::HardwarePixelBufferSharedPtr mPixelBuffer;
 };
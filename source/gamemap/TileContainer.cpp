@@ -718,9 +718,9 @@ void TileContainer::buildTileDistance(int distance)
     mTileDistanceComputed = distance;
 }
 
-std::list<Tile*> TileContainer::tilesBetween(int x1, int y1, int x2, int y2) const
+void TileContainer::tilesBetween(int x1, int y1, int x2, int y2, std::vector<Tile*>& path) const
 {
-    std::list<Tile*> path;
+    path.clear();
 
     double deltax = x2 - x1;
     double deltay = y2 - y1;
@@ -804,8 +804,6 @@ std::list<Tile*> TileContainer::tilesBetween(int x1, int y1, int x2, int y2) con
     Tile* tile = getTile(x2, y2);
     if(tile != nullptr)
         path.push_back(tile);
-
-    return path;
 }
 
 std::vector<Tile*> TileContainer::visibleTiles(int x, int y, int radius)
@@ -84,14 +84,15 @@ public:
     int getMapSizeY() const
     { return mMapSizeY; }
 
-    /*! \brief Returns a list of valid tiles along a straight line from (x1, y1) to (x2, y2)
-     * independently from their fullness or type.
+    /*! \brief Fills tiles with the valid tiles along a straight line from (x1, y1) to (x2, y2)
+     * independently from their fullness or type. tiles is cleared first so that callers can
+     * reuse the same vector.
      *
      * This algorithm is from
      * http://en.wikipedia.org/wiki/Bresenham%27s_line_algorithm
      * A more detailed description of how it works can be found there.
      */
-    std::list<Tile*> tilesBetween(int x1, int y1, int x2, int y2) const;
+    void tilesBetween(int x1, int y1, int x2, int y2, std::vector<Tile*>& tiles) const;
 
     //! \brief Returns the tiles visible from the given start tile within radius. The tiles are ordered from the closest to
     //! the furthest
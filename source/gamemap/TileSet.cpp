@@ -18,6 +18,7 @@
 #include "gamemap/TileSet.h"
 
 #include "entities/Tile.h"
+#include "network/ODPacket.h"
 #include "utils/LogManager.h"
 
 TileSet::TileSet() :
@@ -87,3 +88,54 @@ bool TileSet::areLinked(const Tile* tile1, const Tile* tile2) const
 
     return true;
 }
+
+void TileSet::exportToPacket(ODPacket& os) const
+{
+    for(uint32_t tileLink : mTileLinks)
+        os << tileLink;
+
+    for(const std::vector<TileSetValue>& tileValues : mTileValues)
+    {
+        uint32_t nb = tileValues.size();
+        os << nb;
+        for(const TileSetValue& value : tileValues)
+        {
+            os << value.getMeshName() << value.getMaterialName();
+            os << value.getRotationX() << value.getRotationY() << value.getRotationZ();
+        }
+    }
+}
+
+bool TileSet::importFromPacket(ODPacket& is)
+{
+    // The number of tile visuals is fixed by the TileSet constructor
+    for(uint32_t& tileLink : mTileLinks)
+    {
+        if(!(is >> tileLink))
+            return false;
+    }
+
+    for(std::vector<TileSetValue>& tileValues : mTileValues)
+    {
+        uint32_t nb;
+        if(!(is >> nb))
+            return false;
+
+        tileValues.clear();
+        std::string meshName;
+        std::string materialName;
+        Ogre::Real rotationX;
+        Ogre::Real rotationY;
+        Ogre::Real rotationZ;
+        while(nb > 0)
+        {
+            --nb;
+            if(!(is >> meshName >> materialName >> rotationX >> rotationY >> rotationZ))
+                return false;
+
+            tileValues.push_back(TileSetValue(meshName, materialName, rotationX, rotationY, rotationZ));
+        }
+    }
+
+    return true;
+}
@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <string>
 
+class ODPacket;
 class Tile;
 
 enum class TileType;
@@ -84,6 +85,10 @@ public:
 
     void addTileLink(TileVisual tileVisual1, TileVisual tileVisual2);
 
+    //! Writes/reads the tile values and links for the binary configuration cache
+    void exportToPacket(ODPacket& os) const;
+    bool importFromPacket(ODPacket& is);
+
 private:
     std::vector<std::vector<TileSetValue>> mTileValues;
     //! Represents the links between tiles. The uint is used as a bit array.
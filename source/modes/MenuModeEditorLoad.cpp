@@ -27,6 +27,7 @@
 #include "network/ODClient.h"
 #include "network/ServerMode.h"
 #include "utils/LogManager.h"
+#include "gamemap/LevelIndex.h"
 #include "gamemap/MapHandler.h"
 #include "utils/ResourceManager.h"
 #include "utils/ConfigManager.h"
@@ -36,7 +37,7 @@
 #include <boost/filesystem.hpp>
 
 MenuModeEditorLoad::MenuModeEditorLoad(ModeManager* modeManager):
-    AbstractApplicationMode(modeManager, ModeManager::MENU_EDITOR_LOAD)
+    MenuModeLevelListBase(modeManager, ModeManager::MENU_EDITOR_LOAD, Gui::guiSheet::editorLoadMenu)
 {
     CEGUI::Window* window = modeManager->getGui().getGuiSheet(Gui::guiSheet::editorLoadMenu);
 
@@ -136,15 +137,11 @@ static bool findFileStemIn(const std::vector<std::string>& fileList, std::string
 bool MenuModeEditorLoad::updateFilesList(const CEGUI::EventArgs&)
 {
     CEGUI::Window* window = getModeManager().getGui().getGuiSheet(Gui::guiSheet::editorLoadMenu);
-    CEGUI::Listbox* levelSelectList = static_cast<CEGUI::Listbox*>(window->getChild(Gui::EDM_LIST_LEVELS));
-
     CEGUI::Combobox* levelTypeCb = static_cast<CEGUI::Combobox*>(window->getChild(Gui::EDM_LIST_LEVEL_TYPES));
 
     CEGUI::Window* loadText = window->getChild(Gui::EDM_TEXT_LOADING);
     loadText->setText("");
-    mFilesList.clear();
-    mDescriptionList.clear();
-    levelSelectList->resetList();
+    mCustomFilesList.clear();
 
     std::string levelPath;
     size_t selection = levelTypeCb->getItemIndex(levelTypeCb->getSelectedItem());
@@ -169,51 +166,17 @@ bool MenuModeEditorLoad::updateFilesList(const CEGUI::EventArgs&)
             break;
     }
 
-    if(Helper::fillFilesList(levelPath, mFilesList, MapHandler::LEVEL_EXTENSION))
-    {
-        std::vector<std::string> officialFileList;
-        if (officialSkirmishMaps)
-            levelPath = ResourceManager::getSingleton().getUserLevelPathSkirmish();
-        if (officialMultiplayerMaps)
-            levelPath = ResourceManager::getSingleton().getUserLevelPathMultiplayer();
+    // The official levels that have a custom level with the same name are flagged
+    std::string customLevelPath;
+    if (officialSkirmishMaps)
+        customLevelPath = ResourceManager::getSingleton().getUserLevelPathSkirmish();
+    if (officialMultiplayerMaps)
+        customLevelPath = ResourceManager::getSingleton().getUserLevelPathMultiplayer();
 
-        if (officialSkirmishMaps || officialMultiplayerMaps)
-        {
-            if (!Helper::fillFilesList(levelPath, officialFileList, MapHandler::LEVEL_EXTENSION))
-                officialFileList.clear();
-        }
-
-        for (uint32_t n = 0; n < mFilesList.size(); ++n)
-        {
-            std::string filename = mFilesList[n];
-
-            LevelInfo levelInfo;
-            std::string mapName;
-            std::string mapDescription;
-            bool customMapExists = findFileStemIn(officialFileList, filename);
-            if(MapHandler::getMapInfo(filename, levelInfo))
-            {
-                mapName.clear();
-                if (customMapExists)
-                    mapName = "[image-size='w:16 h:16'][image='OpenDungeonsIcons/CogIcon'][vert-alignment='centre'] ";
-                mapName += levelInfo.mLevelName;
-                mapDescription = levelInfo.mLevelDescription;
-                if (customMapExists)
-                    mapDescription += "\n(A custom map exists for this level.)";
-            }
-            else
-            {
-                mapName = "invalid map";
-                mapDescription = "invalid map";
-            }
-
-            mDescriptionList.push_back(mapDescription);
-            CEGUI::ListboxTextItem* item = new CEGUI::ListboxTextItem(mapName);
-            item->setID(n);
-            item->setSelectionBrushImage("OpenDungeonsSkin/SelectionBrush");
-            levelSelectList->addItem(item);
-        }
-    }
+    if (!customLevelPath.empty() && !Helper::fillFilesList(customLevelPath, mCustomFilesList, MapHandler::LEVEL_EXTENSION))
+        mCustomFilesList.clear();
+
+    fillLevelList(levelPath);
 
     updateDescription();
     return true;
@@ -281,3 +244,18 @@ bool MenuModeEditorLoad::updateDescription(const CEGUI::EventArgs&)
     descTxt->setText(description);
     return true;
 }
+
+LevelIndexState MenuModeEditorLoad::getLevelNameAndDescription(uint32_t index, std::string& levelName,
+    std::string& levelDescription)
+{
+    LevelIndexState state = MenuModeLevelListBase::getLevelNameAndDescription(index, levelName, levelDescription);
+    if(state != LevelIndexState::indexed)
+        return state;
+
+    if(!findFileStemIn(mCustomFilesList, mFilesList[index]))
+        return state;
+
+    levelName = "[image-size='w:16 h:16'][image='OpenDungeonsIcons/CogIcon'][vert-alignment='centre'] " + levelName;
+    levelDescription += "\n(A custom map exists for this level.)";
+    return state;
+}
@@ -18,9 +18,9 @@
 #ifndef MENUMODEEDITOR_H
 #define MENUMODEEDITOR_H
 
-#include "AbstractApplicationMode.h"
+#include "modes/MenuModeLevelListBase.h"
 
-class MenuModeEditorLoad: public AbstractApplicationMode
+class MenuModeEditorLoad: public MenuModeLevelListBase
 {
 public:
     MenuModeEditorLoad(ModeManager*);
@@ -33,8 +33,12 @@ public:
     bool updateDescription(const CEGUI::EventArgs& e = {});
 
 private:
-    std::vector<std::string> mFilesList;
-    std::vector<std::string> mDescriptionList;
+    //! \brief Custom levels of the same type when official levels are listed. The official levels
+    //! that have a custom level with the same name are flagged
+    std::vector<std::string> mCustomFilesList;
+
+    LevelIndexState getLevelNameAndDescription(uint32_t index, std::string& levelName,
+        std::string& levelDescription) override;
 
     //! \brief Update the level list according to the level type chosen.
     bool updateFilesList(const CEGUI::EventArgs& e = {});
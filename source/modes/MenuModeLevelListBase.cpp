@@ -0,0 +1,107 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "modes/MenuModeLevelListBase.h"
+
+#include "gamemap/LevelIndex.h"
+#include "gamemap/MapHandler.h"
+#include "utils/Helper.h"
+
+#include <CEGUI/CEGUI.h>
+
+//! \brief Name of the level list and description widgets, shared by the level menus layouts
+static const std::string LEVEL_LIST = "LevelWindowFrame/LevelSelect";
+static const std::string LEVEL_DESCRIPTION = "LevelWindowFrame/MapDescriptionText";
+
+MenuModeLevelListBase::MenuModeLevelListBase(ModeManager* modeManager, ModeManager::ModeType modeType,
+        Gui::guiSheet guiSheet) :
+    AbstractApplicationMode(modeManager, modeType),
+    mGuiSheet(guiSheet),
+    mNbPendingLevels(0),
+    mLevelIndexRevision(0)
+{
+}
+
+void MenuModeLevelListBase::fillLevelList(const std::string& levelPath)
+{
+    CEGUI::Window* window = getModeManager().getGui().getGuiSheet(mGuiSheet);
+    CEGUI::Listbox* levelSelectList = static_cast<CEGUI::Listbox*>(window->getChild(LEVEL_LIST));
+
+    mFilesList.clear();
+    mDescriptionList.clear();
+    mIsLevelPending.clear();
+    mNbPendingLevels = 0;
+    mLevelIndexRevision = LevelIndex::getSingleton().getRevision();
+    levelSelectList->resetList();
+
+    if(!Helper::fillFilesList(levelPath, mFilesList, MapHandler::LEVEL_EXTENSION))
+        return;
+
+    for(uint32_t n = 0; n < mFilesList.size(); ++n)
+    {
+        std::string mapName;
+        std::string mapDescription;
+        bool isPending = (getLevelNameAndDescription(n, mapName, mapDescription) == LevelIndexState::pending);
+        mIsLevelPending.push_back(isPending);
+        if(isPending)
+            ++mNbPendingLevels;
+
+        mDescriptionList.push_back(mapDescription);
+        CEGUI::ListboxTextItem* item = new CEGUI::ListboxTextItem(reinterpret_cast<const CEGUI::utf8*>(mapName.c_str()));
+        item->setID(n);
+        item->setSelectionBrushImage("OpenDungeonsSkin/SelectionBrush");
+        levelSelectList->addItem(item);
+    }
+}
+
+LevelIndexState MenuModeLevelListBase::getLevelNameAndDescription(uint32_t index, std::string& levelName,
+    std::string& levelDescription)
+{
+    return LevelIndex::getSingleton().getLevelNameAndDescription(mFilesList[index], levelName, levelDescription);
+}
+
+void MenuModeLevelListBase::onFrameStarted(const Ogre::FrameEvent&)
+{
+    if(mNbPendingLevels == 0)
+        return;
+
+    uint32_t revision = LevelIndex::getSingleton().getRevision();
+    if(revision == mLevelIndexRevision)
+        return;
+
+    mLevelIndexRevision = revision;
+    CEGUI::Window* window = getModeManager().getGui().getGuiSheet(mGuiSheet);
+    CEGUI::Listbox* levelSelectList = static_cast<CEGUI::Listbox*>(window->getChild(LEVEL_LIST));
+    for(uint32_t n = 0; n < mFilesList.size(); ++n)
+    {
+        if(!mIsLevelPending[n])
+            continue;
+
+        std::string mapName;
+        std::string mapDescription;
+        if(getLevelNameAndDescription(n, mapName, mapDescription) == LevelIndexState::pending)
+            continue;
+
+        mIsLevelPending[n] = false;
+        --mNbPendingLevels;
+        mDescriptionList[n] = mapDescription;
+        CEGUI::ListboxItem* item = levelSelectList->getListboxItemFromIndex(n);
+        item->setText(reinterpret_cast<const CEGUI::utf8*>(mapName.c_str()));
+        if(item->isSelected())
+            window->getChild(LEVEL_DESCRIPTION)->setText(reinterpret_cast<const CEGUI::utf8*>(mapDescription.c_str()));
+    }
+    levelSelectList->handleUpdatedItemData();
+}
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MENUMODELEVELLISTBASE_H
+#define MENUMODELEVELLISTBASE_H
+
+#include "modes/AbstractApplicationMode.h"
+
+#include "render/Gui.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class LevelIndexState;
+
+/*! \brief Base class of the menus listing the level files of a folder.
+ *
+ * The level names and descriptions come from the level index. The levels that were still being
+ * read when the list was filled show their file name and are refreshed in onFrameStarted once
+ * the level index has read them.
+ */
+class MenuModeLevelListBase: public AbstractApplicationMode
+{
+public:
+    MenuModeLevelListBase(ModeManager* modeManager, ModeManager::ModeType modeType, Gui::guiSheet guiSheet);
+
+    //! \brief Refreshes the levels that were not in the level index when the list was filled
+    void onFrameStarted(const Ogre::FrameEvent& evt) override;
+
+protected:
+    std::vector<std::string> mFilesList;
+    std::vector<std::string> mDescriptionList;
+
+    //! \brief Fills the level list with the levels from the given folder
+    void fillLevelList(const std::string& levelPath);
+
+    //! \brief Sets the name and description to display for the level at the given index in mFilesList
+    virtual LevelIndexState getLevelNameAndDescription(uint32_t index, std::string& levelName,
+        std::string& levelDescription);
+
+private:
+    Gui::guiSheet mGuiSheet;
+
+    //! \brief Levels being read by the level index. Their name is the file name until they are read
+    std::vector<bool> mIsLevelPending;
+    uint32_t mNbPendingLevels;
+    uint32_t mLevelIndexRevision;
+};
+
+#endif // MENUMODELEVELLISTBASE_H
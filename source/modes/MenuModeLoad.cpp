@@ -28,6 +28,7 @@
 #include "network/ServerMode.h"
 #include "network/ServerNotification.h"
 #include "utils/LogManager.h"
+#include "gamemap/LevelIndex.h"
 #include "gamemap/MapHandler.h"
 #include "utils/ConfigManager.h"
 #include "utils/ResourceManager.h"
@@ -221,7 +222,7 @@ bool MenuModeLoad::updateDescription(const CEGUI::EventArgs&)
 
     LevelInfo levelInfo;
     std::string mapDescription;
-    if(MapHandler::getMapInfo(filename, levelInfo))
+    if(LevelIndex::getSingleton().getLevelInfoNow(filename, levelInfo))
         mapDescription = levelInfo.mLevelDescription;
     else
         mapDescription = "invalid map";
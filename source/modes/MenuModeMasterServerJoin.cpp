@@ -33,10 +33,13 @@
 #include <CEGUI/CEGUI.h>
 
 const Ogre::Real PERIOD_REFRESH_LIST = 10;
+const std::string TEXT_RETRIEVING_LIST = "Retrieving games list...";
+const std::string TEXT_LIST_FAILED = "Could not reach the master server.";
 
 MenuModeMasterServerJoin::MenuModeMasterServerJoin(ModeManager *modeManager):
     AbstractApplicationMode(modeManager, ModeManager::MENU_MASTERSERVER_JOIN),
-    mTimeSinceLastUpdateList(0)
+    mTimeSinceLastUpdateList(0),
+    mMasterServerWorker(ConfigManager::getSingleton().getMasterServerUrl())
 {
     CEGUI::Window* window = getModeManager().getGui().getGuiSheet(Gui::guiSheet::multiMasterServerJoinMenu);
 
@@ -99,7 +102,7 @@ void MenuModeMasterServerJoin::activate()
     gameMap->setGamePaused(true);
 
     CEGUI::Window* mainWin = gui.getGuiSheet(Gui::guiSheet::multiMasterServerJoinMenu);
-    mainWin->getChild("LoadingText")->setText("");
+    mainWin->getChild("LoadingText")->setText(TEXT_RETRIEVING_LIST);
 
     CEGUI::Editbox* editNick = static_cast<CEGUI::Editbox*>(
         mainWin->getChild("LevelWindowFrame/NickEdit"));
@@ -108,10 +111,11 @@ void MenuModeMasterServerJoin::activate()
     if (!nickname.empty())
         editNick->setText(reinterpret_cast<const CEGUI::utf8*>(nickname.c_str()));
 
-    refreshList();
+    mMasterServerWorker.requestGamesList(ODApplication::VERSION);
+    mTimeSinceLastUpdateList = 0;
 }
 
-void MenuModeMasterServerJoin::refreshList()
+void MenuModeMasterServerJoin::refreshList(bool isSuccess, std::vector<MasterServerGame>& games)
 {
     Gui& gui = getModeManager().getGui();
     CEGUI::Window* mainWin = gui.getGuiSheet(Gui::guiSheet::multiMasterServerJoinMenu);
@@ -138,8 +142,16 @@ void MenuModeMasterServerJoin::refreshList()
 
     levelSelectList->resetList();
     mMasterServerGames.clear();
+    mMasterServerGames.swap(games);
+
+    CEGUI::Window* infoText = mainWin->getChild("LoadingText");
+    // We only replace the messages about the list
+    if(!isSuccess)
+        infoText->setText(TEXT_LIST_FAILED);
+    else if((infoText->getText() == TEXT_RETRIEVING_LIST) || (infoText->getText() == TEXT_LIST_FAILED))
+        infoText->setText("");
 
-    if(MasterServer::fillMasterServerGames(ODApplication::VERSION, mMasterServerGames))
+    if(isSuccess)
     {
         uint32_t id = 0;
         for(MasterServerGame& game : mMasterServerGames)
@@ -162,15 +174,21 @@ void MenuModeMasterServerJoin::refreshList()
             ++id;
         }
     }
-
-    mTimeSinceLastUpdateList = 0;
 }
 
 void MenuModeMasterServerJoin::onFrameStarted(const Ogre::FrameEvent& evt)
 {
+    std::vector<MasterServerGame> games;
+    bool isSuccess;
+    if(mMasterServerWorker.popGamesList(games, isSuccess))
+        refreshList(isSuccess, games);
+
     mTimeSinceLastUpdateList += evt.timeSinceLastFrame;
     if(mTimeSinceLastUpdateList >= PERIOD_REFRESH_LIST)
-        refreshList();
+    {
+        mMasterServerWorker.requestGamesList(ODApplication::VERSION);
+        mTimeSinceLastUpdateList = 0;
+    }
 }
 
 bool MenuModeMasterServerJoin::clientButtonPressed(const CEGUI::EventArgs&)
@@ -20,6 +20,7 @@
 
 #include "AbstractApplicationMode.h"
 #include "utils/MasterServer.h"
+#include "utils/MasterServerWorker.h"
 
 class MenuModeMasterServerJoin: public AbstractApplicationMode
 {
@@ -36,10 +37,13 @@ public:
     void onFrameStarted(const Ogre::FrameEvent& evt) override;
 
 private:
-    void refreshList();
+    //! \brief Fills the list with the games retrieved by mMasterServerWorker
+    void refreshList(bool isSuccess, std::vector<MasterServerGame>& games);
 
     std::vector<MasterServerGame> mMasterServerGames;
     Ogre::Real mTimeSinceLastUpdateList;
+    //! \brief Retrieves the games list in the background so that the menu is not blocked
+    MasterServerWorker mMasterServerWorker;
 };
 
 #endif // MENUMODEMASTERSERVERJOIN_H
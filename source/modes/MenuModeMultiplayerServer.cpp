@@ -38,7 +38,8 @@
 const std::string MPM_LIST_LEVEL_TYPES = "LevelWindowFrame/LevelTypeSelect";
 
 MenuModeMultiplayerServer::MenuModeMultiplayerServer(ModeManager *modeManager, bool useMasterServer):
-    AbstractApplicationMode(modeManager, useMasterServer ? ModeManager::MENU_MASTERSERVER_HOST : ModeManager::MENU_MULTIPLAYER_SERVER)
+    MenuModeLevelListBase(modeManager, useMasterServer ? ModeManager::MENU_MASTERSERVER_HOST : ModeManager::MENU_MULTIPLAYER_SERVER,
+        Gui::guiSheet::multiplayerServerMenu)
 {
     CEGUI::Window* window = getModeManager().getGui().getGuiSheet(Gui::guiSheet::multiplayerServerMenu);
 
@@ -133,15 +134,10 @@ void MenuModeMultiplayerServer::activate()
 bool MenuModeMultiplayerServer::updateFilesList(const CEGUI::EventArgs&)
 {
     CEGUI::Window* window = getModeManager().getGui().getGuiSheet(Gui::guiSheet::multiplayerServerMenu);
-    CEGUI::Listbox* levelSelectList = static_cast<CEGUI::Listbox*>(window->getChild(Gui::MPM_LIST_LEVELS));
-
     CEGUI::Combobox* levelTypeCb = static_cast<CEGUI::Combobox*>(window->getChild(MPM_LIST_LEVEL_TYPES));
 
     CEGUI::Window* loadText = window->getChild(Gui::MPM_TEXT_LOADING);
     loadText->setText("");
-    mFilesList.clear();
-    mDescriptionList.clear();
-    levelSelectList->resetList();
 
     std::string levelPath;
     size_t selection = levelTypeCb->getItemIndex(levelTypeCb->getSelectedItem());
@@ -156,33 +152,7 @@ bool MenuModeMultiplayerServer::updateFilesList(const CEGUI::EventArgs&)
             break;
     }
 
-    if(Helper::fillFilesList(levelPath, mFilesList, MapHandler::LEVEL_EXTENSION))
-    {
-        for (uint32_t n = 0; n < mFilesList.size(); ++n)
-        {
-            std::string filename = mFilesList[n];
-
-            LevelInfo levelInfo;
-            std::string mapName;
-            std::string mapDescription;
-            if(MapHandler::getMapInfo(filename, levelInfo))
-            {
-                mapName = levelInfo.mLevelName;
-                mapDescription = levelInfo.mLevelDescription;
-            }
-            else
-            {
-                mapName = "invalid map";
-                mapDescription = "invalid map";
-            }
-
-            mDescriptionList.push_back(mapDescription);
-            CEGUI::ListboxTextItem* item = new CEGUI::ListboxTextItem(mapName);
-            item->setID(n);
-            item->setSelectionBrushImage("OpenDungeonsSkin/SelectionBrush");
-            levelSelectList->addItem(item);
-        }
-    }
+    fillLevelList(levelPath);
 
     updateDescription();
     return true;
@@ -18,9 +18,9 @@
 #ifndef MENUMODEMULTIPLAYERSERVER_H
 #define MENUMODEMULTIPLAYERSERVER_H
 
-#include "AbstractApplicationMode.h"
+#include "modes/MenuModeLevelListBase.h"
 
-class MenuModeMultiplayerServer: public AbstractApplicationMode
+class MenuModeMultiplayerServer: public MenuModeLevelListBase
 {
 public:
     MenuModeMultiplayerServer(ModeManager *modeManager, bool useMasterServer);
@@ -33,9 +33,6 @@ public:
     bool updateDescription(const CEGUI::EventArgs& e = {});
 
 private:
-    std::vector<std::string> mFilesList;
-    std::vector<std::string> mDescriptionList;
-
     //! \brief Update the level list according to the level type chosen.
     bool updateFilesList(const CEGUI::EventArgs& e = {});
 };
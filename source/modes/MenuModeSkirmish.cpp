@@ -35,7 +35,7 @@
 #include "boost/filesystem.hpp"
 
 MenuModeSkirmish::MenuModeSkirmish(ModeManager* modeManager):
-    AbstractApplicationMode(modeManager, ModeManager::MENU_SKIRMISH)
+    MenuModeLevelListBase(modeManager, ModeManager::MENU_SKIRMISH, Gui::guiSheet::skirmishMenu)
 {
     CEGUI::Window* window = modeManager->getGui().getGuiSheet(Gui::guiSheet::skirmishMenu);
 
@@ -131,15 +131,10 @@ void MenuModeSkirmish::activate()
 bool MenuModeSkirmish::updateFilesList(const CEGUI::EventArgs&)
 {
     CEGUI::Window* window = getModeManager().getGui().getGuiSheet(Gui::guiSheet::skirmishMenu);
-    CEGUI::Listbox* levelSelectList = static_cast<CEGUI::Listbox*>(window->getChild(Gui::SKM_LIST_LEVELS));
-
     CEGUI::Combobox* levelTypeCb = static_cast<CEGUI::Combobox*>(window->getChild(Gui::SKM_LIST_LEVEL_TYPES));
 
     CEGUI::Window* loadText = window->getChild(Gui::SKM_TEXT_LOADING);
     loadText->setText("");
-    mFilesList.clear();
-    mDescriptionList.clear();
-    levelSelectList->resetList();
 
     std::string levelPath;
     size_t selection = levelTypeCb->getItemIndex(levelTypeCb->getSelectedItem());
@@ -160,33 +155,7 @@ bool MenuModeSkirmish::updateFilesList(const CEGUI::EventArgs&)
             break;
     }
 
-    if(Helper::fillFilesList(levelPath, mFilesList, MapHandler::LEVEL_EXTENSION))
-    {
-        for (uint32_t n = 0; n < mFilesList.size(); ++n)
-        {
-            std::string filename = mFilesList[n];
-
-            LevelInfo levelInfo;
-            std::string mapName;
-            std::string mapDescription;
-            if(MapHandler::getMapInfo(filename, levelInfo))
-            {
-                mapName = levelInfo.mLevelName;
-                mapDescription = levelInfo.mLevelDescription;
-            }
-            else
-            {
-                mapName = "invalid map";
-                mapDescription = "invalid map";
-            }
-
-            mDescriptionList.push_back(mapDescription);
-            CEGUI::ListboxTextItem* item = new CEGUI::ListboxTextItem(mapName);
-            item->setID(n);
-            item->setSelectionBrushImage("OpenDungeonsSkin/SelectionBrush");
-            levelSelectList->addItem(item);
-        }
-    }
+    fillLevelList(levelPath);
 
     updateDescription();
     return true;
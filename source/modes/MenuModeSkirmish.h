@@ -18,9 +18,9 @@
 #ifndef MENUMODESKIRMISH_H
 #define MENUMODESKIRMISH_H
 
-#include "AbstractApplicationMode.h"
+#include "modes/MenuModeLevelListBase.h"
 
-class MenuModeSkirmish: public AbstractApplicationMode
+class MenuModeSkirmish: public MenuModeLevelListBase
 {
 public:
     MenuModeSkirmish(ModeManager*);
@@ -33,9 +33,6 @@ public:
     bool updateDescription(const CEGUI::EventArgs& e = {});
 
 private:
-    std::vector<std::string> mFilesList;
-    std::vector<std::string> mDescriptionList;
-
     //! \brief Update the level list according to the level type chosen.
     bool updateFilesList(const CEGUI::EventArgs& e = {});
 };
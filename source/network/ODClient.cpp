@@ -22,6 +22,7 @@
 #include "entities/EntityLoading.h"
 #include "entities/GameEntityType.h"
 #include "entities/MapLight.h"
+#include "entities/MissileObject.h"
 #include "entities/RenderedMovableEntity.h"
 #include "entities/Tile.h"
 #include "entities/Weapon.h"
@@ -37,6 +38,7 @@
 #include "network/ODPacket.h"
 #include "network/ServerMode.h"
 #include "network/ServerNotification.h"
+#include "network/WalkPathPacket.h"
 #include "render/ODFrameListener.h"
 #include "render/RenderManager.h"
 #include "sound/MusicPlayer.h"
@@ -112,6 +114,11 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
 
             gameMap->setTileSetName(str);
 
+            // The match seed is sent so that it is kept in the replays
+            uint64_t randomSeed;
+            OD_ASSERT_TRUE(packetReceived >> randomSeed);
+            gameMap->setRandomSeed(randomSeed);
+
             int32_t nb;
             // Seats
             OD_ASSERT_TRUE(packetReceived >> nb);
@@ -449,14 +456,44 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
             break;
         }
 
+        case ServerNotificationType::addMissile:
+        {
+            MissileObject* missile = MissileObject::getMissileObjectFromPacket(gameMap, packetReceived);
+            if(missile == nullptr)
+                break;
+            missile->addToGameMap();
+            missile->createMesh();
+            missile->restoreEntityState();
+            missile->setPosition(missile->getPosition());
+            break;
+        }
+
+        case ServerNotificationType::removeMissile:
+        {
+            std::string missileName;
+            OD_ASSERT_TRUE(packetReceived >> missileName);
+            RenderedMovableEntity* missile = gameMap->getRenderedMovableEntity(missileName);
+            if(missile == nullptr)
+            {
+                OD_LOG_ERR("missileName=" + missileName);
+                break;
+            }
+
+            missile->removeEntityFromPositionTile();
+            missile->removeFromGameMap();
+            missile->deleteYourself();
+            break;
+        }
+
         case ServerNotificationType::turnStarted:
         {
             int64_t turnNum;
-            OD_ASSERT_TRUE(packetReceived >> turnNum);
+            double turnStartTime;
+            OD_ASSERT_TRUE(packetReceived >> turnNum >> turnStartTime);
             OD_LOG_INF("Client (" + getPlayer()->getNick() + ") received turnStarted="
                 + boost::lexical_cast<std::string>(turnNum));
 
-            gameMap->clientUpKeep(turnNum);
+            gameMap->clientUpKeep(turnNum, turnStartTime);
             // We acknowledge the new turn to the server so that he knows we are
             // ready for next one
             ODPacket packSend;
@@ -474,13 +511,14 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
         case ServerNotificationType::animatedObjectSetWalkPath:
         {
             std::string objName;
-            std::string walkAnim;
-            std::string endAnim;
+            EntityAnimation walkAnim;
+            EntityAnimation endAnim;
             bool loopEndAnim;
             bool playIdleWhenAnimationEnds;
-            uint32_t nbDest;
+            std::vector<Ogre::Vector3> path;
             OD_ASSERT_TRUE(packetReceived >> objName >> walkAnim >> endAnim);
-            OD_ASSERT_TRUE(packetReceived >> loopEndAnim >> playIdleWhenAnimationEnds >> nbDest);
+            OD_ASSERT_TRUE(packetReceived >> loopEndAnim >> playIdleWhenAnimationEnds);
+            OD_ASSERT_TRUE(WalkPathPacket::importFromPacket(packetReceived, path));
 
             MovableGameEntity *tempAnimatedObject = gameMap->getAnimatedObject(objName);
             if(tempAnimatedObject == nullptr)
@@ -489,15 +527,9 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
                 break;
             }
 
-            std::vector<Ogre::Vector3> path;
-            while(nbDest > 0)
-            {
-                --nbDest;
-                Ogre::Vector3 dest;
-                OD_ASSERT_TRUE(packetReceived >> dest);
+            for(Ogre::Vector3& dest : path)
                 tempAnimatedObject->correctEntityMovePosition(dest);
-                path.push_back(dest);
-            }
+
             tempAnimatedObject->setWalkPath(walkAnim, endAnim, loopEndAnim, playIdleWhenAnimationEnds, path);
             break;
         }
@@ -553,7 +585,7 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
         case ServerNotificationType::setObjectAnimationState:
         {
             std::string objName;
-            std::string animState;
+            EntityAnimation animState;
             bool loop;
             bool playIdleWhenAnimationEnds;
             bool shouldSetWalkDirection;
@@ -562,7 +594,7 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
             MovableGameEntity *obj = gameMap->getAnimatedObject(objName);
             if (obj == nullptr)
             {
-                OD_LOG_ERR("objName=" + objName + ", state=" + animState);
+                OD_LOG_ERR("objName=" + objName + ", state=" + entityAnimationToString(animState));
                 break;
             }
 
@@ -277,3 +277,18 @@ int32_t ODPacket::readPacket(std::ifstream& is)
 
     return timestamp;
 }
+
+void ODPacket::appendData(const void* data, std::size_t size)
+{
+    mPacket.append(data, size);
+}
+
+const void* ODPacket::getData() const
+{
+    return mPacket.getData();
+}
+
+std::size_t ODPacket::getDataSize() const
+{
+    return mPacket.getDataSize();
+}
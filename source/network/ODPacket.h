@@ -135,6 +135,16 @@ class ODPacket
          */
         int32_t readPacket(std::ifstream& is);
 
+        /*! \brief Appends raw data previously got from getData to the packet.
+         */
+        void appendData(const void* data, std::size_t size);
+
+        /*! \brief Raw content of the packet. Used to store it outside of the network
+         *         (for example, in a cache file).
+         */
+        const void* getData() const;
+        std::size_t getDataSize() const;
+
         /*! \brief Template function to put arguments in a packet, used for in-place construction.
          */
         template<typename FirstArg, typename ...Args>
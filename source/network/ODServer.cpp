@@ -30,6 +30,7 @@
 #include "game/SkillType.h"
 #include "game/Seat.h"
 #include "gamemap/GameMap.h"
+#include "gamemap/GameMapSnapshot.h"
 #include "gamemap/MapHandler.h"
 #include "modes/ConsoleCommands.h"
 #include "network/ODClient.h"
@@ -46,6 +47,8 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MasterServer.h"
+#include "utils/MasterServerWorker.h"
+#include "utils/Random.h"
 #include "utils/ResourceManager.h"
 #include "ODApplication.h"
 
@@ -57,17 +60,37 @@
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+
 
 const std::string SAVEGAME_SKIRMISH_PREFIX = "SK-";
 const std::string SAVEGAME_MULTIPLAYER_PREFIX = "MP-";
+const std::string SAVEGAME_AUTOSAVE_PREFIX = "Autosave-";
 static const double MASTER_SERVER_UPDATE_PERIOD_MS = 30000.0;
 static const int32_t MASTER_SERVER_STATUS_PENDING = 0;
 static const int32_t MASTER_SERVER_STATUS_STARTED = 1;
 static const int32_t MASTER_SERVER_STATUS_FINISHED = 2;
 
-template<> ODServer* Ogre::Singleton<ODServer>::msSingleton = nullptr;
+//! \brief First server created. Used by the threads not working on a match
+static ODServer* gMainServer = nullptr;
+//! \brief Server of the match the current thread is working on
+static thread_local ODServer* gThreadServer = nullptr;
+
+ODServer::ThreadBinding::ThreadBinding(ODServer* server) :
+    mPreviousServer(gThreadServer)
+{
+    gThreadServer = server;
+    Random::setThreadContext((server != nullptr) ? &server->mRandomContext : nullptr);
+}
+
+ODServer::ThreadBinding::~ThreadBinding()
+{
+    gThreadServer = mPreviousServer;
+    Random::setThreadContext((mPreviousServer != nullptr) ? &mPreviousServer->mRandomContext : nullptr);
+}
 
-ODServer::ODServer() :
+ODServer::ODServer(uint32_t matchId) :
+    mMatchId(matchId),
     mUniqueNumberPlayer(0),
     mServerMode(ServerMode::ModeNone),
     mServerState(ServerState::StateNone),
@@ -75,19 +98,45 @@ ODServer::ODServer() :
     mSeatsConfigured(false),
     mPlayerConfig(nullptr),
     mConsoleInterface(std::bind(&ODServer::printConsoleMsg, this, std::placeholders::_1)),
-    mMasterServerGameStatusUpdateTime(0)
+    mMasterServerGameStatusUpdateTime(0),
+    mMasterServerWorker(ConfigManager::getSingleton().getMasterServerUrl()),
+    mAutoSaveWriter(this),
+    mLastAutoSaveTurn(0)
 {
     ConsoleCommands::addConsoleCommands(mConsoleInterface);
+    if(gMainServer == nullptr)
+        gMainServer = this;
 }
 
 ODServer::~ODServer()
 {
-    delete mGameMap;
+    {
+        ThreadBinding binding(this);
+        delete mGameMap;
+    }
+    if(gMainServer == this)
+        gMainServer = nullptr;
+}
+
+ODServer& ODServer::getSingleton()
+{
+    ODServer* server = getSingletonPtr();
+    OD_ASSERT_TRUE(server != nullptr);
+    return *server;
+}
+
+ODServer* ODServer::getSingletonPtr()
+{
+    if(gThreadServer != nullptr)
+        return gThreadServer;
+
+    return gMainServer;
 }
 
 bool ODServer::startServer(const std::string& creator, const std::string& levelFilename, ServerMode mode, bool useMasterServer)
 {
     OD_LOG_INF("Asked to launch server with levelFilename=" + levelFilename);
+    ThreadBinding binding(this);
 
     mSeatsConfigured = false;
     mDisconnectedPlayers.clear();
@@ -123,6 +172,24 @@ bool ODServer::startServer(const std::string& creator, const std::string& levelF
         return false;
     }
 
+    // The random generators are seeded from the match seed. It is kept when the game is saved
+    // with the generators states so that a saved game continues the same sequences. In the editor,
+    // we don't want to save a seed in the level because every match played on it would then be the same
+    if(mServerMode == ServerMode::ModeEditor)
+        gameMap->setRandomSeed(0);
+    else if(gameMap->getRandomSeed() == 0)
+        gameMap->setRandomSeed(Random::generateSeed());
+
+    if(gameMap->getRandomSeed() != 0)
+    {
+        gameMap->initRandomGenerators();
+        OD_LOG_INF("Match seed: " + Helper::toString(gameMap->getRandomSeed()));
+    }
+
+    // The autosave period starts from the loaded turn so that a game that was just loaded (or
+    // a previous game played on this server) does not trigger an autosave on its first turn
+    mLastAutoSaveTurn = std::max(static_cast<int64_t>(0), gameMap->getTurnNumber());
+
     // Set up the socket to listen on the specified port
     int32_t port = getNetworkPort();
     if (!createServer(port))
@@ -190,7 +257,9 @@ bool ODServer::startServer(const std::string& creator, const std::string& levelF
         const std::string& label = info.mLevelName;
         const std::string& descr = info.mLevelDescription;
         std::string uuid;
-        if(!MasterServer::registerGame(ODApplication::VERSION, creator, port, label, descr, uuid))
+        // The game cannot be hosted without its uuid so we wait for the registration
+        const std::string& url = ConfigManager::getSingleton().getMasterServerUrl();
+        if(!MasterServer::registerGame(url, 0, ODApplication::VERSION, creator, port, label, descr, uuid))
         {
             OD_LOG_ERR("Could not register the game in the master server !!!");
             stopServer();
@@ -315,10 +384,14 @@ void ODServer::startNewTurn(double timeSinceLastTurn)
     }
 
     gameMap->setTurnNumber(++turn);
+    // The entities are moved once per turn by the elapsed time. We send the resulting server time
+    // so that the clients can synchronise the movements
+    double turnStartTime = gameMap->getTurnStartTime() + timeSinceLastTurn;
+    gameMap->setTurnStartTime(turnStartTime);
 
     ServerNotification* serverNotification = new ServerNotification(
         ServerNotificationType::turnStarted, nullptr);
-    serverNotification->mPacket << turn;
+    serverNotification->mPacket << turn << turnStartTime;
     queueServerNotification(serverNotification);
 
     if(mServerMode == ServerMode::ModeEditor)
@@ -392,6 +465,7 @@ void ODServer::startNewTurn(double timeSinceLastTurn)
 
 void ODServer::serverThread()
 {
+    ThreadBinding binding(this);
     GameMap* gameMap = mGameMap;
     sf::Clock clock;
     double turnLengthMs = 1000.0 / ODApplication::turnsPerSecond;
@@ -419,7 +493,7 @@ void ODServer::serverThread()
                 if(!mMasterServerGameId.empty())
                 {
                     mMasterServerGameStatusUpdateTime = 0.0;
-                    MasterServer::updateGame(mMasterServerGameId, MASTER_SERVER_STATUS_STARTED);
+                    mMasterServerWorker.updateGame(mMasterServerGameId, MASTER_SERVER_STATUS_STARTED);
                 }
 
                 // We configure the game for launching
@@ -450,11 +524,12 @@ void ODServer::serverThread()
                 // Send turn 0 to init the map
                 ServerNotification* serverNotification = new ServerNotification(
                     ServerNotificationType::turnStarted, nullptr);
-                serverNotification->mPacket << static_cast<int64_t>(0);
+                serverNotification->mPacket << static_cast<int64_t>(0) << 0.0;
                 queueServerNotification(serverNotification);
 
                 OD_LOG_INF("Server ready, starting game");
                 gameMap->setTurnNumber(0);
+                gameMap->setTurnStartTime(0.0);
                 gameMap->setGamePaused(false);
 
                 // In editor mode, we give vision on all the gamemap tiles
@@ -495,7 +570,7 @@ void ODServer::serverThread()
                     if(mMasterServerGameStatusUpdateTime >= MASTER_SERVER_UPDATE_PERIOD_MS)
                     {
                         mMasterServerGameStatusUpdateTime = 0.0;
-                        MasterServer::updateGame(mMasterServerGameId, MASTER_SERVER_STATUS_PENDING);
+                        mMasterServerWorker.updateGame(mMasterServerGameId, MASTER_SERVER_STATUS_PENDING);
                     }
                 }
                 continue;
@@ -513,15 +588,93 @@ void ODServer::serverThread()
         startNewTurn(static_cast<double>(clock.restart().asSeconds()) * 0.95);
 
         processServerNotifications();
+
+        autoSave();
     }
 
     if(!mMasterServerGameId.empty())
     {
         mMasterServerGameStatusUpdateTime = 0.0;
-        MasterServer::updateGame(mMasterServerGameId, MASTER_SERVER_STATUS_FINISHED);
+        mMasterServerWorker.updateGame(mMasterServerGameId, MASTER_SERVER_STATUS_FINISHED);
     }
 }
 
+void ODServer::autoSave()
+{
+    std::string fileName;
+    bool isSuccess;
+    double writeTimeMs;
+    if(mAutoSaveWriter.popResult(fileName, isSuccess, writeTimeMs))
+    {
+        if(isSuccess)
+            OD_LOG_INF("Autosave written in " + Helper::toString(writeTimeMs) + " ms: " + fileName);
+        else
+            OD_LOG_WRN("Autosave failed after " + Helper::toString(writeTimeMs) + " ms: " + fileName);
+    }
+
+    uint32_t period = ConfigManager::getSingleton().getAutoSavePeriod();
+    if(period == 0)
+        return;
+
+    switch(mServerMode)
+    {
+        case ServerMode::ModeGameSinglePlayer:
+        case ServerMode::ModeGameMultiPlayer:
+        case ServerMode::ModeGameLoaded:
+            break;
+        default:
+            return;
+    }
+
+    GameMap* gameMap = mGameMap;
+    int64_t turn = gameMap->getTurnNumber();
+    if(turn <= 0)
+        return;
+
+    if(turn - mLastAutoSaveTurn < static_cast<int64_t>(period))
+        return;
+
+    // We do not wait for the previous autosave. We will try again next turn
+    if(mAutoSaveWriter.isWriting())
+        return;
+
+    mLastAutoSaveTurn = turn;
+
+    // We keep the Skirmish or multiplayer prefix so that the autosave is sorted with the other saves
+    std::string fileLevel = boost::filesystem::path(gameMap->getLevelFileName()).filename().string();
+    std::string saveName;
+    size_t indexSk = fileLevel.find(SAVEGAME_SKIRMISH_PREFIX);
+    size_t indexMp = fileLevel.find(SAVEGAME_MULTIPLAYER_PREFIX);
+    if(indexSk != std::string::npos)
+        saveName = fileLevel.substr(indexSk);
+    else if(indexMp != std::string::npos)
+        saveName = fileLevel.substr(indexMp);
+    else if(mServerMode == ServerMode::ModeGameMultiPlayer)
+        saveName = SAVEGAME_MULTIPLAYER_PREFIX + fileLevel;
+    else
+        saveName = SAVEGAME_SKIRMISH_PREFIX + fileLevel;
+
+    // When several matches are hosted, they may play the same level so we add the match id to
+    // not overwrite the autosave of another match
+    ResourceManager& resMgr = ResourceManager::getSingleton();
+    std::string autoSavePrefix = SAVEGAME_AUTOSAVE_PREFIX;
+    if(resMgr.getServerModeNbMatches() > 1)
+        autoSavePrefix += "Match" + Helper::toString(mMatchId) + "-";
+
+    fileName = resMgr.getSaveGamePath() + autoSavePrefix + saveName;
+
+    // The snapshot is taken between 2 turns so the gamemap is consistent. Building the saved game
+    // from it and writing the file is done in the background
+    sf::Clock clock;
+    GameMapSnapshot snapshot;
+    MapHandler::takeGameMapSnapshot(*gameMap, snapshot);
+    double snapshotTimeMs = static_cast<double>(clock.getElapsedTime().asMicroseconds()) / 1000.0;
+    OD_LOG_INF("Autosave snapshot at turn " + Helper::toString(turn) + " taken in "
+        + Helper::toString(snapshotTimeMs) + " ms (" + Helper::toString(snapshot.getSize()) + " bytes)");
+
+    mAutoSaveWriter.startWrite(fileName, snapshot);
+}
+
 void ODServer::processServerNotifications()
 {
     GameMap* gameMap = mGameMap;
@@ -684,6 +837,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
             packet << gameMap->getLevelFightMusicFile();
 
             packet << gameMap->getTileSetName();
+            packet << gameMap->getRandomSeed();
 
             int32_t nb;
             // Seats
@@ -1556,8 +1710,11 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
             if (boost::filesystem::exists(levelSave))
                 boost::filesystem::rename(levelSave, levelSave.string() + ".bak");
 
+            // Edited levels are kept in the text format. Saved games use the binary format
+            // that is faster to load
+            bool binary = (mServerMode != ServerMode::ModeEditor);
             std::string msg = "Map saved successfully as: " + levelSave.string();
-            if (!MapHandler::writeGameMapToFile(levelSave.string(), *gameMap))
+            if (!MapHandler::writeGameMapToFile(levelSave.string(), *gameMap, binary))
             {
                 msg = "Couldn't not save map file as: " + levelSave.string() + "\nPlease check logs.";
             }
@@ -1906,6 +2063,8 @@ void ODServer::stopServer()
     // We start by stopping server to make sure no new message comes
     ODSocketServer::stopServer();
 
+    ThreadBinding binding(this);
+
     mServerState = ServerState::StateNone;
     mSeatsConfigured = false;
     mDisconnectedPlayers.clear();
@@ -2017,10 +2176,10 @@ void ODServer::fireSeatConfigurationRefresh()
 int32_t ODServer::getNetworkPort() const
 {
     int32_t port = ResourceManager::getSingleton().getForcedNetworkPort();
-    if(port != -1)
-        return port;
+    if(port == -1)
+        port = ConfigManager::getSingleton().getNetworkPort();
 
-    return ConfigManager::getSingleton().getNetworkPort();
+    return port + static_cast<int32_t>(mMatchId);
 }
 
 void ODServer::printConsoleMsg(const std::string& text)
@@ -19,9 +19,15 @@
 #define ODSERVER_H
 
 #include "ODSocketServer.h"
+#include "gamemap/GameSaveWriter.h"
 #include "modes/ConsoleInterface.h"
+#include "utils/MasterServerWorker.h"
+#include "utils/Random.h"
 
-#include <OgreSingleton.h>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
 
 class ServerNotification;
 class GameMap;
@@ -57,9 +63,12 @@ ODPacket& operator>>(ODPacket& is, EventShortNoticeType& type);
  * queueServerNotification should be called with the message.
  * Note that this rule is not followed when dealing with client connexions or chat because there
  * is no need to synchronize such messages with the gamemap.
+ * A dedicated server can host several matches in the same process. Each match has its own ODServer
+ * (with its own gamemap, random generators and thread). The immutable configuration (ConfigManager,
+ * ResourceManager) is shared. getSingleton returns the server of the match the calling thread is
+ * working on so that the gameplay code does not need to know which match it belongs to.
  */
-class ODServer: public Ogre::Singleton<ODServer>,
-    public ODSocketServer
+class ODServer: public ODSocketServer
 {
  public:
      enum ServerState
@@ -68,9 +77,33 @@ class ODServer: public Ogre::Singleton<ODServer>,
          StateConfiguration,
          StateGame
      };
-    ODServer();
+
+    //! \brief Makes getSingleton and the Random functions use the given server in the current
+    //! thread until destroyed. Every thread working on a match (turn thread, workers of
+    //! the gamemap WorkerPool, autosave writer) should install one
+    class ThreadBinding
+    {
+    public:
+        ThreadBinding(ODServer* server);
+        ~ThreadBinding();
+
+    private:
+        ODServer* mPreviousServer;
+    };
+
+    //! \brief matchId is used when several matches are hosted in the same process. The match
+    //! listens on the network port + matchId
+    ODServer(uint32_t matchId = 0);
     virtual ~ODServer();
 
+    //! \brief Returns the server of the match the calling thread is working on. If the thread
+    //! is not working on a match (like the client thread), returns the first server created
+    static ODServer& getSingleton();
+    static ODServer* getSingletonPtr();
+
+    inline uint32_t getMatchId() const
+    { return mMatchId; }
+
     inline ServerMode getServerMode() const
     { return mServerMode; }
 
@@ -101,6 +134,9 @@ protected:
     void serverThread() override;
 
 private:
+    uint32_t mMatchId;
+    //! \brief Random generators of the match
+    RandomContext mRandomContext;
     uint32_t mUniqueNumberPlayer;
     ServerMode mServerMode;
     ServerState mServerState;
@@ -118,6 +154,17 @@ private:
 
     std::string mMasterServerGameId;
     double mMasterServerGameStatusUpdateTime;
+    //! \brief Sends the game status updates without blocking the turns
+    MasterServerWorker mMasterServerWorker;
+
+    //! \brief Writes the autosaves in the background
+    GameSaveWriter mAutoSaveWriter;
+    int64_t mLastAutoSaveTurn;
+
+    //! \brief Takes a snapshot of the gamemap if an autosave is due and gives it to mAutoSaveWriter.
+    //! Called between turns. If the previous autosave is still being written, the autosave is delayed
+    //! to not block the turns.
+    void autoSave();
 
     void printConsoleMsg(const std::string& text);
 
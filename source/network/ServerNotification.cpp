@@ -74,6 +74,10 @@ std::string ServerNotification::typeString(ServerNotificationType type)
             return "addEntity";
         case ServerNotificationType::removeEntity:
             return "removeEntity";
+        case ServerNotificationType::addMissile:
+            return "addMissile";
+        case ServerNotificationType::removeMissile:
+            return "removeMissile";
         case ServerNotificationType::entitiesRefresh:
             return "entitiesRefresh";
         case ServerNotificationType::playerFighting:
@@ -60,6 +60,8 @@ enum class ServerNotificationType
 
     addEntity,
     removeEntity,
+    addMissile, // Same as addEntity with only what the clients need to draw and fly a missile.
+    removeMissile,
     entitiesRefresh,
     refreshPlayerSeat,
     setEntityOpacity,
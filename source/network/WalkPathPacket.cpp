@@ -0,0 +1,196 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "network/WalkPathPacket.h"
+
+#include "network/ODPacket.h"
+
+#include <cmath>
+#include <cstdint>
+
+namespace
+{
+    const uint32_t NB_DIRECTIONS = 8;
+    const int32_t DIRECTION_X[NB_DIRECTIONS] = { 1, 1, 0, -1, -1, -1,  0,  1 };
+    const int32_t DIRECTION_Y[NB_DIRECTIONS] = { 0, 1, 1,  1,  0, -1, -1, -1 };
+
+    //! \brief A run is stored in one byte: the direction in the 3 lower bits and the
+    //! length - 1 in the others
+    const uint32_t RUN_LENGTH_SHIFT = 3;
+    const uint32_t MAX_RUN_LENGTH = 32;
+
+    //! \brief Max number of positions accepted when reading a path. Paths are never that long
+    //! and it avoids allocating huge vectors from corrupted packets
+    const uint32_t MAX_PATH_SIZE = 0xFFFF;
+
+    bool isTilePosition(const Ogre::Vector3& v)
+    {
+        return (v.x == std::floor(v.x)) && (v.y == std::floor(v.y));
+    }
+
+    int32_t getDirection(int32_t dx, int32_t dy)
+    {
+        for(uint32_t dir = 0; dir < NB_DIRECTIONS; ++dir)
+        {
+            if((DIRECTION_X[dir] == dx) && (DIRECTION_Y[dir] == dy))
+                return static_cast<int32_t>(dir);
+        }
+        return -1;
+    }
+
+    //! \brief Fills runs with the compact encoding of path. Returns false if the path
+    //! cannot be encoded that way
+    bool computeRuns(const std::deque<Ogre::Vector3>& path, std::vector<uint8_t>& runs)
+    {
+        const Ogre::Vector3& first = path.front();
+        if(!isTilePosition(first))
+            return false;
+
+        int32_t prevX = static_cast<int32_t>(first.x);
+        int32_t prevY = static_cast<int32_t>(first.y);
+        int32_t runDir = -1;
+        uint32_t runLength = 0;
+        for(std::size_t i = 1; i < path.size(); ++i)
+        {
+            const Ogre::Vector3& v = path[i];
+            if((v.z != first.z) || !isTilePosition(v))
+                return false;
+
+            int32_t x = static_cast<int32_t>(v.x);
+            int32_t y = static_cast<int32_t>(v.y);
+            int32_t dir = getDirection(x - prevX, y - prevY);
+            if(dir < 0)
+                return false;
+
+            prevX = x;
+            prevY = y;
+            if((dir == runDir) && (runLength < MAX_RUN_LENGTH))
+            {
+                ++runLength;
+                continue;
+            }
+
+            if(runLength > 0)
+                runs.push_back(static_cast<uint8_t>(runDir | ((runLength - 1) << RUN_LENGTH_SHIFT)));
+
+            runDir = dir;
+            runLength = 1;
+        }
+
+        if(runLength > 0)
+            runs.push_back(static_cast<uint8_t>(runDir | ((runLength - 1) << RUN_LENGTH_SHIFT)));
+
+        return true;
+    }
+}
+
+namespace WalkPathPacket
+{
+
+void exportToPacket(ODPacket& os, const std::deque<Ogre::Vector3>& path)
+{
+    uint32_t nbDest = path.size();
+    os << nbDest;
+    if(nbDest == 0)
+        return;
+
+    std::vector<uint8_t> runs;
+    bool isCompact = computeRuns(path, runs);
+    os << isCompact;
+    if(!isCompact)
+    {
+        for(const Ogre::Vector3& v : path)
+            os << v;
+
+        return;
+    }
+
+    const Ogre::Vector3& first = path.front();
+    int32_t x = static_cast<int32_t>(first.x);
+    int32_t y = static_cast<int32_t>(first.y);
+    uint32_t nbRuns = runs.size();
+    os << x << y << first.z << nbRuns;
+    for(uint8_t run : runs)
+        os << run;
+}
+
+bool importFromPacket(ODPacket& is, std::vector<Ogre::Vector3>& path)
+{
+    uint32_t nbDest;
+    if(!(is >> nbDest))
+        return false;
+
+    if(nbDest == 0)
+        return true;
+
+    if(nbDest > MAX_PATH_SIZE)
+        return false;
+
+    bool isCompact;
+    if(!(is >> isCompact))
+        return false;
+
+    path.reserve(path.size() + nbDest);
+    if(!isCompact)
+    {
+        for(uint32_t i = 0; i < nbDest; ++i)
+        {
+            Ogre::Vector3 v;
+            if(!(is >> v))
+                return false;
+
+            path.push_back(v);
+        }
+        return true;
+    }
+
+    int32_t x;
+    int32_t y;
+    Ogre::Real z;
+    uint32_t nbRuns;
+    if(!(is >> x >> y >> z >> nbRuns))
+        return false;
+
+    if(nbRuns >= nbDest)
+        return false;
+
+    path.push_back(Ogre::Vector3(static_cast<Ogre::Real>(x), static_cast<Ogre::Real>(y), z));
+    uint32_t nbRead = 1;
+    for(uint32_t i = 0; i < nbRuns; ++i)
+    {
+        uint8_t run;
+        if(!(is >> run))
+            return false;
+
+        uint32_t dir = run & (NB_DIRECTIONS - 1);
+        uint32_t length = (run >> RUN_LENGTH_SHIFT) + 1;
+        if(nbRead + length > nbDest)
+            return false;
+
+        for(uint32_t step = 0; step < length; ++step)
+        {
+            x += DIRECTION_X[dir];
+            y += DIRECTION_Y[dir];
+            path.push_back(Ogre::Vector3(static_cast<Ogre::Real>(x), static_cast<Ogre::Real>(y), z));
+        }
+        nbRead += length;
+    }
+
+    return nbRead == nbDest;
+}
+
+}
@@ -0,0 +1,44 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WALKPATHPACKET_H
+#define WALKPATHPACKET_H
+
+#include <OgreVector3.h>
+
+#include <deque>
+#include <vector>
+
+class ODPacket;
+
+/*! \brief Encoding of the walk paths sent to the clients.
+ *
+ * Most paths come from the pathfinding and go from tile to tile at a constant height. Such
+ * paths are sent as their first tile followed by runs of steps in one of the 8 directions
+ * (one byte per run of up to 32 tiles). Other paths are sent as a list of positions.
+ */
+namespace WalkPathPacket
+{
+    //! \brief Writes the given path in the packet
+    void exportToPacket(ODPacket& os, const std::deque<Ogre::Vector3>& path);
+
+    //! \brief Reads a path written by exportToPacket. The positions are appended to path.
+    //! Returns false if the packet is invalid
+    bool importFromPacket(ODPacket& is, std::vector<Ogre::Vector3>& path);
+}
+
+#endif // WALKPATHPACKET_H
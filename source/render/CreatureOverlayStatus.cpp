@@ -36,7 +36,7 @@ enum class CreatureOverlays
 };
 
 CreatureOverlayStatus::CreatureOverlayStatus(Creature* creature, Ogre::Entity* ent,
-        Ogre::Camera* cam) :
+        Ogre::Overlay* overlay) :
     mCreature(creature),
     mMovableTextOverlay(nullptr),
     mHealthValue(0),
@@ -46,7 +46,7 @@ CreatureOverlayStatus::CreatureOverlayStatus(Creature* creature, Ogre::Entity* e
     mOverlayIds(std::vector<uint32_t>(static_cast<uint32_t>(CreatureOverlays::nbCreatureOverlays), 0))
 {
     mMovableTextOverlay = new MovableTextOverlay(creature->getName(),
-        ent, cam);
+        ent, overlay);
 
     uint32_t healthId = mMovableTextOverlay->createChildOverlay("MedievalSharp", 16, Ogre::ColourValue::White, "");
     mOverlayIds[static_cast<uint32_t>(CreatureOverlays::health)] = healthId;
@@ -176,13 +176,18 @@ void CreatureOverlayStatus::updateStatus(Ogre::Real timeSincelastFrame)
     mMovableTextOverlay->displayOverlay(statusId, -1);
 }
 
-void CreatureOverlayStatus::update(Ogre::Real timeSincelastFrame)
+void CreatureOverlayStatus::update(Ogre::Real timeSincelastFrame, const MovableTextOverlayView* view)
 {
     // If the creature is not on map, we do not display the overlays
     mMovableTextOverlay->setVisible(mCreature->getIsOnMap());
 
-    updateHealth();
-    updateStatus(timeSincelastFrame);
+    // Materials are only refreshed for creatures that can be seen. They will be refreshed
+    // when the creature enters the camera view
+    if(view != nullptr)
+    {
+        updateHealth();
+        updateStatus(timeSincelastFrame);
+    }
 
-    mMovableTextOverlay->update(timeSincelastFrame);
+    mMovableTextOverlay->update(timeSincelastFrame, view);
 }
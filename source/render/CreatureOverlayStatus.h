@@ -26,21 +26,26 @@ class Creature;
 class MovableTextOverlay;
 class Seat;
 
+struct MovableTextOverlayView;
+
 namespace Ogre
 {
     class Entity;
-    class Camera;
+    class Overlay;
 }
 
 class CreatureOverlayStatus
 {
 public:
     CreatureOverlayStatus(Creature* creature, Ogre::Entity* ent,
-        Ogre::Camera* cam);
+        Ogre::Overlay* overlay);
     ~CreatureOverlayStatus();
 
     void displayHealthOverlay(Ogre::Real timeToDisplay);
-    void update(Ogre::Real timeSincelastFrame);
+
+    //! \brief Called once per frame by the RenderManager (see RenderManager::updateCreatureOverlays). view
+    //! is nullptr if the creature is on a culled tile. In this case, the icons are not refreshed
+    void update(Ogre::Real timeSincelastFrame, const MovableTextOverlayView* view);
 
 private:
     void updateHealth();
@@ -27,6 +27,15 @@
 #include <Overlay/OgreOverlayContainer.h>
 #include <Overlay/OgreOverlayManager.h>
 
+MovableTextOverlayView::MovableTextOverlayView(const Ogre::Camera& camera) :
+    mCamera(camera),
+    mViewProjMatrix(camera.getProjectionMatrix() * camera.getViewMatrix()),
+    mCameraPlane(Ogre::Vector3(camera.getDerivedOrientation().zAxis()), camera.getDerivedPosition()),
+    mViewportWidth(static_cast<Ogre::Real>(Ogre::OverlayManager::getSingleton().getViewportWidth())),
+    mViewportHeight(static_cast<Ogre::Real>(Ogre::OverlayManager::getSingleton().getViewportHeight()))
+{
+}
+
 ChildOverlay::ChildOverlay(const Ogre::String& fontName, Ogre::Real charHeight,
         const Ogre::ColourValue& color, const Ogre::String& materialName) :
     mOverlayContainer(nullptr),
@@ -37,6 +46,11 @@ ChildOverlay::ChildOverlay(const Ogre::String& fontName, Ogre::Real charHeight,
     mForcedHeight(-1),
     mCharHeight(charHeight),
     mTimeToDisplay(0),
+    mIsShown(false),
+    mLeft(0),
+    mTop(0),
+    mWidth(0),
+    mHeight(0),
     mFont(dynamic_cast<Ogre::Font*>(Ogre::FontManager::getSingleton().getByName(fontName).getPointer()))
 {
     if(mFont == nullptr)
@@ -94,14 +108,9 @@ void ChildOverlay::displayOverlay(Ogre::Real time)
     if((mTimeToDisplay < 0) && (time > 0))
         return;
 
-    if((mTimeToDisplay == 0) && (time != 0))
-    {
-        mOverlayContainer->show();
-    }
-    else if((mTimeToDisplay != 0) && (time == 0))
-    {
-        mOverlayContainer->hide();
-    }
+    // The container will be shown by MovableTextOverlay::update if the followed object is on screen
+    if(time == 0)
+        showContainer(false);
 
     mTimeToDisplay = time;
 }
@@ -134,38 +143,60 @@ void ChildOverlay::update(Ogre::Real timeSincelastFrame)
     }
 
     mTimeToDisplay = 0.0;
-    mOverlayContainer->hide();
+    showContainer(false);
 }
 
 void ChildOverlay::setOnScreen(bool onScreen)
 {
-    if(onScreen && isDisplayed())
+    showContainer(onScreen && isDisplayed());
+}
+
+void ChildOverlay::showContainer(bool show)
+{
+    if(show == mIsShown)
+        return;
+
+    mIsShown = show;
+    if(mIsShown)
         mOverlayContainer->show();
     else
         mOverlayContainer->hide();
 }
 
+void ChildOverlay::setScreenArea(Ogre::Real left, Ogre::Real top, Ogre::Real width, Ogre::Real height)
+{
+    // Moving an overlay element invalidates its geometry so we only do it when needed
+    if((left != mLeft) || (top != mTop))
+    {
+        mLeft = left;
+        mTop = top;
+        mOverlayContainer->setPosition(mLeft, mTop);
+    }
+
+    if((width != mWidth) || (height != mHeight))
+    {
+        mWidth = width;
+        mHeight = height;
+        mOverlayContainer->setDimensions(mWidth, mHeight);
+    }
+}
+
 bool ChildOverlay::isDisplayed()
 {
     return mTimeToDisplay != 0.0;
 }
 
 MovableTextOverlay::MovableTextOverlay(const Ogre::String& name, const Ogre::MovableObject* followedMov,
-        Ogre::Camera* camera) :
+        Ogre::Overlay* overlay) :
     mName(name),
     mFollowedMov(followedMov),
-    mOverlay(nullptr),
-    mCamera(camera)
+    mOverlay(overlay),
+    mIsVisible(true)
 {
-    // create an overlay that we can use for later
-    Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
-    mOverlay = overlayManager.create(name + "_Ov");
-    mOverlay->show();
 }
 
 MovableTextOverlay::~MovableTextOverlay()
 {
-    mOverlay->hide();
     Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
     for(ChildOverlay& childOverlay : mChildOverlays)
     {
@@ -174,7 +205,6 @@ MovableTextOverlay::~MovableTextOverlay()
         overlayManager.destroyOverlayElement(childOverlay.mOverlayText);
         overlayManager.destroyOverlayElement(childOverlay.mOverlayContainer);
     }
-    overlayManager.destroy(mOverlay);
 }
 
 uint32_t MovableTextOverlay::createChildOverlay(const Ogre::String& fontName, Ogre::Real charHeight,
@@ -186,6 +216,7 @@ uint32_t MovableTextOverlay::createChildOverlay(const Ogre::String& fontName, Og
     childOverlay.mOverlayContainer = static_cast<Ogre::OverlayContainer*>(overlayManager.createOverlayElement(
         "Panel", mName + Helper::toString(id) + "_OvC"));
     childOverlay.mOverlayContainer->setDimensions(0.0, 0.0);
+    childOverlay.mOverlayContainer->hide();
 
     mOverlay->add2D(childOverlay.mOverlayContainer);
 
@@ -213,14 +244,16 @@ uint32_t MovableTextOverlay::createChildOverlay(const Ogre::String& fontName, Og
 
 void MovableTextOverlay::setVisible(bool visible)
 {
-    if(visible == mOverlay->isVisible())
+    if(visible == mIsVisible)
         return;
 
-    if(visible)
-        mOverlay->show();
-    else
-        mOverlay->hide();
-
+    // The overlay is shared so we hide the children. They will be shown by update if needed
+    mIsVisible = visible;
+    if(!mIsVisible)
+    {
+        for(ChildOverlay& childOverlay : mChildOverlays)
+            childOverlay.setOnScreen(false);
+    }
 }
 
 void MovableTextOverlay::setCaption(uint32_t childOverlayId, const Ogre::String& caption)
@@ -259,11 +292,11 @@ void MovableTextOverlay::setMaterialName(uint32_t childOverlayId, const Ogre::St
     childOverlay.setMaterialName(materialName);
 }
 
-bool MovableTextOverlay::computeOverlayPositionHead(Ogre::Vector2& position)
+bool MovableTextOverlay::computeOverlayPositionHead(const MovableTextOverlayView& view, Ogre::Vector2& position)
 {
     // the AABB of the target
     const Ogre::AxisAlignedBox& AABB = mFollowedMov->getWorldBoundingBox();
-    if (!mCamera->isVisible(AABB))
+    if (!view.mCamera.isVisible(AABB))
         return false;
 
     const Ogre::Vector3 farLeftTop = AABB.getCorner(Ogre::AxisAlignedBox::NEAR_RIGHT_TOP);
@@ -272,12 +305,11 @@ bool MovableTextOverlay::computeOverlayPositionHead(Ogre::Vector2& position)
     const Ogre::Vector3 centerTop = (farLeftTop + nearRightTop) * 0.5;
 
     // Is the camera facing that point?
-    Ogre::Plane cameraPlane(Ogre::Vector3(mCamera->getDerivedOrientation().zAxis()), mCamera->getDerivedPosition());
-    if(cameraPlane.getSide(centerTop) != Ogre::Plane::NEGATIVE_SIDE)
+    if(view.mCameraPlane.getSide(centerTop) != Ogre::Plane::NEGATIVE_SIDE)
         return false;
 
     // Transform 3D point to screen
-    Ogre::Vector3 screenPosition = mCamera->getProjectionMatrix() * (mCamera->getViewMatrix() * centerTop);
+    Ogre::Vector3 screenPosition = view.mViewProjMatrix * centerTop;
 
     // We transform from coordinate space [-1, 1] to [0, 1]
     position.x = 0.5 + (screenPosition.x * 0.5);
@@ -298,7 +330,7 @@ void MovableTextOverlay::displayOverlay(uint32_t childOverlayId, Ogre::Real time
     childOverlay.displayOverlay(time);
 }
 
-void MovableTextOverlay::update(Ogre::Real timeSincelastFrame)
+void MovableTextOverlay::update(Ogre::Real timeSincelastFrame, const MovableTextOverlayView* view)
 {
     bool displayed = false;
     for(ChildOverlay& childOverlay : mChildOverlays)
@@ -315,7 +347,7 @@ void MovableTextOverlay::update(Ogre::Real timeSincelastFrame)
         return;
 
     Ogre::Vector2 screenPosition;
-    if(!computeOverlayPositionHead(screenPosition))
+    if(!mIsVisible || (view == nullptr) || !computeOverlayPositionHead(*view, screenPosition))
     {
         for(ChildOverlay& childOverlay : mChildOverlays)
             childOverlay.setOnScreen(false);
@@ -329,14 +361,11 @@ void MovableTextOverlay::update(Ogre::Real timeSincelastFrame)
         if(!childOverlay.isDisplayed())
             continue;
 
-        Ogre::Real relTextWidth = childOverlay.getWidth();
-        Ogre::Real relTextHeight = childOverlay.getHeight();
-        relTextWidth /= Ogre::OverlayManager::getSingleton().getViewportWidth();
-        relTextHeight /= Ogre::OverlayManager::getSingleton().getViewportHeight();
+        Ogre::Real relTextWidth = childOverlay.getWidth() / view->mViewportWidth;
+        Ogre::Real relTextHeight = childOverlay.getHeight() / view->mViewportHeight;
 
         screenPosition.y -= relTextHeight;
         Ogre::Real xPos = screenPosition.x - (relTextWidth * 0.5);
-        childOverlay.mOverlayContainer->setPosition(xPos, screenPosition.y);
-        childOverlay.mOverlayContainer->setDimensions(relTextWidth, relTextHeight);
+        childOverlay.setScreenArea(xPos, screenPosition.y, relTextWidth, relTextHeight);
     }
 }
@@ -18,9 +18,12 @@
 #ifndef MOVABLETEXTOVERLAY_H
 #define MOVABLETEXTOVERLAY_H
 
+#include <OgreMatrix4.h>
+#include <OgrePlane.h>
 #include <OgrePrerequisites.h>
 
 #include <cstdint>
+#include <vector>
 
 namespace Ogre
 {
@@ -30,6 +33,24 @@ class OverlayContainer;
 class OverlayElement;
 }
 
+//! \brief Camera data used to project the overlays on screen. It is computed once per frame and
+//! shared by every MovableTextOverlay
+struct MovableTextOverlayView
+{
+    MovableTextOverlayView(const Ogre::Camera& camera);
+
+    const Ogre::Camera& mCamera;
+
+    //! \brief Projection and view matrices of the camera multiplied
+    Ogre::Matrix4 mViewProjMatrix;
+
+    //! \brief Points behind the camera are on the positive side of this plane
+    Ogre::Plane mCameraPlane;
+
+    Ogre::Real mViewportWidth;
+    Ogre::Real mViewportHeight;
+};
+
 class ChildOverlay
 {
     friend class MovableTextOverlay;
@@ -53,6 +74,12 @@ private:
     //! \brief Called to notify if the overlay is visible by the current camera or not
     void setOnScreen(bool onScreen);
 
+    //! \brief Shows or hides the container if it is not already in the wanted state
+    void showContainer(bool show);
+
+    //! \brief Moves the container. Nothing is done if it is already at the given place
+    void setScreenArea(Ogre::Real left, Ogre::Real top, Ogre::Real width, Ogre::Real height);
+
     bool isDisplayed();
 
     Ogre::Real getWidth();
@@ -85,15 +112,27 @@ private:
 
     Ogre::Real mTimeToDisplay;
 
+    //! True if mOverlayContainer is shown
+    bool mIsShown;
+
+    //! Screen area of mOverlayContainer in relative coordinates
+    Ogre::Real mLeft;
+    Ogre::Real mTop;
+    Ogre::Real mWidth;
+    Ogre::Real mHeight;
+
     //! Font used to display the text
     Ogre::Font* mFont;
 };
 
+//! \brief Texts and icons displayed above a movable object. The children overlays are added to
+//! an overlay shared by every MovableTextOverlay so that the OverlayManager does not have to go
+//! through one overlay per object
 class MovableTextOverlay
 {
 public:
     MovableTextOverlay(const Ogre::String& name, const Ogre::MovableObject *followedMov,
-        Ogre::Camera* camera);
+        Ogre::Overlay* overlay);
 
     virtual ~MovableTextOverlay();
 
@@ -114,20 +153,24 @@ public:
 
     //! Displays the overlay during time seconds. If time < 0, the overlay will be always displayed
     void displayOverlay(uint32_t childOverlayId, Ogre::Real time);
-    void update(Ogre::Real timeSincelastFrame);
+
+    //! \brief Updates the display times and moves the displayed overlays above the followed object. If
+    //! view is nullptr, the followed object is known to be culled and the overlays are hidden without
+    //! projecting it
+    void update(Ogre::Real timeSincelastFrame, const MovableTextOverlayView* view);
 
 private:
     //! Computes the position of the head of the followed entity in the screen coordinates. Returns true if
     //! the entity is on screen and position contains the position where the text should be displayed and false otherwise
-    bool computeOverlayPositionHead(Ogre::Vector2& position);
+    bool computeOverlayPositionHead(const MovableTextOverlayView& view, Ogre::Vector2& position);
 
     const Ogre::String mName;
     const Ogre::MovableObject* mFollowedMov;
 
+    //! The shared overlay the children are added to. Don't delete it
     Ogre::Overlay* mOverlay;
 
-    //! The camera used to display the scene
-    const Ogre::Camera* mCamera;
+    bool mIsVisible;
 
     std::vector<ChildOverlay> mChildOverlays;
 };
@@ -156,9 +156,13 @@ void ODFrameListener::updateAnimations(Ogre::Real timeSinceLastFrame)
     updateMenuScene(timeSinceLastFrame);
     MusicPlayer::getSingleton().update(static_cast<float>(timeSinceLastFrame));
     mRenderManager->updateRenderAnimations(timeSinceLastFrame);
+    mGameMap->processTileMeshRefreshes();
+    mRenderManager->updateTileChunks();
     mGameMap->processDeletionQueues();
 
+    mGameMap->setAnimationViewTarget(mCameraManager.getCameraViewTarget());
     mGameMap->updateAnimations(timeSinceLastFrame);
+    mRenderManager->updateCreatureOverlays(*mGameMap, timeSinceLastFrame);
 }
 
 bool ODFrameListener::frameRenderingQueued(const Ogre::FrameEvent& evt)
@@ -276,6 +280,10 @@ void ODFrameListener::printDebugInfo()
         infoSS << "FPS: " << mWindow->getStatistics().lastFPS;
         infoSS << "\ntriangleCount: " << mWindow->getStatistics().triangleCount;
         infoSS << "\nBatches: " << mWindow->getStatistics().batchCount;
+        if(mWindow->getStatistics().lastFPS > 0.0f)
+            infoSS << "\nFrame time: " << 1000.0f / mWindow->getStatistics().lastFPS << " ms";
+        infoSS << "\nTile chunks: " << mRenderManager->getNbTileChunks()
+            << " (rebuilt: " << mRenderManager->getNbTileChunksBuilt() << ")";
         infoSS << "\nTurn number:  " << mGameMap->getTurnNumber();
         infoSS << "\nCursor:  " << mModeManager->getInputManager().mXPos << ", " << mModeManager->getInputManager().mYPos;
         if(ODClient::getSingleton().isConnected())
@@ -21,6 +21,7 @@
 
 #include "render/RenderManager.h"
 
+#include "camera/CullingManager.h"
 #include "entities/Creature.h"
 #include "entities/CreatureDefinition.h"
 #include "entities/GameEntity.h"
@@ -34,6 +35,7 @@
 #include "gamemap/GameMap.h"
 #include "gamemap/TileSet.h"
 #include "render/CreatureOverlayStatus.h"
+#include "render/MovableTextOverlay.h"
 #include "rooms/Room.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
@@ -43,8 +45,11 @@
 #include <OgreCamera.h>
 #include <OgreCompositorManager.h>
 #include <OgreEntity.h>
+#include <OgreHardwareBufferManager.h>
+#include <OgreManualObject.h>
 #include <OgreMaterialManager.h>
 #include <OgreMesh.h>
+#include <OgreMeshManager.h>
 #include <OgreMovableObject.h>
 #include <OgreParticleSystem.h>
 #include <OgreQuaternion.h>
@@ -62,12 +67,16 @@
 #include <Overlay/OgreOverlaySystem.h>
 #include <RTShaderSystem/OgreShaderGenerator.h>
 
+#include <algorithm>
+#include <iterator>
 #include <sstream>
 
 template<> RenderManager* Ogre::Singleton<RenderManager>::msSingleton = nullptr;
 
 const uint8_t RenderManager::OD_RENDER_QUEUE_ID_GUI = 101;
 
+const int RenderManager::TILE_CHUNK_SIZE = 16;
+
 const Ogre::Real RenderManager::BLENDER_UNITS_PER_OGRE_UNIT = 10.0f;
 
 const Ogre::Real KEEPER_HAND_POS_Z = 20.0;
@@ -83,12 +92,16 @@ RenderManager::RenderManager(Ogre::OverlaySystem* overlaySystem) :
     mViewport(nullptr),
     mShaderGenerator(nullptr),
     mHandKeeperNode(nullptr),
+    mHandKeeperEntity(nullptr),
     mHandLight(nullptr),
     mCurrentFOVy(0.0f),
     mFactorWidth(0.0f),
     mFactorHeight(0.0f),
     mCreatureTextOverlayDisplayed(false),
-    mHandKeeperHandVisibility(0)
+    mCreatureOverlay(nullptr),
+    mHandKeeperHandVisibility(0),
+    mNbTileChunksX(0),
+    mNbTileChunksBuilt(0)
 {
     // Use Ogre::SceneType enum instead of string to identify the scene manager type; this is more robust!
     mSceneManager = Ogre::Root::getSingleton().createSceneManager(Ogre::ST_INTERIOR, "SceneManager");
@@ -216,6 +229,7 @@ void RenderManager::createScene(Ogre::Viewport* nViewport)
     // will not call the render function with queue id = OD_RENDER_QUEUE_ID_GUI and the
     // GUI will not be displayed
     keeperHandEnt->setRenderQueueGroup(OD_RENDER_QUEUE_ID_GUI);
+    mHandKeeperEntity = keeperHandEnt;
 
     Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
     Ogre::Overlay* handKeeperOverlay = overlayManager.create(keeperHandEnt->getName() + "_Ov");
@@ -226,6 +240,9 @@ void RenderManager::createScene(Ogre::Viewport* nViewport)
     handKeeperOverlay->add3D(mHandKeeperNode);
     handKeeperOverlay->show();
 
+    mCreatureOverlay = overlayManager.create("CreatureOverlays_Ov");
+    mCreatureOverlay->show();
+
     mHandKeeperNode->setVisible(mHandKeeperHandVisibility == 0);
 }
 
@@ -427,8 +444,7 @@ void RenderManager::updateRenderAnimations(Ogre::Real timeSinceLastFrame)
         mHandAnimationState->addTime(timeSinceLastFrame);
         if(mHandAnimationState->hasEnded())
         {
-            Ogre::Entity* ent = mSceneManager->getEntity("keeperHandEnt");
-            mHandAnimationState = setEntityAnimation(ent, "Idle", true);
+            mHandAnimationState = setEntityAnimation(mHandKeeperEntity, "Idle", true);
         }
     }
 }
@@ -438,9 +454,9 @@ void RenderManager::rrRefreshTile(const Tile& tile, const GameMap& gameMap, cons
     if (tile.getEntityNode() == nullptr)
         return;
 
-    std::string tileName = tile.getOgreNamePrefix() + tile.getName();
-    bool displayTilesetMesh = tile.shouldDisplayTileMesh();
-    std::string meshName;
+    TileChunk* chunk = getTileChunk(tile.getX(), tile.getY());
+    if(chunk == nullptr)
+        return;
 
     // We only mark vision on ground tiles (except lava and water)
     bool vision = true;
@@ -459,53 +475,14 @@ void RenderManager::rrRefreshTile(const Tile& tile, const GameMap& gameMap, cons
     bool isMarked = tile.getMarkedForDigging(&localPlayer);
     const TileSetValue& tileSetValue = gameMap.getMeshForTile(&tile);
 
-    // We display the tile mesh if needed
-    if(displayTilesetMesh)
-    {
-        // We compute the mesh
-        meshName = tileSetValue.getMeshName();
-    }
-
-    Ogre::Entity* tileMeshEnt = nullptr;
-    const std::string tileMeshName = tileName + "_tileMesh";
-    if(mSceneManager->hasEntity(tileMeshName))
-    {
-        tileMeshEnt = mSceneManager->getEntity(tileMeshName);
-        if(tileMeshEnt->getMesh()->getName().compare(meshName) != 0)
-        {
-            // Unlink and delete the old mesh
-            mSceneManager->getSceneNode(tileMeshName + "_node")->detachObject(tileMeshEnt);
-            mSceneManager->destroyEntity(tileMeshEnt);
-            tileMeshEnt = nullptr;
-        }
-    }
-
-    Ogre::SceneNode* tileMeshNode = nullptr;
-    std::string tileMeshNodeName = tileMeshName + "_node";
-    if(mSceneManager->hasSceneNode(tileMeshNodeName))
-        tileMeshNode = mSceneManager->getSceneNode(tileMeshNodeName);
-
-    if((tileMeshEnt == nullptr) && !meshName.empty())
-    {
-        tileMeshEnt = mSceneManager->createEntity(tileMeshName, meshName);
-        // If the node does not exist, we create it
-        if(tileMeshNode == nullptr)
-            tileMeshNode = tile.getEntityNode()->createChildSceneNode(tileMeshNodeName);
-        // Link the tile mesh back to the relevant scene node so OGRE will render it
-        tileMeshNode->attachObject(tileMeshEnt);
-
-        Ogre::MeshPtr meshPtr = tileMeshEnt->getMesh();
-        unsigned short src, dest;
-        if (!meshPtr->suggestTangentVectorBuildParams(Ogre::VES_TANGENT, src, dest))
-        {
-            meshPtr->buildTangentVectors(Ogre::VES_TANGENT, src, dest);
-        }
-    }
+    TileMeshData data;
+    data.mIsCreated = true;
 
-    // We rescale and set the orientation that may have changed
-    if(tileMeshNode != nullptr)
+    // We display the tile mesh if needed
+    if(tile.shouldDisplayTileMesh() && !tileSetValue.getMeshName().empty())
     {
-        tileMeshNode->resetOrientation();
+        const TileMeshPrototype& prototype = getTileMeshPrototype(tileSetValue.getMeshName());
+        data.mTileMeshName = tileSetValue.getMeshName();
 
         // We rotate depending on the tileset
         Ogre::Quaternion q;
@@ -518,70 +495,52 @@ void RenderManager::rrRefreshTile(const Tile& tile, const GameMap& gameMap, cons
         if(tileSetValue.getRotationZ() != 0.0)
             q = q * Ogre::Quaternion(Ogre::Degree(tileSetValue.getRotationZ()), Ogre::Vector3::UNIT_Z);
 
-        if(q != Ogre::Quaternion::IDENTITY)
-            tileMeshNode->rotate(q);
-    }
-
-    if(tileMeshEnt != nullptr)
-    {
-        // We replace the material if required by the tileset
-        if(!tileSetValue.getMaterialName().empty())
-            tileMeshEnt->setMaterialName(tileSetValue.getMaterialName());
+        data.mTileMeshOrientation = q;
 
         Seat* seatColor = nullptr;
         if(tile.shouldColorTileMesh())
             seatColor = tile.getSeat();
 
-        colourizeEntity(tileMeshEnt, seatColor, isMarked, vision);
-    }
-
-    // We display the custom mesh if there is one
-    const std::string customMeshName = tileName + "_customMesh";
-    meshName = tile.getMeshName();
-    Ogre::Entity* customMeshEnt = nullptr;
-    if(mSceneManager->hasEntity(customMeshName))
-    {
-        customMeshEnt = mSceneManager->getEntity(customMeshName);
-        if(customMeshEnt->getMesh()->getName().compare(meshName) != 0)
-        {
-            // Unlink and delete the old mesh
-            mSceneManager->getSceneNode(customMeshName + "_node")->detachObject(customMeshEnt);
-            mSceneManager->destroyEntity(customMeshEnt);
-            customMeshEnt = nullptr;
-        }
-    }
-
-    if((customMeshEnt == nullptr) && !meshName.empty())
-    {
-        // If the node does not exist, we create it
-        std::string customMeshNodeName = customMeshName + "_node";
-        Ogre::SceneNode* customMeshNode;
-        if(!mSceneManager->hasSceneNode(customMeshNodeName))
-            customMeshNode = tile.getEntityNode()->createChildSceneNode(customMeshNodeName);
+        // We replace the material if required by the tileset
+        if(tileSetValue.getMaterialName().empty())
+            data.mTileMeshMaterials = prototype.mMaterials;
         else
-            customMeshNode = mSceneManager->getSceneNode(customMeshNodeName);
-
-        customMeshEnt = mSceneManager->createEntity(customMeshName, meshName);
+            data.mTileMeshMaterials.assign(prototype.mMaterials.size(), tileSetValue.getMaterialName());
 
-        customMeshNode->attachObject(customMeshEnt);
-        customMeshNode->resetOrientation();
-
-        Ogre::MeshPtr meshPtr = customMeshEnt->getMesh();
-        unsigned short src, dest;
-        if (!meshPtr->suggestTangentVectorBuildParams(Ogre::VES_TANGENT, src, dest))
-        {
-            meshPtr->buildTangentVectors(Ogre::VES_TANGENT, src, dest);
-        }
+        data.mTileMeshColour = getTileMeshColour(seatColor, isMarked, vision);
     }
 
-    if(customMeshEnt != nullptr)
+    // We display the custom mesh if there is one
+    if(!tile.getMeshName().empty())
     {
+        const TileMeshPrototype& prototype = getTileMeshPrototype(tile.getMeshName());
+        data.mCustomMeshName = tile.getMeshName();
+
         Seat* seatColor = nullptr;
         if(tile.shouldColorCustomMesh())
             seatColor = tile.getSeat();
 
-        colourizeEntity(customMeshEnt, seatColor, isMarked, vision);
+        data.mCustomMeshMaterials = prototype.mMaterials;
+        data.mCustomMeshColour = getTileMeshColour(seatColor, isMarked, vision);
     }
+
+    TileMeshData& current = chunk->mTiles[getTileIndexInChunk(tile.getX(), tile.getY())];
+    // Most refreshes do not change what is displayed (vision updates, claiming in progress, ...). In this
+    // case, there is no need to rebuild the chunk
+    if((current.mTileMeshName == data.mTileMeshName) &&
+       (current.mTileMeshOrientation == data.mTileMeshOrientation) &&
+       (current.mTileMeshMaterials == data.mTileMeshMaterials) &&
+       (current.mTileMeshColour == data.mTileMeshColour) &&
+       (current.mCustomMeshName == data.mCustomMeshName) &&
+       (current.mCustomMeshMaterials == data.mCustomMeshMaterials) &&
+       (current.mCustomMeshColour == data.mCustomMeshColour))
+    {
+        return;
+    }
+
+    data.mIsCulled = current.mIsCulled;
+    current = std::move(data);
+    chunk->mIsDirty = true;
 }
 
 void RenderManager::rrCreateTile(Tile& tile, const GameMap& gameMap, const Player& localPlayer)
@@ -592,6 +551,46 @@ void RenderManager::rrCreateTile(Tile& tile, const GameMap& gameMap, const Playe
     tile.setEntityNode(node);
     node->setPosition(static_cast<Ogre::Real>(tile.getX()), static_cast<Ogre::Real>(tile.getY()), 0);
 
+    // If the chunks do not match the map (first tile of a new map), we create them
+    int nbChunksX = (gameMap.getMapSizeX() + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+    int nbChunksY = (gameMap.getMapSizeY() + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE;
+    if((mNbTileChunksX != nbChunksX) || (mTileChunks.size() != static_cast<std::size_t>(nbChunksX * nbChunksY)))
+    {
+        destroyTileChunks();
+        mNbTileChunksX = nbChunksX;
+        mTileChunks.resize(nbChunksX * nbChunksY);
+    }
+
+    TileChunk* chunk = getTileChunk(tile.getX(), tile.getY());
+    if(chunk == nullptr)
+    {
+        OD_LOG_ERR("No chunk for tile=" + Tile::displayAsString(&tile));
+        return;
+    }
+
+    if(chunk->mGeometry == nullptr)
+    {
+        int chunkX = tile.getX() / TILE_CHUNK_SIZE;
+        int chunkY = tile.getY() / TILE_CHUNK_SIZE;
+        std::string chunkName = "TileChunk_" + Helper::toString(chunkX) + "_" + Helper::toString(chunkY);
+        // The chunk node is placed on its first tile. The vertices are relative to it
+        chunk->mNode = mTileSceneNode->createChildSceneNode(chunkName + "_node");
+        chunk->mNode->setPosition(static_cast<Ogre::Real>(chunkX * TILE_CHUNK_SIZE),
+            static_cast<Ogre::Real>(chunkY * TILE_CHUNK_SIZE), 0);
+        chunk->mGeometry = mSceneManager->createManualObject(chunkName);
+        chunk->mGeometry->setCastShadows(false);
+        chunk->mNode->attachObject(chunk->mGeometry);
+        chunk->mTiles.resize(TILE_CHUNK_SIZE * TILE_CHUNK_SIZE);
+    }
+
+    TileMeshData& data = chunk->mTiles[getTileIndexInChunk(tile.getX(), tile.getY())];
+    if(!data.mIsCreated)
+        ++chunk->mNbTiles;
+
+    data = TileMeshData();
+    data.mIsCreated = true;
+    chunk->mIsDirty = true;
+
     rrRefreshTile(tile, gameMap, localPlayer);
 }
 
@@ -600,44 +599,39 @@ void RenderManager::rrDestroyTile(Tile& tile)
     if (tile.getEntityNode() == nullptr)
         return;
 
-    std::string tileName = tile.getOgreNamePrefix() + tile.getName();
-    std::string selectorName = tileName + "_selection_indicator";
-    if(mSceneManager->hasEntity(selectorName))
+    Ogre::Entity* selectorEnt = tile.getOgreEntity();
+    if(selectorEnt != nullptr)
     {
-        Ogre::SceneNode* selectorNode = mSceneManager->getSceneNode(selectorName + "Node");
-        Ogre::Entity* selectorEnt = mSceneManager->getEntity(selectorName);
+        Ogre::SceneNode* selectorNode = selectorEnt->getParentSceneNode();
         tile.getEntityNode()->removeChild(selectorNode);
         selectorNode->detachObject(selectorEnt);
         mSceneManager->destroySceneNode(selectorNode);
         mSceneManager->destroyEntity(selectorEnt);
+        tile.setOgreEntity(nullptr);
     }
 
-    const std::string tileMeshName = tileName + "_tileMesh";
-    if(mSceneManager->hasSceneNode(tileMeshName + "_node"))
+    TileChunk* chunk = getTileChunk(tile.getX(), tile.getY());
+    if((chunk != nullptr) && (chunk->mGeometry != nullptr))
     {
-        Ogre::SceneNode* tileMeshNode = mSceneManager->getSceneNode(tileMeshName + "_node");
-        if(mSceneManager->hasEntity(tileMeshName))
+        TileMeshData& data = chunk->mTiles[getTileIndexInChunk(tile.getX(), tile.getY())];
+        if(data.mIsCreated)
         {
-            Ogre::Entity* ent = mSceneManager->getEntity(tileMeshName);
-            tileMeshNode->detachObject(ent);
-            mSceneManager->destroyEntity(ent);
+            if(data.mIsCulled)
+                --chunk->mNbCulledTiles;
+
+            data = TileMeshData();
+            --chunk->mNbTiles;
+            chunk->mIsDirty = true;
         }
-        tile.getEntityNode()->removeChild(tileMeshNode);
-        mSceneManager->destroySceneNode(tileMeshNode);
-    }
 
-    const std::string customMeshName = tileName + "_customMesh";
-    if(mSceneManager->hasSceneNode(customMeshName + "_node"))
-    {
-        Ogre::SceneNode* customMeshNode = mSceneManager->getSceneNode(customMeshName + "_node");
-        if(mSceneManager->hasEntity(customMeshName))
+        // When the last tile of the chunk is removed, there is nothing left to render
+        if(chunk->mNbTiles == 0)
         {
-            Ogre::Entity* ent = mSceneManager->getEntity(customMeshName);
-            customMeshNode->detachObject(ent);
-            mSceneManager->destroyEntity(ent);
+            chunk->mNode->detachObject(chunk->mGeometry);
+            mSceneManager->destroyManualObject(chunk->mGeometry);
+            mSceneManager->destroySceneNode(chunk->mNode);
+            *chunk = TileChunk();
         }
-        tile.getEntityNode()->removeChild(customMeshNode);
-        mSceneManager->destroySceneNode(customMeshNode);
     }
 
     mSceneManager->destroySceneNode(tile.getEntityNode());
@@ -645,29 +639,283 @@ void RenderManager::rrDestroyTile(Tile& tile)
     tile.setEntityNode(nullptr);
 }
 
-void RenderManager::rrTemporalMarkTile(Tile* curTile)
+void RenderManager::rrSetTileCulled(const Tile& tile, bool culled)
 {
-    Ogre::SceneManager* mSceneMgr = RenderManager::getSingletonPtr()->getSceneManager();
-    Ogre::Entity* ent;
+    TileChunk* chunk = getTileChunk(tile.getX(), tile.getY());
+    if((chunk == nullptr) || (chunk->mGeometry == nullptr))
+        return;
 
-    bool bb = curTile->getSelected();
+    TileMeshData& data = chunk->mTiles[getTileIndexInChunk(tile.getX(), tile.getY())];
+    if(!data.mIsCreated || (data.mIsCulled == culled))
+        return;
+
+    data.mIsCulled = culled;
+    if(culled)
+        ++chunk->mNbCulledTiles;
+    else
+        --chunk->mNbCulledTiles;
+
+    // A chunk is displayed as long as one of its tiles is visible. If it was changed while
+    // hidden, we rebuild it before it gets displayed
+    bool isVisible = (chunk->mNbCulledTiles < chunk->mNbTiles);
+    if(isVisible && chunk->mIsDirty)
+        buildTileChunk(*chunk);
+
+    chunk->mGeometry->setVisible(isVisible);
+}
 
-    std::string tileName = curTile->getOgreNamePrefix() + curTile->getName();
-    std::string selectorName = tileName + "_selection_indicator";
-    if (mSceneMgr->hasEntity(selectorName))
+void RenderManager::updateTileChunks()
+{
+    mNbTileChunksBuilt = 0;
+    for(TileChunk& chunk : mTileChunks)
     {
-        ent = mSceneMgr->getEntity(selectorName);
+        if(!chunk.mIsDirty || (chunk.mGeometry == nullptr))
+            continue;
+
+        // Hidden chunks are rebuilt when they become visible
+        if(chunk.mNbCulledTiles >= chunk.mNbTiles)
+            continue;
+
+        buildTileChunk(chunk);
     }
-    else
+}
+
+void RenderManager::buildTileChunk(TileChunk& chunk)
+{
+    // Each material is one section of the chunk. The tint of every tile is written in its vertices
+    // so that the chunk uses the same few materials whatever the seats and tile states are
+    struct TileSubMeshInstance
+    {
+        const TileSubMesh* mSubMesh;
+        Ogre::Vector3 mPosition;
+        Ogre::Quaternion mOrientation;
+        Ogre::ColourValue mColour;
+    };
+    std::map<std::string, std::vector<TileSubMeshInstance>> sections;
+    for(int index = 0; index < TILE_CHUNK_SIZE * TILE_CHUNK_SIZE; ++index)
     {
-        std::string tileNodeName = tileName + "_node";
-        ent = mSceneMgr->createEntity(selectorName, "SquareSelector.mesh");
+        const TileMeshData& data = chunk.mTiles[index];
+        if(!data.mIsCreated)
+            continue;
+
+        Ogre::Vector3 position(static_cast<Ogre::Real>(index % TILE_CHUNK_SIZE),
+            static_cast<Ogre::Real>(index / TILE_CHUNK_SIZE), 0);
+
+        if(!data.mTileMeshName.empty())
+        {
+            const TileMeshPrototype& prototype = getTileMeshPrototype(data.mTileMeshName);
+            for(uint32_t i = 0; (i < prototype.mSubMeshes.size()) && (i < data.mTileMeshMaterials.size()); ++i)
+            {
+                TileSubMeshInstance instance = { &prototype.mSubMeshes[i], position,
+                    data.mTileMeshOrientation, data.mTileMeshColour };
+                sections[data.mTileMeshMaterials[i]].push_back(instance);
+            }
+        }
+
+        if(!data.mCustomMeshName.empty())
+        {
+            const TileMeshPrototype& prototype = getTileMeshPrototype(data.mCustomMeshName);
+            for(uint32_t i = 0; (i < prototype.mSubMeshes.size()) && (i < data.mCustomMeshMaterials.size()); ++i)
+            {
+                TileSubMeshInstance instance = { &prototype.mSubMeshes[i], position,
+                    Ogre::Quaternion::IDENTITY, data.mCustomMeshColour };
+                sections[data.mCustomMeshMaterials[i]].push_back(instance);
+            }
+        }
+    }
+
+    chunk.mGeometry->clear();
+    for(const std::pair<const std::string, std::vector<TileSubMeshInstance>>& section : sections)
+    {
+        chunk.mGeometry->begin(getVertexColourMaterial(section.first), Ogre::RenderOperation::OT_TRIANGLE_LIST);
+        uint32_t firstVertex = 0;
+        for(const TileSubMeshInstance& instance : section.second)
+        {
+            for(const TileMeshVertex& vertex : instance.mSubMesh->mVertices)
+            {
+                chunk.mGeometry->position(instance.mPosition + instance.mOrientation * vertex.mPosition);
+                chunk.mGeometry->normal(instance.mOrientation * vertex.mNormal);
+                chunk.mGeometry->tangent(instance.mOrientation * vertex.mTangent);
+                chunk.mGeometry->textureCoord(vertex.mTexCoord);
+                chunk.mGeometry->colour(instance.mColour);
+            }
+
+            for(uint32_t index : instance.mSubMesh->mIndices)
+                chunk.mGeometry->index(firstVertex + index);
+
+            firstVertex += static_cast<uint32_t>(instance.mSubMesh->mVertices.size());
+        }
+        chunk.mGeometry->end();
+    }
+
+    chunk.mIsDirty = false;
+    ++mNbTileChunksBuilt;
+}
+
+void RenderManager::destroyTileChunks()
+{
+    for(TileChunk& chunk : mTileChunks)
+    {
+        if(chunk.mGeometry == nullptr)
+            continue;
+
+        chunk.mNode->detachObject(chunk.mGeometry);
+        mSceneManager->destroyManualObject(chunk.mGeometry);
+        mSceneManager->destroySceneNode(chunk.mNode);
+    }
+    mTileChunks.clear();
+    mNbTileChunksX = 0;
+}
+
+RenderManager::TileChunk* RenderManager::getTileChunk(int tileX, int tileY)
+{
+    if((tileX < 0) || (tileY < 0) || (mNbTileChunksX <= 0))
+        return nullptr;
+
+    int chunkX = tileX / TILE_CHUNK_SIZE;
+    if(chunkX >= mNbTileChunksX)
+        return nullptr;
+
+    std::size_t index = static_cast<std::size_t>((tileY / TILE_CHUNK_SIZE) * mNbTileChunksX + chunkX);
+    if(index >= mTileChunks.size())
+        return nullptr;
+
+    return &mTileChunks[index];
+}
+
+int RenderManager::getTileIndexInChunk(int tileX, int tileY)
+{
+    return (tileY % TILE_CHUNK_SIZE) * TILE_CHUNK_SIZE + (tileX % TILE_CHUNK_SIZE);
+}
+
+uint32_t RenderManager::getNbTileChunks() const
+{
+    uint32_t nbChunks = 0;
+    for(const TileChunk& chunk : mTileChunks)
+    {
+        if(chunk.mGeometry != nullptr)
+            ++nbChunks;
+    }
+    return nbChunks;
+}
+
+const RenderManager::TileMeshPrototype& RenderManager::getTileMeshPrototype(const std::string& meshName)
+{
+    auto it = mTileMeshPrototypes.find(meshName);
+    if(it != mTileMeshPrototypes.end())
+        return it->second;
+
+    // The mesh is read back once. The chunks are then filled from this copy
+    TileMeshPrototype& prototype = mTileMeshPrototypes[meshName];
+    Ogre::MeshPtr meshPtr = Ogre::MeshManager::getSingleton().load(meshName,
+        Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+    unsigned short src, dest;
+    if (!meshPtr->suggestTangentVectorBuildParams(Ogre::VES_TANGENT, src, dest))
+    {
+        meshPtr->buildTangentVectors(Ogre::VES_TANGENT, src, dest);
+    }
+
+    prototype.mSubMeshes.resize(meshPtr->getNumSubMeshes());
+    for(uint16_t i = 0; i < meshPtr->getNumSubMeshes(); ++i)
+    {
+        readTileSubMesh(meshPtr, i, prototype.mSubMeshes[i]);
+        prototype.mMaterials.push_back(prototype.mSubMeshes[i].mMaterial);
+    }
+
+    return prototype;
+}
+
+void RenderManager::readTileSubMesh(const Ogre::MeshPtr& mesh, uint16_t subMeshIndex, TileSubMesh& subMesh)
+{
+    const Ogre::SubMesh* ogreSubMesh = mesh->getSubMesh(subMeshIndex);
+    subMesh.mMaterial = ogreSubMesh->getMaterialName();
+    if(ogreSubMesh->operationType != Ogre::RenderOperation::OT_TRIANGLE_LIST)
+    {
+        OD_LOG_ERR("Unsupported operation type for tile mesh=" + mesh->getName() + ", subMesh=" + Helper::toString(subMeshIndex));
+        return;
+    }
+
+    const Ogre::VertexData* vertexData = ogreSubMesh->useSharedVertices
+        ? mesh->sharedVertexData
+        : ogreSubMesh->vertexData;
+    subMesh.mVertices.resize(vertexData->vertexCount);
+
+    // Every tile vertex has a position, normal, tangent and texture coordinates. Missing elements
+    // are left to zero
+    const Ogre::VertexElementSemantic semantics[] = { Ogre::VES_POSITION, Ogre::VES_NORMAL,
+        Ogre::VES_TANGENT, Ogre::VES_TEXTURE_COORDINATES };
+    for(Ogre::VertexElementSemantic semantic : semantics)
+    {
+        const Ogre::VertexElement* element = vertexData->vertexDeclaration->findElementBySemantic(semantic);
+        if(element == nullptr)
+            continue;
+
+        Ogre::HardwareVertexBufferSharedPtr buffer = vertexData->vertexBufferBinding->getBuffer(element->getSource());
+        const unsigned char* vertex = static_cast<const unsigned char*>(buffer->lock(Ogre::HardwareBuffer::HBL_READ_ONLY));
+        vertex += vertexData->vertexStart * buffer->getVertexSize();
+        for(TileMeshVertex& tileVertex : subMesh.mVertices)
+        {
+            float* values;
+            element->baseVertexPointerToElement(const_cast<unsigned char*>(vertex), &values);
+            switch(semantic)
+            {
+                case Ogre::VES_POSITION:
+                    tileVertex.mPosition = Ogre::Vector3(values[0], values[1], values[2]);
+                    break;
+                case Ogre::VES_NORMAL:
+                    tileVertex.mNormal = Ogre::Vector3(values[0], values[1], values[2]);
+                    break;
+                case Ogre::VES_TANGENT:
+                    tileVertex.mTangent = Ogre::Vector3(values[0], values[1], values[2]);
+                    break;
+                default:
+                    tileVertex.mTexCoord = Ogre::Vector2(values[0], values[1]);
+                    break;
+            }
+            vertex += buffer->getVertexSize();
+        }
+        buffer->unlock();
+    }
+
+    const Ogre::IndexData* indexData = ogreSubMesh->indexData;
+    Ogre::HardwareIndexBufferSharedPtr indexBuffer = indexData->indexBuffer;
+    subMesh.mIndices.resize(indexData->indexCount);
+    const void* indices = indexBuffer->lock(Ogre::HardwareBuffer::HBL_READ_ONLY);
+    for(std::size_t i = 0; i < indexData->indexCount; ++i)
+    {
+        std::size_t index = indexData->indexStart + i;
+        if(indexBuffer->getType() == Ogre::HardwareIndexBuffer::IT_32BIT)
+            subMesh.mIndices[i] = static_cast<const uint32_t*>(indices)[index];
+        else
+            subMesh.mIndices[i] = static_cast<const uint16_t*>(indices)[index];
+    }
+    indexBuffer->unlock();
+}
+
+void RenderManager::rrTemporalMarkTile(Tile* curTile)
+{
+    Ogre::SceneNode* tileNode = curTile->getEntityNode();
+    if(tileNode == nullptr)
+        return;
+
+    bool bb = curTile->getSelected();
+
+    // Tiles are rendered by chunks so the only entity a tile has is its selection indicator. It is
+    // created the first time the tile is selected
+    Ogre::Entity* ent = curTile->getOgreEntity();
+    if(ent == nullptr)
+    {
+        if(!bb)
+            return;
+
+        std::string selectorName = curTile->getOgreNamePrefix() + curTile->getName() + "_selection_indicator";
+        ent = mSceneManager->createEntity(selectorName, "SquareSelector.mesh");
         ent->setLightMask(0);
         ent->setCastShadows(false);
-        Ogre::SceneNode* tileNode = mSceneManager->getSceneNode(tileNodeName);
         Ogre::SceneNode* selectorNode = tileNode->createChildSceneNode(selectorName + "Node");
         selectorNode->setInheritScale(false);
         selectorNode->attachObject(ent);
+        curTile->setOgreEntity(ent);
     }
 
     ent->setVisible(bb);
@@ -703,22 +951,7 @@ void RenderManager::rrCreateRenderedMovableEntity(RenderedMovableEntity* rendere
 
     renderedMovableEntity->setParentSceneNode(node->getParentSceneNode());
     renderedMovableEntity->setEntityNode(node);
-
-    // If it is required, we hide the tile
-    if((renderedMovableEntity->getHideCoveredTile()) &&
-       (renderedMovableEntity->getOpacity() >= 1.0))
-    {
-        Tile* posTile = renderedMovableEntity->getPositionTile();
-        if(posTile == nullptr)
-            return;
-
-        std::string tileName = posTile->getOgreNamePrefix() + posTile->getName();
-        if (!mSceneManager->hasEntity(tileName))
-            return;
-
-        Ogre::Entity* entity = mSceneManager->getEntity(tileName);
-        entity->setVisible(false);
-    }
+    renderedMovableEntity->setOgreEntity(ent);
 
     if ((ent != nullptr) && (renderedMovableEntity->getOpacity() < 1.0f))
         setEntityOpacity(ent, renderedMovableEntity->getOpacity());
@@ -726,62 +959,30 @@ void RenderManager::rrCreateRenderedMovableEntity(RenderedMovableEntity* rendere
 
 void RenderManager::rrDestroyRenderedMovableEntity(RenderedMovableEntity* curRenderedMovableEntity)
 {
-    std::string tempString = curRenderedMovableEntity->getOgreNamePrefix()
-                             + curRenderedMovableEntity->getName();
     Ogre::SceneNode* node = curRenderedMovableEntity->getEntityNode();
-    if(mSceneManager->hasEntity(tempString))
+    Ogre::Entity* ent = curRenderedMovableEntity->getOgreEntity();
+    if(ent != nullptr)
     {
-        Ogre::Entity* ent = mSceneManager->getEntity(tempString);
         node->detachObject(ent);
         mSceneManager->destroyEntity(ent);
     }
     mSceneManager->destroySceneNode(node);
     curRenderedMovableEntity->setParentSceneNode(nullptr);
     curRenderedMovableEntity->setEntityNode(nullptr);
-
-    // If it was hidden, we display the tile
-    if(curRenderedMovableEntity->getHideCoveredTile())
-    {
-        Tile* posTile = curRenderedMovableEntity->getPositionTile();
-        if(posTile == nullptr)
-            return;
-
-        std::string tileName = posTile->getOgreNamePrefix() + posTile->getName();
-        if (!mSceneManager->hasEntity(tileName))
-            return;
-
-        Ogre::Entity* entity = mSceneManager->getEntity(tileName);
-        if (posTile->getCoveringBuilding() != nullptr)
-            entity->setVisible(posTile->getCoveringBuilding()->shouldDisplayGroundTile());
-        else
-            entity->setVisible(true);
-    }
+    curRenderedMovableEntity->setOgreEntity(nullptr);
+    curRenderedMovableEntity->clearAnimationStatesCache();
 }
 
 void RenderManager::rrUpdateEntityOpacity(RenderedMovableEntity* entity)
 {
-    std::string entStr = entity->getOgreNamePrefix() + entity->getName();
-    Ogre::Entity* ogreEnt = mSceneManager->hasEntity(entStr) ? mSceneManager->getEntity(entStr) : nullptr;
+    Ogre::Entity* ogreEnt = entity->getOgreEntity();
     if (ogreEnt == nullptr)
     {
-        OD_LOG_INF("Update opacity: Couldn't find entity: " + entStr);
+        OD_LOG_INF("Update opacity: Couldn't find entity: " + entity->getName());
         return;
     }
 
     setEntityOpacity(ogreEnt, entity->getOpacity());
-
-    // We add the tile if it is required and the opacity is 1. Otherwise, we show it (in case the trap gets deactivated)
-    bool tileVisible = (!entity->getHideCoveredTile() || (entity->getOpacity() < 1.0f));
-    Tile* posTile = entity->getPositionTile();
-    if(posTile != nullptr)
-    {
-        std::string tileName = posTile->getOgreNamePrefix() + posTile->getName();
-        if (mSceneManager->hasEntity(tileName))
-        {
-            Ogre::Entity* ogreEntity = mSceneManager->getEntity(tileName);
-            ogreEntity->setVisible(tileVisible);
-        }
-    }
 }
 
 void RenderManager::rrCreateCreature(Creature* curCreature)
@@ -800,12 +1001,12 @@ void RenderManager::rrCreateCreature(Creature* curCreature)
 
     Ogre::SceneNode* node = mCreatureSceneNode->createChildSceneNode(creatureName + "_node");
     curCreature->setEntityNode(node);
+    curCreature->setOgreEntity(ent);
     node->setPosition(curCreature->getPosition());
     node->attachObject(ent);
     curCreature->setParentSceneNode(node->getParentSceneNode());
 
-    Ogre::Camera* cam = mViewport->getCamera();
-    CreatureOverlayStatus* creatureOverlay = new CreatureOverlayStatus(curCreature, ent, cam);
+    CreatureOverlayStatus* creatureOverlay = new CreatureOverlayStatus(curCreature, ent, mCreatureOverlay);
     curCreature->setOverlayStatus(creatureOverlay);
 
     creatureOverlay->displayHealthOverlay(mCreatureTextOverlayDisplayed ? -1.0 : 0.0);
@@ -813,29 +1014,45 @@ void RenderManager::rrCreateCreature(Creature* curCreature)
 
 void RenderManager::rrDestroyCreature(Creature* curCreature)
 {
-    if(curCreature->getOverlayStatus() != nullptr)
+    CreatureOverlayStatus* overlayStatus = curCreature->getOverlayStatus();
+    if(overlayStatus != nullptr)
     {
-        delete curCreature->getOverlayStatus();
+        auto itOnScreen = std::lower_bound(mCreatureOverlaysOnScreen.begin(), mCreatureOverlaysOnScreen.end(), overlayStatus);
+        if((itOnScreen != mCreatureOverlaysOnScreen.end()) && (*itOnScreen == overlayStatus))
+            mCreatureOverlaysOnScreen.erase(itOnScreen);
+
+        mCreatureOverlayTimers.erase(std::remove_if(mCreatureOverlayTimers.begin(), mCreatureOverlayTimers.end(),
+            [overlayStatus](const CreatureOverlayTimer& timer) { return timer.mOverlayStatus == overlayStatus; }),
+            mCreatureOverlayTimers.end());
+
+        delete overlayStatus;
         curCreature->setOverlayStatus(nullptr);
     }
 
-    std::string creatureName = curCreature->getOgreNamePrefix() + curCreature->getName();
-    if (mSceneManager->hasEntity(creatureName))
+    Ogre::Entity* ent = curCreature->getOgreEntity();
+    if (ent != nullptr)
     {
         Ogre::SceneNode* creatureNode = curCreature->getEntityNode();
-        Ogre::Entity* ent = mSceneManager->getEntity(creatureName);
         creatureNode->detachObject(ent);
         mCreatureSceneNode->removeChild(creatureNode);
         curCreature->setParentSceneNode(nullptr);
         curCreature->setEntityNode(nullptr);
+        curCreature->setOgreEntity(nullptr);
+        curCreature->clearAnimationStatesCache();
         mSceneManager->destroyEntity(ent);
-        mSceneManager->destroySceneNode(creatureNode->getName());
+        mSceneManager->destroySceneNode(creatureNode);
     }
 }
 
 void RenderManager::rrOrientEntityToward(MovableGameEntity* gameEntity, const Ogre::Vector3& direction)
 {
-    Ogre::SceneNode* node = mSceneManager->getSceneNode(gameEntity->getOgreNamePrefix() + gameEntity->getName() + "_node");
+    Ogre::SceneNode* node = gameEntity->getEntityNode();
+    if(node == nullptr)
+    {
+        OD_LOG_ERR("Entity do not have node=" + gameEntity->getName());
+        return;
+    }
+
     Ogre::Vector3 tempVector = node->getOrientation() * Ogre::Vector3::NEGATIVE_UNIT_Y;
 
     // Work around 180 degree quaternion rotation quirk
@@ -862,19 +1079,24 @@ void RenderManager::rrScaleCreature(Creature& creature)
     creature.getEntityNode()->setScale(Ogre::Vector3::UNIT_SCALE * scaleFactor);
 }
 
-void RenderManager::rrCreateWeapon(Creature* curCreature, const Weapon* curWeapon, const std::string& hand)
+Ogre::Entity* RenderManager::rrCreateWeapon(Creature* curCreature, const Weapon* curWeapon, const std::string& hand)
 {
-    Ogre::Entity* ent = mSceneManager->getEntity(curCreature->getOgreNamePrefix() + curCreature->getName());
+    Ogre::Entity* ent = curCreature->getOgreEntity();
+    if(ent == nullptr)
+    {
+        OD_LOG_ERR("creature=" + curCreature->getName());
+        return nullptr;
+    }
+
     std::string weaponName = curWeapon->getOgreNamePrefix() + hand;
-    if(!ent->getSkeleton()->hasBone(weaponName))
+    if(!ent->hasSkeleton() || !ent->getSkeleton()->hasBone(weaponName))
     {
         OD_LOG_WRN("Tried to add weapons to entity \"" + ent->getName() + " \" using model \"" +
                               ent->getMesh()->getName() + "\" that is missing the required bone \"" +
-                              curWeapon->getOgreNamePrefix() + hand + "\"");
-        return;
+                              weaponName + "\"");
+        return nullptr;
     }
-    Ogre::Bone* weaponBone = ent->getSkeleton()->getBone(
-                                curWeapon->getOgreNamePrefix() + hand);
+    Ogre::Bone* weaponBone = ent->getSkeleton()->getBone(weaponName);
     Ogre::Entity* weaponEntity = mSceneManager->createEntity(curWeapon->getOgreNamePrefix()
                                 + hand + "_" + curCreature->getName(),
                                 curWeapon->getMeshName());
@@ -886,17 +1108,13 @@ void RenderManager::rrCreateWeapon(Creature* curCreature, const Weapon* curWeapo
 
     ent->attachObjectToBone(weaponBone->getName(), weaponEntity,
                             rotationQuaternion);
+    return weaponEntity;
 }
 
-void RenderManager::rrDestroyWeapon(Creature* curCreature, const Weapon* curWeapon, const std::string& hand)
+void RenderManager::rrDestroyWeapon(Ogre::Entity* weaponEntity)
 {
-    std::string weaponEntityName = curWeapon->getOgreNamePrefix() + hand + "_" + curCreature->getName();
-    if(mSceneManager->hasEntity(weaponEntityName))
-    {
-        Ogre::Entity* weaponEntity = mSceneManager->getEntity(weaponEntityName);
-        weaponEntity->detachFromParent();
-        mSceneManager->destroyEntity(weaponEntity);
-    }
+    weaponEntity->detachFromParent();
+    mSceneManager->destroyEntity(weaponEntity);
 }
 
 void RenderManager::rrCreateMapLight(MapLight* curMapLight, bool displayVisual)
@@ -922,6 +1140,7 @@ void RenderManager::rrCreateMapLight(MapLight* curMapLight, bool displayVisual)
         // Create the MapLightIndicator mesh so the light can be drug around in the map editor.
         Ogre::Entity* lightEntity = mSceneManager->createEntity(mapLightName, "Lamp.mesh");
         mapLightNode->attachObject(lightEntity);
+        curMapLight->setOgreEntity(lightEntity);
     }
 
     // Create the "flicker_node" which moves around randomly relative to
@@ -937,47 +1156,42 @@ void RenderManager::rrDestroyMapLight(MapLight* curMapLight)
     if (mSceneManager->hasLight(mapLightName + "_light"))
     {
         Ogre::Light* light = mSceneManager->getLight(mapLightName + "_light");
-        Ogre::SceneNode* lightNode = mSceneManager->getSceneNode(mapLightName + "_node");
-        Ogre::SceneNode* lightFlickerNode = mSceneManager->getSceneNode(mapLightName
-                                            + "_flicker_node");
+        Ogre::SceneNode* lightNode = curMapLight->getEntityNode();
+        Ogre::SceneNode* lightFlickerNode = curMapLight->getFlickerNode();
         lightFlickerNode->detachObject(light);
         mLightSceneNode->removeChild(lightNode);
         mSceneManager->destroyLight(light);
 
-        if (mSceneManager->hasEntity(mapLightName))
+        Ogre::Entity* mapLightIndicatorEntity = curMapLight->getOgreEntity();
+        if (mapLightIndicatorEntity != nullptr)
         {
-            Ogre::Entity* mapLightIndicatorEntity = mSceneManager->getEntity(
-                mapLightName);
             lightNode->detachObject(mapLightIndicatorEntity);
+            mSceneManager->destroyEntity(mapLightIndicatorEntity);
+            curMapLight->setOgreEntity(nullptr);
         }
-        mSceneManager->destroySceneNode(lightFlickerNode->getName());
-        mSceneManager->destroySceneNode(lightNode->getName());
+        mSceneManager->destroySceneNode(lightFlickerNode);
+        mSceneManager->destroySceneNode(lightNode);
+        curMapLight->setFlickerNode(nullptr);
+        curMapLight->setEntityNode(nullptr);
+        curMapLight->setParentSceneNode(nullptr);
     }
 }
 
 void RenderManager::rrDestroyMapLightVisualIndicator(MapLight* curMapLight)
 {
-    std::string mapLightName = curMapLight->getOgreNamePrefix() + curMapLight->getName();
-    if (mSceneManager->hasLight(mapLightName + "_light"))
-    {
-        Ogre::SceneNode* mapLightNode = mSceneManager->getSceneNode(mapLightName + "_node");
-        std::string mapLightIndicatorName = mapLightName;
-        if (mSceneManager->hasEntity(mapLightIndicatorName))
-        {
-            Ogre::Entity* mapLightIndicatorEntity = mSceneManager->getEntity(mapLightIndicatorName);
-            mapLightNode->detachObject(mapLightIndicatorEntity);
-            mSceneManager->destroyEntity(mapLightIndicatorEntity);
-            //NOTE: This line throws an error complaining 'scene node not found' that should not be happening.
-            //mSceneManager->destroySceneNode(node->getName());
-        }
-    }
+    Ogre::Entity* mapLightIndicatorEntity = curMapLight->getOgreEntity();
+    if (mapLightIndicatorEntity == nullptr)
+        return;
+
+    curMapLight->getEntityNode()->detachObject(mapLightIndicatorEntity);
+    mSceneManager->destroyEntity(mapLightIndicatorEntity);
+    curMapLight->setOgreEntity(nullptr);
 }
 
 void RenderManager::rrPickUpEntity(GameEntity* curEntity, Player* localPlayer)
 {
-    Ogre::Entity* ent = mSceneManager->getEntity("keeperHandEnt");
-    if(ent->hasAnimationState("Pickup"))
-        mHandAnimationState = setEntityAnimation(ent, "Pickup", false);
+    if(mHandKeeperEntity->hasAnimationState("Pickup"))
+        mHandAnimationState = setEntityAnimation(mHandKeeperEntity, "Pickup", false);
 
     // Detach the entity from its scene node
     Ogre::SceneNode* curEntityNode = curEntity->getEntityNode();
@@ -999,9 +1213,8 @@ void RenderManager::rrPickUpEntity(GameEntity* curEntity, Player* localPlayer)
 
 void RenderManager::rrDropHand(GameEntity* curEntity, Player* localPlayer)
 {
-    Ogre::Entity* ent = mSceneManager->getEntity("keeperHandEnt");
-    if(ent->hasAnimationState("Drop"))
-        mHandAnimationState = setEntityAnimation(ent, "Drop", false);
+    if(mHandKeeperEntity->hasAnimationState("Drop"))
+        mHandAnimationState = setEntityAnimation(mHandKeeperEntity, "Drop", false);
 
     // Detach the entity from the "hand" scene node
     Ogre::SceneNode* curEntityNode = curEntity->getEntityNode();
@@ -1044,8 +1257,7 @@ void RenderManager::rrRotateHand(Player* localPlayer)
     const std::vector<GameEntity*>& objectsInHand = localPlayer->getObjectsInHand();
     for (GameEntity* tmpEntity : objectsInHand)
     {
-        Ogre::SceneNode* tmpEntityNode = mSceneManager->getSceneNode(tmpEntity->getOgreNamePrefix() + tmpEntity->getName() + "_node");
-        tmpEntityNode->setPosition(static_cast<Ogre::Real>(i % 6 + 1), static_cast<Ogre::Real>(i / 6), static_cast<Ogre::Real>(0.0));
+        tmpEntity->getEntityNode()->setPosition(static_cast<Ogre::Real>(i % 6 + 1), static_cast<Ogre::Real>(i / 6), static_cast<Ogre::Real>(0.0));
         ++i;
     }
 }
@@ -1120,56 +1332,86 @@ void RenderManager::rrDestroySeatVisionVisualDebug(int seatId, Tile* tile)
     }
 }
 
-void RenderManager::rrSetObjectAnimationState(MovableGameEntity* curAnimatedObject, const std::string& animation, bool loop)
+void RenderManager::rrSetObjectAnimationState(MovableGameEntity* curAnimatedObject, EntityAnimation animation, bool loop)
 {
-    std::string objectName = curAnimatedObject->getOgreNamePrefix()
-        + curAnimatedObject->getName();
-    if (!mSceneManager->hasEntity(objectName))
+    Ogre::Entity* objectEntity = curAnimatedObject->getOgreEntity();
+    if (objectEntity == nullptr)
         return;
 
-    Ogre::Entity* objectEntity = mSceneManager->getEntity(objectName);
-
     // Can't animate entities without skeleton
     if (!objectEntity->hasSkeleton())
         return;
 
-    std::string anim = animation;
+    // The animation states are resolved once per animation and entity
+    bool isCached;
+    Ogre::AnimationState* animState = curAnimatedObject->getCachedAnimationState(animation, isCached);
+    if(!isCached)
+    {
+        animState = resolveAnimationState(objectEntity, animation);
+        curAnimatedObject->cacheAnimationState(animation, animState);
+    }
+
+    if (animState == nullptr)
+        return;
+
+    // Only the current animation state is enabled so there is no need to go through all the states
+    Ogre::AnimationState* prevAnimState = curAnimatedObject->getAnimationState();
+    if ((prevAnimState != nullptr) && (prevAnimState != animState))
+        prevAnimState->setEnabled(false);
+
+    // We we are not currently playing the animation or if we
+    // are not looped, we start the animation from the beginning
+    if (!animState->getEnabled() || !loop)
+        animState->setTimePosition(0);
+
+    animState->setLoop(loop);
+    animState->setEnabled(true);
+    curAnimatedObject->setAnimationState(animState);
+}
+
+Ogre::AnimationState* RenderManager::resolveAnimationState(Ogre::Entity* objectEntity, EntityAnimation animation)
+{
+    EntityAnimation anim = animation;
 
     // Handle the case where this entity does not have the requested animation.
-    while (!objectEntity->getSkeleton()->hasAnimation(anim))
+    while (!objectEntity->getSkeleton()->hasAnimation(entityAnimationToString(anim)))
     {
         // Try to change the unexisting animation to a close existing one.
-        if (anim == EntityAnimation::sleep_anim)
+        if (anim == EntityAnimation::sleep)
         {
-            anim = EntityAnimation::die_anim;
+            anim = EntityAnimation::die;
             continue;
         }
-        else if (anim == EntityAnimation::die_anim)
+        else if (anim == EntityAnimation::die)
         {
-            anim = EntityAnimation::idle_anim;
+            anim = EntityAnimation::idle;
             break;
         }
 
-        if (anim == EntityAnimation::flee_anim)
+        if (anim == EntityAnimation::flee)
         {
-            anim = EntityAnimation::walk_anim;
+            anim = EntityAnimation::walk;
         }
-        else if (anim == EntityAnimation::dig_anim || anim == EntityAnimation::claim_anim)
+        else if (anim == EntityAnimation::dig || anim == EntityAnimation::claim)
         {
-            anim = EntityAnimation::attack_anim;
+            anim = EntityAnimation::attack;
         }
         else
         {
-            anim = EntityAnimation::idle_anim;
+            anim = EntityAnimation::idle;
             break;
         }
     }
 
-    if (!objectEntity->getSkeleton()->hasAnimation(anim))
-        return;
+    const std::string& animName = entityAnimationToString(anim);
+    if (!objectEntity->getSkeleton()->hasAnimation(animName))
+        return nullptr;
 
-    Ogre::AnimationState* animState = setEntityAnimation(objectEntity, anim, loop);
-    curAnimatedObject->setAnimationState(animState);
+    Ogre::AnimationStateSet* animationSet = objectEntity->getAllAnimationStates();
+    if ((animationSet == nullptr) || !animationSet->hasAnimationState(animName))
+        return nullptr;
+
+    return animationSet->getAnimationState(animName);
 }
 void RenderManager::rrMoveEntity(GameEntity* entity, const Ogre::Vector3& position)
 {
@@ -1249,124 +1491,70 @@ std::string RenderManager::consoleListAnimationsForMesh(const std::string& meshN
     return ret;
 }
 
-void RenderManager::colourizeEntity(Ogre::Entity *ent, const Seat* seat, bool markedForDigging, bool playerHasVision)
+Ogre::ColourValue RenderManager::getTileMeshColour(const Seat* seat, bool markedForDigging, bool playerHasVision)
 {
-    // Colorize the the textures
-    // Loop over the sub entities in the mesh
-    for (unsigned int i = 0; i < ent->getNumSubEntities(); ++i)
+    // Digging marks take precedence over the seat colour and vision
+    if(markedForDigging)
+        return Ogre::ColourValue(1.0, 1.0, 0.0, 1.0);
+
+    Ogre::ColourValue color = Ogre::ColourValue::White;
+    if(seat != nullptr)
     {
-        Ogre::SubEntity *tempSubEntity = ent->getSubEntity(i);
+        color = seat->getColorValue();
+        color.a = 1.0;
+    }
 
-        std::string materialName = tempSubEntity->getMaterialName();
-        // If the material name have been modified, we restore the original name
-        std::size_t index = materialName.find("##");
-        if(index != std::string::npos)
-            materialName = materialName.substr(0, index);
+    if(!playerHasVision)
+        color *= 0.2;
 
-        materialName = colourizeMaterial(materialName, seat, markedForDigging, playerHasVision);
-        tempSubEntity->setMaterialName(materialName);
-    }
+    color.a = 1.0;
+    return color;
 }
 
-std::string RenderManager::colourizeMaterial(const std::string& materialName, const Seat* seat, bool markedForDigging, bool playerHasVision)
+const std::string& RenderManager::getVertexColourMaterial(const std::string& materialName)
 {
-    if (seat == nullptr && !markedForDigging && playerHasVision)
-        return materialName;
-
-    std::stringstream tempSS;
-
-    tempSS.str("");
-
-    tempSS << materialName << "##";
-
-    // Create the material name.
-    if(seat != nullptr)
-        tempSS << "Color_" << seat->getColorId() << "_" ;
-    else
-        tempSS << "Color_null_" ;
-
-    if (markedForDigging)
-        tempSS << "dig_";
-    else if(!playerHasVision)
-        tempSS << "novision_";
-
-    Ogre::MaterialPtr requestedMaterial = Ogre::MaterialManager::getSingleton().getByName(tempSS.str());
-
-    //cout << "\nCloning material:  " << tempSS.str();
-
-    // If this texture has been copied and colourized, we can return
-    if (!requestedMaterial.isNull())
-        return tempSS.str();
-
-    // If not yet, then do so
-
-    // Check to see if we find a seat with the requested color, if not then just use the original, uncolored material.
-    if (seat == nullptr && !markedForDigging && playerHasVision)
-        return materialName;
-
-    Ogre::MaterialPtr oldMaterial = Ogre::MaterialManager::getSingleton().getByName(materialName);
+    auto it = mVertexColourMaterials.find(materialName);
+    if(it != mVertexColourMaterials.end())
+        return it->second;
 
-    //std::cout << "\nMaterial does not exist, creating a new one.";
-    Ogre::MaterialPtr newMaterial = oldMaterial->clone(tempSS.str());
-    bool cloned = mShaderGenerator->cloneShaderBasedTechniques(oldMaterial->getName(), oldMaterial->getGroup(),
-                                                 newMaterial->getName(), newMaterial->getGroup());
-    if(!cloned)
-    {
-        OD_LOG_ERR("Failed to clone rtss for material: " + materialName);
-    }
-
-    // Loop over the techniques for the new material
-    for (unsigned int j = 0; j < newMaterial->getNumTechniques(); ++j)
+    std::string vertexColourName = materialName + "##VertexColour";
+    Ogre::MaterialPtr newMaterial = Ogre::MaterialManager::getSingleton().getByName(vertexColourName);
+    if(newMaterial.isNull())
     {
-        Ogre::Technique* technique = newMaterial->getTechnique(j);
-        if (technique->getNumPasses() == 0)
-            continue;
-
-        if (markedForDigging)
+        Ogre::MaterialPtr oldMaterial = Ogre::MaterialManager::getSingleton().getByName(materialName);
+        if(oldMaterial.isNull())
         {
-            // Color the material with yellow on the latest pass
-            // so we're sure to see the taint.
-            Ogre::ColourValue color(1.0, 1.0, 0.0, 1.0);
-            for (uint16_t i = 0; i < technique->getNumPasses(); ++i)
-            {
-                Ogre::Pass* pass = technique->getPass(i);
-                pass->setSpecular(color);
-                pass->setAmbient(color);
-                pass->setDiffuse(color);
-                pass->setEmissive(color);
-            }
+            OD_LOG_ERR("Cannot find material: " + materialName);
+            return mVertexColourMaterials[materialName] = materialName;
         }
-        else if(!playerHasVision)
+
+        newMaterial = oldMaterial->clone(vertexColourName);
+        bool cloned = mShaderGenerator->cloneShaderBasedTechniques(oldMaterial->getName(), oldMaterial->getGroup(),
+                                                     newMaterial->getName(), newMaterial->getGroup());
+        if(!cloned)
         {
-            // Color the material with dark color on the latest pass
-            // so we're sure to see the taint.
-            Ogre::Pass* pass = technique->getPass(0);
-            Ogre::ColourValue color(0.2, 0.2, 0.2, 1.0);
-            pass->setSpecular(color);
-            pass->setAmbient(color);
-            pass->setDiffuse(color);
+            OD_LOG_ERR("Failed to clone rtss for material: " + materialName);
         }
-        if (seat != nullptr)
+
+        // The ambient and diffuse colours are taken from the vertices. The RTSS generates its
+        // shaders according to the tracking flags
+        for (unsigned int j = 0; j < newMaterial->getNumTechniques(); ++j)
         {
-            // Color the material with the Seat's color.
-            Ogre::Pass* pass = technique->getPass(technique->getNumPasses() - 1);
-            Ogre::ColourValue color = seat->getColorValue();
-            color.a = 1.0;
-            pass->setAmbient(color);
-            pass->setDiffuse(color);
-            pass->setSpecular(color);
+            Ogre::Technique* technique = newMaterial->getTechnique(j);
+            for (uint16_t i = 0; i < technique->getNumPasses(); ++i)
+                technique->getPass(i)->setVertexColourTracking(Ogre::TVC_AMBIENT | Ogre::TVC_DIFFUSE);
         }
+        mShaderGenerator->invalidateMaterial(Ogre::RTShader::ShaderGenerator::DEFAULT_SCHEME_NAME,
+            newMaterial->getName(), newMaterial->getGroup());
     }
 
-    return tempSS.str();
+    return mVertexColourMaterials[materialName] = vertexColourName;
 }
 
 void RenderManager::rrCarryEntity(Creature* carrier, GameEntity* carried)
 {
-    Ogre::Entity* carrierEnt = mSceneManager->getEntity(carrier->getOgreNamePrefix() + carrier->getName());
-    Ogre::Entity* carriedEnt = mSceneManager->getEntity(carried->getOgreNamePrefix() + carried->getName());
-    Ogre::SceneNode* carrierNode = mSceneManager->getSceneNode(carrierEnt->getName() + "_node");
-    Ogre::SceneNode* carriedNode = mSceneManager->getSceneNode(carriedEnt->getName() + "_node");
+    Ogre::SceneNode* carrierNode = carrier->getEntityNode();
+    Ogre::SceneNode* carriedNode = carried->getEntityNode();
     carried->setParentNodeDetachFlags(
         EntityParentNodeAttach::DETACH_CARRIED, true);
     carriedNode->setInheritScale(false);
@@ -1377,10 +1565,8 @@ void RenderManager::rrCarryEntity(Creature* carrier, GameEntity* carried)
 
 void RenderManager::rrReleaseCarriedEntity(Creature* carrier, GameEntity* carried)
 {
-    Ogre::Entity* carrierEnt = mSceneManager->getEntity(carrier->getOgreNamePrefix() + carrier->getName());
-    Ogre::Entity* carriedEnt = mSceneManager->getEntity(carried->getOgreNamePrefix() + carried->getName());
-    Ogre::SceneNode* carrierNode = mSceneManager->getSceneNode(carrierEnt->getName() + "_node");
-    Ogre::SceneNode* carriedNode = mSceneManager->getSceneNode(carriedEnt->getName() + "_node");
+    Ogre::SceneNode* carrierNode = carrier->getEntityNode();
+    Ogre::SceneNode* carriedNode = carried->getEntityNode();
     carrierNode->removeChild(carriedNode);
     carried->setParentNodeDetachFlags(
         EntityParentNodeAttach::DETACH_CARRIED, false);
@@ -1390,13 +1576,99 @@ void RenderManager::rrReleaseCarriedEntity(Creature* carrier, GameEntity* carrie
 void RenderManager::rrSetCreaturesTextOverlay(GameMap& gameMap, bool value)
 {
     mCreatureTextOverlayDisplayed = value;
+    mCreatureOverlayTimers.clear();
     for(Creature* creature : gameMap.getCreatures())
         creature->getOverlayStatus()->displayHealthOverlay(mCreatureTextOverlayDisplayed ? -1.0 : 0.0);
 }
 
+void RenderManager::updateCreatureOverlays(const GameMap& gameMap, Ogre::Real timeSinceLastFrame)
+{
+    // The temporary overlays are hidden when their time is over, even if the creature is not on screen
+    for(std::size_t i = 0; i < mCreatureOverlayTimers.size();)
+    {
+        CreatureOverlayTimer& timer = mCreatureOverlayTimers[i];
+        if(timer.mTimeLeft > timeSinceLastFrame)
+        {
+            timer.mTimeLeft -= timeSinceLastFrame;
+            ++i;
+            continue;
+        }
+
+        timer.mOverlayStatus->displayHealthOverlay(0.0);
+        timer = mCreatureOverlayTimers.back();
+        mCreatureOverlayTimers.pop_back();
+    }
+
+    // We only go through the creatures on the tiles that are not culled
+    std::vector<CreatureOverlayStatus*> overlaysOnScreen;
+    MovableTextOverlayView view(*mViewport->getCamera());
+    for(std::size_t chunkIndex = 0; chunkIndex < mTileChunks.size(); ++chunkIndex)
+    {
+        const TileChunk& chunk = mTileChunks[chunkIndex];
+        if((chunk.mGeometry == nullptr) || (chunk.mNbCulledTiles >= chunk.mNbTiles))
+            continue;
+
+        int originX = static_cast<int>(chunkIndex % mNbTileChunksX) * TILE_CHUNK_SIZE;
+        int originY = static_cast<int>(chunkIndex / mNbTileChunksX) * TILE_CHUNK_SIZE;
+        for(int index = 0; index < TILE_CHUNK_SIZE * TILE_CHUNK_SIZE; ++index)
+        {
+            const TileMeshData& data = chunk.mTiles[index];
+            if(!data.mIsCreated || data.mIsCulled)
+                continue;
+
+            Tile* tile = gameMap.getTile(originX + (index % TILE_CHUNK_SIZE), originY + (index / TILE_CHUNK_SIZE));
+            if(tile == nullptr)
+                continue;
+
+            for(GameEntity* entity : tile->getEntitiesInTile())
+            {
+                if(entity->getObjectType() != GameEntityType::creature)
+                    continue;
+
+                CreatureOverlayStatus* overlayStatus = static_cast<Creature*>(entity)->getOverlayStatus();
+                if(overlayStatus == nullptr)
+                    continue;
+
+                overlayStatus->update(timeSinceLastFrame, &view);
+                overlaysOnScreen.push_back(overlayStatus);
+            }
+        }
+    }
+
+    // The creatures that left the visible tiles since the last frame (moved, picked up, culled, ...)
+    // get their overlays hidden
+    std::sort(overlaysOnScreen.begin(), overlaysOnScreen.end());
+    std::vector<CreatureOverlayStatus*> overlaysHidden;
+    std::set_difference(mCreatureOverlaysOnScreen.begin(), mCreatureOverlaysOnScreen.end(),
+        overlaysOnScreen.begin(), overlaysOnScreen.end(), std::back_inserter(overlaysHidden));
+    for(CreatureOverlayStatus* overlayStatus : overlaysHidden)
+        overlayStatus->update(timeSinceLastFrame, nullptr);
+
+    mCreatureOverlaysOnScreen.swap(overlaysOnScreen);
+}
+
 void RenderManager::rrTemporaryDisplayCreaturesTextOverlay(Creature* creature, Ogre::Real timeToDisplay)
 {
-    creature->getOverlayStatus()->displayHealthOverlay(timeToDisplay);
+    CreatureOverlayStatus* overlayStatus = creature->getOverlayStatus();
+    if(overlayStatus == nullptr)
+        return;
+
+    // When the overlays are toggled on, they are already displayed
+    if(mCreatureTextOverlayDisplayed)
+        return;
+
+    overlayStatus->displayHealthOverlay(-1.0);
+    for(CreatureOverlayTimer& timer : mCreatureOverlayTimers)
+    {
+        if(timer.mOverlayStatus != overlayStatus)
+            continue;
+
+        timer.mTimeLeft = std::max(timer.mTimeLeft, timeToDisplay);
+        return;
+    }
+
+    CreatureOverlayTimer timer = { overlayStatus, timeToDisplay };
+    mCreatureOverlayTimers.push_back(timer);
 }
 
 void RenderManager::rrToggleHandSelectorVisibility()
@@ -1530,9 +1802,8 @@ void RenderManager::moveWorldCoords(Ogre::Real x, Ogre::Real y)
 
 void RenderManager::entitySlapped()
 {
-    Ogre::Entity* ent = mSceneManager->getEntity("keeperHandEnt");
-    if(ent->hasAnimationState("Slap"))
-        mHandAnimationState = setEntityAnimation(ent, "Slap", false);
+    if(mHandKeeperEntity->hasAnimationState("Slap"))
+        mHandAnimationState = setEntityAnimation(mHandKeeperEntity, "Slap", false);
 }
 
 std::string RenderManager::rrBuildSkullFlagMaterial(const std::string& materialNameBase,
@@ -25,7 +25,14 @@
 #include <string>
 #include <OgreSingleton.h>
 #include <OgreMath.h>
+#include <OgreColourValue.h>
+#include <OgreQuaternion.h>
+#include <OgreVector2.h>
+#include <OgreVector3.h>
 #include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
 
 class GameMap;
 class Building;
@@ -35,13 +42,18 @@ class GameEntity;
 class MovableGameEntity;
 class MapLight;
 class Creature;
+class CreatureOverlayStatus;
 class Player;
 class RenderedMovableEntity;
 class Weapon;
 
+enum class EntityAnimation : uint8_t;
+
 namespace Ogre
 {
 class AnimationState;
+class ManualObject;
+class Overlay;
 class OverlaySystem;
 class SceneManager;
 class SceneNode;
@@ -60,12 +72,25 @@ public:
 
     static const uint8_t OD_RENDER_QUEUE_ID_GUI;
 
+    //! \brief Number of tiles on each side of a tile chunk. Tiles are batched and culled by chunk
+    static const int TILE_CHUNK_SIZE;
+
     inline Ogre::SceneManager* getSceneManager() const
     { return mSceneManager; }
 
     //! \brief Loop through the render requests in the queue and process them
     void updateRenderAnimations(Ogre::Real timeSinceLastFrame);
 
+    //! \brief Rebuilds the visible tile chunks that have been changed since the last call. Should
+    //! be called once per frame
+    void updateTileChunks();
+
+    //! \brief Number of tile chunks currently created and number of chunks rebuilt during
+    //! the last updateTileChunks
+    uint32_t getNbTileChunks() const;
+    inline uint32_t getNbTileChunksBuilt() const
+    { return mNbTileChunksBuilt; }
+
     //! \brief Initialize the renderer when a new game (Game or Editor) is launched
     void initGameRenderer(GameMap* gameMap);
     void stopGameRenderer(GameMap* gameMap);
@@ -99,6 +124,9 @@ public:
     void rrRefreshTile(const Tile& tile, const GameMap& gameMap, const Player& localPlayer);
     void rrCreateTile(Tile& tile, const GameMap& gameMap, const Player& localPlayer);
     void rrDestroyTile(Tile& tile);
+    //! \brief Called when the culling state of the given tile changes. The tile chunk is hidden
+    //! when all its tiles are culled
+    void rrSetTileCulled(const Tile& tile, bool culled);
     void rrTemporalMarkTile(Tile* curTile);
     void rrDetachEntity(GameEntity* curEntity);
     void rrAttachEntity(GameEntity* curEntity);
@@ -109,8 +137,10 @@ public:
     void rrDestroyCreature(Creature* curCreature);
     void rrOrientEntityToward(MovableGameEntity* gameEntity, const Ogre::Vector3& direction);
     void rrScaleCreature(Creature& creature);
-    void rrCreateWeapon(Creature* curCreature, const Weapon* curWeapon, const std::string& hand);
-    void rrDestroyWeapon(Creature* curCreature, const Weapon* curWeapon, const std::string& hand);
+    //! \brief Attaches the weapon to the creature hand bone. Returns the weapon entity (to be given to
+    //! rrDestroyWeapon) or nullptr if the creature mesh has no bone for this hand
+    Ogre::Entity* rrCreateWeapon(Creature* curCreature, const Weapon* curWeapon, const std::string& hand);
+    void rrDestroyWeapon(Ogre::Entity* weaponEntity);
     void rrCreateMapLight(MapLight* curMapLight, bool displayVisual);
     void rrDestroyMapLight(MapLight* curMapLight);
     void rrDestroyMapLightVisualIndicator(MapLight* curMapLight);
@@ -121,7 +151,7 @@ public:
     void rrDestroyCreatureVisualDebug(Creature* curCreature, Tile* curTile);
     void rrCreateSeatVisionVisualDebug(int seatId, Tile* tile);
     void rrDestroySeatVisionVisualDebug(int seatId, Tile* tile);
-    void rrSetObjectAnimationState(MovableGameEntity* curAnimatedObject, const std::string& animation, bool loop);
+    void rrSetObjectAnimationState(MovableGameEntity* curAnimatedObject, EntityAnimation animation, bool loop);
     void rrMoveEntity(GameEntity* entity, const Ogre::Vector3& position);
     void rrMoveMapLightFlicker(MapLight* mapLight, const Ogre::Vector3& position);
     void rrCarryEntity(Creature* carrier, GameEntity* carried);
@@ -134,6 +164,11 @@ public:
     //! \brief Toggles the creatures text overlay
     void rrSetCreaturesTextOverlay(GameMap& gameMap, bool value);
 
+    //! \brief Moves the creatures text overlays. Only the creatures on the visible tile chunks are
+    //! updated, with the camera projection computed once for all of them. The overlays of the
+    //! creatures that left the visible chunks are hidden. Should be called once per frame
+    void updateCreatureOverlays(const GameMap& gameMap, Ogre::Real timeSinceLastFrame);
+
     //! \brief Toggles the creatures text overlay
     void rrTemporaryDisplayCreaturesTextOverlay(Creature* creature, Ogre::Real timeToDisplay);
 
@@ -176,22 +211,95 @@ public:
     const Ogre::Vector3& getMenuEntityScale(Ogre::SceneNode* node);
 
 private:
+    //! \brief What is displayed on a tile. The tile meshes are not rendered as separate entities
+    //! but copied in the geometry of their chunk. The materials are the untinted ones: the seat
+    //! colour, digging mark and vision are given by the colour written in the vertices
+    struct TileMeshData
+    {
+        TileMeshData() :
+            mIsCreated(false),
+            mIsCulled(false),
+            mTileMeshColour(Ogre::ColourValue::White),
+            mCustomMeshColour(Ogre::ColourValue::White)
+        {}
+
+        bool mIsCreated;
+        bool mIsCulled;
+        std::string mTileMeshName;
+        Ogre::Quaternion mTileMeshOrientation;
+        std::vector<std::string> mTileMeshMaterials;
+        Ogre::ColourValue mTileMeshColour;
+        std::string mCustomMeshName;
+        std::vector<std::string> mCustomMeshMaterials;
+        Ogre::ColourValue mCustomMeshColour;
+    };
+
+    //! \brief Square of TILE_CHUNK_SIZE tiles rendered as one manual object with one section
+    //! per material. The geometry is rebuilt only when one of its tiles changes
+    struct TileChunk
+    {
+        TileChunk() :
+            mNode(nullptr),
+            mGeometry(nullptr),
+            mNbTiles(0),
+            mNbCulledTiles(0),
+            mIsDirty(false)
+        {}
+
+        Ogre::SceneNode* mNode;
+        Ogre::ManualObject* mGeometry;
+        std::vector<TileMeshData> mTiles;
+        uint32_t mNbTiles;
+        uint32_t mNbCulledTiles;
+        bool mIsDirty;
+    };
+
+    struct TileMeshVertex
+    {
+        Ogre::Vector3 mPosition;
+        Ogre::Vector3 mNormal;
+        Ogre::Vector3 mTangent;
+        Ogre::Vector2 mTexCoord;
+    };
+
+    //! \brief Triangle list of a sub mesh read back from the mesh buffers
+    struct TileSubMesh
+    {
+        std::string mMaterial;
+        std::vector<TileMeshVertex> mVertices;
+        std::vector<uint32_t> mIndices;
+    };
+
+    //! \brief Copy of a mesh used to fill the tile chunks. mMaterials are the original
+    //! materials of the sub meshes
+    struct TileMeshPrototype
+    {
+        std::vector<TileSubMesh> mSubMeshes;
+        std::vector<std::string> mMaterials;
+    };
+
+    //! \brief Returns the chunk containing the given tile or nullptr if there is none
+    TileChunk* getTileChunk(int tileX, int tileY);
+    static int getTileIndexInChunk(int tileX, int tileY);
+    void buildTileChunk(TileChunk& chunk);
+    void destroyTileChunks();
+    const TileMeshPrototype& getTileMeshPrototype(const std::string& meshName);
+    //! \brief Copies the triangles of the given sub mesh from the hardware buffers
+    static void readTileSubMesh(const Ogre::MeshPtr& mesh, uint16_t subMeshIndex, TileSubMesh& subMesh);
+
     //! \brief Correctly places entities in hand next to the keeper hand
     void changeRenderQueueRecursive(Ogre::SceneNode* node, uint8_t renderQueueId);
 
     //! \brief Correctly places entities in hand next to the keeper hand
     void rrOrderHand(Player* localPlayer);
 
-    //! \brief Colorize the material with the corresponding team id color.
-    //! \note If the material (wall tiles only) is marked for digging, a yellow color is added
-    //! to the given color.
-    //! \returns The new material name according to the current colorization.
-    std::string colourizeMaterial(const std::string& materialName, const Seat* seat, bool markedForDigging, bool playerHasVision);
+    //! \brief Returns the colour to write in the vertices of a tile mesh. The seat colour is used
+    //! if seat is not nullptr. Tiles marked for digging are yellow and tiles without vision are darkened.
+    static Ogre::ColourValue getTileMeshColour(const Seat* seat, bool markedForDigging, bool playerHasVision);
 
-    //! \brief Colorize an entity with the team corresponding color.
-    //! \Note: if the entity is marked for digging (wall tiles only), then a yellow color
-    //! is added to the current colorization.
-    void colourizeEntity(Ogre::Entity* ent, const Seat* seat, bool markedForDigging, bool playerHasVision);
+    //! \brief Returns the name of the clone of the given material taking its ambient and diffuse
+    //! colours from the vertices. The clone is created the first time it is requested
+    const std::string& getVertexColourMaterial(const std::string& materialName);
 
     //! \brief Makes the material be transparent with the given opacity (0.0f - 1.0f)
     //! \returns The new material name according to the current opacity.
@@ -200,6 +308,10 @@ private:
     //! \brief Disables all animations of the given entity and starts the given one
     Ogre::AnimationState* setEntityAnimation(Ogre::Entity* ent, const std::string& animation, bool loop);
 
+    //! \brief Returns the animation state to use for the given animation. If the entity does not
+    //! have it, a close one is used. Returns nullptr if none can be used
+    Ogre::AnimationState* resolveAnimationState(Ogre::Entity* objectEntity, EntityAnimation animation);
+
     //! \brief The main scene manager reference. Don't delete it.
     Ogre::SceneManager* mSceneManager;
 
@@ -217,6 +329,7 @@ private:
 
     //! For the keeper hand
     Ogre::SceneNode* mHandKeeperNode;
+    Ogre::Entity* mHandKeeperEntity;
     Ogre::Light* mHandLight;
     Ogre::Radian mCurrentFOVy;
     Ogre::Real mFactorWidth;
@@ -230,8 +343,35 @@ private:
     //! \brief True if the creatures are currently displaying their text overlay
     bool mCreatureTextOverlayDisplayed;
 
+    //! \brief Overlay containing the text overlays of every creature. Don't delete it.
+    Ogre::Overlay* mCreatureOverlay;
+
+    //! \brief Health overlay temporarily displayed for a creature
+    struct CreatureOverlayTimer
+    {
+        CreatureOverlayStatus* mOverlayStatus;
+        Ogre::Real mTimeLeft;
+    };
+
+    //! \brief Timers of the temporarily displayed health overlays. They run whether the creature
+    //! is on screen or not
+    std::vector<CreatureOverlayTimer> mCreatureOverlayTimers;
+
+    //! \brief Creature overlays updated during the last frame, sorted
+    std::vector<CreatureOverlayStatus*> mCreatureOverlaysOnScreen;
+
     //! Bit array to allow to display tile hand (= 0) or not (!= 0)
     uint32_t mHandKeeperHandVisibility;
+
+    //! \brief Tile chunks of the current map, row by row
+    std::vector<TileChunk> mTileChunks;
+    int mNbTileChunksX;
+    uint32_t mNbTileChunksBuilt;
+
+    std::map<std::string, TileMeshPrototype> mTileMeshPrototypes;
+
+    //! \brief Vertex colour clone of each material used by the tile chunks
+    std::unordered_map<std::string, std::string> mVertexColourMaterials;
 };
 
 #endif // RENDERMANAGER_H
@@ -42,7 +42,10 @@
 
 Room::Room(GameMap* gameMap):
     Building(gameMap),
-    mNumActiveSpots(0)
+    mNumActiveSpots(0),
+    mSeatGoldCounted(nullptr),
+    mGoldCounted(0),
+    mGoldMaxCounted(0)
 {
 }
 
@@ -66,6 +69,7 @@ void Room::addToGameMap()
 {
     getGameMap()->addRoom(this);
     getGameMap()->addActiveObject(this);
+    setSeatGoldCounted(getSeat());
 }
 
 void Room::removeFromGameMap()
@@ -83,6 +87,7 @@ void Room::removeFromGameMap()
 
     removeAllBuildingObjects();
     getGameMap()->removeActiveObject(this);
+    setSeatGoldCounted(nullptr);
 }
 
 void Room::absorbRoom(Room *r)
@@ -131,6 +136,9 @@ void Room::absorbRoom(Room *r)
     r->mCoveredTilesDestroyed.insert(r->mCoveredTilesDestroyed.end(), r->mCoveredTiles.begin(), r->mCoveredTiles.end());
     r->mCoveredTiles.clear();
 
+    updateSeatGoldCounters();
+    r->updateSeatGoldCounters();
+
     // We fire the dead event so that if there are creatures heading for this room or
     // whatever, we release them before the remove from gamemap event
     r->fireEntityDead();
@@ -141,7 +149,7 @@ void Room::handleCreatureUsingAbsorbedRoom(Creature& creature)
     // If the job room is absorbed, we force the creatures working in the old rooms to search
     // a job. If there is space in the new one, they will use it. If not, they
     // will do something else
-    creature.clearDestinations(EntityAnimation::idle_anim, true, true);
+    creature.clearDestinations(EntityAnimation::idle, true, true);
     creature.clearActionQueue();
     creature.pushAction(Utils::make_unique<CreatureActionSearchJob>(creature, true));
 }
@@ -674,6 +682,7 @@ void Room::repairRoom()
         tile->setCoveringBuilding(this);
     }
 
+    updateSeatGoldCounters();
     updateActiveSpots();
 }
 
@@ -691,6 +700,34 @@ bool Room::sortForMapSave(Room* r1, Room* r2)
     return r1->getName().compare(r2->getName()) < 0;
 }
 
+void Room::updateSeatGoldCounters()
+{
+    // If the room is not counted, it is not on the gamemap
+    if(mSeatGoldCounted == nullptr)
+        return;
+
+    setSeatGoldCounted(getSeat());
+}
+
+void Room::setSeatGoldCounted(Seat* seat)
+{
+    if(!getIsOnServerMap())
+        return;
+
+    if(mSeatGoldCounted != nullptr)
+        mSeatGoldCounted->updateGoldCounters(-mGoldCounted, -mGoldMaxCounted);
+
+    mSeatGoldCounted = seat;
+    mGoldCounted = 0;
+    mGoldMaxCounted = 0;
+    if(mSeatGoldCounted == nullptr)
+        return;
+
+    mGoldCounted = getTotalGoldStored();
+    mGoldMaxCounted = getTotalGoldStorage();
+    mSeatGoldCounted->updateGoldCounters(mGoldCounted, mGoldMaxCounted);
+}
+
 void Room::fireRoomSound(Tile& tile, const std::string& soundFamily)
 {
     std::string sound = "Rooms/" + soundFamily;
@@ -168,10 +168,24 @@ protected:
 
     //! \brief This function will be called when reordering room is needed (for example if another room has been absorbed)
     static void reorderRoomTiles(std::vector<Tile*>& tiles);
+
+    //! \brief Should be called when the gold stored in the room or its storage changes so that
+    //! the owning seat counters are kept up to date. Used on server side only
+    void updateSeatGoldCounters();
 private :
     void activeSpotCheckChange(ActiveSpotPlace place, const std::vector<Tile*>& originalSpotTiles,
         const std::vector<Tile*>& newSpotTiles);
 
+    //! \brief Removes the gold counted by this room from mSeatGoldCounted and adds the current
+    //! gold to the given seat (if not null)
+    void setSeatGoldCounted(Seat* seat);
+
+    //! \brief Seat whose gold counters include this room and the values that were added to them.
+    //! Used on server side only
+    Seat* mSeatGoldCounted;
+    int mGoldCounted;
+    int mGoldMaxCounted;
+
 };
 
 #endif // ROOM_H
@@ -251,7 +251,7 @@ bool RoomArena::useRoom(Creature& creature, bool forced)
             return false;
         }
 
-        uint32_t index = Random::Uint(0, tiles.size() - 1);
+        uint32_t index = Random::getGenerator(RandomStream::room).Uint(0, tiles.size() - 1);
         Tile* tile = tiles[index];
         if(!creature.setDestination(tile))
         {
@@ -279,25 +279,25 @@ BuildingObject* RoomArena::notifyActiveSpotCreated(ActiveSpotPlace place, Tile*
         case ActiveSpotPlace::activeSpotLeft:
         {
             x -= OFFSET_DUMMY;
-            std::string meshName = Random::Int(1, 2) > 1 ? "WeaponShield2" : "WeaponShield1";
+            std::string meshName = Random::getGenerator(RandomStream::room).Int(1, 2) > 1 ? "WeaponShield2" : "WeaponShield1";
             return new BuildingObject(getGameMap(), *this, meshName, tile, x, y, z, 90.0, false);
         }
         case ActiveSpotPlace::activeSpotRight:
         {
             x += OFFSET_DUMMY;
-            std::string meshName = Random::Int(1, 2) > 1 ? "WeaponShield2" : "WeaponShield1";
+            std::string meshName = Random::getGenerator(RandomStream::room).Int(1, 2) > 1 ? "WeaponShield2" : "WeaponShield1";
             return new BuildingObject(getGameMap(), *this, meshName, tile, x, y, z, 270.0, false);
         }
         case ActiveSpotPlace::activeSpotTop:
         {
             y += OFFSET_DUMMY;
-            std::string meshName = Random::Int(1, 2) > 1 ? "WeaponShield2" : "WeaponShield1";
+            std::string meshName = Random::getGenerator(RandomStream::room).Int(1, 2) > 1 ? "WeaponShield2" : "WeaponShield1";
             return new BuildingObject(getGameMap(), *this, meshName, tile, x, y, z, 0.0, false);
         }
         case ActiveSpotPlace::activeSpotBottom:
         {
             y -= OFFSET_DUMMY;
-            std::string meshName = Random::Int(1, 2) > 1 ? "WeaponShield2" : "WeaponShield1";
+            std::string meshName = Random::getGenerator(RandomStream::room).Int(1, 2) > 1 ? "WeaponShield2" : "WeaponShield1";
             return new BuildingObject(getGameMap(), *this, meshName, tile, x, y, z, 180.0, false);
         }
         default:
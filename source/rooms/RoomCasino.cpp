@@ -131,7 +131,7 @@ BuildingObject* RoomCasino::notifyActiveSpotCreated(ActiveSpotPlace place, Tile*
             Ogre::Real y = static_cast<Ogre::Real>(tile->getY());
             Ogre::Real z = 0;
             mCreaturesSpots.emplace(std::make_pair(tile, RoomCasinoGame()));
-            if(Random::Uint(0,9) < 5)
+            if(Random::getGenerator(RandomStream::room).Uint(0,9) < 5)
                 return new BuildingObject(getGameMap(), *this, "CasinoPokerTable", tile, x, y, z, 0.0, false);
             else
                 return new BuildingObject(getGameMap(), *this, "Roulette", tile, x, y, z, 0.0, false);
@@ -370,12 +370,12 @@ void RoomCasino::doUpkeep()
             return;
         }
 
-        ro->setAnimationState("Triggered", false);
+        ro->setAnimationState(EntityAnimation::triggered, false);
 
         // TODO: we could use the wall active spots to change feePercent/bets
 
         // We set anim for both creatures
-        uint32_t cooldown = Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("CasinoCooldownWorkMin"),
+        uint32_t cooldown = Random::getGenerator(RandomStream::room).Uint(ConfigManager::getSingleton().getRoomConfigUInt32("CasinoCooldownWorkMin"),
             ConfigManager::getSingleton().getRoomConfigUInt32("CasinoCooldownWorkMax"));
         double feePercent = std::min(ConfigManager::getSingleton().getRoomConfigDouble("CasinoFee"), 1.0);
         double wakefullness = ConfigManager::getSingleton().getRoomConfigDouble("CasinoWakefulnessPerWork");
@@ -409,7 +409,7 @@ void RoomCasino::doUpkeep()
         // We give the total amount to the winning creature
         double totalWinPercent = creature1RoomAffinity.getEfficiency()
                 + creature2RoomAffinity.getEfficiency();
-        if(Random::Double(0, totalWinPercent) <= creature1RoomAffinity.getEfficiency())
+        if(Random::getGenerator(RandomStream::room).Double(0, totalWinPercent) <= creature1RoomAffinity.getEfficiency())
         {
             setCreatureWinning(*p.second.mCreature1.mCreature, ro->getPosition());
             setCreatureLoosing(*p.second.mCreature2.mCreature, ro->getPosition());
@@ -479,7 +479,7 @@ bool RoomCasino::useRoom(Creature& creature, bool forced)
         Creature* opponent = opponentInfo->mCreature;
         creature.popAction();
         // We randomly engage the creature we are playing with if any
-        if((opponent != nullptr) && (Random::Uint(0,100) <= 50))
+        if((opponent != nullptr) && (Random::getGenerator(RandomStream::room).Uint(0,100) <= 50))
         {
             // We fight for KO
             // We notify the player that his own creatures are fighting
@@ -515,7 +515,7 @@ bool RoomCasino::useRoom(Creature& creature, bool forced)
         // We add the last step to take account of the offset
         Ogre::Vector3 dest(wantedX, wantedY, 0.0);
         path.push_back(dest);
-        creature.setWalkPath(EntityAnimation::walk_anim, EntityAnimation::idle_anim, true, true, path);
+        creature.setWalkPath(EntityAnimation::walk, EntityAnimation::idle, true, true, path);
         return false;
     }
 
@@ -529,7 +529,7 @@ bool RoomCasino::useRoom(Creature& creature, bool forced)
             return false;
         }
 
-        uint32_t index = Random::Uint(0, tiles.size() - 1);
+        uint32_t index = Random::getGenerator(RandomStream::room).Uint(0, tiles.size() - 1);
         Tile* tile = tiles[index];
         creature.setDestination(tile);
         creatureInfo->mIsReady = false;
@@ -545,12 +545,12 @@ void RoomCasino::setCreatureWinning(Creature& creature, const Ogre::Vector3& gam
 {
     Ogre::Vector3 walkDirection(gamePosition.x - creature.getPosition().x, gamePosition.y - creature.getPosition().y, static_cast<Ogre::Real>(0));
     walkDirection.normalise();
-    creature.setAnimationState(EntityAnimation::attack_anim, false, walkDirection);
+    creature.setAnimationState(EntityAnimation::attack, false, walkDirection);
 }
 
 void RoomCasino::setCreatureLoosing(Creature& creature, const Ogre::Vector3& gamePosition)
 {
     Ogre::Vector3 walkDirection(gamePosition.x - creature.getPosition().x, gamePosition.y - creature.getPosition().y, static_cast<Ogre::Real>(0));
     walkDirection.normalise();
-    creature.setAnimationState(EntityAnimation::idle_anim, false, walkDirection);
+    creature.setAnimationState(EntityAnimation::idle, false, walkDirection);
 }
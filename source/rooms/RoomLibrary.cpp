@@ -134,7 +134,7 @@ BuildingObject* RoomLibrary::notifyActiveSpotCreated(ActiveSpotPlace place, Tile
             Ogre::Real z = 0;
             y += OFFSET_SPOT;
             mUnusedSpots.push_back(tile);
-            if (Random::Int(0, 100) > 50)
+            if (Random::getGenerator(RandomStream::room).Int(0, 100) > 50)
                 return new BuildingObject(getGameMap(), *this, "Podium", tile, x, y, z, 45.0, false);
             else
                 return new BuildingObject(getGameMap(), *this, "Bookcase", tile, x, y, z, 45.0, false);
@@ -228,7 +228,7 @@ bool RoomLibrary::addCreatureUsingRoom(Creature* creature)
     if(!Room::addCreatureUsingRoom(creature))
         return false;
 
-    int index = Random::Int(0, mUnusedSpots.size() - 1);
+    int index = Random::getGenerator(RandomStream::room).Int(0, mUnusedSpots.size() - 1);
     Tile* tileSpot = mUnusedSpots[index];
     mUnusedSpots.erase(mUnusedSpots.begin() + index);
     mCreaturesSpots[creature] = tileSpot;
@@ -252,7 +252,7 @@ bool RoomLibrary::addCreatureUsingRoom(Creature* creature)
         // We add the last step to take account of the offset
         Ogre::Vector3 dest(wantedX, wantedY, 0.0);
         path.push_back(dest);
-        creature->setWalkPath(EntityAnimation::walk_anim, EntityAnimation::idle_anim, true, true, path);
+        creature->setWalkPath(EntityAnimation::walk, EntityAnimation::idle, true, true, path);
     }
 
     return true;
@@ -366,9 +366,9 @@ bool RoomLibrary::useRoom(Creature& creature, bool forced)
 
     Ogre::Vector3 walkDirection(ro->getPosition().x - creature.getPosition().x, ro->getPosition().y - creature.getPosition().y, 0);
     walkDirection.normalise();
-    creature.setAnimationState(EntityAnimation::attack_anim, false, walkDirection);
+    creature.setAnimationState(EntityAnimation::attack, false, walkDirection);
 
-    ro->setAnimationState("Triggered", false);
+    ro->setAnimationState(EntityAnimation::triggered, false);
 
     const CreatureRoomAffinity& creatureRoomAffinity = creature.getDefinition()->getRoomAffinity(getType());
     OD_ASSERT_TRUE_MSG(creatureRoomAffinity.getRoomType() == getType(), "name=" + getName() + ", creature=" + creature.getName()
@@ -376,7 +376,7 @@ bool RoomLibrary::useRoom(Creature& creature, bool forced)
 
     int32_t pointsEarned = static_cast<int32_t>(creatureRoomAffinity.getEfficiency() * ConfigManager::getSingleton().getRoomConfigDouble("LibraryPointsPerWork"));
     creature.jobDone(ConfigManager::getSingleton().getRoomConfigDouble("LibraryWakefulnessPerWork"));
-    creature.setJobCooldown(Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("LibraryCooldownWorkMin"),
+    creature.setJobCooldown(Random::getGenerator(RandomStream::room).Uint(ConfigManager::getSingleton().getRoomConfigUInt32("LibraryCooldownWorkMin"),
         ConfigManager::getSingleton().getRoomConfigUInt32("LibraryCooldownWorkMax")));
 
     // We check if we have enough points to create a skill entity
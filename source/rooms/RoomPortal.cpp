@@ -196,7 +196,7 @@ void RoomPortal::updatePortalPosition()
         return;
 
     mPortalObject = new PersistentObject(getGameMap(), *this, "PortalObject",
-        centralTile, 0.0, false, 1.0f, "Idle", true);
+        centralTile, 0.0, false, 1.0f, EntityAnimation::idle, true);
     addBuildingObject(centralTile, mPortalObject);
 }
 
@@ -216,7 +216,7 @@ void RoomPortal::doUpkeep()
         --mSpawnCreatureCountdown;
         return;
     }
-    mSpawnCreatureCountdown = Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("PortalCooldownSpawnMin"),
+    mSpawnCreatureCountdown = Random::getGenerator(RandomStream::spawning).Uint(ConfigManager::getSingleton().getRoomConfigUInt32("PortalCooldownSpawnMin"),
         ConfigManager::getSingleton().getRoomConfigUInt32("PortalCooldownSpawnMax"));
 
     if (mCoveredTiles.empty())
@@ -256,7 +256,7 @@ void RoomPortal::spawnCreature()
         return;
 
     if (mPortalObject != nullptr)
-        mPortalObject->setAnimationState("Triggered", false);
+        mPortalObject->setAnimationState(EntityAnimation::triggered, false);
 
     Ogre::Real xPos = static_cast<Ogre::Real>(centralTile->getX());
     Ogre::Real yPos = static_cast<Ogre::Real>(centralTile->getY());
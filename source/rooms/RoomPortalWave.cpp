@@ -246,7 +246,7 @@ void RoomPortalWave::updatePortalPosition()
     mPortalObject = new PersistentObject(getGameMap(), *this, "KnightCoffin", centralTile, 0.0, false);
     addBuildingObject(centralTile, mPortalObject);
 
-    mPortalObject->setAnimationState("Idle");
+    mPortalObject->setAnimationState(EntityAnimation::idle);
 }
 
 void RoomPortalWave::destroyMeshLocal()
@@ -274,7 +274,7 @@ void RoomPortalWave::doUpkeep()
         --mSearchFoeCountdown;
     else
     {
-        mSearchFoeCountdown = Random::Uint(10, 20);
+        mSearchFoeCountdown = Random::getGenerator(RandomStream::room).Uint(10, 20);
 
         handleAttack();
     }
@@ -282,7 +282,7 @@ void RoomPortalWave::doUpkeep()
     if (mSpawnCountdown < mTurnsBetween2Waves)
     {
         ++mSpawnCountdown;
-        mPortalObject->setAnimationState("Idle");
+        mPortalObject->setAnimationState(EntityAnimation::idle);
         return;
     }
 
@@ -304,7 +304,7 @@ void RoomPortalWave::handleChooseTarget()
         {
             case RoomPortalWaveStrategy::randomPlayer:
             {
-                uint32_t kk = Random::Uint(0, mAttackableSeats.size() - 1);
+                uint32_t kk = Random::getGenerator(RandomStream::room).Uint(0, mAttackableSeats.size() - 1);
                 mTargetSeats.clear();
                 Seat* attackedSeat = mAttackableSeats[kk];
                 OD_LOG_INF("PortalWave=" + getName() + ", attacking seatId=" + Helper::toString(attackedSeat->getId()));
@@ -331,7 +331,7 @@ void RoomPortalWave::spawnWave(RoomPortalWaveData* roomPortalWaveData, uint32_t
         return;
 
     if (mPortalObject != nullptr)
-        mPortalObject->setAnimationState("Triggered", false);
+        mPortalObject->setAnimationState(EntityAnimation::triggered, false);
 
     Ogre::Real xPos = static_cast<Ogre::Real>(centralTile->getX());
     Ogre::Real yPos = static_cast<Ogre::Real>(centralTile->getY());
@@ -477,7 +477,7 @@ void RoomPortalWave::handleSpawnWave()
         return;
 
     // Randomly choose a wave to spawn
-    uint32_t index = Random::Uint(0, mRoomPortalWaveDataSpawnable.size() - 1);
+    uint32_t index = Random::getGenerator(RandomStream::spawning).Uint(0, mRoomPortalWaveDataSpawnable.size() - 1);
     spawnWave(mRoomPortalWaveDataSpawnable[index], maxCreatures - numCreatures);
 }
 
@@ -720,7 +720,7 @@ bool RoomPortalWave::handleSearchFoe()
         return false;
 
     // We randomly pick a creature to test for path
-    uint32_t index = Random::Uint(0, creatures.size() - 1);
+    uint32_t index = Random::getGenerator(RandomStream::room).Uint(0, creatures.size() - 1);
     Creature* creature = creatures[index];
 
     std::vector<Room*> dungeonTemples = getGameMap()->getRoomsByType(RoomType::dungeonTemple);
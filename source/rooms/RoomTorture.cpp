@@ -328,7 +328,7 @@ bool RoomTorture::useRoom(Creature& creature, bool forced)
         p.second.mIsReady = true;
 
         if((getSeat() != creature.getSeat()) &&
-           (Random::Double(0.0, 1.0) <= config.getRoomConfigDouble("TortureRallyPercent")))
+           (Random::getGenerator(RandomStream::room).Double(0.0, 1.0) <= config.getRoomConfigDouble("TortureRallyPercent")))
         {
             // The creature changes side
             creature.changeSeat(getSeat());
@@ -349,7 +349,7 @@ bool RoomTorture::useRoom(Creature& creature, bool forced)
         }
 
         // We start the fire effect and we set job cooldown
-        uint32_t nbTurns = Random::Uint(config.getRoomConfigUInt32("TortureSessionLengthMin"),
+        uint32_t nbTurns = Random::getGenerator(RandomStream::room).Uint(config.getRoomConfigUInt32("TortureSessionLengthMin"),
             config.getRoomConfigUInt32("TortureSessionLengthMax"));
         creature.setJobCooldown(nbTurns);
 
@@ -368,12 +368,12 @@ bool RoomTorture::useRoom(Creature& creature, bool forced)
             {
                 obj->addParticleEffect("Flame", nbTurns / 2);
                 obj->fireRefresh();
-                creature.setAnimationState(EntityAnimation::flee_anim);
+                creature.setAnimationState(EntityAnimation::flee);
                 break;
             }
             case 2:
             {
-                creature.setAnimationState(EntityAnimation::idle_anim);
+                creature.setAnimationState(EntityAnimation::idle);
                 p.second.mState = 0;
                 break;
             }
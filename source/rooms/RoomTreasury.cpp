@@ -287,7 +287,9 @@ bool RoomTreasury::removeCoveredTile(Tile* t)
 
     roomTreasuryTileData->mMeshOfTile.clear();
     roomTreasuryTileData->mGoldInTile = 0;
-    return Room::removeCoveredTile(t);
+    bool ret = Room::removeCoveredTile(t);
+    updateSeatGoldCounters();
+    return ret;
 }
 
 int RoomTreasury::getTotalGoldStorage() const
@@ -344,6 +346,7 @@ int RoomTreasury::depositGold(int gold, Tile *tile)
         return wasDeposited;
 
     mGoldChanged = true;
+    updateSeatGoldCounters();
 
     // Tells the client to play a deposit gold sound. For now, we only send it to the players
     // with vision on tile
@@ -377,6 +380,7 @@ int RoomTreasury::withdrawGold(int gold)
         }
     }
 
+    updateSeatGoldCounters();
     return withdrawlAmount;
 }
 
@@ -412,9 +416,9 @@ void RoomTreasury::updateMeshesForTile(Tile* tile, RoomTreasuryTileData* roomTre
         double posX = static_cast<double>(tile->getX());
         double posY = static_cast<double>(tile->getY());
         double posZ = 0;
-        posX += Random::Double(-offset, offset);
-        posY += Random::Double(-offset, offset);
-        double angle = Random::Double(0.0, 360);
+        posX += Random::getGenerator(RandomStream::room).Double(-offset, offset);
+        posY += Random::getGenerator(RandomStream::room).Double(-offset, offset);
+        double angle = Random::getGenerator(RandomStream::room).Double(0.0, 360);
         BuildingObject* ro = new BuildingObject(getGameMap(), *this, newMeshName, tile, posX, posY, posZ, angle, false);
         addBuildingObject(tile, ro);
     }
@@ -137,11 +137,11 @@ BuildingObject* RoomWorkshop::notifyActiveSpotCreated(ActiveSpotPlace place, Til
             Ogre::Real y = static_cast<Ogre::Real>(tile->getY()) + Y_OFFSET_SPOT;
             Ogre::Real z = 0;
             mUnusedSpots.push_back(tile);
-            int result = Random::Int(0, 3);
+            int result = Random::getGenerator(RandomStream::room).Int(0, 3);
             if(result < 2)
                 return new BuildingObject(getGameMap(), *this, "WorkshopMachine1", tile, x, y, z, 30.0, false);
             else
-                return new BuildingObject(getGameMap(), *this, "WorkshopMachine2", tile, x, y, z, 30.0, false, 1.0, "Loop");
+                return new BuildingObject(getGameMap(), *this, "WorkshopMachine2", tile, x, y, z, 30.0, false, 1.0, EntityAnimation::loop);
         }
         case ActiveSpotPlace::activeSpotLeft:
         {
@@ -236,7 +236,7 @@ bool RoomWorkshop::addCreatureUsingRoom(Creature* creature)
     if(!Room::addCreatureUsingRoom(creature))
         return false;
 
-    int index = Random::Int(0, mUnusedSpots.size() - 1);
+    int index = Random::getGenerator(RandomStream::room).Int(0, mUnusedSpots.size() - 1);
     Tile* tileSpot = mUnusedSpots[index];
     mUnusedSpots.erase(mUnusedSpots.begin() + index);
     mCreaturesSpots[creature] = tileSpot;
@@ -260,7 +260,7 @@ bool RoomWorkshop::addCreatureUsingRoom(Creature* creature)
         // We add the last step to take account of the offset
         Ogre::Vector3 dest(wantedX, wantedY, 0.0);
         path.push_back(dest);
-        creature->setWalkPath(EntityAnimation::walk_anim, EntityAnimation::idle_anim, true, true, path);
+        creature->setWalkPath(EntityAnimation::walk, EntityAnimation::idle, true, true, path);
     }
 
     return true;
@@ -357,7 +357,7 @@ void RoomWorkshop::doUpkeep()
             // We randomly pickup the trap to craft if any
             if(!trapsToCraft.empty())
             {
-                uint32_t index = Random::Uint(0, trapsToCraft.size() - 1);
+                uint32_t index = Random::getGenerator(RandomStream::room).Uint(0, trapsToCraft.size() - 1);
                 mTrapType = trapsToCraft[index];
             }
         }
@@ -463,9 +463,9 @@ bool RoomWorkshop::useRoom(Creature& creature, bool forced)
 
     Ogre::Vector3 walkDirection(ro->getPosition().x - creature.getPosition().x - 1.0, ro->getPosition().y - creature.getPosition().y + 1.0, 0);
     walkDirection.normalise();
-    creature.setAnimationState(EntityAnimation::attack_anim, false, walkDirection);
+    creature.setAnimationState(EntityAnimation::attack, false, walkDirection);
 
-    ro->setAnimationState("Triggered", false);
+    ro->setAnimationState(EntityAnimation::triggered, false);
 
     const CreatureRoomAffinity& creatureRoomAffinity = creature.getDefinition()->getRoomAffinity(getType());
     OD_ASSERT_TRUE_MSG(creatureRoomAffinity.getRoomType() == getType(), "name=" + getName() + ", creature=" + creature.getName()
@@ -473,7 +473,7 @@ bool RoomWorkshop::useRoom(Creature& creature, bool forced)
 
     mPoints += static_cast<int32_t>(creatureRoomAffinity.getEfficiency() * ConfigManager::getSingleton().getRoomConfigDouble("WorkshopPointsPerWork"));
     creature.jobDone(ConfigManager::getSingleton().getRoomConfigDouble("WorkshopWakefulnessPerWork"));
-    creature.setJobCooldown(Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("WorkshopCooldownWorkMin"),
+    creature.setJobCooldown(Random::getGenerator(RandomStream::room).Uint(ConfigManager::getSingleton().getRoomConfigUInt32("WorkshopCooldownWorkMin"),
         ConfigManager::getSingleton().getRoomConfigUInt32("WorkshopCooldownWorkMax")));
 
     return false;
@@ -26,110 +26,83 @@
 
 #include <OgreQuaternion.h>
 
-// class GameSound
-GameSound::GameSound(const std::string& filename, bool spatialSound):
-    mSound(nullptr),
-    mSoundBuffer(nullptr)
-{
-    // Loads the buffer
-    mSoundBuffer = new sf::SoundBuffer();
-    if (mSoundBuffer->loadFromFile(filename) == false)
-    {
-        delete mSoundBuffer;
-        mSoundBuffer = nullptr;
-        return;
-    }
-
-    mFilename = filename;
-
-    mSound = new sf::Sound();
-    // Loads the main sound object
-    mSound->setBuffer(*mSoundBuffer);
-
-    mSound->setLoop(false);
-
-    // Sets a correct attenuation value if the sound is spatial
-    if (spatialSound == true)
-    {
-        // Set convenient spatial fading unit.
-        mSound->setVolume(100.0f);
-        mSound->setAttenuation(3.0f);
-        mSound->setMinDistance(3.0f);
-    }
-    else // Disable attenuation for sounds that must heard the same way everywhere
-    {
-        // Prevents the sound from being too loud
-        mSound->setRelativeToListener(true);
-        mSound->setVolume(30.0f);
-        mSound->setAttenuation(0.0f);
-    }
-}
+//! \brief Maximum number of spatial sounds played at the same time
+static const uint32_t NB_SPATIAL_VOICES = 24;
 
-GameSound::~GameSound()
+// class GameSound
+GameSound::GameSound(const std::string& filename):
+    mLoadState(LoadState::notLoaded),
+    mFilename(filename)
 {
-    // The sound object must be stopped and destroyed before its corresponding
-    // buffer to ensure detaching the sound stream from the sound source.
-    // This prevents a lot of warnings at app quit.
-    if (mSound != nullptr)
-    {
-        mSound->stop();
-        delete mSound;
-    }
-
-    if (mSoundBuffer != nullptr)
-        delete mSoundBuffer;
 }
 
-void GameSound::play(float x, float y, float z)
+bool GameSound::load()
 {
-    // Check whether the sound is spatial
-    if (mSound->getAttenuation() > 0.0f)
-    {
-        // Check the distance against the listener height and cull the sound accordingly.
-        // This permits to hear only the sound of the area seen in game,
-        // and avoid glitches in heard sounds.
-        sf::Vector3f lis = sf::Listener::getPosition();
-        float distance2 = (lis.x - x) * (lis.x - x) + (lis.y - y) * (lis.y - y);
-        double height2 = (lis.z * lis.z) + (lis.z * lis.z);
-
-        if (distance2 > height2)
-            return;
-    }
-
-    mSound->setPosition(x, y, z);
-    mSound->play();
+    return mSoundBuffer.loadFromFile(mFilename);
 }
 
 // SoundEffectsManager class
 template<> SoundEffectsManager* Ogre::Singleton<SoundEffectsManager>::msSingleton = nullptr;
 
-SoundEffectsManager::SoundEffectsManager()
+SoundEffectsManager::SoundEffectsManager() :
+    mSpatialVoices(NB_SPATIAL_VOICES),
+    mPrefetchThread(&SoundEffectsManager::prefetchSounds, this),
+    mIsStopRequested(false)
 {
     const std::string& soundFolderPath = ResourceManager::getSingleton().getSoundPath();
     // We read the spatial sound directory
-    readSounds(mSpatialSounds, soundFolderPath + "Spatial/", "", true);
+    readSounds(mSpatialSounds, mSpatialSoundIds, soundFolderPath + "Spatial/", "");
 
     // We read the relative sound directory
     for(const std::string& keeper : ConfigManager::getSingleton().getKeeperVoices())
     {
-        readSounds(mRelativeSounds, soundFolderPath + "Relative/" + keeper, keeper, false);
+        readSounds(mRelativeSounds, mRelativeSoundIds, soundFolderPath + "Relative/" + keeper, keeper);
     }
+
+    for(SoundVoice& voice : mSpatialVoices)
+    {
+        // Set convenient spatial fading unit.
+        voice.mSound.setLoop(false);
+        voice.mSound.setVolume(100.0f);
+        voice.mSound.setAttenuation(3.0f);
+        voice.mSound.setMinDistance(3.0f);
+    }
+
+    // Relative sounds must be heard the same way everywhere. We prevent them from being too loud
+    mRelativeVoice.setLoop(false);
+    mRelativeVoice.setRelativeToListener(true);
+    mRelativeVoice.setVolume(30.0f);
+    mRelativeVoice.setAttenuation(0.0f);
+
+    // The sound families are not changed anymore so the thread can browse them without locking
+    mPrefetchThread.launch();
 }
 
 SoundEffectsManager::~SoundEffectsManager()
 {
-    // Clear up every cached sounds...
-    std::map<std::string, GameSound*>::iterator it = mGameSoundCache.begin();
-    std::map<std::string, GameSound*>::iterator it_end = mGameSoundCache.end();
-    for (; it != it_end; ++it)
     {
-        if (it->second != nullptr)
-            delete it->second;
+        sf::Lock lock(mMutex);
+        mIsStopRequested = true;
     }
+    mPrefetchThread.wait();
+
+    // The voices must be stopped and detached before their buffers are destroyed.
+    // This prevents a lot of warnings at app quit.
+    for(SoundVoice& voice : mSpatialVoices)
+    {
+        voice.mSound.stop();
+        voice.mSound.resetBuffer();
+    }
+    mRelativeVoice.stop();
+    mRelativeVoice.resetBuffer();
+
+    // Clear up every cached sounds...
+    for(std::pair<const std::string, GameSound*>& p : mGameSoundCache)
+        delete p.second;
 }
 
-void SoundEffectsManager::readSounds(std::map<std::string, std::vector<GameSound*>>& soundsFamily,
-        const std::string& parentPath, const std::string& parentFamily, bool spatialSound)
+void SoundEffectsManager::readSounds(std::vector<SoundFamily>& soundFamilies, std::unordered_map<std::string, uint32_t>& soundIds,
+        const std::string& parentPath, const std::string& parentFamily)
 {
     std::vector<std::string> directories;
     if(!Helper::fillDirList(parentPath, directories, false))
@@ -143,7 +116,7 @@ void SoundEffectsManager::readSounds(std::map<std::string, std::vector<GameSound
         // We read sub directories
         std::string fullDir = parentPath + "/" + directory;
         std::string fullFamily = parentFamily.empty() ? directory : parentFamily + "/" + directory;
-        readSounds(soundsFamily, fullDir, fullFamily, spatialSound);
+        readSounds(soundFamilies, soundIds, fullDir, fullFamily);
 
         std::vector<std::string> soundFilenames;
         if(!Helper::fillFilesList(fullDir, soundFilenames, ".ogg"))
@@ -156,20 +129,84 @@ void SoundEffectsManager::readSounds(std::map<std::string, std::vector<GameSound
         if(soundFilenames.empty())
             continue;
 
-        std::vector<GameSound*>& sounds = soundsFamily[fullFamily];
+        auto it = soundIds.find(fullFamily);
+        if(it == soundIds.end())
+        {
+            it = soundIds.emplace(fullFamily, static_cast<uint32_t>(soundFamilies.size())).first;
+            soundFamilies.emplace_back();
+            soundFamilies.back().mPriority = getFamilyPriority(fullFamily);
+        }
+
+        std::vector<GameSound*>& sounds = soundFamilies[it->second].mSounds;
         for(const std::string& soundFilename : soundFilenames)
         {
-            GameSound* gm = getGameSound(soundFilename, spatialSound);
-            if (gm == nullptr)
+            OD_LOG_INF("Sound registered family=" + fullFamily + ", filename=" + soundFilename);
+            sounds.push_back(getGameSound(soundFilename));
+        }
+    }
+}
+
+bool SoundEffectsManager::loadGameSound(GameSound* sound)
+{
+    {
+        sf::Lock lock(mMutex);
+        switch(sound->getLoadState())
+        {
+            case GameSound::LoadState::loaded:
+                return true;
+            case GameSound::LoadState::loading:
+            case GameSound::LoadState::invalid:
+                return false;
+            case GameSound::LoadState::notLoaded:
+            default:
+                break;
+        }
+        sound->setLoadState(GameSound::LoadState::loading);
+    }
+
+    // The buffer is not used by anyone else while the sound is loading so we can decode it without the lock
+    bool isLoaded = sound->load();
+    if(!isLoaded)
+        OD_LOG_ERR("Cannot load sound=" + sound->getFilename());
+
+    sf::Lock lock(mMutex);
+    sound->setLoadState(isLoaded ? GameSound::LoadState::loaded : GameSound::LoadState::invalid);
+    return isLoaded;
+}
+
+void SoundEffectsManager::prefetchSounds()
+{
+    sf::Clock clock;
+    // Interface and keeper sounds are decoded first as they can be played from the menus
+    for(const std::vector<SoundFamily>* soundFamilies : {&mRelativeSounds, &mSpatialSounds})
+    {
+        for(const SoundFamily& family : *soundFamilies)
+        {
+            for(GameSound* sound : family.mSounds)
             {
-                OD_LOG_ERR("Cannot load sound=" + soundFilename);
-                continue;
+                {
+                    sf::Lock lock(mMutex);
+                    if(mIsStopRequested)
+                        return;
+                }
+                loadGameSound(sound);
             }
-
-            OD_LOG_INF("Sound loaded family=" + fullFamily + ", filename=" + soundFilename);
-            sounds.push_back(gm);
         }
     }
+
+    OD_LOG_INF("Sounds prefetched in " + Helper::toString(clock.getElapsedTime().asMilliseconds()) + " ms");
+}
+
+SoundPriority SoundEffectsManager::getFamilyPriority(const std::string& family)
+{
+    // The priority depends on the family root folder
+    std::string root = family.substr(0, family.find('/'));
+    if(root == "Game")
+        return SoundPriority::low;
+    if((root == "Traps") || (root == "Spells"))
+        return SoundPriority::high;
+
+    return SoundPriority::normal;
 }
 
 void SoundEffectsManager::updateListener(float timeSinceLastFrame,
@@ -186,87 +223,169 @@ void SoundEffectsManager::updateListener(float timeSinceLastFrame,
     if(mRelativeSoundQueue.empty())
         return;
 
-    auto it = mRelativeSoundQueue.begin();
-    GameSound* sound = *it;
-    if(sound->isPlaying())
+    if(mRelativeVoice.getStatus() == sf::SoundSource::Status::Playing)
         return;
 
-    mRelativeSoundQueue.erase(it);
+    mRelativeSoundQueue.erase(mRelativeSoundQueue.begin());
     if(mRelativeSoundQueue.empty())
         return;
 
-    mRelativeSoundQueue[0]->play();
+    playRelativeVoice(mRelativeSoundQueue[0]);
 }
 
-void SoundEffectsManager::playSpatialSound(const std::string& family,
-        float XPos, float YPos, float height)
+SoundEffectsManager::SoundVoice* SoundEffectsManager::findSpatialVoice(SoundPriority priority, float x, float y, float z)
 {
-    auto it = mSpatialSounds.find(family);
-    if(it == mSpatialSounds.end())
+    // We use the distance to the listener to choose between sounds with the same priority
+    sf::Vector3f lis = sf::Listener::getPosition();
+    float distance2 = (lis.x - x) * (lis.x - x) + (lis.y - y) * (lis.y - y) + (lis.z - z) * (lis.z - z);
+
+    SoundVoice* stolenVoice = nullptr;
+    float stolenDistance2 = 0.0f;
+    for(SoundVoice& voice : mSpatialVoices)
     {
-        OD_LOG_ERR("Couldn't find sound family=" + family);
+        if(voice.mSound.getStatus() != sf::SoundSource::Status::Playing)
+            return &voice;
+
+        if(voice.mPriority > priority)
+            continue;
+
+        sf::Vector3f pos = voice.mSound.getPosition();
+        float voiceDistance2 = (lis.x - pos.x) * (lis.x - pos.x) + (lis.y - pos.y) * (lis.y - pos.y) + (lis.z - pos.z) * (lis.z - pos.z);
+        if((voice.mPriority == priority) && (voiceDistance2 <= distance2))
+            continue;
+
+        // We steal the voice with the lowest priority. Between voices with the same priority, the furthest
+        if((stolenVoice == nullptr) ||
+           (voice.mPriority < stolenVoice->mPriority) ||
+           ((voice.mPriority == stolenVoice->mPriority) && (voiceDistance2 > stolenDistance2)))
+        {
+            stolenVoice = &voice;
+            stolenDistance2 = voiceDistance2;
+        }
+    }
+
+    return stolenVoice;
+}
+
+void SoundEffectsManager::playSpatialSound(uint32_t soundId, float XPos, float YPos, float height)
+{
+    if(soundId >= mSpatialSounds.size())
+    {
+        OD_LOG_ERR("Couldn't find sound id=" + Helper::toString(soundId));
         return;
     }
 
-    std::vector<GameSound*>& sounds = it->second;
-    if(sounds.empty())
+    const SoundFamily& family = mSpatialSounds[soundId];
+    if(family.mSounds.empty())
+        return;
+
+    // Check the distance against the listener height and cull the sound accordingly.
+    // This permits to hear only the sound of the area seen in game,
+    // and avoid glitches in heard sounds.
+    sf::Vector3f lis = sf::Listener::getPosition();
+    float distance2 = (lis.x - XPos) * (lis.x - XPos) + (lis.y - YPos) * (lis.y - YPos);
+    float height2 = (lis.z * lis.z) + (lis.z * lis.z);
+    if (distance2 > height2)
+        return;
+
+    SoundVoice* voice = findSpatialVoice(family.mPriority, XPos, YPos, height);
+    if(voice == nullptr)
+        return;
+
+    // If the sound is being prefetched, we do not wait for it
+    unsigned int index = Random::getGenerator(RandomStream::sound).Uint(0, family.mSounds.size() - 1);
+    GameSound* sound = family.mSounds[index];
+    if(!loadGameSound(sound))
+        return;
+
+    voice->mSound.stop();
+    voice->mSound.setBuffer(sound->getSoundBuffer());
+    voice->mSound.setPosition(XPos, YPos, height);
+    voice->mPriority = family.mPriority;
+    voice->mSound.play();
+}
+
+void SoundEffectsManager::playSpatialSound(const std::string& family,
+        float XPos, float YPos, float height)
+{
+    auto it = mSpatialSoundIds.find(family);
+    if(it == mSpatialSoundIds.end())
     {
-        OD_LOG_ERR("No sound found for sound family=" + family);
+        OD_LOG_ERR("Couldn't find sound family=" + family);
         return;
     }
 
-    unsigned int soundId = Random::Uint(0, sounds.size() - 1);
-    sounds[soundId]->play(XPos, YPos, height);
+    playSpatialSound(it->second, XPos, YPos, height);
 }
 
-void SoundEffectsManager::playRelativeSound(const std::string& family)
+uint32_t SoundEffectsManager::getRelativeSoundId(const std::string& family)
 {
+    const std::string& keeperVoice = ConfigManager::getSingleton().getGameValue(Config::KEEPERVOICE);
+    if(keeperVoice != mResolvedKeeperVoice)
+    {
+        mResolvedKeeperVoice = keeperVoice;
+        mResolvedRelativeSoundIds.clear();
+    }
+
+    auto itResolved = mResolvedRelativeSoundIds.find(family);
+    if(itResolved != mResolvedRelativeSoundIds.end())
+        return itResolved->second;
+
     // We search for the selected sound in the currently selected voice group. If we cannot
     // find it, we fall down to the default group. That allows to create new voice groups that
     // do not have to have sound for every event
-    std::string keeperVoice = ConfigManager::getSingleton().getGameValue(Config::KEEPERVOICE);
-    auto it = mRelativeSounds.find(keeperVoice + "/" + family);
-    if(it == mRelativeSounds.end())
+    uint32_t soundId = INVALID_SOUND_ID;
+    auto it = mRelativeSoundIds.find(keeperVoice + "/" + family);
+    if(it == mRelativeSoundIds.end())
+        it = mRelativeSoundIds.find(ConfigManager::DEFAULT_KEEPER_VOICE + "/" + family);
+
+    if(it != mRelativeSoundIds.end())
+        soundId = it->second;
+
+    mResolvedRelativeSoundIds.emplace(family, soundId);
+    return soundId;
+}
+
+void SoundEffectsManager::playRelativeSound(const std::string& family)
+{
+    uint32_t soundId = getRelativeSoundId(family);
+    if(soundId == INVALID_SOUND_ID)
     {
-        it = mRelativeSounds.find(ConfigManager::DEFAULT_KEEPER_VOICE + "/" + family);
-        if(it == mRelativeSounds.end())
-        {
-            OD_LOG_ERR("Couldn't find sound family=" + family);
-            return;
-        }
+        OD_LOG_ERR("Couldn't find sound family=" + family);
+        return;
     }
 
-    std::vector<GameSound*>& sounds = it->second;
+    const std::vector<GameSound*>& sounds = mRelativeSounds[soundId].mSounds;
     if(sounds.empty())
         return;
 
-    unsigned int soundId = Random::Uint(0, sounds.size() - 1);
-    GameSound* sound = sounds[soundId];
+    unsigned int index = Random::getGenerator(RandomStream::sound).Uint(0, sounds.size() - 1);
+    GameSound* sound = sounds[index];
+    if(!loadGameSound(sound))
+        return;
+
     if(mRelativeSoundQueue.empty())
-        sound->play();
+        playRelativeVoice(sound);
 
     mRelativeSoundQueue.push_back(sound);
 }
 
-GameSound* SoundEffectsManager::getGameSound(const std::string& filename, bool spatialSound)
+void SoundEffectsManager::playRelativeVoice(GameSound* sound)
 {
-    // We add a suffix to the sound filename as two versions of it can be kept, one spatial,
-    // and one which isn't.
-    std::string soundFile = filename + (spatialSound ? "_spatial": "");
+    mRelativeVoice.stop();
+    mRelativeVoice.setBuffer(sound->getSoundBuffer());
+    mRelativeVoice.play();
+}
 
-    std::map<std::string, GameSound*>::iterator it = mGameSoundCache.find(soundFile);
+GameSound* SoundEffectsManager::getGameSound(const std::string& filename)
+{
+    std::map<std::string, GameSound*>::iterator it = mGameSoundCache.find(filename);
     // Create a new game sound instance when the sound doesn't exist and register it.
+    // The file is decoded later (see loadGameSound)
     if (it == mGameSoundCache.end())
     {
-        GameSound* gm = new GameSound(filename, spatialSound);
-        if (gm->isInitialized() == false)
-        {
-            // Invalid sound filename
-            delete gm;
-            return nullptr;
-        }
-
-        mGameSoundCache.insert(std::make_pair(soundFile, gm));
+        GameSound* gm = new GameSound(filename);
+        mGameSoundCache.insert(std::make_pair(filename, gm));
         return gm;
     }
 
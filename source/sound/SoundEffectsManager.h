@@ -21,8 +21,13 @@
 #include <OgreSingleton.h>
 #include <OgreVector3.h>
 #include <SFML/Audio.hpp>
-#include <vector>
+#include <SFML/System.hpp>
+
+#include <cstdint>
 #include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 // Forward declarations
 class CreatureDefinition;
@@ -58,59 +63,77 @@ namespace SoundRelativeKeeperStatements
 // and we're using an pseudo-average value.
 const float TILE_ZPOS = 2.5;
 
-//! \brief A small object used to contain both the sound and its buffer,
-//! as both  must have the same life-cycle.
+//! \brief Returned when a sound family is unknown
+const uint32_t INVALID_SOUND_ID = static_cast<uint32_t>(-1);
+
+//! \brief When every voice is used, a sound can only replace a sound with a lower priority (or the
+//! same priority if it is further from the listener)
+enum class SoundPriority
+{
+    low,    // Frequent sounds like claiming tiles
+    normal,
+    high    // Sounds the player should not miss like traps and spells
+};
+
+//! \brief A sound buffer loaded from a file. It is played by the voices of the SoundEffectsManager.
+//! The file is only decoded when the sound is first played or prefetched by the SoundEffectsManager
 class GameSound
 {
 public:
+    enum class LoadState
+    {
+        notLoaded,
+        loading,
+        loaded,
+        invalid
+    };
+
     //! \brief Game sound constructor
     //! \param filename The sound filename used to load the sound.
-    //! \param spatialSound tells whether the sound should be prepared to be a spatial sound.
-    //! with a position, strength and attenuation relative to the camera position.
-    GameSound(const std::string& filename, bool spatialSound);
-
-    ~GameSound();
+    GameSound(const std::string& filename);
 
-    bool isInitialized() const
-    { return !(mSoundBuffer == nullptr); }
+    //! \brief Decodes the sound file. Returns false if it cannot be read
+    bool load();
 
-    bool isPlaying() const
-    { return mSound->getStatus() == sf::SoundSource::Status::Playing; }
+    //! \brief The load state is protected by the SoundEffectsManager mutex
+    LoadState getLoadState() const
+    { return mLoadState; }
 
-    //! \brief Play at the given spatial position
-    void play(float x, float y, float z);
+    void setLoadState(LoadState loadState)
+    { mLoadState = loadState; }
 
-    void play()
-    { mSound->play(); }
-
-    void stop()
-    { mSound->stop(); }
+    const sf::SoundBuffer& getSoundBuffer() const
+    { return mSoundBuffer; }
 
     const std::string& getFilename() const
     { return mFilename; }
 
 private:
-    //! \brief The Main sound object
-    sf::Sound* mSound;
+    LoadState mLoadState;
 
-    //! \brief The corresponding sound buffer, must not be destroyed
-    //! before the sound object itself is deleted.
-    sf::SoundBuffer* mSoundBuffer;
+    //! \brief The sound data. It must not be destroyed while a voice plays it
+    sf::SoundBuffer mSoundBuffer;
 
     //! \brief The sound filename
     std::string mFilename;
 };
 
 //! \brief Helper class to manage sound effects.
+//! The sound families are read from the sound folder when launching the game. The server sends the family
+//! names (the sounds available may differ between clients) and they are resolved with a hash lookup.
+//! The spatial sounds are played by a fixed number of voices. When every voice is used, the new sound
+//! replaces the less important one if it is more important (see SoundPriority). Otherwise, it is not played.
+//! The sound files are not decoded at startup. A background thread decodes them (interface and keeper sounds
+//! first) while a sound played before being prefetched is decoded when played.
 class SoundEffectsManager: public Ogre::Singleton<SoundEffectsManager>
 {
 public:
     static const std::string DEFAULT_KEEPER_VOICE;
 
-    //! \brief Loads every available interface sounds
+    //! \brief Lists every available sounds and starts decoding them in the background
     SoundEffectsManager();
 
-    //! \brief Deletes both sound caches.
+    //! \brief Stops the prefetch thread and deletes both sound caches.
     virtual ~SoundEffectsManager();
 
     void updateListener(float timeSinceLastFrame,
@@ -124,36 +147,92 @@ public:
     void playRelativeSound(const std::string& family);
 
 private:
+    //! \brief Sounds of a family. One of them is chosen randomly when the family is played
+    struct SoundFamily
+    {
+        SoundFamily() :
+            mPriority(SoundPriority::normal)
+        {}
+
+        std::vector<GameSound*> mSounds;
+        SoundPriority mPriority;
+    };
+
+    struct SoundVoice
+    {
+        SoundVoice() :
+            mPriority(SoundPriority::normal)
+        {}
+
+        sf::Sound mSound;
+        SoundPriority mPriority;
+    };
+
     //! \brief Every spatial game sounds (spells, traps, creatures...). The sounds are read when launching the
-    //! game by browsing the sound directory
-    //! \note the GameSound here are handled by the game sound cache.
-    std::map<std::string, std::vector<GameSound*>> mSpatialSounds;
+    //! game by browsing the sound directory. The sound id is the index in this vector
+    std::vector<SoundFamily> mSpatialSounds;
+    std::unordered_map<std::string, uint32_t> mSpatialSoundIds;
 
     //! \brief Every relative (ie not spatial) game sounds (interface, keeper statements, ...). The sounds
-    //! are read when launching the game by browsing the sound directory
-    //! \note the GameSound here are handled by the game sound cache.
-    std::map<std::string, std::vector<GameSound*>> mRelativeSounds;
+    //! are read when launching the game by browsing the sound directory. They are stored by keeper voice
+    //! then family
+    std::vector<SoundFamily> mRelativeSounds;
+    std::unordered_map<std::string, uint32_t> mRelativeSoundIds;
 
-    //! \brief The sound cache, containing the sound references, used by game entities.
-    //! \brief The GameSounds here must be deleted at destruction.
+    //! \brief Relative sound ids for the keeper voice used by the last played relative sound. They are
+    //! resolved once to not build the full family name each time
+    std::string mResolvedKeeperVoice;
+    std::unordered_map<std::string, uint32_t> mResolvedRelativeSoundIds;
+
+    //! \brief The sound cache, containing the sound buffers. The GameSounds here must be deleted at destruction.
     std::map<std::string, GameSound*> mGameSoundCache;
 
+    //! \brief Voices playing the spatial sounds
+    std::vector<SoundVoice> mSpatialVoices;
+
+    //! \brief Voice playing the relative sounds. They are played one after the other
+    sf::Sound mRelativeVoice;
+
     //! \brief Stores the relative sounds to play. Once a sound has stopped playing, the next one will start
     std::vector<GameSound*> mRelativeSoundQueue;
 
+    //! \brief Protects the load state of the game sounds and mIsStopRequested
+    sf::Mutex mMutex;
+    sf::Thread mPrefetchThread;
+    bool mIsStopRequested;
+
     //! \brief Returns a game sounds from the cache.
     //! \param filename The sound filename.
-    //! \param spatialSound Whether the sound is a spatial sound.
     //! If an unexisting file is given, a new cache instance is returned.
     //! \note Use this function only to create new game sounds as it is the only way to make sure
     //! the GameSound* instance is correclty cleared up when quitting.
-    //! \warning Returns nullptr if the filename is an invalid/unreadable sound.
-    GameSound* getGameSound(const std::string& filename, bool spatialSound = false);
+    GameSound* getGameSound(const std::string& filename);
+
+    //! \brief Returns true if the sound buffer is decoded. If it has not been decoded yet, it is decoded
+    //! now unless the prefetch thread is already doing it (in this case, false is returned)
+    bool loadGameSound(GameSound* sound);
+
+    //! \brief Decodes every sound that has not been played yet. Run by mPrefetchThread
+    void prefetchSounds();
 
-    //! \brief Recursive function that fills the sound map with sound files found and reads
+    //! \brief Recursive function that fills the sound families with sound files found and reads
     //! child directories
-    void readSounds(std::map<std::string, std::vector<GameSound*>>& soundsFamily,
-        const std::string& parentPath, const std::string& parentFamily, bool spatialSound);
+    void readSounds(std::vector<SoundFamily>& soundFamilies, std::unordered_map<std::string, uint32_t>& soundIds,
+        const std::string& parentPath, const std::string& parentFamily);
+
+    //! \brief Returns the voice that should play a sound with the given priority at the given position or
+    //! nullptr if the sound should not be played
+    SoundVoice* findSpatialVoice(SoundPriority priority, float x, float y, float z);
+
+    //! \brief Plays the spatial sound family with the given id (index in mSpatialSounds)
+    void playSpatialSound(uint32_t soundId, float XPos, float YPos, float height);
+
+    //! \brief Returns the id of the given relative family for the current keeper voice
+    uint32_t getRelativeSoundId(const std::string& family);
+
+    void playRelativeVoice(GameSound* sound);
+
+    static SoundPriority getFamilyPriority(const std::string& family);
 };
 
 #endif // SOUNDEFFECTSMANAGER_H_
@@ -22,6 +22,8 @@
 #include "spawnconditions/SpawnConditionGold.h"
 #include "spawnconditions/SpawnConditionRoom.h"
 
+#include "network/ODPacket.h"
+
 #include "rooms/RoomManager.h"
 #include "rooms/RoomType.h"
 
@@ -106,3 +108,52 @@ SpawnCondition* SpawnCondition::load(std::istream& defFile)
     OD_LOG_ERR("Couldn't read spawn condition");
     return nullptr;
 }
+
+SpawnCondition* SpawnCondition::loadFromPacket(ODPacket& is)
+{
+    std::string type;
+    if(!(is >> type))
+        return nullptr;
+
+    if(type == "Room")
+    {
+        RoomType roomType;
+        int32_t nbActiveSpotsMin;
+        int32_t pointsPerAdditionalActiveSpots;
+        if(!(is >> roomType >> nbActiveSpotsMin >> pointsPerAdditionalActiveSpots))
+            return nullptr;
+
+        return new SpawnConditionRoom(roomType, nbActiveSpotsMin, pointsPerAdditionalActiveSpots);
+    }
+
+    if(type == "Creature")
+    {
+        std::string className;
+        int32_t nbCreatureMin;
+        int32_t pointsPerAdditionalCreature;
+        if(!(is >> className >> nbCreatureMin >> pointsPerAdditionalCreature))
+            return nullptr;
+
+        const CreatureDefinition* creatureDefinition = ConfigManager::getSingleton().getCreatureDefinition(className);
+        if(creatureDefinition == nullptr)
+        {
+            OD_LOG_ERR("className=" + className);
+            return nullptr;
+        }
+
+        return new SpawnConditionCreature(creatureDefinition, nbCreatureMin, pointsPerAdditionalCreature);
+    }
+
+    if(type == "Gold")
+    {
+        int32_t nbGoldMin;
+        int32_t pointsPerAdditional100Gold;
+        if(!(is >> nbGoldMin >> pointsPerAdditional100Gold))
+            return nullptr;
+
+        return new SpawnConditionGold(nbGoldMin, pointsPerAdditional100Gold);
+    }
+
+    OD_LOG_ERR("Unknown spawn condition type=" + type);
+    return nullptr;
+}
@@ -23,6 +23,7 @@
 #include <vector>
 
 class GameMap;
+class ODPacket;
 class Seat;
 
 class SpawnCondition
@@ -37,6 +38,13 @@ public:
 
     static SpawnCondition* load(std::istream& defFile);
 
+    //! \brief Reads a spawn condition written by exportToPacket. The creature definitions
+    //! should be loaded before
+    static SpawnCondition* loadFromPacket(ODPacket& is);
+
+    //! \brief Writes the condition type followed by its parameters (used by the binary configuration cache)
+    virtual void exportToPacket(ODPacket& os) const = 0;
+
     //! \brief Checks if this spawning condition is met for the given gameMap/Seat. Returns true if the conditions are met and
     //! false otherwise. If true, computedPoints will be set to the additional points (can be < 0).
     virtual bool computePointsForSeat(const GameMap& gameMap, const Seat& seat, int32_t& computedPoints) const = 0;
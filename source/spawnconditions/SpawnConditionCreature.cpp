@@ -16,9 +16,12 @@
  */
 
 #include "entities/Creature.h"
+#include "entities/CreatureDefinition.h"
 
 #include "gamemap/GameMap.h"
 
+#include "network/ODPacket.h"
+
 #include "spawnconditions/SpawnConditionCreature.h"
 
 bool SpawnConditionCreature::computePointsForSeat(const GameMap& gameMap, const Seat& seat, int32_t& computedPoints) const
@@ -36,3 +39,8 @@ bool SpawnConditionCreature::computePointsForSeat(const GameMap& gameMap, const
     computedPoints = (nbCreatures - mNbCreatureMin) * mPointsPerAdditionalCreature;
     return true;
 }
+
+void SpawnConditionCreature::exportToPacket(ODPacket& os) const
+{
+    os << "Creature" << mCreatureDefinition->getClassName() << mNbCreatureMin << mPointsPerAdditionalCreature;
+}
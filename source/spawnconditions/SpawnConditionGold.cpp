@@ -17,6 +17,8 @@
 
 #include "game/Seat.h"
 
+#include "network/ODPacket.h"
+
 #include "spawnconditions/SpawnConditionGold.h"
 
 bool SpawnConditionGold::computePointsForSeat(const GameMap&, const Seat& seat, int32_t& computedPoints) const
@@ -29,3 +31,8 @@ bool SpawnConditionGold::computePointsForSeat(const GameMap&, const Seat& seat,
     computedPoints = diffGold * mPointsPerAdditional100Gold;
     return true;
 }
+
+void SpawnConditionGold::exportToPacket(ODPacket& os) const
+{
+    os << "Gold" << mNbGoldMin << mPointsPerAdditional100Gold;
+}
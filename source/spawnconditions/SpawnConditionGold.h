@@ -36,6 +36,8 @@ public:
     //! false otherwise. If true, computedPoints will be set to the additional points (can be < 0).
     virtual bool computePointsForSeat(const GameMap&, const Seat& seat, int32_t& computedPoints) const;
 
+    virtual void exportToPacket(ODPacket& os) const override;
+
 private:
     int32_t mNbGoldMin;
     int32_t mPointsPerAdditional100Gold;
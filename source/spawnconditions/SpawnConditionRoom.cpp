@@ -17,7 +17,10 @@
 
 #include "gamemap/GameMap.h"
 
+#include "network/ODPacket.h"
+
 #include "rooms/Room.h"
+#include "rooms/RoomType.h"
 
 #include "spawnconditions/SpawnConditionRoom.h"
 
@@ -35,3 +38,8 @@ bool SpawnConditionRoom::computePointsForSeat(const GameMap& gameMap, const Seat
     computedPoints = (nbActiveSpots - mNbActiveSpotsMin) * mPointsPerAdditionalActiveSpots;
     return true;
 }
+
+void SpawnConditionRoom::exportToPacket(ODPacket& os) const
+{
+    os << "Room" << mRoomType << mNbActiveSpotsMin << mPointsPerAdditionalActiveSpots;
+}
@@ -38,6 +38,8 @@ public:
     //! false otherwise. If true, computedPoints will be set to the additional points (can be < 0).
     virtual bool computePointsForSeat(const GameMap& gameMap, const Seat& seat, int32_t& computedPoints) const;
 
+    virtual void exportToPacket(ODPacket& os) const override;
+
 private:
     RoomType mRoomType;
     int32_t mNbActiveSpotsMin;
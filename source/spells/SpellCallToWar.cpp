@@ -72,7 +72,7 @@ SpellCallToWar::SpellCallToWar(GameMap* gameMap) :
     Spell(gameMap, SpellManager::getSpellNameFromSpellType(SpellType::callToWar), "WarBanner", 0.0,
         ConfigManager::getSingleton().getSpellConfigInt32("CallToWarNbTurnsMax"))
 {
-    mPrevAnimationState = "Loop";
+    mPrevAnimationState = EntityAnimation::loop;
     mPrevAnimationStateLoop = true;
 }
 
@@ -72,7 +72,7 @@ SpellEyeEvil::SpellEyeEvil(GameMap* gameMap) :
     Spell(gameMap, SpellManager::getSpellNameFromSpellType(getSpellType()), "FlyingSkull", 0.0,
         ConfigManager::getSingleton().getSpellConfigInt32("EyeEvilNbTurns"))
 {
-    mPrevAnimationState = "Triggered";
+    mPrevAnimationState = EntityAnimation::triggered;
     mPrevAnimationStateLoop = true;
 }
 
@@ -17,10 +17,12 @@
 
 #include "ODClientTest.h"
 
+#include "entities/EntityAnimation.h"
 #include "game/SeatData.h"
 #include "network/ClientNotification.h"
 #include "network/ServerMode.h"
 #include "network/ServerNotification.h"
+#include "network/WalkPathPacket.h"
 #include "utils/LogManager.h"
 
 #include <BoostTestTargetConfig.h>
@@ -117,6 +119,10 @@ bool ODClientTest::processMessage(ServerNotificationType cmd, ODPacket& packetRe
             BOOST_CHECK(packetReceived >> str);
             OD_LOG_INF("level tileset=" + (str.empty() ? "default" : str));
 
+            uint64_t randomSeed;
+            BOOST_CHECK(packetReceived >> randomSeed);
+            OD_LOG_INF("match seed=" + Helper::toString(randomSeed));
+
             uint32_t nb;
             // We read the seats
             BOOST_CHECK(mSeats.empty());
@@ -397,7 +403,7 @@ bool ODClientTest::processMessage(ServerNotificationType cmd, ODPacket& packetRe
         case ServerNotificationType::setObjectAnimationState:
         {
             std::string entityName;
-            std::string animState;
+            EntityAnimation animState;
             bool loop;
             bool playIdleWhenAnimationEnds;
             bool shouldSetWalkDirection;
@@ -410,33 +416,26 @@ bool ODClientTest::processMessage(ServerNotificationType cmd, ODPacket& packetRe
                 BOOST_CHECK(packetReceived >> walkDirection);
             }
 
-            animationPlayed(entityName, animState, loop, playIdleWhenAnimationEnds, shouldSetWalkDirection, walkDirection);
+            animationPlayed(entityName, entityAnimationToString(animState), loop, playIdleWhenAnimationEnds, shouldSetWalkDirection, walkDirection);
             break;
         }
         case ServerNotificationType::animatedObjectSetWalkPath:
         {
             std::string entityName;
-            std::string walkAnim;
-            std::string endAnim;
+            EntityAnimation walkAnim;
+            EntityAnimation endAnim;
             bool loopEndAnim;
             bool playIdleWhenAnimationEnds;
-            uint32_t nbDest;
             BOOST_CHECK(packetReceived >> entityName >> walkAnim >> endAnim);
-            BOOST_CHECK(packetReceived >> loopEndAnim >> playIdleWhenAnimationEnds >> nbDest);
+            BOOST_CHECK(packetReceived >> loopEndAnim >> playIdleWhenAnimationEnds);
             std::vector<Ogre::Vector3> path;
-            while(nbDest)
-            {
-                --nbDest;
-                Ogre::Vector3 dest;
-                BOOST_CHECK(packetReceived >> dest);
-                path.push_back(dest);
-            }
+            BOOST_CHECK(WalkPathPacket::importFromPacket(packetReceived, path));
 
             //! We want to make sure animationPlayed is played for both animations (if required)
-            if(!walkAnim.empty())
-                animationPlayed(entityName, walkAnim, true, false, false, Ogre::Vector3::ZERO);
-            if(!endAnim.empty())
-                animationPlayed(entityName, endAnim, loopEndAnim, false, false, Ogre::Vector3::ZERO);
+            if(walkAnim != EntityAnimation::none)
+                animationPlayed(entityName, entityAnimationToString(walkAnim), true, false, false, Ogre::Vector3::ZERO);
+            if(endAnim != EntityAnimation::none)
+                animationPlayed(entityName, entityAnimationToString(endAnim), loopEndAnim, false, false, Ogre::Vector3::ZERO);
             break;
         }
         default:
@@ -0,0 +1,100 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/ConfigCache.h"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <string>
+
+#define BOOST_TEST_MODULE ConfigCache
+#include "BoostTestTargetConfig.h"
+
+static void writeFile(const std::string& fileName, const std::string& content)
+{
+    std::ofstream file(fileName.c_str(), std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+BOOST_AUTO_TEST_CASE(test_HashFile)
+{
+    boost::filesystem::path dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::create_directories(dir);
+    std::string fileName = (dir / "test.cfg").string();
+
+    // Hashing the files one after the other gives the hash of their concatenation
+    writeFile(fileName, "[Test]\nValue\t1\n[/Test]\n");
+    uint64_t hash = ConfigCache::HASH_INIT;
+    BOOST_REQUIRE(ConfigCache::hashFile(fileName, hash));
+    BOOST_REQUIRE(ConfigCache::hashFile(fileName, hash));
+    std::string content = "[Test]\nValue\t1\n[/Test]\n[Test]\nValue\t1\n[/Test]\n";
+    BOOST_CHECK_EQUAL(hash, ConfigCache::computeHash(content.data(), content.size(), ConfigCache::HASH_INIT));
+
+    writeFile(fileName, "[Test]\nValue\t2\n[/Test]\n");
+    uint64_t hashChanged = ConfigCache::HASH_INIT;
+    BOOST_REQUIRE(ConfigCache::hashFile(fileName, hashChanged));
+    BOOST_CHECK(hashChanged != hash);
+
+    uint64_t hashMissing = ConfigCache::HASH_INIT;
+    BOOST_CHECK(!ConfigCache::hashFile((dir / "missing.cfg").string(), hashMissing));
+
+    boost::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(test_ConfigCacheOpen)
+{
+    boost::filesystem::path dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::create_directories(dir);
+    std::string cacheFileName = (dir / "config.cache").string();
+    std::string payload("definitions\0with a null byte", 28);
+    std::string error;
+
+    // No cache yet
+    {
+        ConfigCache cache;
+        BOOST_CHECK(!cache.open(cacheFileName, 42, error));
+    }
+
+    BOOST_REQUIRE(ConfigCache::write(cacheFileName, 42, payload.data(), payload.size()));
+    {
+        ConfigCache cache;
+        BOOST_REQUIRE(cache.open(cacheFileName, 42, error));
+        BOOST_CHECK_EQUAL(std::string(cache.getPayload(), cache.getPayloadSize()), payload);
+    }
+
+    // The configuration files changed
+    {
+        ConfigCache cache;
+        BOOST_CHECK(!cache.open(cacheFileName, 43, error));
+    }
+
+    // Corrupted files
+    {
+        ConfigCache cache;
+        writeFile(cacheFileName, "not a cache");
+        BOOST_CHECK(!cache.open(cacheFileName, 42, error));
+    }
+    {
+        BOOST_REQUIRE(ConfigCache::write(cacheFileName, 42, payload.data(), payload.size()));
+        boost::filesystem::resize_file(cacheFileName, boost::filesystem::file_size(cacheFileName) - 1);
+        ConfigCache cache;
+        BOOST_CHECK(!cache.open(cacheFileName, 42, error));
+    }
+
+    boost::filesystem::remove_all(dir);
+}
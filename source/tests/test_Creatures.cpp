@@ -18,6 +18,8 @@
 #include "mocks/ODClientTest.h"
 
 #include "game/SeatData.h"
+#include "network/ClientNotification.h"
+#include "rooms/RoomType.h"
 #include "utils/LogManager.h"
 #include "utils/LogSinkConsole.h"
 
@@ -29,11 +31,17 @@ class ODClientTestCreatures : public ODClientTest
 public:
     ODClientTestCreatures(const std::vector<PlayerInfo>& players, uint32_t indexLocalPlayer) :
         ODClientTest(players, indexLocalPlayer),
+        mCheckWalkDirection(false),
+        mAwaitedShouldSetWalkDirection(false),
         mResultTest(false)
     {}
 
     std::string mAwaitedEntityName;
     std::string mAwaitedEntityAnimation;
+    //! \brief If mCheckWalkDirection is set, only the animations with (or without) a walk direction
+    //! are awaited. That allows to know if a worker claims a wall (it faces the wall) or a ground tile
+    bool mCheckWalkDirection;
+    bool mAwaitedShouldSetWalkDirection;
     bool mResultTest;
 
     virtual void animationPlayed(const std::string& entityName, const std::string& animState, bool loop,
@@ -47,12 +55,21 @@ public:
             return;
         if(animState != mAwaitedEntityAnimation)
             return;
+        if(mCheckWalkDirection && (shouldSetWalkDirection != mAwaitedShouldSetWalkDirection))
+            return;
 
         mContinueLoop = false;
         mResultTest = true;
     }
 };
 
+static void markTileForDigging(ODClientTest& client, int x, int y, bool isDigSet)
+{
+    ODPacket packSend;
+    packSend << ClientNotificationType::askMarkTiles << x << y << x << y << isDigSet;
+    client.send(packSend);
+}
+
 BOOST_AUTO_TEST_CASE(test_Creatures)
 {
     LogManager logMgr;
@@ -114,6 +131,68 @@ BOOST_AUTO_TEST_CASE(test_Creatures)
     client.runFor(5000);
 
     std::string cmd;
+    // We add a worker in the claimed area. The walls around it are not claimed so we expect it to claim them
+    cmd = "addcreature 1 Kobold1 Kobold 2 12 0 Kobold 1 0 max 100 0 0 none none 4 none 0";
+    client.sendConsoleCmd(cmd);
+
+    client.mResultTest = false;
+    client.mAwaitedEntityName = "Kobold1";
+    client.mAwaitedEntityAnimation = "Claim";
+    client.mCheckWalkDirection = true;
+    client.mAwaitedShouldSetWalkDirection = true;
+    client.runFor(10000);
+
+    BOOST_CHECK(client.mResultTest);
+
+    // We mark a wall for digging and unmark it right away. We expect the worker not to dig
+    markTileForDigging(client, 4, 14, true);
+    markTileForDigging(client, 4, 14, false);
+
+    client.mResultTest = false;
+    client.mAwaitedEntityAnimation = "Dig";
+    client.mCheckWalkDirection = false;
+    client.runFor(10000);
+
+    BOOST_CHECK(!client.mResultTest);
+
+    // We mark the wall between the claimed area and the dug tiles next to it. The worker should
+    // dig it. Note that with the worker sight radius, the job search goes out of the map on the left
+    markTileForDigging(client, 2, 9, true);
+
+    client.mResultTest = false;
+    client.mAwaitedEntityAnimation = "Dig";
+    client.runFor(15000);
+
+    BOOST_CHECK(client.mResultTest);
+
+    // Once dug, the dug tiles next to it are connected to the claimed area. We expect the worker to claim them
+    client.mResultTest = false;
+    client.mAwaitedEntityAnimation = "Claim";
+    client.mCheckWalkDirection = true;
+    client.mAwaitedShouldSetWalkDirection = false;
+    client.runFor(15000);
+
+    BOOST_CHECK(client.mResultTest);
+
+    // We cover a claimed tile with a room and remove it. The claim jobs of the tile and its
+    // neighbors are refreshed each time (the server checks them in debug)
+    ODPacket packSend;
+    RoomType type = RoomType::treasury;
+    uint32_t nb = 1;
+    int32_t x = 8;
+    int32_t y = 13;
+    packSend << ClientNotificationType::askBuildRoom << type << nb << x << y;
+    client.send(packSend);
+
+    client.runFor(3000);
+
+    packSend.clear();
+    packSend << ClientNotificationType::askSellRoomTiles << nb << x << y;
+    client.send(packSend);
+
+    client.runFor(3000);
+
+    client.mCheckWalkDirection = false;
     cmd = "addcreature 1 Wyvern1 Wyvern 3 12 0 Wyvern 1 0 max 100 0 0 none none 4 none 0";
     client.sendConsoleCmd(cmd);
 
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/GameMapSnapshot.h"
+
+#include <string>
+
+#define BOOST_TEST_MODULE GameMapSnapshot
+#include "BoostTestTargetConfig.h"
+
+BOOST_AUTO_TEST_CASE(test_BuildLevel)
+{
+    // Level text as exported when taking a snapshot: the tiles section only contains the map size
+    std::string text = "0.7.0\n"
+        "[Info]\nName\tSnapshot # comment\n[/Info]\n"
+        "[Seats]\n[/Seats]\n"
+        "[Goals]\n[/Goals]\n"
+        "[Tiles]\n10\n20\n[/Tiles]\n"
+        "[Rooms]\n[/Rooms]\n"
+        "[Traps]\n[/Traps]\n"
+        "[Lights]\n[/Lights]\n"
+        "[Creatures]\n[/Creatures]\n"
+        "[Spells]\n[/Spells]\n";
+
+    GameMapSnapshot snapshot;
+    snapshot.setText(text);
+    LevelFile::TileRecord record;
+    record.mX = 3;
+    record.mY = 4;
+    record.mType = 1;
+    record.mSeatId = 2;
+    record.mFullness = 0.0;
+    snapshot.getTiles().push_back(record);
+    BOOST_CHECK(snapshot.getSize() > sizeof(LevelFile::TileRecord));
+
+    LevelFile::LevelData level;
+    std::string error;
+    BOOST_REQUIRE(snapshot.buildLevel(level, error));
+    BOOST_CHECK(level.mVersion == "0.7.0");
+    BOOST_CHECK(level.mMapSizeX == 10);
+    BOOST_CHECK(level.mMapSizeY == 20);
+    BOOST_REQUIRE(level.mTiles.size() == 1);
+    BOOST_CHECK(level.mTiles[0].mX == 3);
+    BOOST_CHECK(level.mTiles[0].mSeatId == 2);
+    // The comments are removed
+    const std::string& info = level.mSections[static_cast<uint32_t>(LevelFile::Section::info)];
+    BOOST_CHECK(info.find("Snapshot") != std::string::npos);
+    BOOST_CHECK(info.find("comment") == std::string::npos);
+    BOOST_CHECK(level.mSections[static_cast<uint32_t>(LevelFile::Section::entities)].find("[Spells]") == 0);
+
+    // A snapshot without the level text cannot be saved
+    snapshot.clear();
+    BOOST_CHECK(!snapshot.buildLevel(level, error));
+}
@@ -0,0 +1,100 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/LevelFile.h"
+
+#include <boost/filesystem.hpp>
+
+#include <sstream>
+
+#define BOOST_TEST_MODULE LevelFile
+#include "BoostTestTargetConfig.h"
+
+static const std::string LEVEL_TEXT =
+    "0.7.0 # Version\n"
+    "[Info]\n"
+    "Name\tTest level\n"
+    "[/Info]\n"
+    "[Seats]\n"
+    "[Seat]\n"
+    "seatId\t1\n"
+    "[/Seat]\n"
+    "[/Seats]\n"
+    "[Goals]\n"
+    "[/Goals]\n"
+    "[Tiles]\n"
+    "4 # MapSizeX\n"
+    "3 # MapSizeY\n"
+    "0\t0\t1\t0\t1\n"
+    "1\t2\t3\t50\n"
+    "[/Tiles]\n"
+    "[Rooms]\n"
+    "[/Rooms]\n"
+    "[Traps]\n"
+    "[/Traps]\n"
+    "[Lights]\n"
+    "[/Lights]\n"
+    "[Creatures]\n"
+    "[/Creatures]\n"
+    "[Spells]\n"
+    "[/Spells]\n";
+
+BOOST_AUTO_TEST_CASE(test_ParseText)
+{
+    std::stringstream ss(LEVEL_TEXT);
+    LevelFile::LevelData level;
+    std::string error;
+    BOOST_REQUIRE(LevelFile::parseText(LevelFile::removeComments(ss), level, error));
+    BOOST_CHECK(level.mVersion == "0.7.0");
+    BOOST_CHECK(level.mMapSizeX == 4);
+    BOOST_CHECK(level.mMapSizeY == 3);
+    BOOST_REQUIRE(level.mTiles.size() == 2);
+    BOOST_CHECK(level.mTiles[0].mSeatId == 1);
+    BOOST_CHECK(level.mTiles[1].mX == 1 && level.mTiles[1].mY == 2);
+    BOOST_CHECK(level.mTiles[1].mType == 3);
+    BOOST_CHECK(level.mTiles[1].mFullness == 50.0);
+    BOOST_CHECK(level.mTiles[1].mSeatId == -1);
+    BOOST_CHECK(level.mSections[static_cast<uint32_t>(LevelFile::Section::info)].find("Test level") != std::string::npos);
+    BOOST_CHECK(level.mSections[static_cast<uint32_t>(LevelFile::Section::entities)].find("[Spells]") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_BinaryRoundTrip)
+{
+    std::stringstream ss(LEVEL_TEXT);
+    LevelFile::LevelData level;
+    std::string error;
+    BOOST_REQUIRE(LevelFile::parseText(LevelFile::removeComments(ss), level, error));
+
+    boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    BOOST_REQUIRE(LevelFile::writeBinary(path.string(), level, error));
+    BOOST_CHECK(LevelFile::isBinaryFile(path.string()));
+
+    LevelFile::LevelData levelRead;
+    {
+        LevelFile::MappedLevel mappedLevel;
+        BOOST_REQUIRE(mappedLevel.open(path.string(), error));
+        BOOST_CHECK(mappedLevel.getNbTiles() == 2);
+        mappedLevel.toLevelData(levelRead);
+    }
+    boost::filesystem::remove(path);
+
+    std::stringstream text;
+    std::stringstream textRead;
+    LevelFile::writeText(text, level);
+    LevelFile::writeText(textRead, levelRead);
+    BOOST_CHECK(text.str() == textRead.str());
+}
@@ -0,0 +1,322 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE MasterServer
+#include "BoostTestTargetConfig.h"
+
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+#include "utils/LogSinkConsole.h"
+#include "utils/MasterServer.h"
+#include "utils/MasterServerWorker.h"
+
+#include <SFML/Network.hpp>
+#include <SFML/System.hpp>
+
+static const std::string TEST_URL = "127.0.0.1";
+static const std::string TEST_VERSION = "0.7.0";
+
+//! \brief Minimal http server answering like the master server on a local port
+class TestMasterServer
+{
+public:
+    TestMasterServer() :
+        mThread(&TestMasterServer::serve, this),
+        mIsStopRequested(false),
+        mNbFailures(0),
+        mResponseDelayMs(0),
+        mNbGamesListRequests(0),
+        mNbUpdateRequests(0)
+    {
+        mListener.listen(sf::Socket::AnyPort);
+        mSelector.add(mListener);
+        mThread.launch();
+    }
+
+    ~TestMasterServer()
+    {
+        {
+            sf::Lock lock(mMutex);
+            mIsStopRequested = true;
+        }
+        mThread.wait();
+    }
+
+    uint16_t getPort() const
+    { return mListener.getLocalPort(); }
+
+    //! \brief The next nbFailures requests will get an error
+    void setNbFailures(uint32_t nbFailures)
+    {
+        sf::Lock lock(mMutex);
+        mNbFailures = nbFailures;
+    }
+
+    void setResponseDelayMs(int32_t delayMs)
+    {
+        sf::Lock lock(mMutex);
+        mResponseDelayMs = delayMs;
+    }
+
+    uint32_t getNbGamesListRequests()
+    {
+        sf::Lock lock(mMutex);
+        return mNbGamesListRequests;
+    }
+
+    uint32_t getNbUpdateRequests()
+    {
+        sf::Lock lock(mMutex);
+        return mNbUpdateRequests;
+    }
+
+    std::string getLastUpdateBody()
+    {
+        sf::Lock lock(mMutex);
+        return mLastUpdateBody;
+    }
+
+private:
+    sf::Mutex mMutex;
+    sf::Thread mThread;
+    sf::TcpListener mListener;
+    sf::SocketSelector mSelector;
+    bool mIsStopRequested;
+    uint32_t mNbFailures;
+    int32_t mResponseDelayMs;
+    uint32_t mNbGamesListRequests;
+    uint32_t mNbUpdateRequests;
+    std::string mLastUpdateBody;
+
+    //! \brief Reads the request until its body is complete
+    static bool readRequest(sf::TcpSocket& socket, std::string& header, std::string& body)
+    {
+        std::string data;
+        char buffer[1024];
+        std::size_t received;
+        std::size_t headerEnd = std::string::npos;
+        std::size_t contentLength = 0;
+        while(true)
+        {
+            if(headerEnd != std::string::npos)
+            {
+                if(data.size() >= headerEnd + 4 + contentLength)
+                    break;
+            }
+
+            if(socket.receive(buffer, sizeof(buffer), received) != sf::Socket::Done)
+                return false;
+
+            data.append(buffer, received);
+            if(headerEnd != std::string::npos)
+                continue;
+
+            headerEnd = data.find("\r\n\r\n");
+            if(headerEnd == std::string::npos)
+                continue;
+
+            std::size_t pos = data.find("Content-Length: ");
+            if((pos != std::string::npos) && (pos < headerEnd))
+                contentLength = static_cast<std::size_t>(Helper::toInt(data.substr(pos + 16, data.find("\r\n", pos) - pos - 16)));
+        }
+        header = data.substr(0, headerEnd);
+        body = data.substr(headerEnd + 4, contentLength);
+        return true;
+    }
+
+    void answer(sf::TcpSocket& socket)
+    {
+        std::string header;
+        std::string body;
+        if(!readRequest(socket, header, body))
+            return;
+
+        bool isFailure;
+        int32_t delayMs;
+        {
+            sf::Lock lock(mMutex);
+            isFailure = (mNbFailures > 0);
+            if(isFailure)
+                --mNbFailures;
+            delayMs = mResponseDelayMs;
+
+            if(header.find("/get_csv.php") != std::string::npos)
+                ++mNbGamesListRequests;
+            else if(header.find("/update.php") != std::string::npos)
+            {
+                ++mNbUpdateRequests;
+                mLastUpdateBody = body;
+            }
+        }
+
+        sf::sleep(sf::milliseconds(delayMs));
+
+        std::string status = "200 OK";
+        std::string content;
+        if(isFailure)
+            status = "500 Internal Server Error";
+        else if(header.find("/get_csv.php") != std::string::npos)
+        {
+            content = TEST_VERSION + ";uuid1;creator1;10.0.0.1;32222;label_21;descr1\n"
+                + "0.1.0;uuid2;creator2;10.0.0.2;32222;label2;descr2\n"
+                + "invalid line\n"
+                + TEST_VERSION + ";uuid3;creator3;10.0.0.3;32223;label3;descr3\n";
+        }
+        else if(header.find("/announce.php") != std::string::npos)
+            content = "uuid=new-uuid\n";
+
+        std::string response = "HTTP/1.0 " + status + "\r\nContent-Length: " + Helper::toString(static_cast<uint32_t>(content.size()))
+            + "\r\n\r\n" + content;
+        socket.send(response.data(), response.size());
+    }
+
+    void serve()
+    {
+        while(true)
+        {
+            {
+                sf::Lock lock(mMutex);
+                if(mIsStopRequested)
+                    return;
+            }
+
+            if(!mSelector.wait(sf::milliseconds(50)))
+                continue;
+
+            sf::TcpSocket socket;
+            if(mListener.accept(socket) != sf::Socket::Done)
+                continue;
+
+            answer(socket);
+            socket.disconnect();
+        }
+    }
+};
+
+//! \brief Polls the worker until the games list is retrieved
+static bool waitGamesList(MasterServerWorker& worker, std::vector<MasterServerGame>& games, bool& isSuccess)
+{
+    sf::Clock clock;
+    while(clock.getElapsedTime() < sf::seconds(20))
+    {
+        if(worker.popGamesList(games, isSuccess))
+            return true;
+
+        sf::sleep(sf::milliseconds(10));
+    }
+    return false;
+}
+
+static bool waitIdle(MasterServerWorker& worker)
+{
+    sf::Clock clock;
+    while(clock.getElapsedTime() < sf::seconds(20))
+    {
+        if(worker.isIdle())
+            return true;
+
+        sf::sleep(sf::milliseconds(10));
+    }
+    return false;
+}
+
+BOOST_AUTO_TEST_CASE(test_MasterServerRequests)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+    TestMasterServer server;
+
+    std::vector<MasterServerGame> games;
+    BOOST_REQUIRE(MasterServer::fillMasterServerGames(TEST_URL, server.getPort(), TEST_VERSION, games));
+    // Only the valid lines with the same version are kept
+    BOOST_REQUIRE(games.size() == 2);
+    BOOST_CHECK(games[0].mUuid == "uuid1");
+    BOOST_CHECK(games[0].mCreator == "creator1");
+    BOOST_CHECK(games[0].mIp == "10.0.0.1");
+    BOOST_CHECK(games[0].mPort == 32222);
+    BOOST_CHECK(games[0].mLabel == "label;");
+    BOOST_CHECK(games[1].mUuid == "uuid3");
+
+    std::string uuid;
+    BOOST_REQUIRE(MasterServer::registerGame(TEST_URL, server.getPort(), TEST_VERSION, "creator", 32222, "label", "descr", uuid));
+    BOOST_CHECK(uuid == "new-uuid");
+
+    server.setNbFailures(1);
+    BOOST_CHECK(!MasterServer::updateGame(TEST_URL, server.getPort(), uuid, 0));
+    BOOST_CHECK(MasterServer::updateGame(TEST_URL, server.getPort(), uuid, 0));
+}
+
+BOOST_AUTO_TEST_CASE(test_MasterServerWorkerRetry)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+    TestMasterServer server;
+    MasterServerWorker worker(TEST_URL, server.getPort());
+
+    // The first try fails and the request is sent again
+    server.setNbFailures(1);
+    worker.requestGamesList(TEST_VERSION);
+    std::vector<MasterServerGame> games;
+    bool isSuccess = false;
+    BOOST_REQUIRE(waitGamesList(worker, games, isSuccess));
+    BOOST_CHECK(isSuccess);
+    BOOST_CHECK(games.size() == 2);
+    BOOST_CHECK(server.getNbGamesListRequests() == 2);
+
+    // The worker gives up after the last try
+    server.setNbFailures(10);
+    worker.requestGamesList(TEST_VERSION);
+    BOOST_REQUIRE(waitGamesList(worker, games, isSuccess));
+    BOOST_CHECK(!isSuccess);
+    BOOST_CHECK(games.empty());
+    BOOST_CHECK(server.getNbGamesListRequests() == 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_MasterServerWorkerCoalesce)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+    TestMasterServer server;
+    MasterServerWorker worker(TEST_URL, server.getPort());
+
+    // While the first update is being sent, the next ones for the same game replace each other
+    server.setResponseDelayMs(300);
+    worker.updateGame("uuid1", 0);
+    worker.updateGame("uuid1", 1);
+    worker.updateGame("uuid1", 2);
+    BOOST_REQUIRE(waitIdle(worker));
+    BOOST_CHECK(server.getNbUpdateRequests() == 2);
+    BOOST_CHECK(server.getLastUpdateBody() == "uuid=uuid1&status=2");
+}
+
+BOOST_AUTO_TEST_CASE(test_MasterServerWorkerStop)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+    TestMasterServer server;
+    {
+        MasterServerWorker worker(TEST_URL, server.getPort());
+        server.setNbFailures(10);
+        worker.updateGame("uuid1", 1);
+        // We let the worker fail once so that it waits before retrying
+        sf::sleep(sf::milliseconds(200));
+        worker.updateGame("uuid1", 2);
+    }
+    // When the worker is stopped, the pending update is sent once without retry
+    BOOST_CHECK(server.getNbUpdateRequests() == 2);
+    BOOST_CHECK(server.getLastUpdateBody() == "uuid=uuid1&status=2");
+}
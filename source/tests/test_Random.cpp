@@ -17,6 +17,9 @@
 
 #include "utils/Random.h"
 
+#include <sstream>
+#include <vector>
+
 #define BOOST_TEST_MODULE Random
 #include "BoostTestTargetConfig.h"
 
@@ -25,3 +28,88 @@ BOOST_AUTO_TEST_CASE(test_Random)
     Random::initialize();
     BOOST_CHECK (Random::Int(1, 2 ) <= 2);
 }
+
+BOOST_AUTO_TEST_CASE(test_RandomRanges)
+{
+    RandomGenerator generator(42);
+    for(int i = 0; i < 10000; ++i)
+    {
+        int valInt = generator.Int(-3, 5);
+        BOOST_CHECK(valInt >= -3 && valInt <= 5);
+        unsigned int valUint = generator.Uint(2, 4);
+        BOOST_CHECK(valUint >= 2 && valUint <= 4);
+        double valDouble = generator.Double(-1.0, 1.0);
+        BOOST_CHECK(valDouble >= -1.0 && valDouble < 1.0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_RandomSeed)
+{
+    // The same seed gives the same sequence
+    Random::initialize(1234);
+    BOOST_CHECK(Random::getSeed() == 1234);
+    std::vector<int> values;
+    for(int i = 0; i < 100; ++i)
+        values.push_back(Random::Int(0, 1000000));
+
+    Random::initialize(1234);
+    for(int i = 0; i < 100; ++i)
+        BOOST_CHECK(Random::Int(0, 1000000) == values[i]);
+
+    // Using a stream does not change the others
+    Random::initialize(1234);
+    for(int i = 0; i < 100; ++i)
+    {
+        Random::getGenerator(RandomStream::sound).next();
+        BOOST_CHECK(Random::Int(0, 1000000) == values[i]);
+    }
+
+    // Derived seeds differ between streams and entities
+    BOOST_CHECK(Random::deriveSeed(RandomStream::ai, 1) != Random::deriveSeed(RandomStream::ai, 2));
+    BOOST_CHECK(Random::deriveSeed(RandomStream::ai, 1) != Random::deriveSeed(RandomStream::game, 1));
+}
+
+BOOST_AUTO_TEST_CASE(test_RandomContext)
+{
+    Random::initialize(1234);
+    int value = Random::Int(0, 1000000);
+
+    // A match using its own context does not change the global one
+    RandomContext context;
+    Random::setThreadContext(&context);
+    Random::initialize(5678);
+    BOOST_CHECK(Random::getSeed() == 5678);
+    Random::Int(0, 1000000);
+    Random::setThreadContext(nullptr);
+
+    BOOST_CHECK(Random::getSeed() == 1234);
+    Random::initialize(1234);
+    BOOST_CHECK(Random::Int(0, 1000000) == value);
+    BOOST_CHECK(context.mMatchSeed == 5678);
+}
+
+BOOST_AUTO_TEST_CASE(test_RandomState)
+{
+    // A generator restored from a saved state continues the same sequence
+    RandomGenerator generator(1234);
+    for(int i = 0; i < 10; ++i)
+        generator.next();
+
+    std::stringstream ss;
+    generator.exportToStream(ss);
+    RandomGenerator restored;
+    BOOST_CHECK(restored.importFromStream(ss));
+    for(int i = 0; i < 100; ++i)
+        BOOST_CHECK(restored.next() == generator.next());
+
+    // An invalid state leaves the generator unchanged
+    std::stringstream invalid("0\t0\t0\t0");
+    BOOST_CHECK(!restored.importFromStream(invalid));
+    BOOST_CHECK(restored.next() == generator.next());
+
+    // Entities identified by name get different seeds
+    Random::initialize(1234);
+    BOOST_CHECK(Random::deriveSeed(RandomStream::creature, "Troll1") != Random::deriveSeed(RandomStream::creature, "Troll2"));
+    BOOST_CHECK(Random::getStateKey(RandomStream::creature, "Troll1") == "creature.Troll1");
+    BOOST_CHECK(Random::getStateKey(RandomStream::game) == "game");
+}
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE WalkPathPacket
+#include "BoostTestTargetConfig.h"
+
+#include "network/ODPacket.h"
+#include "network/WalkPathPacket.h"
+
+#include <algorithm>
+
+static bool checkPath(const std::deque<Ogre::Vector3>& path)
+{
+    ODPacket packet;
+    WalkPathPacket::exportToPacket(packet, path);
+    std::vector<Ogre::Vector3> result;
+    if(!WalkPathPacket::importFromPacket(packet, result))
+        return false;
+
+    return (path.size() == result.size()) && std::equal(path.begin(), path.end(), result.begin());
+}
+
+BOOST_AUTO_TEST_CASE(test_WalkPathPacket)
+{
+    // Empty path
+    {
+        std::deque<Ogre::Vector3> path;
+        BOOST_CHECK(checkPath(path));
+    }
+    // Tile path with straight runs longer than a run can store and every direction
+    {
+        std::deque<Ogre::Vector3> path;
+        Ogre::Vector3 pos(3, 4, 0);
+        path.push_back(pos);
+        for(int i = 0; i < 40; ++i)
+        {
+            pos.x += 1;
+            path.push_back(pos);
+        }
+        const int dirs[8][2] = { {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}, {1, 0} };
+        for(const int* dir : dirs)
+        {
+            pos.x += dir[0];
+            pos.y += dir[1];
+            path.push_back(pos);
+        }
+        BOOST_CHECK(checkPath(path));
+
+        // Such a path should use the compact encoding
+        ODPacket packet;
+        WalkPathPacket::exportToPacket(packet, path);
+        uint32_t nbDest;
+        bool isCompact;
+        BOOST_CHECK(packet >> nbDest >> isCompact);
+        BOOST_CHECK(nbDest == path.size());
+        BOOST_CHECK(isCompact);
+    }
+    // Paths that cannot be compacted
+    {
+        std::deque<Ogre::Vector3> path;
+        path.push_back(Ogre::Vector3(3.2, 4, 0));
+        path.push_back(Ogre::Vector3(4, 4, 0));
+        BOOST_CHECK(checkPath(path));
+
+        path.clear();
+        path.push_back(Ogre::Vector3(3, 4, 0));
+        path.push_back(Ogre::Vector3(8, 4, 0));
+        BOOST_CHECK(checkPath(path));
+
+        path.clear();
+        path.push_back(Ogre::Vector3(3, 4, 0));
+        path.push_back(Ogre::Vector3(4, 4, 1));
+        BOOST_CHECK(checkPath(path));
+    }
+}
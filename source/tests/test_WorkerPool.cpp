@@ -0,0 +1,66 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/WorkerPool.h"
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#define BOOST_TEST_MODULE WorkerPool
+#include "BoostTestTargetConfig.h"
+
+BOOST_AUTO_TEST_CASE(test_WorkerPoolRunsEveryTask)
+{
+    WorkerPool pool(3);
+    BOOST_CHECK(pool.getNbWorkers() == 3);
+
+    // The pool is reused for several runs like it is during the turns
+    for(uint32_t run = 0; run < 50; ++run)
+    {
+        std::vector<uint32_t> results(100, 0);
+        std::vector<std::function<void()>> tasks;
+        for(uint32_t i = 0; i < results.size(); ++i)
+        {
+            tasks.emplace_back([&results, i, run]()
+            {
+                results[i] = i + run;
+            });
+        }
+        pool.run(tasks);
+
+        for(uint32_t i = 0; i < results.size(); ++i)
+            BOOST_CHECK(results[i] == i + run);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_WorkerPoolWithoutWorker)
+{
+    // Without worker, every task runs on the calling thread
+    WorkerPool pool(0);
+    std::atomic<uint32_t> nbTasksDone(0);
+    std::vector<std::function<void()>> tasks(10, [&nbTasksDone]()
+    {
+        ++nbTasksDone;
+    });
+    pool.run(tasks);
+    BOOST_CHECK(nbTasksDone == 10);
+
+    tasks.clear();
+    pool.run(tasks);
+    BOOST_CHECK(nbTasksDone == 10);
+}
@@ -0,0 +1,196 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \brief Converts levels between the text and the binary formats:
+ *     odlevelconverter <input> <output>
+ * The direction depends on the input file.
+ * It can also compare the time needed to decode both formats:
+ *     odlevelconverter --benchmark <level> [iterations]
+ * Both formats are decoded to the same result, like MapHandler::readGameMapFromFile does: every
+ * tile record and every token of the entity sections (the game reads them with operator>>). Only
+ * the creation of the game entities from the tokens is left out as it is the same for both formats.
+ */
+
+#include "gamemap/LevelFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+//! \brief What the game reads from a level, whatever its format
+struct DecodedLevel
+{
+    std::vector<std::string> mTokens;
+    std::vector<LevelFile::TileRecord> mTiles;
+};
+
+static int usage()
+{
+    std::cerr << "Usage: odlevelconverter <input> <output>" << std::endl;
+    std::cerr << "       odlevelconverter --benchmark <level> [iterations]" << std::endl;
+    return 1;
+}
+
+static void decodeSections(LevelFile::LevelData& level, DecodedLevel& decoded)
+{
+    decoded.mTokens.clear();
+    for(uint32_t id = 0; id < static_cast<uint32_t>(LevelFile::Section::nbSections); ++id)
+    {
+        std::stringstream ss(level.mSections[id]);
+        std::string token;
+        while(ss >> token)
+            decoded.mTokens.push_back(token);
+    }
+    decoded.mTiles.swap(level.mTiles);
+}
+
+static bool decodeText(const std::string& fileName, DecodedLevel& decoded, std::string& error)
+{
+    std::ifstream file(fileName.c_str());
+    if(!file.is_open())
+    {
+        error = "Cannot open " + fileName;
+        return false;
+    }
+    LevelFile::LevelData level;
+    if(!LevelFile::parseText(LevelFile::removeComments(file), level, error))
+        return false;
+
+    decodeSections(level, decoded);
+    return true;
+}
+
+static bool decodeBinary(const std::string& fileName, DecodedLevel& decoded, std::string& error)
+{
+    LevelFile::MappedLevel mappedLevel;
+    if(!mappedLevel.open(fileName, error))
+        return false;
+
+    LevelFile::LevelData level;
+    mappedLevel.toLevelData(level);
+    decodeSections(level, decoded);
+    return true;
+}
+
+static bool isSameLevel(const DecodedLevel& level1, const DecodedLevel& level2)
+{
+    if(level1.mTokens != level2.mTokens)
+        return false;
+    if(level1.mTiles.size() != level2.mTiles.size())
+        return false;
+
+    for(std::size_t index = 0; index < level1.mTiles.size(); ++index)
+    {
+        const LevelFile::TileRecord& tile1 = level1.mTiles[index];
+        const LevelFile::TileRecord& tile2 = level2.mTiles[index];
+        if((tile1.mX != tile2.mX) || (tile1.mY != tile2.mY) || (tile1.mType != tile2.mType) ||
+           (tile1.mSeatId != tile2.mSeatId) || (tile1.mFullness != tile2.mFullness))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int benchmark(const std::string& fileName, int iterations)
+{
+    std::string error;
+    std::string textFile = fileName;
+    std::string binaryFile = fileName + ".bin";
+    bool isBinary = LevelFile::isBinaryFile(fileName);
+    if(isBinary)
+    {
+        binaryFile = fileName;
+        textFile = fileName + ".txt";
+    }
+
+    if(!LevelFile::convertFile(fileName, isBinary ? textFile : binaryFile, error))
+    {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    // We make sure both decodings give the same result before measuring them
+    DecodedLevel textLevel;
+    DecodedLevel binaryLevel;
+    if(!decodeText(textFile, textLevel, error) || !decodeBinary(binaryFile, binaryLevel, error))
+    {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    if(!isSameLevel(textLevel, binaryLevel))
+    {
+        std::cerr << "The text and binary levels are different" << std::endl;
+        return 1;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(int i = 0; i < iterations; ++i)
+    {
+        if(!decodeText(textFile, textLevel, error))
+        {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+    }
+    std::chrono::duration<double, std::milli> textDuration = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for(int i = 0; i < iterations; ++i)
+    {
+        if(!decodeBinary(binaryFile, binaryLevel, error))
+        {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+    }
+    std::chrono::duration<double, std::milli> binaryDuration = std::chrono::steady_clock::now() - start;
+
+    std::remove(isBinary ? textFile.c_str() : binaryFile.c_str());
+
+    std::cout << "Text:   " << textDuration.count() / iterations << " ms per load" << std::endl;
+    std::cout << "Binary: " << binaryDuration.count() / iterations << " ms per load" << std::endl;
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 3)
+        return usage();
+
+    std::string arg = argv[1];
+    if(arg == "--benchmark")
+    {
+        int iterations = 100;
+        if(argc >= 4)
+            iterations = std::max(1, std::atoi(argv[3]));
+
+        return benchmark(argv[2], iterations);
+    }
+
+    std::string error;
+    if(!LevelFile::convertFile(argv[1], argv[2], error))
+    {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -277,9 +277,6 @@ class TrapDoorFactory : public TrapFactory
 static TrapRegister reg(new TrapDoorFactory);
 }
 
-const std::string TrapDoor::ANIMATION_OPEN = "Open";
-const std::string TrapDoor::ANIMATION_CLOSE = "Close";
-
 TrapDoor::TrapDoor(GameMap* gameMap) :
     Trap(gameMap),
     mIsLocked(false),
@@ -306,7 +303,7 @@ TrapEntity* TrapDoor::getTrapEntity(Tile* tile)
         rotation = 0.0;
     }
     return new DoorEntity(getGameMap(), *this, reg.getTrapFactory()->getMeshName(), tile, rotation, false, isActivated(tile) ? 1.0f : 0.5f,
-        ANIMATION_OPEN, false);
+        EntityAnimation::open, false);
 }
 
 void TrapDoor::doUpkeep()
@@ -372,9 +369,9 @@ void TrapDoor::notifyDoorSlapped(DoorEntity* doorEntity, Tile* tile)
 void TrapDoor::changeDoorState(DoorEntity* doorEntity, Tile* tile, bool locked)
 {
     if(locked)
-        doorEntity->setAnimationState(ANIMATION_CLOSE, false, Ogre::Vector3::ZERO, false);
+        doorEntity->setAnimationState(EntityAnimation::close, false, Ogre::Vector3::ZERO, false);
     else
-        doorEntity->setAnimationState(ANIMATION_OPEN, false, Ogre::Vector3::ZERO, false);
+        doorEntity->setAnimationState(EntityAnimation::open, false, Ogre::Vector3::ZERO, false);
 
     if(!isActivated(tile))
         return;
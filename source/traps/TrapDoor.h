@@ -28,9 +28,6 @@ class TrapDoor : public Trap
 public:
     TrapDoor(GameMap* gameMap);
 
-    static const std::string ANIMATION_OPEN;
-    static const std::string ANIMATION_CLOSE;
-
     const TrapType getType() const override
     { return TrapType::doorWooden; }
 
@@ -129,7 +129,7 @@ bool TrapSpike::shoot(Tile* tile)
         return false;
 
     RenderedMovableEntity* spike = getBuildingObjectFromTile(tile);
-    spike->setAnimationState("Triggered", false);
+    spike->setAnimationState(EntityAnimation::triggered, false);
 
     // We damage every creature standing on the trap
     for(GameEntity* target : enemyCreatures)
@@ -0,0 +1,177 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/ConfigCache.h"
+
+#include <boost/filesystem.hpp>
+
+#include <cstring>
+#include <fstream>
+
+static const char MAGIC[8] = {'O', 'D', 'C', 'F', 'G', 'B', 'I', 'N'};
+//! \brief Allows to detect files written on a platform with another endianness
+static const uint32_t ENDIANNESS_MARK = 0x01020304;
+
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+const uint64_t ConfigCache::HASH_INIT = 14695981039346656037ULL;
+
+struct FileHeader
+{
+    char mMagic[8];
+    uint32_t mFormatVersion;
+    uint32_t mEndiannessMark;
+    uint64_t mContentHash;
+    uint64_t mPayloadSize;
+};
+
+ConfigCache::ConfigCache() :
+    mPayloadOffset(0),
+    mPayloadSize(0)
+{
+}
+
+bool ConfigCache::open(const std::string& fileName, uint64_t contentHash, std::string& error)
+{
+    close();
+
+    boost::system::error_code ec;
+    if(!boost::filesystem::exists(fileName, ec))
+    {
+        error = "No cache file: " + fileName;
+        return false;
+    }
+
+    try
+    {
+        boost::interprocess::file_mapping file(fileName.c_str(), boost::interprocess::read_only);
+        boost::interprocess::mapped_region region(file, boost::interprocess::read_only);
+        mFile.swap(file);
+        mRegion.swap(region);
+    }
+    catch(const boost::interprocess::interprocess_exception& e)
+    {
+        error = "Cannot map " + fileName + ": " + e.what();
+        return false;
+    }
+
+    const char* data = static_cast<const char*>(mRegion.get_address());
+    uint64_t fileSize = mRegion.get_size();
+    FileHeader header;
+    if(fileSize < sizeof(header))
+    {
+        error = "File too small: " + fileName;
+        close();
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if((std::memcmp(header.mMagic, MAGIC, sizeof(MAGIC)) != 0) ||
+       (header.mEndiannessMark != ENDIANNESS_MARK) ||
+       (header.mFormatVersion != FORMAT_VERSION))
+    {
+        error = "Unsupported cache format: " + fileName;
+        close();
+        return false;
+    }
+    if(header.mContentHash != contentHash)
+    {
+        error = "Configuration files changed since the cache was written: " + fileName;
+        close();
+        return false;
+    }
+    if(header.mPayloadSize != fileSize - sizeof(header))
+    {
+        error = "Corrupted cache: " + fileName;
+        close();
+        return false;
+    }
+
+    mPayloadOffset = sizeof(header);
+    mPayloadSize = header.mPayloadSize;
+    return true;
+}
+
+void ConfigCache::close()
+{
+    boost::interprocess::mapped_region().swap(mRegion);
+    boost::interprocess::file_mapping().swap(mFile);
+    mPayloadOffset = 0;
+    mPayloadSize = 0;
+}
+
+const char* ConfigCache::getPayload() const
+{
+    return static_cast<const char*>(mRegion.get_address()) + mPayloadOffset;
+}
+
+uint64_t ConfigCache::getPayloadSize() const
+{
+    return mPayloadSize;
+}
+
+bool ConfigCache::write(const std::string& fileName, uint64_t contentHash, const void* payload, std::size_t size)
+{
+    std::string tmpFileName = fileName + "." + boost::filesystem::unique_path().string() + ".tmp";
+    {
+        std::ofstream file(tmpFileName.c_str(), std::ios::binary | std::ios::trunc);
+        if(!file.is_open())
+            return false;
+
+        FileHeader header;
+        std::memcpy(header.mMagic, MAGIC, sizeof(MAGIC));
+        header.mFormatVersion = FORMAT_VERSION;
+        header.mEndiannessMark = ENDIANNESS_MARK;
+        header.mContentHash = contentHash;
+        header.mPayloadSize = size;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(static_cast<const char*>(payload), size);
+        if(!file.good())
+            return false;
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::rename(tmpFileName, fileName, ec);
+    if(ec)
+    {
+        boost::filesystem::remove(tmpFileName, ec);
+        return false;
+    }
+    return true;
+}
+
+uint64_t ConfigCache::computeHash(const char* data, std::size_t size, uint64_t hash)
+{
+    for(std::size_t index = 0; index < size; ++index)
+    {
+        hash ^= static_cast<uint8_t>(data[index]);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+bool ConfigCache::hashFile(const std::string& fileName, uint64_t& hash)
+{
+    std::ifstream file(fileName.c_str(), std::ios::binary);
+    if(!file.is_open())
+        return false;
+
+    char buffer[4096];
+    while(file.read(buffer, sizeof(buffer)) || (file.gcount() > 0))
+        hash = computeHash(buffer, static_cast<std::size_t>(file.gcount()), hash);
+
+    return true;
+}
@@ -0,0 +1,78 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONFIGCACHE_H
+#define CONFIGCACHE_H
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstdint>
+#include <string>
+
+/*! \brief Binary cache of the parsed configuration definitions.
+ *
+ * The cache file holds a header followed by the serialized definitions (the payload). The header
+ * stores the content hash of the configuration files the definitions were parsed from, so an edited
+ * file is never read from an outdated cache. The file is mapped in memory and the payload is read
+ * in place.
+ * This class does not know the payload layout so that it can be tested without the game classes.
+ */
+class ConfigCache
+{
+public:
+    //! \brief Version of the cache layout. Should be incremented when the header or the way the
+    //! definitions are serialized changes
+    static const uint32_t FORMAT_VERSION = 1;
+
+    //! \brief Initial value for computeHash
+    static const uint64_t HASH_INIT;
+
+    ConfigCache();
+
+    //! \brief Maps the given cache file. Returns false and fills error if the file is missing, invalid or if it
+    //! was not written for the given content hash
+    bool open(const std::string& fileName, uint64_t contentHash, std::string& error);
+
+    //! \brief Releases the mapping. The payload should not be used after
+    void close();
+
+    //! \brief Serialized definitions. Only valid while the cache is open
+    const char* getPayload() const;
+    uint64_t getPayloadSize() const;
+
+    //! \brief Writes the cache file. The file is written under a unique temporary name then renamed so that
+    //! processes started at the same time never read a partial cache. Returns false if it cannot be written
+    static bool write(const std::string& fileName, uint64_t contentHash, const void* payload, std::size_t size);
+
+    //! \brief FNV-1a hash of the given data. hash is the value returned for the previous data
+    //! (HASH_INIT for the first one) so that several buffers can be hashed together
+    static uint64_t computeHash(const char* data, std::size_t size, uint64_t hash);
+
+    //! \brief Hashes the content of the given file with computeHash. Returns false if the file cannot be read
+    static bool hashFile(const std::string& fileName, uint64_t& hash);
+
+private:
+    boost::interprocess::file_mapping mFile;
+    boost::interprocess::mapped_region mRegion;
+
+    //! \brief Offset of the payload in the mapped file
+    uint64_t mPayloadOffset;
+    uint64_t mPayloadSize;
+};
+
+#endif // CONFIGCACHE_H
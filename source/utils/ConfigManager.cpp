@@ -17,12 +17,16 @@
 
 #include "utils/ConfigManager.h"
 
+#include "ODApplication.h"
+
 #include "entities/CreatureDefinition.h"
 #include "entities/Tile.h"
 #include "entities/Weapon.h"
 #include "game/Skill.h"
 #include "gamemap/TileSet.h"
+#include "network/ODPacket.h"
 #include "spawnconditions/SpawnCondition.h"
+#include "utils/ConfigCache.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
@@ -38,12 +42,46 @@ const std::string ConfigManager::DEFAULT_KEEPER_VOICE = "Default";
 
 const std::string ConfigManager::DefaultWorkerCreatureDefinition = "DefaultWorker";
 
+namespace
+{
+    //! \brief Writes a [Rooms], [Traps], [Spells] or [Skills] config map to the definitions cache
+    template<typename T>
+    void exportConfigMap(ODPacket& os, const std::map<const std::string, T>& config)
+    {
+        uint32_t nb = config.size();
+        os << nb;
+        for(const std::pair<const std::string, T>& p : config)
+            os << p.first << p.second;
+    }
+
+    template<typename T>
+    bool importConfigMap(ODPacket& is, std::map<const std::string, T>& config)
+    {
+        uint32_t nb;
+        if(!(is >> nb))
+            return false;
+
+        while(nb > 0)
+        {
+            --nb;
+            std::string param;
+            T value;
+            if(!(is >> param >> value))
+                return false;
+
+            config[param] = value;
+        }
+        return true;
+    }
+}
+
 template<> ConfigManager* Ogre::Singleton<ConfigManager>::msSingleton = nullptr;
 
 ConfigManager::ConfigManager(const std::string& configPath, const std::string& userConfigPath,
-        const std::string& soundPath) :
+        const std::string& soundPath, const std::string& cacheFileName) :
     mNetworkPort(0),
     mClientConnectionTimeout(5000),
+    mAutoSavePeriod(0),
     mBaseSpawnPoint(10),
     mCreatureDeathCounter(10),
     mMaxCreaturesPerSeatAbsolute(30),
@@ -75,100 +113,344 @@ ConfigManager::ConfigManager(const std::string& configPath, const std::string& u
         OD_LOG_ERR("Couldn't read loadCreatureDefinitions");
         exit(1);
     }
+    if(!loadDefinitions(configPath, cacheFileName))
+    {
+        OD_LOG_ERR("Couldn't load the definitions");
+        exit(1);
+    }
+
+    // Reserve space in any case.
+    mUserConfig.resize(Config::Ctg::TOTAL);
+
+    if (!userConfigPath.empty())
+        loadUserConfig(userConfigPath);
+
+    loadKeeperVoices(soundPath);
+}
+
+ConfigManager::~ConfigManager()
+{
+    if(mCreatureDefinitionDefaultWorker != nullptr)
+        delete mCreatureDefinitionDefaultWorker;
+
+    clearDefinitions();
+}
+
+void ConfigManager::clearDefinitions()
+{
+    for(auto pair : mCreatureDefs)
+    {
+        delete pair.second;
+    }
+    mCreatureDefs.clear();
+
+    for(const Weapon* def : mWeapons)
+    {
+        delete def;
+    }
+    mWeapons.clear();
+
+    for(std::pair<const CreatureDefinition*, std::vector<const SpawnCondition*>> p : mCreatureSpawnConditions)
+    {
+        for(const SpawnCondition* spawnCondition : p.second)
+        {
+            delete spawnCondition;
+        }
+    }
+    mCreatureSpawnConditions.clear();
+
+    for(std::pair<const std::string, const TileSet*> p : mTileSets)
+    {
+        delete p.second;
+    }
+    mTileSets.clear();
+
+    mFactions.clear();
+    mFactionDefaultWorkerClass.clear();
+    mFactionSpawnPool.clear();
+    mDefaultWorkerRogue.clear();
+    mRoomsConfig.clear();
+    mTrapsConfig.clear();
+    mSpellConfig.clear();
+    mSkillPoints.clear();
+}
+
+bool ConfigManager::loadDefinitions(const std::string& configPath, const std::string& cacheFileName)
+{
+    // The cache is keyed by the content of every definition file. The game version is hashed too so that
+    // a cache written by another release is not used
+    const std::vector<std::string> fileNames = {
+        mFilenameCreatureDefinition,
+        mFilenameEquipmentDefinition,
+        mFilenameSpawnConditions,
+        mFilenameFactions,
+        mFilenameRooms,
+        mFilenameTraps,
+        mFilenameSpells,
+        mFilenameSkills,
+        mFilenameTilesets
+    };
+    uint64_t contentHash = ConfigCache::computeHash(ODApplication::VERSION.data(), ODApplication::VERSION.size(),
+        ConfigCache::HASH_INIT);
+    for(const std::string& fileName : fileNames)
+    {
+        if(!ConfigCache::hashFile(configPath + fileName, contentHash))
+        {
+            OD_LOG_ERR("Couldn't read " + configPath + fileName);
+            return false;
+        }
+    }
+
+    if(!cacheFileName.empty())
+    {
+        ConfigCache cache;
+        std::string error;
+        if(cache.open(cacheFileName, contentHash, error))
+        {
+            ODPacket packet;
+            packet.appendData(cache.getPayload(), cache.getPayloadSize());
+            cache.close();
+            if(importDefinitionsFromPacket(packet))
+            {
+                OD_LOG_INF("Definitions loaded from " + cacheFileName);
+                return true;
+            }
+
+            OD_LOG_WRN("Invalid definitions in " + cacheFileName);
+            clearDefinitions();
+        }
+        else
+        {
+            OD_LOG_INF(error);
+        }
+    }
+
+    if(!parseDefinitions(configPath))
+        return false;
+
+    if(!cacheFileName.empty())
+    {
+        ODPacket packet;
+        exportDefinitionsToPacket(packet);
+        if(!ConfigCache::write(cacheFileName, contentHash, packet.getData(), packet.getDataSize()))
+            OD_LOG_WRN("Couldn't write " + cacheFileName);
+    }
+
+    return true;
+}
+
+bool ConfigManager::parseDefinitions(const std::string& configPath)
+{
     std::string fileName = configPath + mFilenameCreatureDefinition;
     if(!loadCreatureDefinitions(fileName))
     {
         OD_LOG_ERR("Couldn't read loadCreatureDefinitions");
-        exit(1);
+        return false;
     }
     fileName = configPath + mFilenameEquipmentDefinition;
     if(!loadEquipements(fileName))
     {
         OD_LOG_ERR("Couldn't read loadEquipements");
-        exit(1);
+        return false;
     }
     fileName = configPath + mFilenameSpawnConditions;
     if(!loadSpawnConditions(fileName))
     {
         OD_LOG_ERR("Couldn't read loadSpawnConditions");
-        exit(1);
+        return false;
     }
     fileName = configPath + mFilenameFactions;
     if(!loadFactions(fileName))
     {
         OD_LOG_ERR("Couldn't read loadFactions");
-        exit(1);
+        return false;
     }
     fileName = configPath + mFilenameRooms;
     if(!loadRooms(fileName))
     {
         OD_LOG_ERR("Couldn't read loadRooms");
-        exit(1);
+        return false;
     }
     fileName = configPath + mFilenameTraps;
     if(!loadTraps(fileName))
     {
         OD_LOG_ERR("Couldn't read loadTraps");
-        exit(1);
+        return false;
     }
     fileName = configPath + mFilenameSpells;
     if(!loadSpellConfig(fileName))
     {
         OD_LOG_ERR("Couldn't read loadSpellConfig");
-        exit(1);
+        return false;
     }
     fileName = configPath + mFilenameSkills;
     if(!loadSkills(fileName))
     {
         OD_LOG_ERR("Couldn't read loadSkills");
-        exit(1);
+        return false;
     }
     fileName = configPath + mFilenameTilesets;
     if(!loadTilesets(fileName))
     {
         OD_LOG_ERR("Couldn't read loadTilesets");
-        exit(1);
+        return false;
     }
 
-    // Reserve space in any case.
-    mUserConfig.resize(Config::Ctg::TOTAL);
+    return true;
+}
 
-    if (!userConfigPath.empty())
-        loadUserConfig(userConfigPath);
+void ConfigManager::exportDefinitionsToPacket(ODPacket& os) const
+{
+    uint32_t nb = mCreatureDefs.size();
+    os << nb;
+    for(const std::pair<const std::string, CreatureDefinition*>& p : mCreatureDefs)
+        p.second->exportToPacketCache(os);
+
+    nb = mWeapons.size();
+    os << nb;
+    for(const Weapon* weapon : mWeapons)
+        os << weapon;
+
+    os << mBaseSpawnPoint;
+    nb = mCreatureSpawnConditions.size();
+    os << nb;
+    for(const std::pair<const CreatureDefinition* const, std::vector<const SpawnCondition*>>& p : mCreatureSpawnConditions)
+    {
+        nb = p.second.size();
+        os << p.first->getClassName() << nb;
+        for(const SpawnCondition* spawnCondition : p.second)
+            spawnCondition->exportToPacket(os);
+    }
 
-    loadKeeperVoices(soundPath);
+    os << mDefaultWorkerRogue;
+    nb = mFactions.size();
+    os << nb;
+    for(const std::string& faction : mFactions)
+    {
+        os << faction << getFactionWorkerClass(faction);
+        const std::vector<std::string>& spawnPool = getFactionSpawnPool(faction);
+        nb = spawnPool.size();
+        os << nb;
+        for(const std::string& className : spawnPool)
+            os << className;
+    }
+
+    exportConfigMap(os, mRoomsConfig);
+    exportConfigMap(os, mTrapsConfig);
+    exportConfigMap(os, mSpellConfig);
+    exportConfigMap(os, mSkillPoints);
+
+    nb = mTileSets.size();
+    os << nb;
+    for(const std::pair<const std::string, const TileSet*>& p : mTileSets)
+    {
+        os << p.first;
+        p.second->exportToPacket(os);
+    }
 }
 
-ConfigManager::~ConfigManager()
+bool ConfigManager::importDefinitionsFromPacket(ODPacket& is)
 {
-    for(auto pair : mCreatureDefs)
+    uint32_t nb;
+    if(!(is >> nb))
+        return false;
+    while(nb > 0)
     {
-        delete pair.second;
+        --nb;
+        CreatureDefinition* creatureDef = CreatureDefinition::loadFromPacketCache(is);
+        if(creatureDef == nullptr)
+            return false;
+
+        mCreatureDefs.emplace(creatureDef->getClassName(), creatureDef);
     }
 
-    if(mCreatureDefinitionDefaultWorker != nullptr)
-        delete mCreatureDefinitionDefaultWorker;
+    if(!(is >> nb))
+        return false;
+    while(nb > 0)
+    {
+        --nb;
+        Weapon* weapon = new Weapon();
+        mWeapons.push_back(weapon);
+        if(!(is >> weapon))
+            return false;
+    }
 
-    for(const Weapon* def : mWeapons)
+    if(!(is >> mBaseSpawnPoint >> nb))
+        return false;
+    while(nb > 0)
     {
-        delete def;
+        --nb;
+        std::string className;
+        uint32_t nbConditions;
+        if(!(is >> className >> nbConditions))
+            return false;
+
+        const CreatureDefinition* creatureDefinition = getCreatureDefinition(className);
+        if(creatureDefinition == nullptr)
+            return false;
+
+        std::vector<const SpawnCondition*>& spawnConditions = mCreatureSpawnConditions[creatureDefinition];
+        while(nbConditions > 0)
+        {
+            --nbConditions;
+            SpawnCondition* spawnCondition = SpawnCondition::loadFromPacket(is);
+            if(spawnCondition == nullptr)
+                return false;
+
+            spawnConditions.push_back(spawnCondition);
+        }
     }
-    mWeapons.clear();
 
-    for(std::pair<const CreatureDefinition*, std::vector<const SpawnCondition*>> p : mCreatureSpawnConditions)
+    if(!(is >> mDefaultWorkerRogue >> nb))
+        return false;
+    while(nb > 0)
     {
-        for(const SpawnCondition* spawnCondition : p.second)
+        --nb;
+        std::string factionName;
+        std::string workerClass;
+        uint32_t nbClasses;
+        if(!(is >> factionName >> workerClass >> nbClasses))
+            return false;
+
+        mFactions.push_back(factionName);
+        mFactionDefaultWorkerClass[factionName] = workerClass;
+        std::vector<std::string>& spawnPool = mFactionSpawnPool[factionName];
+        while(nbClasses > 0)
         {
-            delete spawnCondition;
+            --nbClasses;
+            std::string className;
+            if(!(is >> className))
+                return false;
+
+            spawnPool.push_back(className);
         }
     }
-    mCreatureSpawnConditions.clear();
 
-    for(std::pair<const std::string, const TileSet*> p : mTileSets)
+    if(!importConfigMap(is, mRoomsConfig))
+        return false;
+    if(!importConfigMap(is, mTrapsConfig))
+        return false;
+    if(!importConfigMap(is, mSpellConfig))
+        return false;
+    if(!importConfigMap(is, mSkillPoints))
+        return false;
+
+    if(!(is >> nb))
+        return false;
+    while(nb > 0)
     {
-        delete p.second;
+        --nb;
+        std::string tileSetName;
+        if(!(is >> tileSetName))
+            return false;
+
+        TileSet* tileSet = new TileSet();
+        mTileSets[tileSetName] = tileSet;
+        if(!tileSet->importFromPacket(is))
+            return false;
     }
-    mTileSets.clear();
+
+    return (mTileSets.count(DEFAULT_TILESET_NAME) > 0);
 }
 
 bool ConfigManager::loadGlobalConfig(const std::string& configPath)
@@ -451,6 +733,13 @@ bool ConfigManager::loadGlobalGameConfig(std::stringstream& configFile)
             // Not mandatory
         }
 
+        if(nextParam == "AutoSavePeriod")
+        {
+            configFile >> nextParam;
+            mAutoSavePeriod = Helper::toUInt32(nextParam);
+            // Not mandatory
+        }
+
         if(nextParam == "CreatureDeathCounter")
         {
             configFile >> nextParam;
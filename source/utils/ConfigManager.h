@@ -24,6 +24,7 @@
 #include <cstdint>
 
 class CreatureDefinition;
+class ODPacket;
 class Weapon;
 class SpawnCondition;
 class Skill;
@@ -72,10 +73,11 @@ public:
     //! \brief Loads the game configuration files.
     //! \param configPath The system configuration path.
     //! \param userConfigPath The user profile config path or empty if not used.
+    //! \param cacheFileName The binary cache of the parsed definitions or empty if not used.
     //! \note In server mode, the configuration doesn't load the user config and thus,
     //! doesn't set the userConfigPath.
     ConfigManager(const std::string& configPath, const std::string& userConfigPath,
-        const std::string& soundPath);
+        const std::string& soundPath, const std::string& cacheFileName);
     ~ConfigManager();
 
     static const std::string DefaultWorkerCreatureDefinition;
@@ -130,6 +132,9 @@ public:
     inline uint32_t getClientConnectionTimeout() const
     { return mClientConnectionTimeout; }
 
+    inline uint32_t getAutoSavePeriod() const
+    { return mAutoSavePeriod; }
+
     inline uint32_t getBaseSpawnPoint() const
     { return mBaseSpawnPoint; }
 
@@ -251,6 +256,16 @@ private:
     bool loadGlobalConfigSeatColors(std::stringstream& configFile);
     bool loadGlobalConfigDefinitionFiles(std::stringstream& configFile);
     bool loadGlobalGameConfig(std::stringstream& configFile);
+
+    //! \brief Loads the definitions from the cache if it was written for the current definition files. Otherwise,
+    //! parses the files and rewrites the cache
+    bool loadDefinitions(const std::string& configPath, const std::string& cacheFileName);
+    bool parseDefinitions(const std::string& configPath);
+    //! \brief Releases the loaded definitions. Used if the cache turns out to be invalid
+    void clearDefinitions();
+    void exportDefinitionsToPacket(ODPacket& os) const;
+    bool importDefinitionsFromPacket(ODPacket& is);
+
     bool loadCreatureDefinitions(const std::string& fileName);
     bool loadEquipements(const std::string& fileName);
     bool loadSpawnConditions(const std::string& fileName);
@@ -288,6 +303,8 @@ private:
     std::string mFilenameUserCfg;
     uint32_t mNetworkPort;
     uint32_t mClientConnectionTimeout;
+    //! \brief Number of turns between 2 autosaves. 0 to disable autosave
+    uint32_t mAutoSavePeriod;
     uint32_t mBaseSpawnPoint;
     uint32_t mCreatureDeathCounter;
     uint32_t mMaxCreaturesPerSeatAbsolute;
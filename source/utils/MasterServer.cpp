@@ -17,11 +17,14 @@
 
 #include "utils/MasterServer.h"
 
-#include "utils/ConfigManager.h"
+#include "utils/Helper.h"
 #include "utils/LogManager.h"
 
 #include <SFML/Network.hpp>
 
+#include <algorithm>
+#include <sstream>
+
 // We will replace all special meaning chars to make sure they are correctly read
 // by the master server. For example, since ';' is the separation for CSV,
 // we don't want to use some in the texts as it may break our reading.
@@ -35,11 +38,12 @@ static const std::vector<std::pair<char,char>> specialChars = {
 
 namespace MasterServer
 {
-    bool fillMasterServerGames(const std::string& odVersion, std::vector<MasterServerGame>& masterServerGames)
+    bool fillMasterServerGames(const std::string& url, uint16_t urlPort, const std::string& odVersion,
+        std::vector<MasterServerGame>& masterServerGames)
     {
         sf::Http::Request request("/get_csv.php", sf::Http::Request::Get);
-        sf::Http http(ConfigManager::getSingleton().getMasterServerUrl());
-        sf::Http::Response response = http.sendRequest(request);
+        sf::Http http(url, urlPort);
+        sf::Http::Response response = http.sendRequest(request, sf::seconds(REQUEST_TIMEOUT_S));
 
         if (response.getStatus() != sf::Http::Response::Ok)
             return false;
@@ -73,7 +77,8 @@ namespace MasterServer
         return true;
     }
 
-    bool registerGame(const std::string& odVersion, const std::string& creator, int32_t port, const std::string& label, const std::string& descr, std::string& uuid)
+    bool registerGame(const std::string& url, uint16_t urlPort, const std::string& odVersion, const std::string& creator,
+        int32_t port, const std::string& label, const std::string& descr, std::string& uuid)
     {
         // Before sending the level informations, we format the strings to avoid special meaning chars
         // like '\n' or ';'
@@ -85,8 +90,8 @@ namespace MasterServer
             + "&descr=" + formatStringForMasterServer(descr);
         request.setBody(body);
 
-        sf::Http http(ConfigManager::getSingleton().getMasterServerUrl());
-        sf::Http::Response response = http.sendRequest(request);
+        sf::Http http(url, urlPort);
+        sf::Http::Response response = http.sendRequest(request, sf::seconds(REQUEST_TIMEOUT_S));
         if (response.getStatus() != sf::Http::Response::Ok)
             return false;
 
@@ -102,15 +107,15 @@ namespace MasterServer
         return true;
     }
 
-    bool updateGame(const std::string& uuid, int32_t status)
+    bool updateGame(const std::string& url, uint16_t urlPort, const std::string& uuid, int32_t status)
     {
         sf::Http::Request request("/update.php", sf::Http::Request::Post);
         std::string body = "uuid=" + uuid
             + "&status=" + Helper::toString(status);
         request.setBody(body);
 
-        sf::Http http(ConfigManager::getSingleton().getMasterServerUrl());
-        sf::Http::Response response = http.sendRequest(request);
+        sf::Http http(url, urlPort);
+        sf::Http::Response response = http.sendRequest(request, sf::seconds(REQUEST_TIMEOUT_S));
         if (response.getStatus() != sf::Http::Response::Ok)
             return false;
 
@@ -44,19 +44,27 @@ public:
     const std::string mDescr;
 };
 
-//! \brief MasterServer namespace contains globals use to communicate with the master server
+//! \brief MasterServer namespace contains globals use to communicate with the master server.
+//! The requests are blocking (up to REQUEST_TIMEOUT_S). They should not be sent from the game or
+//! rendering loops (see MasterServerWorker).
+//! url is the master server url and urlPort its port (0 for the default http port)
 namespace MasterServer
 {
+    //! \brief Time after which a request is considered as failed
+    const float REQUEST_TIMEOUT_S = 5.0f;
+
     //! \brief Connects to the master server and fills the given list will currently pending games
     //! Returns true if connection is successful and masterServerGames will be filled
-    bool fillMasterServerGames(const std::string& odVersion, std::vector<MasterServerGame>& masterServerGames);
+    bool fillMasterServerGames(const std::string& url, uint16_t urlPort, const std::string& odVersion,
+        std::vector<MasterServerGame>& masterServerGames);
 
     //! \brief Registers a game to the master server. Returns true if the connexion is successful and
     //! uuid is set to the uuid returned by the server
-    bool registerGame(const std::string& odVersion, const std::string& creator, int32_t port, const std::string& label, const std::string& descr, std::string& uuid);
+    bool registerGame(const std::string& url, uint16_t urlPort, const std::string& odVersion, const std::string& creator,
+        int32_t port, const std::string& label, const std::string& descr, std::string& uuid);
 
-    //! \brief Registers a game to the master server. Returns true if the connexion is successful
-    bool updateGame(const std::string& uuid, int32_t status);
+    //! \brief Updates the status of a registered game. Returns true if the connexion is successful
+    bool updateGame(const std::string& url, uint16_t urlPort, const std::string& uuid, int32_t status);
 
     //! \brief Formats the string so that it can be read by the master server
     //! returns the formatted string
@@ -0,0 +1,208 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/MasterServerWorker.h"
+
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <algorithm>
+
+//! \brief Number of times a request is sent before giving up
+static const uint32_t MAX_NB_TRIES = 3;
+//! \brief Delay before the first retry. It is doubled after each failure
+static const float FIRST_RETRY_DELAY_S = 1.0f;
+//! \brief While waiting before a retry, we check regularly if the worker is stopped
+static const float STOP_CHECK_PERIOD_S = 0.1f;
+
+MasterServerWorker::MasterServerWorker(const std::string& url, uint16_t urlPort) :
+    mUrl(url),
+    mUrlPort(urlPort),
+    mThread(&MasterServerWorker::processRequests, this),
+    mIsThreadRunning(false),
+    mIsStopRequested(false),
+    mHasGamesListResult(false),
+    mIsGamesListSuccess(false)
+{
+}
+
+MasterServerWorker::~MasterServerWorker()
+{
+    {
+        sf::Lock lock(mMutex);
+        mIsStopRequested = true;
+    }
+    mThread.wait();
+}
+
+void MasterServerWorker::requestGamesList(const std::string& odVersion)
+{
+    sf::Lock lock(mMutex);
+    for(const Request& request : mRequests)
+    {
+        if(request.mType == RequestType::gamesList)
+            return;
+    }
+
+    Request request(RequestType::gamesList);
+    request.mOdVersion = odVersion;
+    queueRequest(request);
+}
+
+bool MasterServerWorker::popGamesList(std::vector<MasterServerGame>& games, bool& isSuccess)
+{
+    sf::Lock lock(mMutex);
+    if(!mHasGamesListResult)
+        return false;
+
+    mHasGamesListResult = false;
+    isSuccess = mIsGamesListSuccess;
+    games.clear();
+    games.swap(mGamesList);
+    return true;
+}
+
+void MasterServerWorker::updateGame(const std::string& uuid, int32_t status)
+{
+    sf::Lock lock(mMutex);
+    // If an update for the same game is waiting, we replace it. We do not replace the front request
+    // because it may be being sent
+    for(std::size_t i = 1; i < mRequests.size(); ++i)
+    {
+        Request& request = mRequests[i];
+        if((request.mType != RequestType::updateGame) || (request.mUuid != uuid))
+            continue;
+
+        request.mStatus = status;
+        request.mNbTries = 0;
+        return;
+    }
+
+    Request request(RequestType::updateGame);
+    request.mUuid = uuid;
+    request.mStatus = status;
+    queueRequest(request);
+}
+
+bool MasterServerWorker::isIdle()
+{
+    sf::Lock lock(mMutex);
+    return mRequests.empty();
+}
+
+void MasterServerWorker::queueRequest(const Request& request)
+{
+    mRequests.push_back(request);
+    if(!mIsThreadRunning && !mIsStopRequested)
+    {
+        // The previous thread (if any) has nothing left to do. launch() waits for it to end
+        mIsThreadRunning = true;
+        mThread.launch();
+    }
+}
+
+bool MasterServerWorker::sendRequest(const Request& request, std::vector<MasterServerGame>& games)
+{
+    switch(request.mType)
+    {
+        case RequestType::gamesList:
+            games.clear();
+            return MasterServer::fillMasterServerGames(mUrl, mUrlPort, request.mOdVersion, games);
+        case RequestType::updateGame:
+            return MasterServer::updateGame(mUrl, mUrlPort, request.mUuid, request.mStatus);
+        default:
+            OD_LOG_ERR("Unexpected request type=" + Helper::toString(static_cast<int32_t>(request.mType)));
+            return true;
+    }
+}
+
+bool MasterServerWorker::waitBeforeRetry(float seconds)
+{
+    while(seconds > 0.0f)
+    {
+        {
+            sf::Lock lock(mMutex);
+            if(mIsStopRequested)
+                return false;
+        }
+        float wait = std::min(seconds, STOP_CHECK_PERIOD_S);
+        sf::sleep(sf::seconds(wait));
+        seconds -= wait;
+    }
+    return true;
+}
+
+void MasterServerWorker::processRequests()
+{
+    std::vector<MasterServerGame> games;
+    while(true)
+    {
+        // The front request stays in the queue while it is processed so that updates of the same
+        // game are queued behind it
+        Request request(RequestType::gamesList);
+        bool isStopRequested;
+        {
+            sf::Lock lock(mMutex);
+            // Once mIsThreadRunning is cleared, the thread should not lock mMutex anymore
+            // because queueRequest may be waiting for it to end while holding the lock
+            if(mRequests.empty())
+            {
+                mIsThreadRunning = false;
+                return;
+            }
+            request = mRequests.front();
+            isStopRequested = mIsStopRequested;
+        }
+
+        // When stopping, we only send the status updates once
+        bool isSuccess = false;
+        if(!isStopRequested || (request.mType == RequestType::updateGame))
+            isSuccess = sendRequest(request, games);
+
+        ++request.mNbTries;
+        if(!isSuccess && !isStopRequested && (request.mNbTries < MAX_NB_TRIES))
+        {
+            float delay = FIRST_RETRY_DELAY_S * static_cast<float>(1 << (request.mNbTries - 1));
+            OD_LOG_WRN("Master server request failed, retrying in " + Helper::toString(delay) + "s");
+            if(waitBeforeRetry(delay))
+            {
+                sf::Lock lock(mMutex);
+                mRequests.front().mNbTries = request.mNbTries;
+                continue;
+            }
+        }
+
+        if(!isSuccess)
+            OD_LOG_WRN("Master server request failed url=" + mUrl);
+
+        sf::Lock lock(mMutex);
+        mRequests.pop_front();
+        if(request.mType == RequestType::gamesList)
+        {
+            mHasGamesListResult = true;
+            mIsGamesListSuccess = isSuccess;
+            mGamesList.swap(games);
+            games.clear();
+        }
+
+        if(mIsStopRequested && mRequests.empty())
+        {
+            mIsThreadRunning = false;
+            return;
+        }
+    }
+}
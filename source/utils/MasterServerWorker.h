@@ -0,0 +1,112 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MASTERSERVERWORKER_H
+#define MASTERSERVERWORKER_H
+
+#include "utils/MasterServer.h"
+
+#include <SFML/System.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+/*! \brief Sends the requests to the master server in a background thread so that a slow or
+ * unreachable master server does not block the game or the menus.
+ *
+ * The requests are queued and processed in order. A failed request is tried again after a delay
+ * that doubles each time until it has been tried MAX_NB_TRIES times. The status updates of a game
+ * replace the update of the same game that is still waiting (only the last status matters).
+ * The games list is retrieved by polling popGamesList.
+ */
+class MasterServerWorker
+{
+public:
+    //! \brief url is the master server url and urlPort its port (0 for the default http port)
+    MasterServerWorker(const std::string& url, uint16_t urlPort = 0);
+
+    //! \brief Waits for the background thread. The pending status updates are tried one last time
+    //! (so that the master server knows when a game ends) but not retried
+    ~MasterServerWorker();
+
+    //! \brief Asks for the list of pending games for the given version. Does nothing if a list is
+    //! already being retrieved
+    void requestGamesList(const std::string& odVersion);
+
+    //! \brief Returns true if a games list request has ended since the last call. In this case,
+    //! isSuccess tells if the list could be retrieved and games is filled with it
+    bool popGamesList(std::vector<MasterServerGame>& games, bool& isSuccess);
+
+    //! \brief Sends the status of the given game
+    void updateGame(const std::string& uuid, int32_t status);
+
+    //! \brief Returns true if there is no request left to process
+    bool isIdle();
+
+private:
+    enum class RequestType
+    {
+        gamesList,
+        updateGame
+    };
+
+    struct Request
+    {
+        Request(RequestType type) :
+            mType(type),
+            mStatus(0),
+            mNbTries(0)
+        {}
+
+        RequestType mType;
+        std::string mOdVersion;
+        std::string mUuid;
+        int32_t mStatus;
+        uint32_t mNbTries;
+    };
+
+    const std::string mUrl;
+    const uint16_t mUrlPort;
+
+    //! \brief Protects every member used by the background thread
+    sf::Mutex mMutex;
+    sf::Thread mThread;
+
+    std::deque<Request> mRequests;
+    bool mIsThreadRunning;
+    bool mIsStopRequested;
+
+    bool mHasGamesListResult;
+    bool mIsGamesListSuccess;
+    std::vector<MasterServerGame> mGamesList;
+
+    //! \brief Adds the request and launches the thread if needed. mMutex should be locked
+    void queueRequest(const Request& request);
+
+    //! \brief Sends the request. Should not be called with mMutex locked
+    bool sendRequest(const Request& request, std::vector<MasterServerGame>& games);
+
+    //! \brief Waits for the given time. Returns false if a stop is requested while waiting
+    bool waitBeforeRetry(float seconds);
+
+    //! \brief Processes the requests until the queue is empty
+    void processRequests();
+};
+
+#endif // MASTERSERVERWORKER_H
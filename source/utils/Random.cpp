@@ -24,87 +24,250 @@
 #include "utils/Helper.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <ctime>
+#include <istream>
+#include <ostream>
 
-unsigned long myRandomSeed;
-const unsigned long MAX = 32768;
-
-static unsigned long randgen()
+//! \brief splitmix64 step. Used to expand a seed into the generator state and to derive
+//! seeds: close seeds give very different results
+static uint64_t splitMix64(uint64_t& state)
 {
-    myRandomSeed = myRandomSeed * 1103515245 + 12345;
-    //TODO: What is the purpose of the cast?
-    unsigned long returnVal = static_cast<unsigned int>(myRandomSeed / 65536) % MAX;
-
-    return returnVal;
+    state += 0x9E3779B97F4A7C15ULL;
+    uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
 }
 
-//! \brief uniformly distributed number [0;1)
-static double uniform()
+static inline uint64_t rotl(uint64_t x, int k)
 {
-    return randgen() * 1.0 / static_cast<double>(MAX);
+    return (x << k) | (x >> (64 - k));
 }
 
-//! \brief uniformly distributed number [lo;hi)
-static double uniform(double lo, double hi)
+RandomGenerator::RandomGenerator(uint64_t seed)
 {
-    return uniform() * (hi - lo) + lo;
+    this->seed(seed);
 }
 
-//! \brief random integer [lo;hi]
-static int randint(int lo, int hi)
+void RandomGenerator::seed(uint64_t seed)
 {
-    return static_cast<int>(uniform() * (hi - lo + 1) + lo);
+    for(uint64_t& state : mState)
+        state = splitMix64(seed);
 }
 
-//! \brief random unsigned integer [lo;hi]
-static unsigned int randuint(unsigned int lo, unsigned int hi)
+uint64_t RandomGenerator::next()
 {
-    return static_cast<unsigned int>(uniform() * (hi - lo + 1) + lo);
-}
+    const uint64_t result = rotl(mState[1] * 5, 7) * 9;
+    const uint64_t t = mState[1] << 17;
 
+    mState[2] ^= mState[0];
+    mState[3] ^= mState[1];
+    mState[1] ^= mState[2];
+    mState[0] ^= mState[3];
 
-namespace Random
-{
+    mState[2] ^= t;
+    mState[3] = rotl(mState[3], 45);
 
-void initialize()
+    return result;
+}
+
+double RandomGenerator::uniform()
 {
-    myRandomSeed = static_cast<unsigned long>(std::time(0));
+    // We use the 53 upper bits as a double mantissa
+    return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
 }
 
-double Double(double min, double max)
+double RandomGenerator::Double(double min, double max)
 {
     if (min > max)
     {
         std::swap(min, max);
     }
 
-    return uniform(min, max);
+    return uniform() * (max - min) + min;
 }
 
-int Int(int min, int max)
+int RandomGenerator::Int(int min, int max)
 {
     if (min > max)
     {
         std::swap(min, max);
     }
 
-    return randint(min, max);
+    return static_cast<int>(std::floor(uniform() * (static_cast<double>(max) - min + 1) + min));
 }
 
-unsigned int Uint(unsigned int min, unsigned int max)
+unsigned int RandomGenerator::Uint(unsigned int min, unsigned int max)
 {
     if (min > max)
     {
         std::swap(min, max);
     }
 
-    return randuint(min, max);
+    return static_cast<unsigned int>(uniform() * (static_cast<double>(max) - min + 1) + min);
+}
+
+double RandomGenerator::gaussianRandomDouble()
+{
+    // uniform() can return 0 and log(0) is not defined
+    return std::sqrt(-2.0 * std::log(1.0 - uniform())) * std::cos(2.0 * PI * uniform());
+}
+
+void RandomGenerator::exportToStream(std::ostream& os) const
+{
+    os << mState[0] << "\t" << mState[1] << "\t" << mState[2] << "\t" << mState[3];
+}
+
+bool RandomGenerator::importFromStream(std::istream& is)
+{
+    uint64_t state[4];
+    if(!(is >> state[0] >> state[1] >> state[2] >> state[3]))
+        return false;
+
+    // xoshiro cannot leave the all zero state
+    if((state[0] | state[1] | state[2] | state[3]) == 0)
+        return false;
+
+    std::copy(state, state + 4, mState);
+    return true;
+}
+
+RandomContext::RandomContext() :
+    mMatchSeed(0)
+{
+}
+
+namespace
+{
+    RandomContext gContext;
+    thread_local RandomContext* gThreadContext = nullptr;
+
+    RandomContext& getContext()
+    {
+        if(gThreadContext != nullptr)
+            return *gThreadContext;
+
+        return gContext;
+    }
+}
+
+namespace Random
+{
+
+void setThreadContext(RandomContext* context)
+{
+    gThreadContext = context;
+}
+
+void initialize()
+{
+    initialize(generateSeed());
+}
+
+void initialize(uint64_t seed)
+{
+    RandomContext& context = getContext();
+    context.mMatchSeed = seed;
+    for(uint32_t i = 0; i < static_cast<uint32_t>(RandomStream::nbStreams); ++i)
+        context.mGenerators[i].seed(deriveSeed(static_cast<RandomStream>(i), 0));
+}
+
+uint64_t getSeed()
+{
+    return getContext().mMatchSeed;
+}
+
+uint64_t generateSeed()
+{
+    uint64_t state = static_cast<uint64_t>(std::time(0));
+    state ^= static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    uint64_t seed = splitMix64(state);
+    // 0 is used to tell no seed is set
+    if(seed == 0)
+        seed = 1;
+
+    return seed;
+}
+
+uint64_t deriveSeed(RandomStream stream, uint64_t entityId)
+{
+    uint64_t state = getContext().mMatchSeed;
+    state ^= splitMix64(entityId);
+    state += static_cast<uint64_t>(stream) << 56;
+    return splitMix64(state);
+}
+
+uint64_t deriveSeed(RandomStream stream, const std::string& entityName)
+{
+    // FNV-1a. std::hash is not used because its result depends on the standard library
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for(char c : entityName)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001B3ULL;
+    }
+    return deriveSeed(stream, hash);
+}
+
+std::string getStateKey(RandomStream stream, const std::string& entity)
+{
+    std::string key;
+    switch(stream)
+    {
+        case RandomStream::game:
+            key = "game";
+            break;
+        case RandomStream::ai:
+            key = "ai";
+            break;
+        case RandomStream::sound:
+            key = "sound";
+            break;
+        case RandomStream::creature:
+            key = "creature";
+            break;
+        case RandomStream::room:
+            key = "room";
+            break;
+        case RandomStream::spawning:
+            key = "spawning";
+            break;
+        default:
+            key = "stream" + Helper::toString(static_cast<uint32_t>(stream));
+            break;
+    }
+
+    if(!entity.empty())
+        key += "." + entity;
+
+    return key;
+}
+
+RandomGenerator& getGenerator(RandomStream stream)
+{
+    return getContext().mGenerators[static_cast<uint32_t>(stream)];
+}
+
+double Double(double min, double max)
+{
+    return getGenerator(RandomStream::game).Double(min, max);
+}
+
+int Int(int min, int max)
+{
+    return getGenerator(RandomStream::game).Int(min, max);
+}
+
+unsigned int Uint(unsigned int min, unsigned int max)
+{
+    return getGenerator(RandomStream::game).Uint(min, max);
 }
 
 double gaussianRandomDouble()
 {
-    return std::sqrt(-2.0 * log(Double(0.0, 1.0))) * cos(2.0 * PI * Double(0.0, 1.0));
+    return getGenerator(RandomStream::game).gaussianRandomDouble();
 }
 
 } // namespace Random
@@ -23,12 +23,111 @@
 #ifndef RANDOM_H_
 #define RANDOM_H_
 
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+//! \brief Independent random streams. Each subsystem draws from its own stream so that
+//! the numbers used by one do not depend on how many numbers the others used
+enum class RandomStream
+{
+    game,       // Server side gameplay not covered by the other streams. Used by the Random functions
+    ai,         // Keeper AIs. Each AI derives its own generator from this stream
+    sound,      // Client side sounds
+    creature,   // Creatures. Each creature derives its own generator from this stream
+    room,       // Rooms
+    spawning,   // Creatures spawned by portals and portal waves
+    nbStreams
+};
+
+/*! \brief Seedable pseudo random number generator (xoshiro256**). It is fast, has a
+ *  period of 2^256 - 1 and two generators built with the same seed give the same sequence.
+ */
+class RandomGenerator
+{
+public:
+    explicit RandomGenerator(uint64_t seed = 0);
+
+    //! \brief Restarts the sequence from the given seed
+    void seed(uint64_t seed);
+
+    //! \brief Returns the next 64 random bits
+    uint64_t next();
+
+    //! \brief uniformly distributed number in [min;max)
+    double Double(double min, double max);
+
+    //! \brief uniformly distributed integer in [min;max]
+    int Int(int min, int max);
+
+    //! \brief uniformly distributed unsigned integer in [min;max]
+    unsigned int Uint(unsigned int min, unsigned int max);
+
+    //! \brief gaussian distributed double
+    double gaussianRandomDouble();
+
+    //! \brief Writes the generator state so that the sequence can be continued later
+    void exportToStream(std::ostream& os) const;
+
+    //! \brief Reads a state written by exportToStream. Returns false and leaves the generator
+    //! unchanged if the state cannot be read
+    bool importFromStream(std::istream& is);
+
+private:
+    uint64_t mState[4];
+
+    //! \brief uniformly distributed number [0;1)
+    double uniform();
+};
+
+/*! \brief Match seed and generators used by the Random functions. By default, the process
+ *  uses a global context. A server hosting several matches in the same process gives each
+ *  match its own context (see Random::setThreadContext) so that the matches do not share
+ *  their sequences.
+ */
+class RandomContext
+{
+public:
+    RandomContext();
+
+    uint64_t mMatchSeed;
+    RandomGenerator mGenerators[static_cast<uint32_t>(RandomStream::nbStreams)];
+};
+
 namespace Random
 {
-    //! \brief initializes the semaphore and seeds the generator
+    //! \brief Makes the Random functions called from the current thread use the given context.
+    //! If nullptr, the global context is used
+    void setThreadContext(RandomContext* context);
+
+    //! \brief seeds the generators with a seed computed from the current time
     void initialize();
 
-    /*! \brief generate a random double
+    //! \brief seeds the generators from the given match seed. Every stream is
+    //! derived from it so that a match started with the same seed gives the same results
+    void initialize(uint64_t seed);
+
+    //! \brief Returns the seed used by the last call to initialize
+    uint64_t getSeed();
+
+    //! \brief Returns a new seed that can be used for a new match
+    uint64_t generateSeed();
+
+    //! \brief Returns a seed derived from the match seed for the given stream and
+    //! entity. Entities needing their own generator (like the AIs) should use it
+    uint64_t deriveSeed(RandomStream stream, uint64_t entityId);
+
+    //! \brief Same as deriveSeed for entities identified by their name (like the creatures)
+    uint64_t deriveSeed(RandomStream stream, const std::string& entityName);
+
+    //! \brief Returns the key under which the state of a generator is saved. If entity is
+    //! empty, the key is the one of the stream generator
+    std::string getStateKey(RandomStream stream, const std::string& entity = std::string());
+
+    //! \brief Returns the generator of the given stream
+    RandomGenerator& getGenerator(RandomStream stream);
+
+    /*! \brief generate a random double from the game stream
      *
      *  \param min, max One or both can be negative
      *
@@ -37,7 +136,7 @@ namespace Random
      */
     double Double(double min, double max);
 
-    /*! \brief generate a random int
+    /*! \brief generate a random int from the game stream
      *
      *  \param min, max One or both can be negative
      *
@@ -46,7 +145,7 @@ namespace Random
      */
     int Int(int min, int max);
 
-    /*! \brief generate a random unsigned int
+    /*! \brief generate a random unsigned int from the game stream
      *
      *  \param min, max One or both can be negative
      *
@@ -55,7 +154,7 @@ namespace Random
      */
     unsigned int Uint(unsigned int min, unsigned int max);
 
-    /*! \brief generates a gaussian distributed random double
+    /*! \brief generates a gaussian distributed random double from the game stream
      *
      *  \return a gaussian distributed random double value in [-1,1]
      */
@@ -54,6 +54,8 @@
 
 #include <boost/program_options.hpp>
 
+#include <algorithm>
+
 template<> ResourceManager* Ogre::Singleton<ResourceManager>::msSingleton = nullptr;
 #if OGRE_PLATFORM == OGRE_PLATFORM_WIN32 && defined(OD_DEBUG)
 //On windows, if the application is compiled in debug mode, use the plugins with debug prefix.
@@ -71,6 +73,8 @@ const std::string ResourceManager::SHADERCACHESUBPATH = "shaderCache/";
 const std::string ResourceManager::LOGFILENAME = "opendungeons.log";
 const std::string ResourceManager::CEGUILOGFILENAME = "CEGUI.log";
 const std::string ResourceManager::USERCFGFILENAME = "config.cfg";
+const std::string ResourceManager::LEVELINDEXFILENAME = "levelindex.cache";
+const std::string ResourceManager::CONFIGCACHEFILENAME = "config.cache";
 
 const std::string ResourceManager::RESOURCEGROUPMUSIC = "Music";
 const std::string ResourceManager::RESOURCEGROUPSOUND = "Sound";
@@ -84,7 +88,9 @@ const std::string ResourceManager::RESOURCEGROUPSOUND = "Sound";
  */
 ResourceManager::ResourceManager(boost::program_options::variables_map& options) :
         mServerMode(false),
+        mServerModeNbMatches(1),
         mForcedNetworkPort(-1),
+        mProfileStartup(false),
         mLogLevel(LogMessageLevel::NORMAL),
         mGameDataPath("./"),
         mUserDataPath("./"),
@@ -429,6 +435,12 @@ void ResourceManager::setupUserDataFolders(boost::program_options::variables_map
     if(itOption != options.end())
         mForcedNetworkPort = itOption->second.as<int32_t>();
 
+    itOption = options.find("matches");
+    if(itOption != options.end())
+        mServerModeNbMatches = std::max(1, itOption->second.as<int32_t>());
+
+    mProfileStartup = (options.count("profile-startup") > 0);
+
     itOption = options.find("loglevel");
     if(itOption != options.end())
         mLogLevel = static_cast<LogMessageLevel>(itOption->second.as<int32_t>());
@@ -436,6 +448,8 @@ void ResourceManager::setupUserDataFolders(boost::program_options::variables_map
     mUserConfigFile = mUserConfigPath + USERCFGFILENAME;
     mCeguiLogFile = mUserDataPath + CEGUILOGFILENAME;
     mShaderCachePath = mUserDataPath + SHADERCACHESUBPATH;
+    mLevelIndexFile = mUserDataPath + LEVELINDEXFILENAME;
+    mConfigCacheFile = mUserDataPath + CONFIGCACHEFILENAME;
 
     // Backup the Ogre log files from the previous three instances
     try
@@ -577,7 +591,9 @@ void ResourceManager::buildCommandOptions(boost::program_options::options_descri
         ("appData", boost::program_options::value<std::string>(), "Sets appData to the given path (where logs, replays, ... are saved)")
         ("mscreator", boost::program_options::value<std::string>(), "Sets the creator for this map to connect to the master server. server/servercustom/serversave option needs to be on")
         ("port", boost::program_options::value<int32_t>(), "Sets the port used. Note that the port is used for both single and multi player")
+        ("matches", boost::program_options::value<int32_t>(), "Sets the number of matches hosted on the level in server mode. Each match uses the next port")
         ("loglevel", boost::program_options::value<int32_t>(), "Sets the log level (between 0=Trivial and 3=Critical)")
+        ("profile-startup", "Logs the time spent in each client startup stage")
     ;
 }
 
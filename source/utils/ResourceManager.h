@@ -129,6 +129,12 @@ public:
     inline const std::string& getCeguiLogFile() const
     { return mCeguiLogFile; }
 
+    inline const std::string& getLevelIndexFile() const
+    { return mLevelIndexFile; }
+
+    inline const std::string& getConfigCacheFile() const
+    { return mConfigCacheFile; }
+
     std::string getGameLevelPathSkirmish() const;
     std::string getUserLevelPathSkirmish() const
     { return mUserSkirmishLevelsPath; }
@@ -145,9 +151,15 @@ public:
     inline const std::string& getServerModeCreator() const
     { return mServerModeCreator; }
 
+    inline int32_t getServerModeNbMatches() const
+    { return mServerModeNbMatches; }
+
     inline int32_t getForcedNetworkPort() const
     { return mForcedNetworkPort; }
 
+    inline bool isProfileStartup() const
+    { return mProfileStartup; }
+
     inline LogMessageLevel getLogLevel() const
     { return mLogLevel; }
 
@@ -156,10 +168,15 @@ private:
     bool mServerMode;
     std::string mServerModeLevel;
     std::string mServerModeCreator;
+    //! \brief Number of matches hosted in the same process
+    int32_t mServerModeNbMatches;
 
     //! \brief used when the network port is forced
     int32_t mForcedNetworkPort;
 
+    //! \brief used when the startup stages timings should be logged
+    bool mProfileStartup;
+
     //! \brief The log level
     LogMessageLevel mLogLevel;
 
@@ -186,6 +203,8 @@ private:
     std::string mOgreLogFile;
     std::string mCeguiLogFile;
     std::string mShaderCachePath;
+    std::string mLevelIndexFile;
+    std::string mConfigCacheFile;
 
     //! \brief Specific data sub-paths.
     std::string mConfigPath;
@@ -210,6 +229,8 @@ private:
     static const std::string LOGFILENAME;
     static const std::string CEGUILOGFILENAME;
     static const std::string USERCFGFILENAME;
+    static const std::string LEVELINDEXFILENAME;
+    static const std::string CONFIGCACHEFILENAME;
 
     static const std::string RESOURCEGROUPMUSIC;
     static const std::string RESOURCEGROUPSOUND;
@@ -0,0 +1,62 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/StartupProfiler.h"
+
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+StartupProfiler::StartupProfiler(bool isEnabled) :
+    mIsEnabled(isEnabled),
+    mIsReported(false)
+{
+}
+
+void StartupProfiler::startStage(const std::string& name)
+{
+    if(!mIsEnabled)
+        return;
+
+    endStage();
+    mCurrentStage = name;
+    mStageClock.restart();
+}
+
+void StartupProfiler::endStage()
+{
+    if(mCurrentStage.empty())
+        return;
+
+    mStages.push_back(std::make_pair(mCurrentStage, mStageClock.getElapsedTime().asMicroseconds()));
+    mCurrentStage.clear();
+}
+
+void StartupProfiler::report()
+{
+    if(!mIsEnabled || mIsReported)
+        return;
+
+    mIsReported = true;
+    endStage();
+    sf::Int64 totalUs = mTotalClock.getElapsedTime().asMicroseconds();
+    OD_LOG_INF("Startup profile:");
+    for(const std::pair<std::string, sf::Int64>& stage : mStages)
+    {
+        OD_LOG_INF("  " + stage.first + ": " + Helper::toString(static_cast<double>(stage.second) / 1000.0) + " ms");
+    }
+    OD_LOG_INF("  Total: " + Helper::toString(static_cast<double>(totalUs) / 1000.0) + " ms");
+}
@@ -0,0 +1,55 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STARTUPPROFILER_H
+#define STARTUPPROFILER_H
+
+#include <SFML/System/Clock.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/*! \brief Measures the time spent in each client startup stage (launched with --profile-startup).
+ *
+ * Stages are consecutive: starting a stage ends the previous one. When disabled, nothing is
+ * recorded nor logged.
+ */
+class StartupProfiler
+{
+public:
+    StartupProfiler(bool isEnabled);
+
+    //! \brief Ends the current stage (if any) and starts the given one
+    void startStage(const std::string& name);
+
+    //! \brief Ends the current stage and logs the time spent in every stage. Does nothing
+    //! if the report has already been logged
+    void report();
+
+private:
+    bool mIsEnabled;
+    bool mIsReported;
+    sf::Clock mTotalClock;
+    sf::Clock mStageClock;
+    std::string mCurrentStage;
+    std::vector<std::pair<std::string, sf::Int64>> mStages;
+
+    void endStage();
+};
+
+#endif // STARTUPPROFILER_H
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/WorkerPool.h"
+
+#include <algorithm>
+#include <thread>
+
+WorkerPool::WorkerPool(uint32_t nbWorkers) :
+    mIsStopRequested(false),
+    mTasks(nullptr),
+    mNextTask(0),
+    mNbPendingTasks(0)
+{
+    for(uint32_t i = 0; i < nbWorkers; ++i)
+    {
+        mThreads.emplace_back(new sf::Thread(&WorkerPool::workerThread, this));
+        mThreads.back()->launch();
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsStopRequested = true;
+    }
+    mTasksCondition.notify_all();
+
+    for(std::unique_ptr<sf::Thread>& thread : mThreads)
+        thread->wait();
+}
+
+void WorkerPool::run(const std::vector<std::function<void()>>& tasks)
+{
+    if(tasks.empty())
+        return;
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mTasks = &tasks;
+    mNextTask = 0;
+    mNbPendingTasks = tasks.size();
+    if(!mThreads.empty() && (tasks.size() > 1))
+        mTasksCondition.notify_all();
+
+    processTasks(lock);
+
+    mDoneCondition.wait(lock, [this]() { return mNbPendingTasks == 0; });
+    mTasks = nullptr;
+}
+
+uint32_t WorkerPool::getDefaultNbWorkers()
+{
+    // hardware_concurrency may return 0 if it cannot be computed
+    uint32_t nbThreads = std::max(1u, std::thread::hardware_concurrency());
+    return nbThreads - 1;
+}
+
+void WorkerPool::processTasks(std::unique_lock<std::mutex>& lock)
+{
+    while((mTasks != nullptr) && (mNextTask < mTasks->size()))
+    {
+        const std::function<void()>& task = (*mTasks)[mNextTask];
+        ++mNextTask;
+
+        lock.unlock();
+        task();
+        lock.lock();
+
+        --mNbPendingTasks;
+        if(mNbPendingTasks == 0)
+            mDoneCondition.notify_all();
+    }
+}
+
+void WorkerPool::workerThread()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while(true)
+    {
+        mTasksCondition.wait(lock, [this]()
+        {
+            return mIsStopRequested || ((mTasks != nullptr) && (mNextTask < mTasks->size()));
+        });
+
+        if(mIsStopRequested)
+            return;
+
+        processTasks(lock);
+    }
+}
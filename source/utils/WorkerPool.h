@@ -0,0 +1,82 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <SFML/System.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*! \brief Threads kept alive for the whole game to run the parallel parts of a turn (AI planning,
+ * creature senses, ...) without creating a thread for each of them every turn.
+ *
+ * run() gives a list of tasks to the workers and returns once every task is done. The calling thread
+ * processes tasks too so a pool without worker runs every task on the calling thread. The tasks
+ * may be processed in any order and on any thread: they should not depend on each other and
+ * should install themselves the thread state they need (see ODServer::ThreadBinding).
+ * Only one thread should call run() at a time.
+ */
+class WorkerPool
+{
+public:
+    //! \brief Creates the given number of worker threads
+    WorkerPool(uint32_t nbWorkers);
+
+    //! \brief Stops the workers and waits for them
+    ~WorkerPool();
+
+    inline uint32_t getNbWorkers() const
+    { return static_cast<uint32_t>(mThreads.size()); }
+
+    //! \brief Runs the given tasks on the workers and the calling thread. Returns once all of them are done
+    void run(const std::vector<std::function<void()>>& tasks);
+
+    //! \brief Returns the number of workers to use to keep every hardware thread busy
+    //! (the thread calling run() being one of them)
+    static uint32_t getDefaultNbWorkers();
+
+private:
+    std::vector<std::unique_ptr<sf::Thread>> mThreads;
+
+    //! \brief sf::Mutex cannot be used with a condition variable so the standard ones are used here
+    std::mutex mMutex;
+    //! \brief Notified when tasks are given or when the workers should stop
+    std::condition_variable mTasksCondition;
+    //! \brief Notified when the last task is done
+    std::condition_variable mDoneCondition;
+
+    bool mIsStopRequested;
+    //! \brief Tasks given to run() (nullptr when not running)
+    const std::vector<std::function<void()>>* mTasks;
+    //! \brief Index of the next task to process
+    std::size_t mNextTask;
+    //! \brief Number of tasks not done yet
+    std::size_t mNbPendingTasks;
+
+    //! \brief Processes the tasks left. lock should be locked on mMutex
+    void processTasks(std::unique_lock<std::mutex>& lock);
+
+    void workerThread();
+};
+
+#endif // WORKERPOOL_H